@@ -2,6 +2,13 @@
 
 #include <QMetaType>
 
+#include <memory>
+
 #include "CommonDefinitions.hpp"
 
+// A decoded status frame, shared read-only by every GUI consumer: one
+// allocation per frame, handed between threads and views by pointer.
+using RobotStatusPtr = std::shared_ptr<const utl::RobotStatus>;
+
 Q_DECLARE_METATYPE(utl::RobotStatus)
+Q_DECLARE_METATYPE(RobotStatusPtr)
@@ -1,7 +1,5 @@
 #pragma once
 
-#include <optional>
-
 #include <QObject>
 
 #include "CommonDefinitions.hpp"
@@ -12,18 +10,19 @@ class GuiStateStore final : public QObject {
  public:
   explicit GuiStateStore(QObject* parent = nullptr);
 
-  [[nodiscard]] std::optional<utl::RobotStatus> latestStatus() const;
+  // Null until the first status arrives.
+  [[nodiscard]] RobotStatusPtr latestStatus() const;
   [[nodiscard]] bool isConnected() const;
 
  public slots:
-  void onStatusReceived(const utl::RobotStatus& status);
+  void onStatusReceived(const RobotStatusPtr& status);
   void onServerDisconnected();
 
  signals:
-  void statusUpdated(const utl::RobotStatus& status);
+  void statusUpdated(const RobotStatusPtr& status);
   void connectionChanged(bool connected);
 
  private:
-  std::optional<utl::RobotStatus> _latestStatus;
+  RobotStatusPtr _latestStatus;
   bool _connected{false};
 };
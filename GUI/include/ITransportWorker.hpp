@@ -6,6 +6,7 @@
 
 #include "CommonDefinitions.hpp"
 #include "GuiCommand.hpp"
+#include "GuiMetaTypes.hpp"
 
 class ITransportWorker {
  public:
@@ -19,7 +20,7 @@ class ITransportWorker {
     std::optional<GuiResponse> response;
   };
 
-  using StatusCallback = std::function<void(const utl::RobotStatus&)>;
+  using StatusCallback = std::function<void(RobotStatusPtr)>;
   using ConnectionLostCallback = std::function<void()>;
   using ResponseCallback = std::function<void(const ResponseEvent&)>;
 
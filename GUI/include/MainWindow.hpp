@@ -36,7 +36,7 @@ class MainWindow : public QMainWindow {
   void onJoystickUpdate(int id, double x, double y, bool pressed);
 
  private:
-  void onRobotStatusUpdate(const utl::RobotStatus& status);
+  void onRobotStatusUpdate(const RobotStatusPtr& status);
   Updater _updater;
   GuiStateStore _stateStore;
   Ui::MainWindow *_ui;
@@ -9,6 +9,7 @@
 
 #include "CommonDefinitions.hpp"
 #include "GuiCommand.hpp"
+#include "GuiMetaTypes.hpp"
 #include "ResponseConsumer.hpp"
 
 class QCheckBox;
@@ -28,7 +29,7 @@ class MotorPanelWindow final : public QDialog, public ResponseConsumer {
 
  public:
   explicit MotorPanelWindow(QWidget* parent = nullptr);
-  void setRobotStatus(const utl::RobotStatus& status);
+  void setRobotStatus(const RobotStatusPtr& status);
   void setSelectedMotor(utl::EMotor motor);
   bool suppressGlobalErrorPopup() const override { return true; }
   void processResponse(const GuiResponse& response) override;
@@ -85,6 +86,6 @@ class MotorPanelWindow final : public QDialog, public ResponseConsumer {
   std::map<std::string, std::pair<QLabel*, LedIndicator*>> _netOutputAssignmentRows;
 
   std::vector<utl::EMotor> _visibleMotors;
-  utl::RobotStatus _lastStatus;
+  RobotStatusPtr _lastStatus;
   PendingRequest _pendingRequest{PendingRequest::None};
 };
@@ -12,7 +12,7 @@ class MotorStatsPresenter final : public QObject {
                       QObject* parent = nullptr);
 
  private slots:
-  void onStatusUpdated(const utl::RobotStatus& status);
+  void onStatusUpdated(const RobotStatusPtr& status);
   void onConnectionChanged(bool connected);
 
  private:
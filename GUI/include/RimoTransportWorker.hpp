@@ -1,12 +1,14 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <queue>
 #include <thread>
+#include <unordered_map>
 
 #include "ITransportWorker.hpp"
 #include "GuiCommand.hpp"
@@ -18,8 +20,11 @@ class IRimoGuiClient {
   virtual ~IRimoGuiClient() = default;
   virtual void init() = 0;
   virtual std::optional<utl::RobotStatus> receiveRobotStatus() = 0;
-  virtual std::optional<nlohmann::json> sendCommand(
+  // Non-blocking command path; see utl::RimoClient.
+  virtual std::optional<std::uint64_t> submitCommand(
       const nlohmann::json& command) = 0;
+  virtual std::optional<utl::CommandReply> pollCommandReply(
+      std::chrono::milliseconds wait) = 0;
 };
 
 class RimoTransportWorker final : public ITransportWorker {
@@ -34,11 +39,19 @@ class RimoTransportWorker final : public ITransportWorker {
 
  private:
   void runner();
+  // Submits every queued request without waiting, then delivers whatever
+  // replies have arrived; requests stay in flight across calls.
   void processPendingCommands();
+  void submitPendingCommands();
+  void collectCommandReplies();
+  void emitResponse(std::uint64_t requestId,
+                    const std::optional<nlohmann::json>& reply);
 
   std::atomic<bool> _running{false};
   std::mutex _queueMutex;
   std::queue<Request> _pendingRequests;
+  // Client request id -> GUI request id. Worker thread only.
+  std::unordered_map<std::uint64_t, std::uint64_t> _inFlight;
   std::thread _thread;
   std::unique_ptr<IRimoGuiClient> _client;
 
@@ -32,6 +32,7 @@ class RobotStatusViewModel {
   static std::optional<ToolChangerViewModel> toolChangerForArm(
       const utl::RobotStatus& status, utl::EArm arm);
 
+  // `status` is null while the server is not connected.
   static ResetControlsViewModel resetControlsForStatus(
-      const std::optional<utl::RobotStatus>& status);
+      const utl::RobotStatus* status);
 };
@@ -4,6 +4,7 @@
 #include <QGraphicsView>
 #include <QWidget>
 #include "CommonDefinitions.hpp"
+#include "GuiMetaTypes.hpp"
 
 #include "RobotAluBeam.hpp"
 
@@ -19,7 +20,7 @@ class RobotVisualisation final : public QWidget {
   void moveTop(const QPointF& pos) const;
   void moveLeft(const QPointF& pos) const;
   void moveRight(const QPointF& pos) const;
-  void updateRobotStatus(const utl::RobotStatus& rs) const;
+  void updateRobotStatus(const RobotStatusPtr& status) const;
 
 
  private:
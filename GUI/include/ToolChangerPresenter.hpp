@@ -16,7 +16,7 @@ class ToolChangerPresenter final : public QObject {
   void commandIssued(const GuiCommand& command);
 
  private slots:
-  void onStatusUpdated(const utl::RobotStatus& status);
+  void onStatusUpdated(const RobotStatusPtr& status);
   void onConnectionChanged(bool connected);
 
  private:
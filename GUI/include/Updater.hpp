@@ -13,6 +13,7 @@
 #include "GuiCommand.hpp"
 #include "GuiMetaTypes.hpp"
 #include "ITransportWorker.hpp"
+#include "LatestValueSlot.hpp"
 
 class Updater final : public QObject {
   Q_OBJECT
@@ -26,8 +27,17 @@ class Updater final : public QObject {
   void startUpdaterThread();
   void stopUpdaterThread();
 
+  // Status frames handed over by the transport worker, and how many of them
+  // were replaced by a newer frame before the GUI thread got to them.
+  [[nodiscard]] std::uint64_t queuedStatusFrames() const {
+    return _statusMailbox.publishedCount();
+  }
+  [[nodiscard]] std::uint64_t droppedStatusFrames() const {
+    return _statusMailbox.overwrittenCount();
+  }
+
  signals:
-  void newDataArrived(const utl::RobotStatus& status);
+  void newDataArrived(const RobotStatusPtr& status);
   void serverNotConnected();
 
  public slots:
@@ -40,11 +50,17 @@ class Updater final : public QObject {
     QString senderClassName;
   };
   void handleResponse(const ITransportWorker::ResponseEvent& event);
+  void postStatus(RobotStatusPtr status);
+  void deliverLatestStatus();
   std::uint64_t nextRequestId();
   std::atomic<bool> _running{false};
   std::atomic<std::uint64_t> _requestCounter{1};
   std::mutex _pendingMutex;
   std::unordered_map<std::uint64_t, PendingRequestMeta> _pendingById;
+  // Written by the transport worker, drained on the GUI thread. At most one
+  // delivery is queued in the event loop at a time.
+  utl::LatestValueSlot<RobotStatusPtr> _statusMailbox;
+  std::atomic<bool> _statusDeliveryPending{false};
   std::unique_ptr<ITransportWorker> _worker;
   ErrorNotifier _errorNotifier;
 };
@@ -2,13 +2,16 @@
 
 GuiStateStore::GuiStateStore(QObject* parent) : QObject(parent) {}
 
-std::optional<utl::RobotStatus> GuiStateStore::latestStatus() const {
+RobotStatusPtr GuiStateStore::latestStatus() const {
   return _latestStatus;
 }
 
 bool GuiStateStore::isConnected() const { return _connected; }
 
-void GuiStateStore::onStatusReceived(const utl::RobotStatus& status) {
+void GuiStateStore::onStatusReceived(const RobotStatusPtr& status) {
+  if (!status) {
+    return;
+  }
   const bool wasConnected = _connected;
   _connected = true;
   _latestStatus = status;
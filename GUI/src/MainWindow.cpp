@@ -146,10 +146,14 @@ void MainWindow::openContecPanel() {
   contecPanel->activateWindow();
 }
 
-void MainWindow::onRobotStatusUpdate(const utl::RobotStatus& status) {
+void MainWindow::onRobotStatusUpdate(const RobotStatusPtr& statusPtr) {
+  if (!statusPtr) {
+    return;
+  }
   if (motorPanel) {
-    motorPanel->setRobotStatus(status);
+    motorPanel->setRobotStatus(statusPtr);
   }
+  const auto& status = *statusPtr;
   if (status.joystics.contains(utl::EArm::Left)) {
     const auto& js = status.joystics.at(utl::EArm::Left);
     onJoystickUpdate(0, js.x, js.y, js.btn);
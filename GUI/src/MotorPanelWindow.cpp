@@ -156,11 +156,14 @@ MotorPanelWindow::MotorPanelWindow(QWidget* parent) : QDialog(parent) {
   });
 }
 
-void MotorPanelWindow::setRobotStatus(const utl::RobotStatus& status) {
+void MotorPanelWindow::setRobotStatus(const RobotStatusPtr& status) {
+  if (!status) {
+    return;
+  }
   _lastStatus = status;
   std::vector<utl::EMotor> motors;
-  motors.reserve(status.motors.size());
-  for (const auto& [motor, _] : status.motors) {
+  motors.reserve(status->motors.size());
+  for (const auto& [motor, _] : status->motors) {
     motors.push_back(motor);
   }
   rebuildMotorList(motors);
@@ -265,16 +268,29 @@ void MotorPanelWindow::rebuildMotorList(const std::vector<utl::EMotor>& motors)
 
 void MotorPanelWindow::updateStateLamp() {
   const auto motor = selectedMotor();
-  if (!motor.has_value() || !_lastStatus.motors.contains(*motor)) {
+  if (!motor.has_value() || !_lastStatus ||
+      !_lastStatus->motors.contains(*motor)) {
     _stateLamp->setState(utl::ELEDState::Off);
+    _stateLamp->setToolTip({});
     _enabledLamp->setState(utl::ELEDState::Off);
     _resetAlarmButton->setEnabled(false);
     _enableButton->setEnabled(false);
     _disableButton->setEnabled(false);
     return;
   }
-  const auto& status = _lastStatus.motors.at(*motor);
+  const auto& status = _lastStatus->motors.at(*motor);
   _stateLamp->setState(status.state);
+  switch (status.linkState) {
+    case utl::EMotorLinkState::Online:
+      _stateLamp->setToolTip({});
+      break;
+    case utl::EMotorLinkState::Skipped:
+      _stateLamp->setToolTip("Not responding: status reads are skipped");
+      break;
+    case utl::EMotorLinkState::Probing:
+      _stateLamp->setToolTip("Not responding: probing the drive again");
+      break;
+  }
   const auto enabledIt = status.flags.find(utl::EMotorStatusFlags::Enabled);
   const auto enabledState = enabledIt == status.flags.end()
                                 ? utl::ELEDState::Off
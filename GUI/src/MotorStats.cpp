@@ -95,7 +95,7 @@ void MotorStats::handleUpdate(const utl::RobotStatus& rs) {
                 _motorName);
     return;
   }
-  const auto motData = rs.motors.at(_motorId);
+  const auto& motData = rs.motors.at(_motorId);
   configure(motData);
 
   const auto arm = motorToArm(_motorId);
@@ -10,8 +10,8 @@ MotorStatsPresenter::MotorStatsPresenter(MotorStats* view, const utl::EMotor mot
           &MotorStatsPresenter::onConnectionChanged);
 }
 
-void MotorStatsPresenter::onStatusUpdated(const utl::RobotStatus& status) {
-  _view->handleUpdate(status);
+void MotorStatsPresenter::onStatusUpdated(const RobotStatusPtr& status) {
+  _view->handleUpdate(*status);
 }
 
 void MotorStatsPresenter::onConnectionChanged(const bool connected) {
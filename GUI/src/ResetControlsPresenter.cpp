@@ -2,8 +2,6 @@
 
 #include "RobotStatusViewModel.hpp"
 
-#include <optional>
-
 ResetControlsPresenter::ResetControlsPresenter(ResetControls* view,
                                                GuiStateStore* store,
                                                QObject* parent)
@@ -16,9 +14,8 @@ ResetControlsPresenter::ResetControlsPresenter(ResetControls* view,
           &ResetControlsPresenter::onConnectionChanged);
 }
 
-void ResetControlsPresenter::onStatusUpdated(const utl::RobotStatus& status) {
-  const auto vm =
-      RobotStatusViewModel::resetControlsForStatus(std::make_optional(status));
+void ResetControlsPresenter::onStatusUpdated(const RobotStatusPtr& status) {
+  const auto vm = RobotStatusViewModel::resetControlsForStatus(status.get());
   _view->applyViewModel(vm);
 }
 
@@ -26,6 +23,6 @@ void ResetControlsPresenter::onConnectionChanged(const bool connected) {
   if (connected) {
     return;
   }
-  const auto vm = RobotStatusViewModel::resetControlsForStatus(std::nullopt);
+  const auto vm = RobotStatusViewModel::resetControlsForStatus(nullptr);
   _view->applyViewModel(vm);
 }
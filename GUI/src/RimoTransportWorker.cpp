@@ -10,9 +10,13 @@ class ZmqRimoGuiClient final : public IRimoGuiClient {
   std::optional<utl::RobotStatus> receiveRobotStatus() override {
     return _client.receiveRobotStatus();
   }
-  std::optional<nlohmann::json> sendCommand(
+  std::optional<std::uint64_t> submitCommand(
       const nlohmann::json& command) override {
-    return _client.sendCommand(command);
+    return _client.submitCommand(command);
+  }
+  std::optional<utl::CommandReply> pollCommandReply(
+      const std::chrono::milliseconds wait) override {
+    return _client.pollCommandReply(wait);
   }
 
  private:
@@ -70,7 +74,7 @@ void RimoTransportWorker::runner() {
       continue;
     }
     if (_onStatus) {
-      _onStatus(*status);
+      _onStatus(std::make_shared<const utl::RobotStatus>(std::move(*status)));
     }
     processPendingCommands();
   }
@@ -78,6 +82,11 @@ void RimoTransportWorker::runner() {
 }
 
 void RimoTransportWorker::processPendingCommands() {
+  submitPendingCommands();
+  collectCommandReplies();
+}
+
+void RimoTransportWorker::submitPendingCommands() {
   while (true) {
     Request request;
     {
@@ -90,16 +99,40 @@ void RimoTransportWorker::processPendingCommands() {
     }
 
     const auto jsonCommand = GuiCommandJsonAdapter::toJson(request.command);
-    const auto rawResult = _client->sendCommand(jsonCommand);
-    ResponseEvent responseEvent;
-    responseEvent.id = request.id;
-    if (rawResult) {
-      responseEvent.response = GuiCommandJsonAdapter::fromJson(*rawResult);
+    if (const auto clientId = _client->submitCommand(jsonCommand)) {
+      _inFlight.emplace(*clientId, request.id);
     } else {
-      responseEvent.response = std::nullopt;
+      emitResponse(request.id, std::nullopt);
+    }
+  }
+}
+
+void RimoTransportWorker::collectCommandReplies() {
+  while (!_inFlight.empty()) {
+    auto reply = _client->pollCommandReply(std::chrono::milliseconds{0});
+    if (!reply) {
+      return;
     }
-    if (_onResponse) {
-      _onResponse(responseEvent);
+    const auto it = _inFlight.find(reply->requestId);
+    if (it == _inFlight.end()) {
+      continue;
     }
+    const auto requestId = it->second;
+    _inFlight.erase(it);
+    emitResponse(requestId, reply->response);
+  }
+}
+
+void RimoTransportWorker::emitResponse(
+    const std::uint64_t requestId, const std::optional<nlohmann::json>& reply) {
+  ResponseEvent responseEvent;
+  responseEvent.id = requestId;
+  if (reply) {
+    responseEvent.response = GuiCommandJsonAdapter::fromJson(*reply);
+  } else {
+    responseEvent.response = std::nullopt;
+  }
+  if (_onResponse) {
+    _onResponse(responseEvent);
   }
 }
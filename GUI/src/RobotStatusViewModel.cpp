@@ -34,9 +34,9 @@ std::optional<ToolChangerViewModel> RobotStatusViewModel::toolChangerForArm(
 }
 
 ResetControlsViewModel RobotStatusViewModel::resetControlsForStatus(
-    const std::optional<utl::RobotStatus>& status) {
+    const utl::RobotStatus* status) {
   ResetControlsViewModel vm;
-  if (!status.has_value()) {
+  if (status == nullptr) {
     return vm;
   }
   vm.server = utl::ELEDState::On;
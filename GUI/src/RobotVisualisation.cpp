@@ -71,7 +71,11 @@ void RobotVisualisation::resizeEvent(QResizeEvent* event) {
   _view->fitInView(_scene->sceneRect(), Qt::KeepAspectRatio);
 }
 
-void RobotVisualisation::updateRobotStatus(const utl::RobotStatus& rs) const {
+void RobotVisualisation::updateRobotStatus(const RobotStatusPtr& status) const {
+  if (!status) {
+    return;
+  }
+  const auto& rs = *status;
   const auto updateArm = [&rs](utl::EMotor xMotor, utl::EMotor yMotor)
       -> std::optional<QPointF> {
     const auto xIt = rs.motors.find(xMotor);
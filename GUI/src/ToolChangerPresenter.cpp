@@ -14,8 +14,8 @@ ToolChangerPresenter::ToolChangerPresenter(ToolChanger* view, const utl::EArm ar
           &ToolChangerPresenter::onConnectionChanged);
 }
 
-void ToolChangerPresenter::onStatusUpdated(const utl::RobotStatus& status) {
-  const auto vm = RobotStatusViewModel::toolChangerForArm(status, _arm);
+void ToolChangerPresenter::onStatusUpdated(const RobotStatusPtr& status) {
+  const auto vm = RobotStatusViewModel::toolChangerForArm(*status, _arm);
   if (!vm.has_value()) {
     return;
   }
@@ -13,7 +13,10 @@ namespace {
 void ensureMetaTypesRegistered() {
   static const int robotStatusMetaType =
       qRegisterMetaType<utl::RobotStatus>("utl::RobotStatus");
+  static const int robotStatusPtrMetaType =
+      qRegisterMetaType<RobotStatusPtr>("RobotStatusPtr");
   (void)robotStatusMetaType;
+  (void)robotStatusPtrMetaType;
 }
 }  // namespace
 
@@ -44,11 +47,7 @@ void Updater::startUpdaterThread() {
 
   _running.store(true, std::memory_order_release);
   _worker->start(
-      [this](const utl::RobotStatus& status) {
-        QMetaObject::invokeMethod(
-            this, [this, status]() { emit newDataArrived(status); },
-            Qt::QueuedConnection);
-      },
+      [this](RobotStatusPtr status) { postStatus(std::move(status)); },
       [this]() {
         QMetaObject::invokeMethod(
             this, [this]() { emit serverNotConnected(); }, Qt::QueuedConnection);
@@ -59,6 +58,24 @@ void Updater::startUpdaterThread() {
       });
 }
 
+void Updater::postStatus(RobotStatusPtr status) {
+  _statusMailbox.writeBuffer() = std::move(status);
+  _statusMailbox.publish();
+  if (!_statusDeliveryPending.exchange(true, std::memory_order_acq_rel)) {
+    QMetaObject::invokeMethod(
+        this, [this]() { deliverLatestStatus(); }, Qt::QueuedConnection);
+  }
+}
+
+void Updater::deliverLatestStatus() {
+  // Cleared before taking: a frame published after this point posts a new
+  // delivery, so nothing is left behind in the mailbox.
+  _statusDeliveryPending.store(false, std::memory_order_release);
+  if (const auto* status = _statusMailbox.take(); status && *status) {
+    emit newDataArrived(*status);
+  }
+}
+
 void Updater::sendCommand(const GuiCommand& command) {
   if (!_running.load(std::memory_order_acquire)) {
     SPDLOG_ERROR("Updater thread is not running; command not sent.");
@@ -139,6 +156,8 @@ void Updater::stopUpdaterThread() {
   SPDLOG_INFO("Stopping updater thread");
   _running.store(false, std::memory_order_release);
   _worker->stop();
+  SPDLOG_INFO("Updater received {} status frames, {} dropped as stale",
+              queuedStatusFrames(), droppedStatusFrames());
   std::lock_guard<std::mutex> lock(_pendingMutex);
   _pendingById.clear();
 }
@@ -145,7 +145,8 @@ EArm validatePosition(const nlohmann::json& command) {
 
 [[noreturn]] void handleCommands(RimoServer<RobotStatus>& srv) {
   while (true) {
-    if (auto command = srv.receiveCommand()) {
+    if (auto request = srv.receiveCommand()) {
+      const auto* command = &request->command;
       SPDLOG_INFO("Received command: {}", command->dump());
       nlohmann::json response{
           {"status", "OK"},
@@ -171,7 +172,7 @@ EArm validatePosition(const nlohmann::json& command) {
         response["message"] = ex.what();
         SPDLOG_WARN("Failed to process command: {}", ex.what());
       }
-      srv.sendResponse(response);
+      srv.sendResponse(request->replyTo, response);
     }
   }
 }
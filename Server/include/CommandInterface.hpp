@@ -1,12 +1,19 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <future>
 #include <mutex>
 #include <optional>
-#include <queue>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+#include <BoundedMpscQueue.hpp>
 #include <CommonDefinitions.hpp>
 
 
@@ -47,71 +54,262 @@ struct SetAllMotorsEnabledCommand {
 
 struct ContecDiagnosticsCommand {};
 
-struct EmergencyStopCommand {};
+// Answered with the latest runtime metrics snapshot.
+struct MetricsCommand {};
+
+// Bypasses the command queue (see Machine::dispatchCommandAndWait).
+// `requestedAt` is the moment the request was received; the stop latency is
+// measured from it.
+struct EmergencyStopCommand {
+  std::chrono::steady_clock::time_point requestedAt{
+      std::chrono::steady_clock::now()};
+};
+
+namespace detail {
+// State shared by a Reply and its ReplyFuture. Slots come from a fixed pool,
+// so a command round trip does not allocate; only when the pool runs dry is a
+// slot taken from the heap.
+struct ReplySlot {
+  std::mutex m;
+  std::condition_variable cv;
+  std::string value;
+  bool ready{false};
+  bool pooled{false};
+  // Reply + ReplyFuture; whoever lets go last returns the slot.
+  std::atomic<int> owners{0};
+  std::atomic<std::uint32_t> next{0};
+};
+
+class ReplySlotPool {
+ public:
+  static constexpr std::uint32_t kSlots = 64;
+
+  ReplySlotPool() {
+    for (std::uint32_t i = 0; i < kSlots; ++i) {
+      _slots[i].pooled = true;
+      _slots[i].next.store(i + 1, std::memory_order_relaxed);
+    }
+  }
+
+  static ReplySlotPool& instance() {
+    static ReplySlotPool pool;
+    return pool;
+  }
+
+  ReplySlot* acquire() {
+    // Free list head: index in the low half, ABA tag in the high half.
+    auto head = _free.load(std::memory_order_acquire);
+    for (;;) {
+      const auto index = static_cast<std::uint32_t>(head);
+      if (index == kSlots) {
+        auto* slot = new ReplySlot;
+        slot->owners.store(2, std::memory_order_relaxed);
+        return slot;
+      }
+      const auto next = _slots[index].next.load(std::memory_order_relaxed);
+      const auto tag = (head >> 32) + 1;
+      if (_free.compare_exchange_weak(head, (tag << 32) | next,
+                                      std::memory_order_acquire)) {
+        auto& slot = _slots[index];
+        slot.value.clear();
+        slot.ready = false;
+        slot.owners.store(2, std::memory_order_relaxed);
+        return &slot;
+      }
+    }
+  }
+
+  void release(ReplySlot* slot) {
+    if (slot == nullptr ||
+        slot->owners.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+      return;
+    }
+    if (!slot->pooled) {
+      delete slot;
+      return;
+    }
+    const auto index = static_cast<std::uint32_t>(slot - _slots.data());
+    auto head = _free.load(std::memory_order_relaxed);
+    for (;;) {
+      slot->next.store(static_cast<std::uint32_t>(head),
+                       std::memory_order_relaxed);
+      const auto tag = (head >> 32) + 1;
+      if (_free.compare_exchange_weak(head, (tag << 32) | index,
+                                      std::memory_order_release,
+                                      std::memory_order_relaxed)) {
+        return;
+      }
+    }
+  }
+
+ private:
+  std::array<ReplySlot, kSlots> _slots;
+  std::atomic<std::uint64_t> _free{0};
+};
+}  // namespace detail
+
+// Waiting side of a Reply; mirrors the parts of std::future<std::string> the
+// machine uses.
+class ReplyFuture {
+ public:
+  ReplyFuture() = default;
+  ReplyFuture(ReplyFuture&& other) noexcept
+      : _slot(std::exchange(other._slot, nullptr)) {}
+  ReplyFuture& operator=(ReplyFuture&& other) noexcept {
+    std::swap(_slot, other._slot);
+    return *this;
+  }
+  ~ReplyFuture() { detail::ReplySlotPool::instance().release(_slot); }
+
+  [[nodiscard]] bool valid() const { return _slot != nullptr; }
+
+  template <class Rep, class Period>
+  std::future_status wait_for(
+      const std::chrono::duration<Rep, Period>& timeout) const {
+    std::unique_lock<std::mutex> lock(_slot->m);
+    return _slot->cv.wait_for(lock, timeout, [this] { return _slot->ready; })
+               ? std::future_status::ready
+               : std::future_status::timeout;
+  }
+
+  // Waits for the value and hands it out; call at most once.
+  std::string get() {
+    std::unique_lock<std::mutex> lock(_slot->m);
+    _slot->cv.wait(lock, [this] { return _slot->ready; });
+    return std::move(_slot->value);
+  }
+
+ private:
+  friend class Reply;
+  explicit ReplyFuture(detail::ReplySlot* slot) : _slot(slot) {}
+
+  detail::ReplySlot* _slot{nullptr};
+};
+
+// Answer channel of a Command, used like std::promise<std::string> but
+// without its per-command shared-state allocation. Nothing is acquired until
+// someone asks for the future; set_value() without one is a no-op.
+class Reply {
+ public:
+  Reply() = default;
+  Reply(Reply&& other) noexcept : _slot(std::exchange(other._slot, nullptr)) {}
+  Reply& operator=(Reply&& other) noexcept {
+    std::swap(_slot, other._slot);
+    return *this;
+  }
+  ~Reply() {
+    if (_slot != nullptr) {
+      set_value("Command was dropped without a reply");
+      detail::ReplySlotPool::instance().release(_slot);
+    }
+  }
+
+  ReplyFuture get_future() {
+    if (_slot != nullptr) {
+      throw std::logic_error("Reply future already retrieved");
+    }
+    _slot = detail::ReplySlotPool::instance().acquire();
+    return ReplyFuture{_slot};
+  }
+
+  // Only the first value counts.
+  void set_value(std::string value) {
+    if (_slot == nullptr) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(_slot->m);
+      if (_slot->ready) {
+        return;
+      }
+      _slot->value = std::move(value);
+      _slot->ready = true;
+    }
+    _slot->cv.notify_all();
+  }
+
+ private:
+  detail::ReplySlot* _slot{nullptr};
+};
 
 struct Command {
   std::variant<ToolChangerCommand, ReconnectCommand, MotorDiagnosticsCommand,
                ResetMotorAlarmCommand, SetMotorEnabledCommand,
                SetAllMotorsEnabledCommand, ContecDiagnosticsCommand,
-               EmergencyStopCommand>
+               EmergencyStopCommand, MetricsCommand>
       payload;
-  std::promise<std::string> reply;
+  Reply reply;
+  // Stamped by Machine::submitCommand; the queue wait is measured from here.
+  std::chrono::steady_clock::time_point submittedAt{};
 };
 
 using DispatchFn = std::function<std::string(Command, std::chrono::milliseconds)>;
 
+// Commands from the command-server threads to the control loop. Pushing and
+// popping are lock-free (utl::BoundedMpscQueue); the mutex is only taken to
+// park and wake a pop_wait_for() caller. The control loop is the single
+// consumer.
 class CommandQueue {
 public:
-  explicit CommandQueue(std::size_t maxSize = 0) : _maxSize(maxSize) {}
+  static constexpr std::size_t kDefaultCapacity = 1024;
+
+  explicit CommandQueue(std::size_t maxSize = 0)
+      : _ring(maxSize > 0 ? maxSize : kDefaultCapacity) {}
 
   bool push(Command cmd) {
-    std::lock_guard<std::mutex> lock(_m);
-    if (_shutdown) {
+    if (!_ring.push(std::move(cmd))) {
       return false;
     }
-    if (_maxSize > 0 && _q.size() >= _maxSize) {
-      return false;
+    // Pairs with the fence in pop_wait_for(): either the waiter sees the
+    // command, or we see the waiter.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_waiting.load(std::memory_order_relaxed)) {
+      std::lock_guard<std::mutex> lock(_m);
+      _cv.notify_one();
     }
-    _q.push(std::move(cmd));
-    _cv.notify_one();
     return true;
   }
 
   std::optional<Command> pop_wait_for(const std::chrono::milliseconds timeout) {
-    std::unique_lock<std::mutex> lock(_m);
-    _cv.wait_for(lock, timeout, [this] { return _shutdown || !_q.empty(); });
-    if (_q.empty()) return std::nullopt;
-    Command c = std::move(_q.front());
-    _q.pop();
-    return c;
-  }
-
-  std::optional<Command> try_pop() {
-    std::lock_guard<std::mutex> lock(_m);
-    if (_q.empty()) {
-      return std::nullopt;
+    if (auto c = _ring.try_pop()) {
+      return c;
+    }
+    {
+      std::unique_lock<std::mutex> lock(_m);
+      _waiting.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      _cv.wait_for(lock, timeout,
+                   [this] { return _ring.closed() || !_ring.empty(); });
+      _waiting.store(false, std::memory_order_relaxed);
     }
-    Command c = std::move(_q.front());
-    _q.pop();
-    return c;
+    return _ring.try_pop();
   }
 
+  std::optional<Command> try_pop() { return _ring.try_pop(); }
+
+  // Wait-free; for the control loop's per-cycle check.
+  [[nodiscard]] bool empty() const { return _ring.empty(); }
+
+  // After shutdown() this also counts pushes still being published; pop
+  // until it reaches zero to drain everything that was accepted.
+  [[nodiscard]] std::size_t size() const { return _ring.size(); }
+
+  // Resizes the ring, dropping anything queued (0 = kDefaultCapacity). Only
+  // call before producers and the consumer start.
   void setMaxSize(std::size_t maxSize) {
-    std::lock_guard<std::mutex> lock(_m);
-    _maxSize = maxSize;
+    _ring.reset(maxSize > 0 ? maxSize : kDefaultCapacity);
   }
 
   void shutdown() {
+    _ring.close();
     std::lock_guard<std::mutex> lock(_m);
-    _shutdown = true;
     _cv.notify_all();
   }
 
 private:
+  utl::BoundedMpscQueue<Command> _ring;
   std::mutex _m;
   std::condition_variable _cv;
-  std::queue<Command> _q;
-  std::size_t _maxSize{0};
-  bool _shutdown{false};
+  std::atomic<bool> _waiting{false};
 };
 }
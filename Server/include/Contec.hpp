@@ -18,10 +18,16 @@ class Contec final : public MachineComponent {
   void setOutputs(const bitVector& outputs);
   [[nodiscard]] unsigned int getNOutputs() const {return _nDO;}
   [[nodiscard]] unsigned int getNInputs() const {return _nDI;}
+  // Transaction counters and round trip times since the previous call; see
+  // ModbusTrafficStats. Control loop thread.
+  [[nodiscard]] std::vector<ModbusTrafficStats::SlaveReport> collectTraffic() {
+    return _traffic.collect();
+  }
 
 
 private:
   ModbusClient& ensureModbusClient();
+  ModbusTrafficStats _traffic;
   std::optional<ModbusClient> _modbus;   // not initialized at startup
   std::string _ipAddress;
   unsigned int _port;
@@ -1,34 +1,196 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <LatencyHistogram.hpp>
 
 #include "IClock.hpp"
 
+inline constexpr std::size_t kMaxLoopTasks = 16;
+
+// What a task does about the releases it missed while the loop was late.
+enum class LoopTaskOverrun {
+  // Runs once and drops the missed releases; it stays on its period grid.
+  Skip,
+  // Runs once per cycle until every missed release is made up.
+  CatchUp,
+  // Runs once; the next release is one period after this run.
+  Restart,
+};
+
+struct LoopTaskConfig {
+  std::string name;
+  IClock::duration period{};
+  // First release after the loop starts. Left empty, the runner picks the
+  // cycle that collides least with the other tasks slower than the loop.
+  std::optional<IClock::duration> phase;
+  // Higher runs first within a cycle; equal priorities in registration order.
+  int priority{0};
+  LoopTaskOverrun overrun{LoopTaskOverrun::Skip};
+};
+
+struct LoopTaskMetrics {
+  std::uint64_t runs{0};
+  // Releases dropped by LoopTaskOverrun::Skip.
+  std::uint64_t skippedReleases{0};
+  utl::LatencySnapshot time;
+  // How long after its release each run started.
+  utl::LatencySnapshot lateness;
+};
+
+// Loop timing accumulated by ControlLoopRunner until its owner takes it.
+struct ControlLoopMetrics {
+  std::uint64_t cycles{0};
+  std::uint64_t overruns{0};
+  // Time spent in the tasks of a cycle; relative to the loop interval this
+  // is the duty cycle.
+  utl::LatencySnapshot work;
+  // How late each cycle woke up relative to its scheduled start.
+  utl::LatencySnapshot wakeLatency;
+  // Time between the starts of consecutive cycles, and how far that is off
+  // the loop interval in either direction.
+  utl::LatencySnapshot period;
+  utl::LatencySnapshot jitter;
+  // Indexed like the runner's tasks.
+  std::vector<LoopTaskMetrics> tasks;
+  // Wake steps run between ticks, and their run time. Not part of `work`.
+  std::uint64_t wakeSteps{0};
+  utl::LatencySnapshot wakeStepTime;
+
+  // Starts a new interval, keeping the per-task slots.
+  void clear() {
+    auto kept = std::move(tasks);
+    *this = ControlLoopMetrics{};
+    for (auto& task : kept) {
+      task = LoopTaskMetrics{};
+    }
+    tasks = std::move(kept);
+  }
+};
+
+// One cycle that ran past the next tick, with the time of each task.
+struct ControlLoopOverrun {
+  IClock::time_point startedAt{};
+  IClock::duration late{};
+  IClock::duration wake{};
+  // Indexed like the runner's tasks; zero for tasks that did not run.
+  std::array<IClock::duration, kMaxLoopTasks> tasks{};
+  // The task that took longest, or empty when the late wake-up did.
+  std::optional<std::size_t> culprit;
+};
+
+// The most recent overruns in a fixed ring; older ones are overwritten.
+class ControlLoopOverrunLog {
+ public:
+  static constexpr std::size_t kCapacity = 32;
+
+  void push(const ControlLoopOverrun& overrun) {
+    _entries[_total % kCapacity] = overrun;
+    ++_total;
+  }
+
+  // Overruns ever pushed, including the overwritten ones.
+  [[nodiscard]] std::uint64_t total() const { return _total; }
+
+  // Oldest first.
+  [[nodiscard]] std::vector<ControlLoopOverrun> recent() const {
+    const auto kept = std::min<std::uint64_t>(_total, kCapacity);
+    std::vector<ControlLoopOverrun> overruns;
+    overruns.reserve(kept);
+    for (auto i = _total - kept; i < _total; ++i) {
+      overruns.push_back(_entries[i % kCapacity]);
+    }
+    return overruns;
+  }
+
+ private:
+  std::array<ControlLoopOverrun, kCapacity> _entries{};
+  std::uint64_t _total{0};
+};
+
+// Multi-rate scheduler of the control loop. It wakes once per loop interval
+// and runs, by priority, every registered task whose release is due; each
+// task has its own period, phase and overrun policy. Tasks slower than the
+// loop are staggered across cycles unless given a phase. Optionally, a
+// wakeup notification runs a wake step between ticks.
 class ControlLoopRunner {
  public:
+  using TaskId = std::size_t;
+
+  struct TaskSchedule {
+    IClock::time_point nextReleaseAt{};
+  };
+
   struct State {
     IClock::time_point nextLoopAt{};
-    IClock::time_point nextUpdateAt{};
     IClock::time_point nextDutyLogAt{};
     double dutyCycleSum{0.0};
     std::size_t dutyCycleSamples{0};
     bool initialized{false};
+    std::optional<IClock::time_point> lastLoopStart;
+    std::optional<IClock::time_point> lastWakeStepAt;
+    // Indexed like the runner's tasks.
+    std::vector<TaskSchedule> tasks;
+    ControlLoopMetrics metrics;
+    ControlLoopOverrunLog overrunLog;
   };
 
-  ControlLoopRunner(IClock& clock,
-                    std::chrono::milliseconds loopInterval,
-                    std::chrono::milliseconds updateInterval);
+  ControlLoopRunner(IClock& clock, std::chrono::milliseconds loopInterval);
+
+  // Periods shorter than the loop interval are raised to it. Throws for a
+  // non-positive period, a negative phase or more than kMaxLoopTasks tasks.
+  TaskId addTask(LoopTaskConfig config, std::function<void()> fn);
+  [[nodiscard]] std::size_t taskCount() const { return _tasks.size(); }
+  // The task's settings, with the phase the runner picked if it was empty.
+  [[nodiscard]] const LoopTaskConfig& task(const TaskId id) const {
+    return _tasks.at(id).config;
+  }
+
+  // Lets a notification of `wakeup` end the sleep before a tick and run
+  // `step` on its own, outside the task schedule; the next tick still runs
+  // every due task. A step starts at least `minSpacing` after the previous
+  // cycle or step, and one that would not start before the next tick is left
+  // to that tick. Set before the first cycle; `wakeup` must outlive the
+  // runner.
+  void setWakeStep(LoopWakeup& wakeup, IClock::duration minSpacing,
+                   std::function<void()> step);
 
   [[nodiscard]] State makeInitialState() const;
-  void runOneCycle(const std::function<void()>& controlStep,
-                   const std::function<void()>& commandStep,
-                   const std::function<void()>& updateStep,
-                   State& state) const;
+  [[nodiscard]] std::chrono::milliseconds loopInterval() const {
+    return _loopInterval;
+  }
+  void runOneCycle(State& state) const;
 
  private:
+  struct Task {
+    LoopTaskConfig config;
+    std::function<void()> fn;
+  };
+
+  struct WakeStep {
+    LoopWakeup* wakeup{nullptr};
+    IClock::duration minSpacing{};
+    std::function<void()> fn;
+  };
+
+  [[nodiscard]] IClock::duration staggeredPhase(IClock::duration period) const;
+  void addMissingTasks(State& state, IClock::time_point start) const;
+  // Sleeps until the next tick or a wake step is due; true for the latter.
+  bool sleepUntilTickOrWake(State& state) const;
+  void runWakeStep(State& state) const;
+
   IClock& _clock;
   std::chrono::milliseconds _loopInterval;
-  std::chrono::milliseconds _updateInterval;
+  std::vector<Task> _tasks;
+  // Task ids by descending priority.
+  std::vector<TaskId> _runOrder;
+  std::optional<WakeStep> _wakeStep;
 };
@@ -7,6 +7,7 @@
 #include <array>
 #include <atomic>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <thread>
@@ -20,6 +21,13 @@ class ControlPanel final : public MachineComponent {
     std::array<bool, 3> b{};
   };
 
+  // How far an axis has to move to be worth an early control step; the same
+  // thresholds `Machine.motion` gives the motion policy.
+  struct WakeThresholds {
+    double activation{0.10};
+    double delta{0.02};
+  };
+
   ControlPanel();
   ControlPanel(std::unique_ptr<IControlPanelComm> comm,
                std::size_t movingAverageDepth,
@@ -31,6 +39,10 @@ class ControlPanel final : public MachineComponent {
   void initialize() override;
   void reset() override;
   [[nodiscard]] Snapshot getSnapshot() const;
+  // Called on the reader thread after a line that moved an axis across its
+  // activation threshold or at least its delta away from the value at the
+  // previous call, or that changed a button. Set before initialize().
+  void setChangeListener(std::function<void()> listener);
   [[nodiscard]] utl::ERobotComponent componentType() const override {
     return utl::ERobotComponent::ControlPanel;
   }
@@ -39,6 +51,7 @@ class ControlPanel final : public MachineComponent {
   void readerLoop();
   void processLine(const std::string& line);
   void resetSignalProcessingState();
+  void notifyIfChanged(const Snapshot& current);
 
   std::unique_ptr<IControlPanelComm> _comm;
   std::size_t _movingAverageDepth;
@@ -46,6 +59,11 @@ class ControlPanel final : public MachineComponent {
   std::size_t _buttonDebounceSamples;
   std::array<bool, 3> _invertX{};
   std::array<bool, 3> _invertY{};
+  std::array<WakeThresholds, 3> _wakeX{};
+  std::array<WakeThresholds, 3> _wakeY{};
+  std::function<void()> _changeListener;
+  // Reader thread only: the values at the last change notification.
+  Snapshot _notified{};
   std::atomic<bool> _readerRunning{false};
   std::thread _readerThread;
   std::array<std::atomic<double>, 3> _x{};
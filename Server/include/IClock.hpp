@@ -2,6 +2,8 @@
 
 #include <chrono>
 
+#include "LoopWakeup.hpp"
+
 class IClock {
  public:
   using duration = std::chrono::steady_clock::duration;
@@ -10,4 +12,15 @@ class IClock {
   virtual ~IClock() = default;
   [[nodiscard]] virtual time_point now() const = 0;
   virtual void sleepUntil(time_point target) const = 0;
+
+  // Like sleepUntil(), but a notification of `wakeup` ends the sleep early;
+  // returns whether one did. This default cannot be interrupted: it only
+  // returns early for a notification that is already pending.
+  virtual bool waitUntil(const time_point target, LoopWakeup& wakeup) const {
+    if (wakeup.consume()) {
+      return true;
+    }
+    sleepUntil(target);
+    return false;
+  }
 };
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
+// Ends a sleep of the control loop before its tick. Any thread may notify();
+// only the loop thread waits. A notification that arrives while nobody waits
+// stays pending until the next wait or consume().
+class LoopWakeup {
+ public:
+  void notify() {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _pending = true;
+    }
+    _cv.notify_one();
+  }
+
+  // Takes a pending notification; returns whether there was one.
+  bool consume() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return std::exchange(_pending, false);
+  }
+
+  // Waits until `deadline` or a notification, whichever comes first, and
+  // takes the notification. Returns whether one ended the wait.
+  bool waitUntil(const std::chrono::steady_clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _cv.wait_until(lock, deadline, [this] { return _pending; });
+    return std::exchange(_pending, false);
+  }
+
+ private:
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  bool _pending{false};
+};
@@ -3,20 +3,28 @@
 #include <ControlPanel.hpp>
 #include <ControlLoopRunner.hpp>
 #include <IClock.hpp>
+#include <LatencyHistogram.hpp>
+#include <LoopWakeup.hpp>
 #include <MachineComponent.hpp>
 #include <MachineCommandServer.hpp>
 #include <MachineController.hpp>
 #include <MachineStatusBuilder.hpp>
 #include <MotorControl.hpp>
+#include <MotorDiagnosticsJob.hpp>
+#include <RealTimeMode.hpp>
+#include <StatusPublisher.hpp>
 #include <SteadyClockAdapter.hpp>
+#include <array>
 #include <chrono>
 #include <cstddef>
+#include <deque>
 #include <map>
 #include <atomic>
 #include <future>
 #include <memory>
 #include <mutex>
 #include <string_view>
+#include <vector>
 #include <CommonDefinitions.hpp>
 #include <CommandInterface.hpp>
 #include <RimoServer.hpp>
@@ -39,6 +47,8 @@ class Machine {
   bool submitCommand(cmd::Command command);
   std::string dispatchCommandAndWait(cmd::Command command,
                                      std::chrono::milliseconds timeout);
+  // Depth and wait percentiles of the command intake. Control loop thread.
+  [[nodiscard]] utl::CommandQueueStatus commandQueueStatus();
   static void validateMappedIndex(std::string_view signal,
                                   unsigned int index,
                                   std::size_t ioSize,
@@ -54,8 +64,6 @@ class Machine {
   virtual void updateStatus();
   virtual void handleToolChangerCommand(const cmd::ToolChangerCommand& c);
   virtual void handleReconnectCommand(const cmd::ReconnectCommand& c);
-  virtual nlohmann::json handleMotorDiagnosticsCommand(
-      const cmd::MotorDiagnosticsCommand& c);
   virtual void handleResetMotorAlarmCommand(const cmd::ResetMotorAlarmCommand& c);
   virtual void handleSetMotorEnabledCommand(const cmd::SetMotorEnabledCommand& c);
   virtual void handleSetAllMotorsEnabledCommand(
@@ -64,12 +72,59 @@ class Machine {
       const cmd::ContecDiagnosticsCommand& c);
   virtual void handleEmergencyStopCommand(const cmd::EmergencyStopCommand& c);
  private:
+  // Expensive command held back for a later cycle.
+  struct PendingCommand {
+    cmd::Command command;
+  };
+
+  // Motor diagnostics dump being read one register block per cycle.
+  struct DiagnosticsInProgress {
+    MotorDiagnosticsJob job;
+    int deferrals{0};
+  };
+
+  // Latest diagnostics dump of a motor or of the Contec. Requests are
+  // answered from it, so several viewers cost the bus as much as one.
+  struct DiagnosticsSnapshot {
+    std::optional<nlohmann::json> response;
+    IClock::time_point takenAt{};
+    IClock::time_point lastRequestedAt{};
+    bool refreshing{false};
+    // Requests that came in while no recent enough snapshot existed.
+    std::vector<cmd::Command> waiting;
+  };
+
   struct IoSignalCache {
     std::uint64_t cycle{0};
     bool valid{false};
     std::optional<signal_map_t> value;
   };
 
+  std::optional<PendingCommand> nextCommand();
+  // Answers from the motor's snapshot, or parks the command until the next
+  // dump of that motor is read.
+  void requestMotorDiagnostics(cmd::Command& command, utl::EMotor motor);
+  std::string serveContecDiagnostics(const cmd::ContecDiagnosticsCommand& c);
+  // Starts a dump for every watched motor whose snapshot is due, then runs
+  // one read of the oldest dump when the bus has budget for it.
+  void advanceDiagnostics();
+  // Handles queued commands until the cycle's command budget is spent.
+  void runCommandStep();
+  // Motion policy and pulse outputs, without starting a new bus cycle.
+  void runControlStep();
+  // The control step run between ticks after a joystick change.
+  void joystickWakeStep();
+  void executeCommand(cmd::Command& command);
+  void recordCommandWait(const cmd::Command& command);
+  // Takes a new metrics snapshot (and publishes it when enabled) once per
+  // metrics interval, resetting the interval's histograms.
+  void refreshMetrics(LoopState& state);
+  [[nodiscard]] std::string serveMetrics() const;
+  // Locks memory and arranges for the bus workers to switch to real-time
+  // scheduling; the process thread switches itself when it starts.
+  void enterRealTimeMode();
+  // The real-time mode requested and the one actually in effect.
+  [[nodiscard]] nlohmann::json realTimeStatus() const;
   void cacheInputSignals(std::optional<signal_map_t> value);
   void cacheOutputSignals(std::optional<signal_map_t> value);
 
@@ -78,6 +133,8 @@ class Machine {
 
   void makeDummyStatus();
 
+  // Declared before the control panel, whose reader thread notifies it.
+  LoopWakeup _joystickWakeup;
   Contec _contec;
   ControlPanel _controlPanel;
   MotorControl _motorControl;
@@ -86,10 +143,42 @@ class Machine {
   std::map<std::string, unsigned int> _outputMapping;
   utl::RobotStatus _robotStatus;
   cmd::CommandQueue _commandQueue;
+  std::deque<PendingCommand> _deferredCommands;
+  std::deque<DiagnosticsInProgress> _diagnostics;
+  // Motors stay in the map while watched: requested within _diagnosticsIdle
+  // or with a request still waiting. Watched snapshots are re-read every
+  // _diagnosticsRefresh.
+  std::map<utl::EMotor, DiagnosticsSnapshot> _motorDiagnostics;
+  DiagnosticsSnapshot _contecDiagnostics;
+  std::chrono::milliseconds _diagnosticsRefresh{1000};
+  std::chrono::milliseconds _diagnosticsIdle{5000};
+  // Per-cycle command budget: cheap commands are handled back to back until
+  // either limit is hit; at most one expensive command runs per cycle.
+  std::chrono::microseconds _commandBudget{5000};
+  std::size_t _maxCommandsPerCycle{16};
+  static constexpr std::size_t kCommandWaitWindow = 256;
+  std::array<IClock::duration, kCommandWaitWindow> _commandWaits{};
+  std::size_t _commandWaitCount{0};
+  std::vector<IClock::duration> _commandWaitScratch;
+  // Queue waits of the current metrics interval.
+  utl::LatencySnapshot _commandWaitMetrics;
+  std::chrono::milliseconds _metricsInterval{1000};
+  bool _publishMetrics{false};
+  std::optional<nlohmann::json> _metrics;
+  IClock::time_point _metricsTakenAt{};
+  std::optional<IClock::time_point> _nextMetricsAt;
+  realtime::Settings _realTime;
+  // Set before the process thread starts; empty when memory got locked.
+  std::string _memoryLockFailure;
+  // Written by the process thread itself, once, before its first cycle.
+  std::optional<realtime::ThreadReport> _processThreadRealTime;
   std::atomic<bool> _isRunning{false};
   std::chrono::milliseconds _loopInterval{10};
   std::chrono::milliseconds _updateInterval{50};
+  std::size_t _commandWorkers{MachineCommandServer::kDefaultWorkerCount};
   bool _statusUpdatesEnabled{true};
+  bool _joystickWakeEnabled{true};
+  std::chrono::milliseconds _joystickWakeSpacing{2};
   std::shared_ptr<IClock> _clock;
   utl::RimoServer<utl::RobotStatus> _robotServer;
   std::thread _commandServerThread;
@@ -102,4 +191,5 @@ class Machine {
   std::unique_ptr<MachineController> _controller;
   std::unique_ptr<MachineStatusBuilder> _statusBuilder;
   std::unique_ptr<MachineCommandServer> _commandServer;
+  std::unique_ptr<StatusPublisher> _statusPublisher;
 };
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <optional>
 
@@ -10,19 +12,35 @@
 class ICommandChannel {
  public:
   virtual ~ICommandChannel() = default;
-  virtual std::optional<nlohmann::json> receiveCommand() = 0;
-  virtual void sendResponse(const nlohmann::json& response) = 0;
+  virtual std::optional<utl::ReceivedCommand> receiveCommand() = 0;
+  // Called from worker threads, in completion order rather than receipt
+  // order; implementations must be thread safe.
+  virtual void sendResponse(std::uint64_t replyTo,
+                            const nlohmann::json& response) = 0;
+  // Delivers responses queued since the last receiveCommand(); called on the
+  // receiving thread once the workers are done.
+  virtual void flushResponses() {}
 };
 
+// Receives commands on the calling thread and processes them on a pool of
+// workers, so a slow command (e.g. motor diagnostics) only holds up its own
+// client.
 class MachineCommandServer {
  public:
-  explicit MachineCommandServer(utl::RimoServer<utl::RobotStatus>& server);
-  explicit MachineCommandServer(ICommandChannel& channel);
+  static constexpr std::size_t kDefaultWorkerCount = 4;
 
+  explicit MachineCommandServer(utl::RimoServer<utl::RobotStatus>& server,
+                                std::size_t workerCount = kDefaultWorkerCount);
+  explicit MachineCommandServer(ICommandChannel& channel,
+                                std::size_t workerCount = kDefaultWorkerCount);
+
+  // Returns once `running` is false and every received command has been
+  // answered.
   void runLoop(const std::atomic<bool>& running,
                const cmd::DispatchFn& dispatch) const;
 
  private:
   std::unique_ptr<ICommandChannel> _ownedChannel;
   ICommandChannel* _channel{nullptr};
+  std::size_t _workerCount;
 };
@@ -34,6 +34,9 @@ class MachineController {
     std::function<void(utl::EMotor)> stop;
     std::function<bool(utl::EMotor)> isConfigured;
     std::function<void(utl::EMotor)> onAlarmCleared;
+    // Wraps the per-cycle motor commands so driver input changes are written
+    // once per motor at the end of the cycle.
+    std::function<void(const std::function<void()>&)> batchInputs;
   };
 
   MachineController(IoOps io,
@@ -11,6 +11,9 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
 #include <chrono>
 #include <cstring>
 #include <cstdint>
@@ -22,8 +25,10 @@
 #include <string>
 #include <string_view>
 #include <thread>
+#include <utility>
 #include <vector>
 
+#include <LatencyHistogram.hpp>
 #include <TimingMetrics.hpp>
 
 struct ModbusError {
@@ -34,6 +39,175 @@ struct ModbusError {
 template <typename T>
 using ModbusResult = std::expected<T, ModbusError>;
 
+// Modbus RTU frame helpers working on fixed-capacity buffers, so building and
+// checking a frame never touches the heap.
+namespace modbus_rtu {
+
+// Largest RTU ADU: slave id + 253-byte PDU + CRC.
+inline constexpr std::size_t kMaxAduSize = 256;
+
+inline constexpr auto kCrcTable = [] {
+  std::array<std::uint16_t, 256> table{};
+  for (std::size_t i = 0; i < table.size(); ++i) {
+    auto crc = static_cast<std::uint16_t>(i);
+    for (int bit = 0; bit < 8; ++bit) {
+      const bool lsb = (crc & 0x0001u) != 0;
+      crc = static_cast<std::uint16_t>(crc >> 1u);
+      if (lsb) crc ^= 0xA001u;
+    }
+    table[i] = crc;
+  }
+  return table;
+}();
+
+constexpr std::uint16_t crc16(std::span<const std::uint8_t> bytes) noexcept {
+  std::uint16_t crc = 0xFFFFu;
+  for (const auto b : bytes) {
+    crc = static_cast<std::uint16_t>((crc >> 8u) ^
+                                     kCrcTable[(crc ^ b) & 0xFFu]);
+  }
+  return crc;
+}
+
+// Checks the trailing CRC (low byte first) against the bytes before it.
+constexpr bool has_valid_crc(std::span<const std::uint8_t> frame) noexcept {
+  if (frame.size() < 3) return false;
+  const auto received =
+      static_cast<std::uint16_t>(frame[frame.size() - 2]) |
+      static_cast<std::uint16_t>(frame[frame.size() - 1] << 8u);
+  return crc16(frame.first(frame.size() - 2)) == received;
+}
+
+class Adu {
+ public:
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+  [[nodiscard]] std::uint8_t operator[](std::size_t i) const noexcept {
+    return bytes_[i];
+  }
+  [[nodiscard]] std::span<const std::uint8_t> bytes() const noexcept {
+    return {bytes_.data(), size_};
+  }
+  void clear() noexcept { size_ = 0; }
+
+  // Callers validate register/bit counts first, which keeps every request
+  // within kMaxAduSize.
+  void push(std::uint8_t byte) noexcept { bytes_[size_++] = byte; }
+  void push_u16(std::uint16_t value) noexcept {
+    push(static_cast<std::uint8_t>((value >> 8u) & 0xFFu));
+    push(static_cast<std::uint8_t>(value & 0xFFu));
+  }
+  void append_crc() noexcept {
+    const auto crc = crc16(bytes());
+    push(static_cast<std::uint8_t>(crc & 0xFFu));          // low
+    push(static_cast<std::uint8_t>((crc >> 8u) & 0xFFu));  // high
+  }
+  // Grows the frame by `n` bytes and returns them for filling; empty when the
+  // frame would exceed kMaxAduSize.
+  [[nodiscard]] std::span<std::uint8_t> extend(std::size_t n) noexcept {
+    if (n > kMaxAduSize - size_) return {};
+    const auto out = std::span<std::uint8_t>(bytes_.data() + size_, n);
+    size_ += n;
+    return out;
+  }
+
+ private:
+  std::array<std::uint8_t, kMaxAduSize> bytes_{};
+  std::size_t size_{0};
+};
+
+}  // namespace modbus_rtu
+
+// Transactions per slave of one Modbus line. The thread that owns the client
+// records; one collector at a time may read from any thread. Counters are
+// totals since the stats were created, round trip times cover the time since
+// the previous collect().
+class ModbusTrafficStats {
+ public:
+  static constexpr std::size_t kSlaveCount = 248;
+
+  struct SlaveReport {
+    int slave{0};
+    std::uint64_t transactions{0};
+    std::uint64_t timeouts{0};
+    std::uint64_t crc_errors{0};
+    std::uint64_t other_errors{0};
+    utl::LatencySnapshot round_trip;
+  };
+
+  ModbusTrafficStats() = default;
+  ~ModbusTrafficStats() {
+    for (auto& slave : slaves_) {
+      delete slave.load(std::memory_order_relaxed);
+    }
+  }
+  ModbusTrafficStats(const ModbusTrafficStats&) = delete;
+  ModbusTrafficStats& operator=(const ModbusTrafficStats&) = delete;
+
+  // `errno_value` is 0 for a transaction that got a valid response.
+  void record(const int slave, const std::chrono::nanoseconds elapsed,
+              const int errno_value) {
+    if (slave < 0 || static_cast<std::size_t>(slave) >= kSlaveCount) {
+      return;
+    }
+    auto* stats = slaves_[static_cast<std::size_t>(slave)].load(
+        std::memory_order_relaxed);
+    if (stats == nullptr) {
+      stats = new SlaveStats;
+      slaves_[static_cast<std::size_t>(slave)].store(
+          stats, std::memory_order_release);
+    }
+    bump(stats->transactions);
+    if (errno_value == ETIMEDOUT || errno_value == EAGAIN ||
+        errno_value == EWOULDBLOCK) {
+      bump(stats->timeouts);
+    } else if (errno_value == EMBBADCRC) {
+      bump(stats->crc_errors);
+    } else if (errno_value != 0) {
+      bump(stats->other_errors);
+    }
+    stats->round_trip.record(static_cast<std::uint64_t>(
+        std::max<std::int64_t>(0, elapsed.count())));
+  }
+
+  // Slaves that have seen traffic, by address.
+  [[nodiscard]] std::vector<SlaveReport> collect() {
+    std::vector<SlaveReport> reports;
+    for (std::size_t slave = 0; slave < slaves_.size(); ++slave) {
+      auto* stats = slaves_[slave].load(std::memory_order_acquire);
+      if (stats == nullptr) {
+        continue;
+      }
+      auto& report = reports.emplace_back();
+      report.slave = static_cast<int>(slave);
+      report.transactions =
+          stats->transactions.load(std::memory_order_relaxed);
+      report.timeouts = stats->timeouts.load(std::memory_order_relaxed);
+      report.crc_errors = stats->crc_errors.load(std::memory_order_relaxed);
+      report.other_errors =
+          stats->other_errors.load(std::memory_order_relaxed);
+      stats->round_trip.collectInto(report.round_trip);
+    }
+    return reports;
+  }
+
+ private:
+  struct SlaveStats {
+    std::atomic<std::uint64_t> transactions{0};
+    std::atomic<std::uint64_t> timeouts{0};
+    std::atomic<std::uint64_t> crc_errors{0};
+    std::atomic<std::uint64_t> other_errors{0};
+    utl::LatencyHistogram round_trip;
+  };
+
+  // Single writer: a plain load and store is enough.
+  static void bump(std::atomic<std::uint64_t>& counter) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_relaxed);
+  }
+
+  std::array<std::atomic<SlaveStats*>, kSlaveCount> slaves_{};
+};
+
 class ModbusClient {
  public:
   // Factory for TCP
@@ -50,7 +224,7 @@ class ModbusClient {
       return std::unexpected(err);
     }
 
-    return ModbusClient(ctx);
+    return ModbusClient(ctx, slave_id);
   }
 
   // Factory for RTU (/dev/ttyM0, COM5, etc.)
@@ -69,7 +243,7 @@ class ModbusClient {
       return std::unexpected(err);
     }
 
-    return ModbusClient(ctx, TransportKind::RtuSerial);
+    return ModbusClient(ctx, slave_id, TransportKind::RtuSerial);
   }
 
   // Factory for RTU-over-raw-TCP (e.g. serial device servers like Moxa NPort)
@@ -106,6 +280,8 @@ class ModbusClient {
     has_last_transaction_completion_ = other.has_last_transaction_completion_;
     other.inter_request_delay_ = std::chrono::milliseconds{0};
     other.has_last_transaction_completion_ = false;
+    slave_id_ = other.slave_id_;
+    traffic_stats_ = std::exchange(other.traffic_stats_, nullptr);
   }
 
   ModbusClient& operator=(ModbusClient&& other) noexcept {
@@ -123,6 +299,8 @@ class ModbusClient {
       has_last_transaction_completion_ = other.has_last_transaction_completion_;
       other.inter_request_delay_ = std::chrono::milliseconds{0};
       other.has_last_transaction_completion_ = false;
+      slave_id_ = other.slave_id_;
+      traffic_stats_ = std::exchange(other.traffic_stats_, nullptr);
     }
     return *this;
   }
@@ -207,59 +385,53 @@ class ModbusClient {
     if (modbus_set_slave(ctx_, slave_id) == -1) {
       return std::unexpected(last_error());
     }
+    slave_id_ = slave_id;
     return {};
   }
 
+  // Accounts every later transaction (broadcasts excepted) to the addressed
+  // slave in `stats`. The stats must outlive the client or be detached by
+  // passing nullptr.
+  void set_traffic_stats(ModbusTrafficStats* stats) noexcept {
+    traffic_stats_ = stats;
+  }
+
   // ---- Register operations ------------------------------------------------
 
+  // Span overloads read `dest.size()` registers into caller-provided storage
+  // and return the number of registers read. They do not allocate.
+  ModbusResult<int> read_holding_registers(int addr,
+                                           std::span<std::uint16_t> dest) {
+    RIMO_TIMED_SCOPE("ModbusClient::read_holding_registers");
+    return read_registers_into(0x03, addr, dest);
+  }
+
+  ModbusResult<int> read_input_registers(int addr,
+                                         std::span<std::uint16_t> dest) {
+    RIMO_TIMED_SCOPE("ModbusClient::read_input_registers");
+    return read_registers_into(0x04, addr, dest);
+  }
+
   ModbusResult<std::vector<std::uint16_t>> read_holding_registers(int addr,
                                                                   int count) {
-    RIMO_TIMED_SCOPE("ModbusClient::read_holding_registers");
-    wait_inter_request_gap_if_needed();
-    if (backend_ == Backend::RtuOverTcp) {
-      auto res = read_registers_rtu_over_tcp(0x03, addr, count);
-      mark_transaction_completed();
-      return res;
-    }
-    std::vector<std::uint16_t> buffer(static_cast<std::size_t>(count));
-    int rc = modbus_read_registers(ctx_, addr, count, buffer.data());
-    mark_transaction_completed();
-    if (rc == -1) {
-      return std::unexpected(last_error());
-    }
-    buffer.resize(static_cast<std::size_t>(rc));
-    return buffer;
+    return read_registers_vector(0x03, addr, count);
   }
 
   ModbusResult<std::vector<std::uint16_t>> read_input_registers(int addr,
                                                                 int count) {
-    RIMO_TIMED_SCOPE("ModbusClient::read_input_registers");
-    wait_inter_request_gap_if_needed();
-    if (backend_ == Backend::RtuOverTcp) {
-      auto res = read_registers_rtu_over_tcp(0x04, addr, count);
-      mark_transaction_completed();
-      return res;
-    }
-    std::vector<std::uint16_t> buffer(static_cast<std::size_t>(count));
-    int rc = modbus_read_input_registers(ctx_, addr, count, buffer.data());
-    mark_transaction_completed();
-    if (rc == -1) {
-      return std::unexpected(last_error());
-    }
-    buffer.resize(static_cast<std::size_t>(rc));
-    return buffer;
+    return read_registers_vector(0x04, addr, count);
   }
 
   ModbusResult<void> write_single_register(int addr, std::uint16_t value) {
     RIMO_TIMED_SCOPE("ModbusClient::write_single_register");
-    wait_inter_request_gap_if_needed();
+    begin_transaction();
     if (backend_ == Backend::RtuOverTcp) {
       auto res = write_single_register_rtu_over_tcp(addr, value);
-      mark_transaction_completed();
+      mark_transaction_completed(res);
       return res;
     }
     int rc = modbus_write_register(ctx_, addr, value);
-    mark_transaction_completed();
+    mark_transaction_completed(rc == -1 ? errno : 0);
     if (rc == -1) {
       return std::unexpected(last_error());
     }
@@ -269,117 +441,121 @@ class ModbusClient {
   ModbusResult<void> write_multiple_registers(
       int addr, std::span<const std::uint16_t> values) {
     RIMO_TIMED_SCOPE("ModbusClient::write_multiple_registers");
-    wait_inter_request_gap_if_needed();
+    begin_transaction();
     if (backend_ == Backend::RtuOverTcp) {
       auto res = write_multiple_registers_rtu_over_tcp(addr, values);
-      mark_transaction_completed();
+      mark_transaction_completed(res);
       return res;
     }
     // libmodbus needs non-const pointer
     auto* data = const_cast<std::uint16_t*>(values.data());
     int rc = modbus_write_registers(ctx_, addr, static_cast<int>(values.size()),
                                     data);
-    mark_transaction_completed();
+    mark_transaction_completed(rc == -1 ? errno : 0);
     if (rc == -1) {
       return std::unexpected(last_error());
     }
     return {};
   }
 
-  ModbusResult<std::vector<bool>> read_bits(int addr, int count) {
-    RIMO_TIMED_SCOPE("ModbusClient::read_bits");
-    wait_inter_request_gap_if_needed();
+  // FC06 to slave 0: every drive on the line applies it and none answers, so
+  // this returns once the frame is on the wire. RTU transports only.
+  ModbusResult<void> broadcast_write_register(int addr, std::uint16_t value) {
+    RIMO_TIMED_SCOPE("ModbusClient::broadcast_write_register");
+    if (!is_rtu_transport()) {
+      return std::unexpected(
+          ModbusError{EINVAL, "Broadcast requires an RTU transport"});
+    }
+    begin_transaction();
     if (backend_ == Backend::RtuOverTcp) {
-      auto res = read_bits_rtu_over_tcp(0x01, addr, count);
+      modbus_rtu::Adu request;
+      request.push(0);
+      request.push(0x06);
+      request.push_u16(static_cast<std::uint16_t>(addr));
+      request.push_u16(value);
+      request.append_crc();
+      auto res = write_all_rtu_over_tcp(request.bytes());
       mark_transaction_completed();
       return res;
     }
-    std::vector<uint8_t> raw(static_cast<std::size_t>(count));
-
-    int rc = modbus_read_bits(ctx_, addr, count, raw.data());
+    const std::array<std::uint8_t, 6> raw{
+        0, 0x06, static_cast<std::uint8_t>((addr >> 8) & 0xFF),
+        static_cast<std::uint8_t>(addr & 0xFF),
+        static_cast<std::uint8_t>((value >> 8u) & 0xFFu),
+        static_cast<std::uint8_t>(value & 0xFFu)};
+    const int rc = modbus_send_raw_request(ctx_, raw.data(),
+                                           static_cast<int>(raw.size()));
     mark_transaction_completed();
     if (rc == -1) {
       return std::unexpected(last_error());
     }
+    return {};
+  }
 
-    std::vector<bool> bits;
-    bits.reserve(static_cast<std::size_t>(rc));
-
-    for (int i = 0; i < rc; i++) {
-      bits.push_back(raw[i] != 0);  // take only lowest bit
-    }
-    return bits;
+  // Bit span overloads use one byte per bit (0 or 1), like libmodbus.
+  ModbusResult<int> read_bits(int addr, std::span<std::uint8_t> dest) {
+    RIMO_TIMED_SCOPE("ModbusClient::read_bits");
+    return read_bits_into(0x01, addr, dest);
   }
 
-  ModbusResult<std::vector<bool>> read_input_bits(int addr, int count) {
+  ModbusResult<int> read_input_bits(int addr, std::span<std::uint8_t> dest) {
     RIMO_TIMED_SCOPE("ModbusClient::read_input_bits");
-    wait_inter_request_gap_if_needed();
-    if (backend_ == Backend::RtuOverTcp) {
-      auto res = read_bits_rtu_over_tcp(0x02, addr, count);
-      mark_transaction_completed();
-      return res;
-    }
-    std::vector<uint8_t> raw(static_cast<std::size_t>(count));
-
-    int rc = modbus_read_input_bits(ctx_, addr, count, raw.data());
-    mark_transaction_completed();
-    if (rc == -1) {
-      return std::unexpected(last_error());
-    }
-
-    std::vector<bool> bits;
-    bits.reserve(static_cast<std::size_t>(rc));
+    return read_bits_into(0x02, addr, dest);
+  }
 
-    for (int i = 0; i < rc; i++) {
-      bits.push_back(raw[i] != 0);  // take only lowest bit
-    }
+  ModbusResult<std::vector<bool>> read_bits(int addr, int count) {
+    return read_bits_vector(0x01, addr, count);
+  }
 
-    return bits;
+  ModbusResult<std::vector<bool>> read_input_bits(int addr, int count) {
+    return read_bits_vector(0x02, addr, count);
   }
 
   ModbusResult<void> write_bit(int addr, bool value) {
     RIMO_TIMED_SCOPE("ModbusClient::write_bit");
-    wait_inter_request_gap_if_needed();
+    begin_transaction();
     if (backend_ == Backend::RtuOverTcp) {
       auto res = write_single_coil_rtu_over_tcp(addr, value);
-      mark_transaction_completed();
+      mark_transaction_completed(res);
       return res;
     }
     int rc = modbus_write_bit(ctx_, addr, value ? 1 : 0);
-    mark_transaction_completed();
+    mark_transaction_completed(rc == -1 ? errno : 0);
     if (rc == -1) {
       return std::unexpected(last_error());
     }
     return {};
   }
 
-  ModbusResult<void> write_bits(int addr, const std::vector<bool>& values) {
+  ModbusResult<void> write_bits(int addr, std::span<const std::uint8_t> values) {
     RIMO_TIMED_SCOPE("ModbusClient::write_bits");
-    wait_inter_request_gap_if_needed();
+    begin_transaction();
     if (backend_ == Backend::RtuOverTcp) {
       auto res = write_multiple_bits_rtu_over_tcp(addr, values);
-      mark_transaction_completed();
+      mark_transaction_completed(res);
       return res;
     }
-    // Copy bools into a buffer of uint8_t (0 or 1)
-    std::vector<uint8_t> raw;
-    raw.reserve(values.size());
-
-    for (bool b : values) {
-      raw.push_back(b ? 1 : 0);
-    }
-
-    int rc =
-        modbus_write_bits(ctx_, addr, static_cast<int>(raw.size()), raw.data());
-    mark_transaction_completed();
-
+    // libmodbus needs non-const pointer
+    auto* data = const_cast<std::uint8_t*>(values.data());
+    int rc = modbus_write_bits(ctx_, addr, static_cast<int>(values.size()), data);
+    mark_transaction_completed(rc == -1 ? errno : 0);
     if (rc == -1) {
       return std::unexpected(last_error());
     }
-
     return {};
   }
 
+  ModbusResult<void> write_bits(int addr, const std::vector<bool>& values) {
+    if (values.size() > kMaxWriteBits) {
+      return std::unexpected(ModbusError{EINVAL, "Invalid number of bits"});
+    }
+    std::array<std::uint8_t, kMaxWriteBits> raw{};
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      raw[i] = values[i] ? 1 : 0;
+    }
+    return write_bits(addr, std::span<const std::uint8_t>(raw.data(), values.size()));
+  }
+
   // You can add coils/discrete input helpers similarly…
 
  private:
@@ -403,9 +579,9 @@ class ModbusClient {
     std::chrono::milliseconds timeout{100};
   };
 
-  explicit ModbusClient(modbus_t* ctx,
-                        TransportKind transport = TransportKind::Tcp)
-      : ctx_(ctx), transport_kind_(transport) {}
+  ModbusClient(modbus_t* ctx, const int slave_id,
+               TransportKind transport = TransportKind::Tcp)
+      : ctx_(ctx), transport_kind_(transport), slave_id_(slave_id) {}
   explicit ModbusClient(RtuOverTcpContext ctx)
       : backend_(Backend::RtuOverTcp),
         transport_kind_(TransportKind::RtuOverTcp),
@@ -429,6 +605,11 @@ class ModbusClient {
     }
   }
 
+  void begin_transaction() {
+    wait_inter_request_gap_if_needed();
+    transaction_started_ = std::chrono::steady_clock::now();
+  }
+
   void mark_transaction_completed() {
     if (!is_rtu_transport()) {
       return;
@@ -437,6 +618,30 @@ class ModbusClient {
     last_transaction_completion_ = std::chrono::steady_clock::now();
   }
 
+  // Also accounts the transaction to the traffic stats. Leaves errno as it
+  // found it for the caller's last_error().
+  void mark_transaction_completed(const int errno_value) {
+    const int saved_errno = errno;
+    mark_transaction_completed();
+    if (traffic_stats_ != nullptr) {
+      traffic_stats_->record(
+          current_slave(),
+          std::chrono::steady_clock::now() - transaction_started_,
+          errno_value);
+    }
+    errno = saved_errno;
+  }
+
+  template <typename T>
+  void mark_transaction_completed(const ModbusResult<T>& result) {
+    mark_transaction_completed(result ? 0 : result.error().errno_value);
+  }
+
+  [[nodiscard]] int current_slave() const {
+    return backend_ == Backend::RtuOverTcp && rtu_tcp_ ? rtu_tcp_->slave_id
+                                                       : slave_id_;
+  }
+
   void cleanup() noexcept {
     if (backend_ == Backend::RtuOverTcp) {
       close_rtu_over_tcp();
@@ -454,33 +659,93 @@ class ModbusClient {
     return ModbusError{errno, modbus_strerror(errno)};
   }
 
-  static std::uint16_t crc16_modbus(const std::vector<std::uint8_t>& bytes) {
-    std::uint16_t crc = 0xFFFFu;
-    for (const auto b : bytes) {
-      crc ^= b;
-      for (int i = 0; i < 8; ++i) {
-        const bool lsb = (crc & 0x0001u) != 0;
-        crc >>= 1u;
-        if (lsb) crc ^= 0xA001u;
-      }
+  static constexpr int kMaxReadRegisters = 125;
+  static constexpr std::size_t kMaxWriteRegisters = 123;
+  static constexpr int kMaxReadBits = 2000;
+  static constexpr std::size_t kMaxWriteBits = 1968;
+
+  ModbusResult<int> read_registers_into(const std::uint8_t function,
+                                        const int addr,
+                                        std::span<std::uint16_t> dest) {
+    begin_transaction();
+    if (backend_ == Backend::RtuOverTcp) {
+      auto res = read_registers_rtu_over_tcp(function, addr, dest);
+      mark_transaction_completed(res);
+      return res;
     }
-    return crc;
+    const auto count = static_cast<int>(dest.size());
+    int rc = function == 0x03
+                 ? modbus_read_registers(ctx_, addr, count, dest.data())
+                 : modbus_read_input_registers(ctx_, addr, count, dest.data());
+    mark_transaction_completed(rc == -1 ? errno : 0);
+    if (rc == -1) {
+      return std::unexpected(last_error());
+    }
+    return rc;
+  }
+
+  ModbusResult<std::vector<std::uint16_t>> read_registers_vector(
+      const std::uint8_t function, const int addr, const int count) {
+    if (count < 0) {
+      return std::unexpected(ModbusError{EINVAL, "Invalid register count"});
+    }
+    std::vector<std::uint16_t> buffer(static_cast<std::size_t>(count));
+    auto rc = function == 0x03 ? read_holding_registers(addr, buffer)
+                               : read_input_registers(addr, buffer);
+    if (!rc) {
+      return std::unexpected(rc.error());
+    }
+    buffer.resize(static_cast<std::size_t>(*rc));
+    return buffer;
+  }
+
+  ModbusResult<int> read_bits_into(const std::uint8_t function, const int addr,
+                                   std::span<std::uint8_t> dest) {
+    begin_transaction();
+    if (backend_ == Backend::RtuOverTcp) {
+      auto res = read_bits_rtu_over_tcp(function, addr, dest);
+      mark_transaction_completed(res);
+      return res;
+    }
+    const auto count = static_cast<int>(dest.size());
+    int rc = function == 0x01
+                 ? modbus_read_bits(ctx_, addr, count, dest.data())
+                 : modbus_read_input_bits(ctx_, addr, count, dest.data());
+    mark_transaction_completed(rc == -1 ? errno : 0);
+    if (rc == -1) {
+      return std::unexpected(last_error());
+    }
+    return rc;
   }
 
-  static void append_crc(std::vector<std::uint8_t>& frame) {
-    const auto crc = crc16_modbus(frame);
-    frame.push_back(static_cast<std::uint8_t>(crc & 0xFFu));         // low
-    frame.push_back(static_cast<std::uint8_t>((crc >> 8u) & 0xFFu)); // high
+  ModbusResult<std::vector<bool>> read_bits_vector(const std::uint8_t function,
+                                                   const int addr,
+                                                   const int count) {
+    if (count < 0 || count > kMaxReadBits) {
+      return std::unexpected(ModbusError{EINVAL, "Invalid bit count"});
+    }
+    std::array<std::uint8_t, kMaxReadBits> raw{};
+    const auto dest = std::span<std::uint8_t>(raw.data(),
+                                              static_cast<std::size_t>(count));
+    auto rc = function == 0x01 ? read_bits(addr, dest)
+                               : read_input_bits(addr, dest);
+    if (!rc) {
+      return std::unexpected(rc.error());
+    }
+    std::vector<bool> bits;
+    bits.reserve(static_cast<std::size_t>(*rc));
+    for (int i = 0; i < *rc; i++) {
+      bits.push_back(raw[static_cast<std::size_t>(i)] != 0);  // take only lowest bit
+    }
+    return bits;
   }
 
-  static bool validate_crc(const std::vector<std::uint8_t>& frame) {
-    if (frame.size() < 3) return false;
-    const std::vector<std::uint8_t> payload(frame.begin(), frame.end() - 2);
-    const auto expected = crc16_modbus(payload);
-    const auto received = static_cast<std::uint16_t>(frame[frame.size() - 2]) |
-                          (static_cast<std::uint16_t>(frame[frame.size() - 1])
-                           << 8u);
-    return expected == received;
+  void begin_request(modbus_rtu::Adu& request, const std::uint8_t function,
+                     const int addr) const {
+    request.clear();
+    request.push(static_cast<std::uint8_t>(rtu_tcp_->slave_id));
+    request.push(function);
+    request.push_u16(static_cast<std::uint16_t>(addr));
   }
 
   ModbusResult<void> connect_rtu_over_tcp() {
@@ -610,7 +875,7 @@ class ModbusClient {
   }
 
   ModbusResult<void> write_all_rtu_over_tcp(
-      const std::vector<std::uint8_t>& data) const {
+      std::span<const std::uint8_t> data) const {
     if (!rtu_tcp_ || rtu_tcp_->fd < 0) {
       return std::unexpected(ModbusError{ENOTCONN, "RTU-over-TCP is not connected"});
     }
@@ -625,29 +890,39 @@ class ModbusClient {
     return {};
   }
 
-  ModbusResult<std::vector<std::uint8_t>> read_exact_rtu_over_tcp(
-      const std::size_t n) const {
+  ModbusResult<void> read_exact_rtu_over_tcp(std::span<std::uint8_t> out) const {
     if (!rtu_tcp_ || rtu_tcp_->fd < 0) {
       return std::unexpected(ModbusError{ENOTCONN, "RTU-over-TCP is not connected"});
     }
-    std::vector<std::uint8_t> out(n);
     std::size_t got = 0;
-    while (got < n) {
-      const auto rc = ::recv(rtu_tcp_->fd, out.data() + got, n - got, 0);
+    while (got < out.size()) {
+      const auto rc = ::recv(rtu_tcp_->fd, out.data() + got, out.size() - got, 0);
       if (rc <= 0) {
         return std::unexpected(ModbusError{errno ? errno : ETIMEDOUT,
                                            std::strerror(errno)});
       }
       got += static_cast<std::size_t>(rc);
     }
-    return out;
+    return {};
+  }
+
+  // Appends `n` bytes received from the line to `frame`.
+  ModbusResult<void> receive_into_rtu_over_tcp(modbus_rtu::Adu& frame,
+                                               const std::size_t n) const {
+    const auto dest = frame.extend(n);
+    if (dest.size() != n) {
+      return std::unexpected(
+          ModbusError{EIO, "RTU-over-TCP response exceeds maximum frame size"});
+    }
+    return read_exact_rtu_over_tcp(dest);
   }
 
-  ModbusResult<std::vector<std::uint8_t>> read_variable_response_rtu_over_tcp(
-      const std::uint8_t expected_function) const {
-    auto hdrRes = read_exact_rtu_over_tcp(3);
-    if (!hdrRes) return std::unexpected(hdrRes.error());
-    auto frame = std::move(*hdrRes);
+  ModbusResult<void> read_variable_response_rtu_over_tcp(
+      const std::uint8_t expected_function, modbus_rtu::Adu& frame) const {
+    frame.clear();
+    if (auto hdr = receive_into_rtu_over_tcp(frame, 3); !hdr) {
+      return std::unexpected(hdr.error());
+    }
 
     if (frame[0] != static_cast<std::uint8_t>(rtu_tcp_->slave_id)) {
       return std::unexpected(
@@ -656,11 +931,11 @@ class ModbusClient {
 
     const auto function = frame[1];
     if (function == static_cast<std::uint8_t>(expected_function | 0x80u)) {
-      auto rest = read_exact_rtu_over_tcp(2);
-      if (!rest) return std::unexpected(rest.error());
-      frame.insert(frame.end(), rest->begin(), rest->end());
-      if (!validate_crc(frame)) {
-        return std::unexpected(ModbusError{EIO, "Invalid CRC in exception response"});
+      if (auto rest = receive_into_rtu_over_tcp(frame, 2); !rest) {
+        return std::unexpected(rest.error());
+      }
+      if (!modbus_rtu::has_valid_crc(frame.bytes())) {
+        return std::unexpected(ModbusError{EMBBADCRC, "Invalid CRC in exception response"});
       }
       return std::unexpected(
           ModbusError{EIO, std::format("Modbus exception code 0x{:02X}", frame[2])});
@@ -671,172 +946,155 @@ class ModbusClient {
     }
 
     const auto byteCount = frame[2];
-    auto rest = read_exact_rtu_over_tcp(static_cast<std::size_t>(byteCount) + 2u);
-    if (!rest) return std::unexpected(rest.error());
-    frame.insert(frame.end(), rest->begin(), rest->end());
-    if (!validate_crc(frame)) {
-      return std::unexpected(ModbusError{EIO, "Invalid CRC in RTU-over-TCP response"});
+    if (auto rest = receive_into_rtu_over_tcp(
+            frame, static_cast<std::size_t>(byteCount) + 2u);
+        !rest) {
+      return std::unexpected(rest.error());
+    }
+    if (!modbus_rtu::has_valid_crc(frame.bytes())) {
+      return std::unexpected(ModbusError{EMBBADCRC, "Invalid CRC in RTU-over-TCP response"});
     }
-    return frame;
+    return {};
   }
 
-  ModbusResult<std::vector<std::uint8_t>> exchange_fixed_response_rtu_over_tcp(
-      const std::vector<std::uint8_t>& request, const std::uint8_t function,
+  ModbusResult<void> exchange_fixed_response_rtu_over_tcp(
+      const modbus_rtu::Adu& request, const std::uint8_t function,
       const std::size_t response_size = 8u) const {
-    if (auto wr = write_all_rtu_over_tcp(request); !wr) {
+    if (auto wr = write_all_rtu_over_tcp(request.bytes()); !wr) {
       return std::unexpected(wr.error());
     }
-    auto response = read_exact_rtu_over_tcp(response_size);
-    if (!response) return std::unexpected(response.error());
-    if ((*response)[0] != static_cast<std::uint8_t>(rtu_tcp_->slave_id) ||
-        ((*response)[1] != function &&
-         (*response)[1] != static_cast<std::uint8_t>(function | 0x80u))) {
+    modbus_rtu::Adu response;
+    if (auto rd = receive_into_rtu_over_tcp(response, response_size); !rd) {
+      return std::unexpected(rd.error());
+    }
+    if (response[0] != static_cast<std::uint8_t>(rtu_tcp_->slave_id) ||
+        (response[1] != function &&
+         response[1] != static_cast<std::uint8_t>(function | 0x80u))) {
       return std::unexpected(ModbusError{EIO, "Invalid RTU-over-TCP response header"});
     }
-    if (!validate_crc(*response)) {
-      return std::unexpected(ModbusError{EIO, "Invalid CRC in RTU-over-TCP response"});
+    if (!modbus_rtu::has_valid_crc(response.bytes())) {
+      return std::unexpected(ModbusError{EMBBADCRC, "Invalid CRC in RTU-over-TCP response"});
     }
-    if ((*response)[1] == static_cast<std::uint8_t>(function | 0x80u)) {
+    if (response[1] == static_cast<std::uint8_t>(function | 0x80u)) {
       return std::unexpected(
-          ModbusError{EIO, std::format("Modbus exception code 0x{:02X}", (*response)[2])});
+          ModbusError{EIO, std::format("Modbus exception code 0x{:02X}", response[2])});
     }
-    return response;
+    return {};
   }
 
-  ModbusResult<std::vector<std::uint16_t>> read_registers_rtu_over_tcp(
-      const std::uint8_t function, const int addr, const int count) const {
-    if (count <= 0 || count > 125) {
+  ModbusResult<int> read_registers_rtu_over_tcp(
+      const std::uint8_t function, const int addr,
+      std::span<std::uint16_t> dest) const {
+    const auto count = static_cast<int>(dest.size());
+    if (count <= 0 || count > kMaxReadRegisters) {
       return std::unexpected(ModbusError{EINVAL, "Invalid register count"});
     }
-    std::vector<std::uint8_t> request{
-        static_cast<std::uint8_t>(rtu_tcp_->slave_id), function,
-        static_cast<std::uint8_t>((addr >> 8u) & 0xFFu),
-        static_cast<std::uint8_t>(addr & 0xFFu),
-        static_cast<std::uint8_t>((count >> 8u) & 0xFFu),
-        static_cast<std::uint8_t>(count & 0xFFu)};
-    append_crc(request);
-    if (auto wr = write_all_rtu_over_tcp(request); !wr) {
+    modbus_rtu::Adu request;
+    begin_request(request, function, addr);
+    request.push_u16(static_cast<std::uint16_t>(count));
+    request.append_crc();
+    if (auto wr = write_all_rtu_over_tcp(request.bytes()); !wr) {
       return std::unexpected(wr.error());
     }
-    auto frame = read_variable_response_rtu_over_tcp(function);
-    if (!frame) return std::unexpected(frame.error());
-    const auto byteCount = (*frame)[2];
+    modbus_rtu::Adu frame;
+    if (auto rd = read_variable_response_rtu_over_tcp(function, frame); !rd) {
+      return std::unexpected(rd.error());
+    }
+    const auto byteCount = frame[2];
     if (byteCount != static_cast<std::uint8_t>(count * 2)) {
       return std::unexpected(ModbusError{EIO, "Unexpected byte count in response"});
     }
-    std::vector<std::uint16_t> out;
-    out.reserve(static_cast<std::size_t>(count));
-    for (int i = 0; i < count; ++i) {
-      const auto hi = (*frame)[3 + i * 2];
-      const auto lo = (*frame)[3 + i * 2 + 1];
-      out.push_back(static_cast<std::uint16_t>((hi << 8u) | lo));
+    for (std::size_t i = 0; i < dest.size(); ++i) {
+      const auto hi = frame[3 + i * 2];
+      const auto lo = frame[3 + i * 2 + 1];
+      dest[i] = static_cast<std::uint16_t>((hi << 8u) | lo);
     }
-    return out;
+    return count;
   }
 
   ModbusResult<void> write_single_register_rtu_over_tcp(const int addr,
                                                          const std::uint16_t value) const {
-    std::vector<std::uint8_t> request{
-        static_cast<std::uint8_t>(rtu_tcp_->slave_id), 0x06,
-        static_cast<std::uint8_t>((addr >> 8u) & 0xFFu),
-        static_cast<std::uint8_t>(addr & 0xFFu),
-        static_cast<std::uint8_t>((value >> 8u) & 0xFFu),
-        static_cast<std::uint8_t>(value & 0xFFu)};
-    append_crc(request);
-    auto response = exchange_fixed_response_rtu_over_tcp(request, 0x06);
-    if (!response) return std::unexpected(response.error());
-    return {};
+    modbus_rtu::Adu request;
+    begin_request(request, 0x06, addr);
+    request.push_u16(value);
+    request.append_crc();
+    return exchange_fixed_response_rtu_over_tcp(request, 0x06);
   }
 
   ModbusResult<void> write_multiple_registers_rtu_over_tcp(
       const int addr, std::span<const std::uint16_t> values) const {
-    if (values.empty() || values.size() > 123) {
+    if (values.empty() || values.size() > kMaxWriteRegisters) {
       return std::unexpected(ModbusError{EINVAL, "Invalid number of registers"});
     }
     const auto count = static_cast<std::uint16_t>(values.size());
-    const auto byteCount = static_cast<std::uint8_t>(count * 2u);
-    std::vector<std::uint8_t> request{
-        static_cast<std::uint8_t>(rtu_tcp_->slave_id), 0x10,
-        static_cast<std::uint8_t>((addr >> 8u) & 0xFFu),
-        static_cast<std::uint8_t>(addr & 0xFFu),
-        static_cast<std::uint8_t>((count >> 8u) & 0xFFu),
-        static_cast<std::uint8_t>(count & 0xFFu), byteCount};
-    request.reserve(request.size() + values.size() * 2u + 2u);
+    modbus_rtu::Adu request;
+    begin_request(request, 0x10, addr);
+    request.push_u16(count);
+    request.push(static_cast<std::uint8_t>(count * 2u));
     for (const auto v : values) {
-      request.push_back(static_cast<std::uint8_t>((v >> 8u) & 0xFFu));
-      request.push_back(static_cast<std::uint8_t>(v & 0xFFu));
+      request.push_u16(v);
     }
-    append_crc(request);
-    auto response = exchange_fixed_response_rtu_over_tcp(request, 0x10);
-    if (!response) return std::unexpected(response.error());
-    return {};
+    request.append_crc();
+    return exchange_fixed_response_rtu_over_tcp(request, 0x10);
   }
 
-  ModbusResult<std::vector<bool>> read_bits_rtu_over_tcp(const std::uint8_t function,
-                                                          const int addr,
-                                                          const int count) const {
-    if (count <= 0 || count > 2000) {
+  ModbusResult<int> read_bits_rtu_over_tcp(const std::uint8_t function,
+                                           const int addr,
+                                           std::span<std::uint8_t> dest) const {
+    const auto count = static_cast<int>(dest.size());
+    if (count <= 0 || count > kMaxReadBits) {
       return std::unexpected(ModbusError{EINVAL, "Invalid bit count"});
     }
-    std::vector<std::uint8_t> request{
-        static_cast<std::uint8_t>(rtu_tcp_->slave_id), function,
-        static_cast<std::uint8_t>((addr >> 8u) & 0xFFu),
-        static_cast<std::uint8_t>(addr & 0xFFu),
-        static_cast<std::uint8_t>((count >> 8u) & 0xFFu),
-        static_cast<std::uint8_t>(count & 0xFFu)};
-    append_crc(request);
-    if (auto wr = write_all_rtu_over_tcp(request); !wr) {
+    modbus_rtu::Adu request;
+    begin_request(request, function, addr);
+    request.push_u16(static_cast<std::uint16_t>(count));
+    request.append_crc();
+    if (auto wr = write_all_rtu_over_tcp(request.bytes()); !wr) {
       return std::unexpected(wr.error());
     }
-    auto frame = read_variable_response_rtu_over_tcp(function);
-    if (!frame) return std::unexpected(frame.error());
-    std::vector<bool> out;
-    out.reserve(static_cast<std::size_t>(count));
-    for (int i = 0; i < count; ++i) {
-      const auto byte = (*frame)[3 + (i / 8)];
-      out.push_back(((byte >> (i % 8)) & 0x01u) != 0);
+    modbus_rtu::Adu frame;
+    if (auto rd = read_variable_response_rtu_over_tcp(function, frame); !rd) {
+      return std::unexpected(rd.error());
     }
-    return out;
+    if (frame[2] != static_cast<std::uint8_t>((count + 7) / 8)) {
+      return std::unexpected(ModbusError{EIO, "Unexpected byte count in response"});
+    }
+    for (std::size_t i = 0; i < dest.size(); ++i) {
+      const auto byte = frame[3 + (i / 8)];
+      dest[i] = static_cast<std::uint8_t>((byte >> (i % 8)) & 0x01u);
+    }
+    return count;
   }
 
   ModbusResult<void> write_single_coil_rtu_over_tcp(const int addr,
                                                      const bool value) const {
-    const std::uint16_t raw = value ? 0xFF00u : 0x0000u;
-    std::vector<std::uint8_t> request{
-        static_cast<std::uint8_t>(rtu_tcp_->slave_id), 0x05,
-        static_cast<std::uint8_t>((addr >> 8u) & 0xFFu),
-        static_cast<std::uint8_t>(addr & 0xFFu),
-        static_cast<std::uint8_t>((raw >> 8u) & 0xFFu),
-        static_cast<std::uint8_t>(raw & 0xFFu)};
-    append_crc(request);
-    auto response = exchange_fixed_response_rtu_over_tcp(request, 0x05);
-    if (!response) return std::unexpected(response.error());
-    return {};
+    modbus_rtu::Adu request;
+    begin_request(request, 0x05, addr);
+    request.push_u16(value ? 0xFF00u : 0x0000u);
+    request.append_crc();
+    return exchange_fixed_response_rtu_over_tcp(request, 0x05);
   }
 
   ModbusResult<void> write_multiple_bits_rtu_over_tcp(
-      const int addr, const std::vector<bool>& values) const {
-    if (values.empty() || values.size() > 1968) {
+      const int addr, std::span<const std::uint8_t> values) const {
+    if (values.empty() || values.size() > kMaxWriteBits) {
       return std::unexpected(ModbusError{EINVAL, "Invalid number of bits"});
     }
     const auto count = static_cast<std::uint16_t>(values.size());
     const auto byteCount = static_cast<std::uint8_t>((values.size() + 7u) / 8u);
-    std::vector<std::uint8_t> request{
-        static_cast<std::uint8_t>(rtu_tcp_->slave_id), 0x0F,
-        static_cast<std::uint8_t>((addr >> 8u) & 0xFFu),
-        static_cast<std::uint8_t>(addr & 0xFFu),
-        static_cast<std::uint8_t>((count >> 8u) & 0xFFu),
-        static_cast<std::uint8_t>(count & 0xFFu), byteCount};
-    request.resize(request.size() + byteCount, 0u);
+    modbus_rtu::Adu request;
+    begin_request(request, 0x0F, addr);
+    request.push_u16(count);
+    request.push(byteCount);
+    const auto packed = request.extend(byteCount);
+    std::fill(packed.begin(), packed.end(), std::uint8_t{0});
     for (std::size_t i = 0; i < values.size(); ++i) {
-      if (values[i]) {
-        request[7 + (i / 8u)] |= static_cast<std::uint8_t>(1u << (i % 8u));
+      if (values[i] != 0) {
+        packed[i / 8u] |= static_cast<std::uint8_t>(1u << (i % 8u));
       }
     }
-    append_crc(request);
-    auto response = exchange_fixed_response_rtu_over_tcp(request, 0x0F);
-    if (!response) return std::unexpected(response.error());
-    return {};
+    request.append_crc();
+    return exchange_fixed_response_rtu_over_tcp(request, 0x0F);
   }
 
   modbus_t* ctx_ = nullptr;
@@ -846,4 +1104,7 @@ class ModbusClient {
   std::chrono::milliseconds inter_request_delay_{0};
   std::chrono::steady_clock::time_point last_transaction_completion_{};
   bool has_last_transaction_completion_{false};
+  int slave_id_{0};
+  std::chrono::steady_clock::time_point transaction_started_{};
+  ModbusTrafficStats* traffic_stats_{nullptr};
 };
@@ -3,14 +3,19 @@
 #include <CommonDefinitions.hpp>
 #include <ModbusClient.hpp>
 #include <MotorRegisterMap.hpp>
+#include <RegisterShadow.hpp>
 
 #include <optional>
 #include <array>
 #include <chrono>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
+class RegisterBlock;
+class RegisterReadPlan;
+
 struct MotorRtuConfig {
   std::string device;
   int baud{9600};
@@ -157,6 +162,20 @@ class Motor {
   [[nodiscard]] std::uint32_t readDirectIoAndBrakeStatusRaw(
       ModbusClient& bus) const;
   [[nodiscard]] MotorMonitorSnapshot readMonitorSnapshot(ModbusClient& bus) const;
+  // Executes the FC03 reads of `plan` against this motor's slave. The decoders
+  // below index the result by MotorRegisterMap address and throw when the
+  // plan did not cover the registers they need.
+  [[nodiscard]] RegisterBlock readRegisterBlock(
+      ModbusClient& bus, const RegisterReadPlan& plan) const;
+  // Same, reusing the storage of `out`.
+  void readRegisterBlock(ModbusClient& bus, const RegisterReadPlan& plan,
+                         RegisterBlock& out) const;
+  [[nodiscard]] MotorMonitorSnapshot decodeMonitorSnapshot(
+      const RegisterBlock& block) const;
+  [[nodiscard]] std::uint8_t decodeAlarmCode(const RegisterBlock& block) const;
+  [[nodiscard]] std::uint8_t decodeWarningCode(const RegisterBlock& block) const;
+  [[nodiscard]] std::uint8_t decodeCommunicationErrorCode(
+      const RegisterBlock& block) const;
   // AR-KD2 motion command hooks via driver input command (007Dh).
   // START/HOME/STOP are exposed as pulses; direction and JOG as level signals.
   void writeDriverInputCommandRaw(ModbusClient& bus, std::uint16_t raw) const;
@@ -176,6 +195,22 @@ class Motor {
   void setJogMinus(ModbusClient& bus, bool enabled) const;
   void setEnabled(ModbusClient& bus, bool enabled) const;
   void invalidateDriverInputCommandCache() const noexcept;
+  // Between stageDriverInputs() and commitDriverInputs() changes to the driver
+  // input command only update the staged word, which is then sent as a single
+  // write. A new operation selection still goes out ahead of a rising
+  // START/HOME/STOP, direction or JOG input, and an input that is pulsed
+  // again while high is sent low first.
+  void stageDriverInputs() const noexcept;
+  void commitDriverInputs(ModbusClient& bus) const;
+  // Drops the staged word; the cache falls back to what the driver holds.
+  void discardStagedDriverInputs() const noexcept;
+  // Word a slave 0 broadcast may write to every drive on the bus to stop it:
+  // STOP alone. Nullopt when C-ON sits on NET-IN, since the broadcast would
+  // then also de-energise the motor.
+  [[nodiscard]] std::optional<std::uint16_t> broadcastStopWord() const;
+  // Drops staged inputs and writes STOP high with every motion trigger low,
+  // keeping the remaining inputs. Throws like any other driver write.
+  void applyEmergencyStop(ModbusClient& bus) const;
   [[nodiscard]] static std::uint8_t decodeOperationIdFromInputRaw(
       std::uint16_t raw);
   [[nodiscard]] std::uint8_t readSelectedOperationId(ModbusClient& bus) const;
@@ -220,6 +255,16 @@ class Motor {
       std::uint16_t reg007D, std::uint16_t reg007F) const;
   void resetAlarm(ModbusClient& bus) const;
 
+  // Operation data and parameter writes go through a shadow of the device
+  // registers: values the device already holds are not sent again. Inside
+  // `fn` such writes are only staged and leave as coalesced FC16 writes when
+  // `fn` returns; any other write flushes them first to keep the order.
+  template <typename Fn>
+  void batchWrites(ModbusClient& bus, Fn&& fn) const;
+  // Forget what the device is known to hold, e.g. after it may have
+  // restarted.
+  void invalidateRegisterShadow() const noexcept;
+
   [[nodiscard]] const MotorRegisterMap& map() const { return _map; }
 
  private:
@@ -246,20 +291,54 @@ class Motor {
       std::uint16_t raw) const;
   [[nodiscard]] std::uint16_t readDriverInputCommandRawCommandTarget(
       ModbusClient& bus) const;
+  void observeDriverInputCommandRaw(std::uint16_t raw) const;
+  void sendDriverInputCommandRaw(ModbusClient& bus, std::uint16_t raw) const;
+  void sendStagedDriverInputs(ModbusClient& bus) const;
+  [[nodiscard]] std::uint16_t inputFlagMask(MotorInputFlag flag) const;
+  // Inputs whose rising edge makes the driver act on the selected operation.
+  [[nodiscard]] std::uint16_t motionTriggerMask() const;
 
   void selectSlave(ModbusClient& bus, SlaveTarget target) const;
   void writeInt32(ModbusClient& bus, int upperAddr, std::int32_t value,
                   SlaveTarget target) const;
+  void writeShadowedInt32(ModbusClient& bus, int upperAddr, std::int32_t value,
+                          SlaveTarget target) const;
+  void flushRegisterShadow(ModbusClient& bus) const;
+  // A write hits this motor's own registers: always for the device slave, and
+  // for the command slave only when it is the same address.
+  [[nodiscard]] bool targetsOwnRegisters(SlaveTarget target) const;
 
   utl::EMotor _id;
   int _slaveAddress;
   int _commandSlaveAddress;
   MotorRegisterMap _map;
   bool _forceFunction10ForSingleRegisterWrites{false};
+  // Cache holds the word as this process wants it (staged or sent); the
+  // device copy is the last value written to or read from the driver.
   mutable std::optional<std::uint16_t> _driverInputCommandRawCache;
+  mutable std::optional<std::uint16_t> _driverInputCommandRawDevice;
+  mutable bool _stagingDriverInputs{false};
   mutable std::optional<std::uint8_t> _selectedOperationIdCache;
   mutable std::optional<std::array<std::uint16_t, 16>> _outputFunctionAssignments;
   mutable std::optional<std::array<std::uint16_t, 12>> _inputFunctionAssignments;
   mutable std::optional<std::array<std::uint16_t, 16>> _netOutputFunctionAssignments;
   mutable std::optional<std::array<std::uint16_t, 16>> _netInputFunctionAssignments;
+  mutable RegisterShadow _shadow;
+  mutable int _writeBatchDepth{0};
 };
+
+template <typename Fn>
+void Motor::batchWrites(ModbusClient& bus, Fn&& fn) const {
+  ++_writeBatchDepth;
+  try {
+    std::forward<Fn>(fn)();
+  } catch (...) {
+    if (--_writeBatchDepth == 0) {
+      _shadow.discardPending();
+    }
+    throw;
+  }
+  if (--_writeBatchDepth == 0) {
+    flushRegisterShadow(bus);
+  }
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+// Traffic classes on a motor bus, most urgent first.
+enum class BusPriority {
+  EmergencyStop,
+  Motion,
+  StatusPoll,
+  Diagnostics,
+};
+inline constexpr std::size_t kBusPriorityCount = 4;
+
+// Bus time spent on each traffic class during one control cycle.
+struct BusCycleUsage {
+  std::array<std::chrono::microseconds, kBusPriorityCount> used{};
+
+  [[nodiscard]] std::chrono::microseconds& operator[](BusPriority priority) {
+    return used[static_cast<std::size_t>(priority)];
+  }
+  [[nodiscard]] std::chrono::microseconds operator[](
+      BusPriority priority) const {
+    return used[static_cast<std::size_t>(priority)];
+  }
+  [[nodiscard]] std::chrono::microseconds total() const;
+};
+
+// Single-threaded executor owning all traffic of one motor bus, so a
+// half-duplex RTU line never sees interleaved transactions, while separate
+// workers (one per bus) run in parallel. Queued jobs run by priority class and
+// in submission order within a class; the time each job holds the line is
+// charged to its class for the current cycle.
+class MotorBusWorker {
+ public:
+  explicit MotorBusWorker(std::string name);
+  ~MotorBusWorker();
+
+  MotorBusWorker(const MotorBusWorker&) = delete;
+  MotorBusWorker& operator=(const MotorBusWorker&) = delete;
+
+  // `onThreadStart`, when set, runs first on the new worker thread (thread
+  // priority, affinity and the like); its exceptions are logged and ignored.
+  void start(std::function<void()> onThreadStart = {});
+  // Drains already queued jobs, then joins the worker thread.
+  void stop();
+  [[nodiscard]] bool isRunning() const;
+  [[nodiscard]] const std::string& name() const { return _name; }
+
+  // Closes the current accounting cycle and returns its usage.
+  BusCycleUsage beginCycle();
+  [[nodiscard]] BusCycleUsage cycleUsage() const;
+
+  template <typename Fn>
+  auto submit(Fn&& fn) -> std::future<std::invoke_result_t<Fn>> {
+    return submit(BusPriority::Motion, std::forward<Fn>(fn));
+  }
+
+  template <typename Fn>
+  auto submit(const BusPriority priority, Fn&& fn)
+      -> std::future<std::invoke_result_t<Fn>> {
+    using Result = std::invoke_result_t<Fn>;
+    auto task =
+        std::make_shared<std::packaged_task<Result()>>(std::forward<Fn>(fn));
+    auto future = task->get_future();
+    if (isWorkerThread()) {
+      // Re-entrant call from a job already running on this bus: queueing would
+      // deadlock, and the caller already owns the line.
+      (*task)();
+      return future;
+    }
+    enqueue(priority, [task]() { (*task)(); });
+    return future;
+  }
+
+  // Submits and blocks until the job completed; rethrows job exceptions.
+  template <typename Fn>
+  auto run(Fn&& fn) -> std::invoke_result_t<Fn> {
+    return submit(std::forward<Fn>(fn)).get();
+  }
+
+  template <typename Fn>
+  auto run(const BusPriority priority, Fn&& fn) -> std::invoke_result_t<Fn> {
+    return submit(priority, std::forward<Fn>(fn)).get();
+  }
+
+ private:
+  void enqueue(BusPriority priority, std::function<void()> job);
+  [[nodiscard]] bool isWorkerThread() const;
+  void loop(const std::function<void()>& onThreadStart);
+
+  std::string _name;
+  mutable std::mutex _mutex;
+  std::condition_variable _cv;
+  std::array<std::deque<std::function<void()>>, kBusPriorityCount> _jobs;
+  BusCycleUsage _cycleUsage;
+  bool _running{false};
+  std::thread _thread;
+  std::thread::id _threadId;
+};
@@ -1,13 +1,22 @@
 #pragma once
 
+#include <IClock.hpp>
 #include <MachineComponent.hpp>
 #include <Motor.hpp>
+#include <MotorBusWorker.hpp>
+#include <RegisterReadPlanner.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string_view>
 #include <string>
+#include <utility>
 #include <vector>
 
 enum class MotorControlMode {
@@ -20,9 +29,71 @@ enum class MotorControlDirection {
   Reverse,
 };
 
+// Result of one status poll of a single motor. `error` is non-empty when any
+// of the reads failed; the remaining fields then hold whatever was read first.
+struct MotorStatusPoll {
+  std::optional<MotorFlagStatus> outputStatus;
+  std::optional<MotorMonitorSnapshot> monitor;
+  std::optional<MotorCodeDiagnostic> warning;
+  std::optional<MotorCodeDiagnostic> alarm;
+  std::string error;
+  // The slave's circuit breaker is open: nothing was read and `error` says so.
+  bool skipped{false};
+};
+
+// FC03 reads issued by pollStatus for a motor, planned from the register map
+// and the timing of the bus the motor sits on. `status` runs every poll; one
+// of the diagnostic plans follows when the output status flags a warning
+// and/or an alarm.
+struct MotorStatusReadPlans {
+  RegisterReadPlan status;
+  RegisterReadPlan warning;
+  RegisterReadPlan alarm;
+  RegisterReadPlan warningAndAlarm;
+};
+
+// Bus time of the last completed control cycle, per traffic class.
+struct MotorBusCycleReport {
+  std::string bus;
+  // Zero when the bus has no budget configured.
+  std::chrono::microseconds budget{0};
+  BusCycleUsage lastCycle;
+  std::uint64_t deferredDiagnostics{0};
+};
+
+// Modbus transactions of one motor bus; see ModbusTrafficStats.
+struct MotorBusTraffic {
+  std::string bus;
+  std::vector<ModbusTrafficStats::SlaveReport> slaves;
+};
+
+// Circuit breaker state of one motor's slave. After `breakerTimeouts`
+// consecutive status poll timeouts the slave is skipped; it is probed again
+// after `backoff`, which doubles on every failed probe.
+struct MotorLinkHealth {
+  utl::EMotorLinkState state{utl::EMotorLinkState::Online};
+  unsigned consecutiveTimeouts{0};
+  std::chrono::milliseconds backoff{0};
+  std::uint64_t skippedPolls{0};
+};
+
+// Outcome of MotorControl::emergencyStop(). Latencies are measured from the
+// moment the stop was requested (command receipt).
+struct EmergencyStopReport {
+  // Until the first stop frame was on the wire: the broadcast where one was
+  // sent, otherwise the first confirmed per-drive write.
+  std::chrono::microseconds toFirstFrame{0};
+  // Until every reachable drive confirmed STOP with a unicast write.
+  std::chrono::microseconds toAllConfirmed{0};
+  std::size_t broadcastBuses{0};
+  // Motors whose STOP write failed or that could not be reached at all.
+  std::vector<utl::EMotor> unconfirmed;
+};
+
 class MotorControl final : public MachineComponent {
  public:
   MotorControl();
+  explicit MotorControl(std::shared_ptr<IClock> clock);
   void initialize() override;
   void reset() override;
   [[nodiscard]] utl::ERobotComponent componentType() const override {
@@ -33,6 +104,10 @@ class MotorControl final : public MachineComponent {
     return _motors;
   }
   [[nodiscard]] std::vector<utl::EMotor> configuredMotorIds() const;
+  [[nodiscard]] std::vector<std::string> busNames() const;
+  [[nodiscard]] std::string busNameFor(utl::EMotor motorId) const;
+  [[nodiscard]] const MotorStatusReadPlans& statusReadPlans(
+      utl::EMotor motorId) const;
 
   void setMode(utl::EMotor motorId, MotorControlMode mode);
   void setSpeed(utl::EMotor motorId, std::int32_t speed);
@@ -43,9 +118,20 @@ class MotorControl final : public MachineComponent {
   void startMovement(utl::EMotor motorId);
   void stopMovement(utl::EMotor motorId);
 
+  // START/STOP/HOME pulses assert the input bit and return; the bit is
+  // deasserted by the bus worker once the hold time has passed (on the next
+  // traffic on that bus or the next servicePulses() call).
   void pulseStart(utl::EMotor motorId);
   void pulseStop(utl::EMotor motorId);
   void pulseHome(utl::EMotor motorId);
+  // Deasserts pulses whose hold time has elapsed; cheap when none are pending.
+  void servicePulses();
+  // Runs `fn` with driver input command (007Dh) changes staged per motor and
+  // writes each changed word once when `fn` returns, so a control cycle's
+  // direction, operation select and START changes share one write. Called
+  // from the control loop thread; staged changes are dropped if `fn` throws.
+  void batchDriverInputs(const std::function<void()>& fn);
+  [[nodiscard]] std::chrono::milliseconds pulseHold() const { return _pulseHold; }
   void setForward(utl::EMotor motorId, bool enabled);
   void setReverse(utl::EMotor motorId, bool enabled);
   void setJogPlus(utl::EMotor motorId, bool enabled);
@@ -83,6 +169,11 @@ class MotorControl final : public MachineComponent {
   [[nodiscard]] MotorDirectIoStatus readDirectIoStatus(utl::EMotor motorId);
   [[nodiscard]] MotorMonitorSnapshot readMonitorSnapshot(utl::EMotor motorId);
   [[nodiscard]] MotorRemoteIoStatus readRemoteIoStatus(utl::EMotor motorId);
+  // Reads output status, monitor snapshot and (when flagged) warning/alarm
+  // diagnostics for all given motors. Motors on different buses are polled
+  // concurrently by their bus workers; the call returns once all are done.
+  [[nodiscard]] std::map<utl::EMotor, MotorStatusPoll> pollStatus(
+      const std::vector<utl::EMotor>& motorIds);
   [[nodiscard]] bool hasAnyWarningOrAlarm();
   void setWarningState(bool warningActive);
   [[nodiscard]] MotorCodeDiagnostic diagnoseCurrentAlarm(utl::EMotor motorId);
@@ -91,6 +182,38 @@ class MotorControl final : public MachineComponent {
       utl::EMotor motorId);
   [[nodiscard]] std::int32_t readGroupId(utl::EMotor motorId);
 
+  // Per-cycle bus accounting. beginBusCycle() is called once at the top of
+  // every control cycle; diagnostics should only start when
+  // admitDiagnostics() agrees, otherwise they are retried in a later cycle so
+  // the status poll of this cycle still fits into the bus budget.
+  void beginBusCycle();
+  [[nodiscard]] bool admitDiagnostics(utl::EMotor motorId);
+  [[nodiscard]] std::vector<MotorBusCycleReport> busCycleReports() const;
+  // Per-slave transaction counters and the round trip times recorded since
+  // the previous call. Control loop thread; counters restart with the bus on
+  // initialize().
+  [[nodiscard]] std::vector<MotorBusTraffic> collectBusTraffic();
+  // Runs on every bus worker thread as it starts, with the bus name; takes
+  // effect from the next initialize().
+  void setBusThreadSetup(std::function<void(const std::string& bus)> setup);
+
+  // Stops every drive from any thread. One EmergencyStop job per bus
+  // preempts queued traffic (a running status poll yields between motors),
+  // broadcasts STOP to slave 0 when all motors on the bus accept the same
+  // word, then writes STOP to each drive individually as confirmation.
+  // Motion traffic is refused from the moment this is called until
+  // initialize() brings the drives back with STOP released.
+  EmergencyStopReport emergencyStop(
+      std::chrono::steady_clock::time_point requestedAt =
+          std::chrono::steady_clock::now());
+  [[nodiscard]] bool emergencyStopActive() const {
+    return _emergencyStopActive.load(std::memory_order_acquire);
+  }
+  [[nodiscard]] std::optional<EmergencyStopReport> lastEmergencyStop() const;
+
+  [[nodiscard]] utl::EMotorLinkState linkState(utl::EMotor motorId) const;
+  [[nodiscard]] std::map<utl::EMotor, MotorLinkHealth> linkHealth() const;
+
  private:
   enum class TransportType {
     SerialRtu,
@@ -102,8 +225,52 @@ class MotorControl final : public MachineComponent {
     int port{0};
   };
 
+  struct MotorBusConfig {
+    std::string name;
+    TransportType type{TransportType::RawTcpRtu};
+    MotorRtuConfig rtu;
+    MotorRawTcpConfig tcp;
+    MotorStatusReadPlans statusReadPlans;
+    std::chrono::microseconds cycleBudget{0};
+  };
+
+  struct PendingPulse {
+    const Motor* motor{nullptr};
+    MotorInputFlag flag{MotorInputFlag::Start};
+    IClock::time_point deassertAt{};
+  };
+
+  // One independent RTU line: its client is only ever touched from the
+  // worker thread, which serializes all transactions on that line.
+  struct MotorBus {
+    explicit MotorBus(const std::string& name) : worker(name) {}
+    // Declared ahead of the client, which records into it.
+    ModbusTrafficStats traffic;
+    std::optional<ModbusClient> client;
+    MotorBusWorker worker;
+    // Owned by the worker thread; the counter lets other threads skip idle
+    // buses without a round trip.
+    std::vector<PendingPulse> pendingPulses;
+    std::atomic<std::size_t> pendingPulseCount{0};
+    // Motors with driver input writes staged by batchDriverInputs().
+    std::vector<const Motor*> stagedInputMotors;
+    // Set while an emergency stop job is queued for this bus, so a running
+    // status poll gives up the line before its next transaction.
+    std::atomic<bool> stopPending{false};
+    // Poll scratch buffers, reused every cycle by the worker.
+    RegisterBlock statusBlock;
+    RegisterBlock diagnosticBlock;
+    // Cycle accounting, guarded by _cycleUsageMutex.
+    BusCycleUsage lastCycleUsage;
+    BusCycleUsage usageSum;
+    BusCycleUsage usagePeak;
+    std::size_t usageCycles{0};
+    std::uint64_t deferredDiagnostics{0};
+  };
+
   struct MotorConfig {
     int address{1};
+    std::size_t bus{0};
     std::optional<int> commandAddress;
     std::optional<std::int32_t> groupId;
     std::optional<bool> forceFunction10ForSingleRegisterWrites;
@@ -117,9 +284,7 @@ class MotorControl final : public MachineComponent {
     std::optional<std::int32_t> motorRotationDirection;
   };
 
-  TransportType _transportType{TransportType::RawTcpRtu};
-  MotorRtuConfig _rtuConfig;
-  MotorRawTcpConfig _rawTcpConfig;
+  std::vector<MotorBusConfig> _busConfigs;
   MotorRegisterMap _registerMap;
   std::map<utl::EMotor, MotorConfig> _motorConfigs;
   std::map<utl::EMotor, Motor> _motors;
@@ -139,11 +304,75 @@ class MotorControl final : public MachineComponent {
   };
   std::map<utl::EMotor, MotorRuntimeState> _runtime;
 
-  std::optional<ModbusClient> _bus;
-  std::mutex _busMutex;
+  std::vector<std::unique_ptr<MotorBus>> _buses;
+  // Serializes initialize()/reset() with emergencyStop(), the only member
+  // called off the control loop thread, so buses are not torn down under it.
+  std::mutex _lifecycleMutex;
+  std::function<void(const std::string&)> _busThreadSetup;
+  std::atomic<bool> _emergencyStopActive{false};
+  mutable std::mutex _emergencyStopReportMutex;
+  std::optional<EmergencyStopReport> _lastEmergencyStop;
+  std::shared_ptr<IClock> _clock;
+  std::chrono::milliseconds _pulseHold{30};
+  // Set by batchDriverInputs() on the control loop thread; buses that got
+  // staged writes are committed when the batch ends.
+  bool _batchingDriverInputs{false};
+  std::vector<MotorBus*> _driverInputBatchBuses;
+  mutable std::mutex _cycleUsageMutex;
+  IClock::time_point _nextUsageLogAt{};
+
+  struct SlaveBreaker {
+    MotorLinkHealth health;
+    IClock::time_point nextProbeAt{};
+  };
+  enum class PollAdmission {
+    Poll,
+    Skip,
+    Probe,
+  };
+  unsigned _breakerTimeouts{3};
+  std::chrono::milliseconds _breakerProbeMin{500};
+  std::chrono::milliseconds _breakerProbeMax{8000};
+  // Written by pollStatus() and by probe jobs on the bus workers.
+  mutable std::mutex _breakerMutex;
+  std::map<utl::EMotor, SlaveBreaker> _breakers;
 
+  [[nodiscard]] static ModbusClient openBusClient(const MotorBusConfig& config);
+  [[nodiscard]] static MotorStatusReadPlans planStatusReads(
+      const MotorRegisterMap& map, const MotorRtuConfig& rtu);
+  [[nodiscard]] MotorBus& busFor(utl::EMotor motorId);
+  void closeBus(MotorBus& bus);
+  void closeAllBuses();
+  // Both run on the bus worker.
+  void schedulePulse(MotorBus& bus, ModbusClient& client, const Motor& motor,
+                     MotorInputFlag flag) const;
+  void serviceDuePulses(MotorBus& bus) const;
+  struct BusStopOutcome {
+    std::optional<std::chrono::steady_clock::time_point> firstFrameAt;
+    std::chrono::steady_clock::time_point confirmedAt{};
+    bool broadcast{false};
+    std::vector<utl::EMotor> unconfirmed;
+  };
+  // Runs on the bus worker as its EmergencyStop job.
+  BusStopOutcome stopBus(
+      MotorBus& bus,
+      const std::vector<std::pair<utl::EMotor, const Motor*>>& motors);
+  // Commits (or drops) the driver input words staged on every batched bus.
+  void finishDriverInputBatch(bool commit);
+  // Runs `fn(client)` on the worker of the bus the motor is assigned to and
+  // waits for the result. Without a priority the job counts as motion.
+  template <typename Fn>
+  auto withBus(utl::EMotor motorId, Fn&& fn);
+  template <typename Fn>
+  auto withBus(utl::EMotor motorId, BusPriority priority, Fn&& fn);
+  void logBusCycleUsage();
+  [[nodiscard]] PollAdmission admitStatusPoll(utl::EMotor motorId);
+  void recordPollOutcome(utl::EMotor motorId, std::string_view error);
+  void recordProbeOutcome(utl::EMotor motorId, std::string_view error);
+  // Re-reads the status of a skipped slave without waiting for the result.
+  void submitProbe(utl::EMotor motorId, std::size_t busIndex);
   void applyConfiguredParameters(const Motor& motor, const MotorConfig& config,
                                  ModbusClient& bus) const;
-  void handleCommunicationFailure(std::string_view action,
-                                  const std::exception& ex);
+  void handleCommunicationFailure(utl::EMotor motorId, std::string_view action,
+                                  std::string_view message);
 };
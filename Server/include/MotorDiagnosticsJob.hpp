@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include <CommonDefinitions.hpp>
+#include <nlohmann/json.hpp>
+
+class MotorControl;
+
+// The motor panel's diagnostics dump, split so the control loop issues one
+// diagnostics read per cycle instead of the whole sequence in one command
+// step. Each step() folds its read into the response; a failed read ends the
+// job with "diagnosticsError" set, like the one-shot dump did.
+class MotorDiagnosticsJob {
+ public:
+  explicit MotorDiagnosticsJob(utl::EMotor motor);
+
+  [[nodiscard]] utl::EMotor motor() const { return _motor; }
+  [[nodiscard]] bool done() const { return _done; }
+  [[nodiscard]] std::size_t stepsTaken() const { return _nextStep; }
+  static constexpr std::size_t kStepCount = 6;
+
+  // Runs the next read. Returns done().
+  bool step(MotorControl& motorControl);
+
+  [[nodiscard]] const nlohmann::json& response() const { return _response; }
+  [[nodiscard]] nlohmann::json takeResponse() { return std::move(_response); }
+
+ private:
+  void readStep(MotorControl& motorControl, std::size_t index);
+
+  utl::EMotor _motor;
+  std::size_t _nextStep{0};
+  bool _done{false};
+  nlohmann::json _response;
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include <yaml-cpp/yaml.h>
+
+#include "IClock.hpp"
+
+// Opt-in real-time execution for the control loop (`Machine.realTime`):
+// SCHED_FIFO and CPU affinity for the process thread and the motor bus
+// workers, locked memory, prefaulted stacks and absolute-deadline sleeps.
+// Every step degrades on its own: without the privileges for it the thread
+// keeps running as before, and the report says what it actually got.
+namespace realtime {
+
+struct ThreadSettings {
+  // SCHED_FIFO priority (1-99); 0 keeps the normal scheduler.
+  int priority{0};
+  // CPUs to pin the thread to; empty leaves the affinity alone.
+  std::vector<int> cpus;
+  // Stack touched up front so the loop never page-faults on it.
+  std::size_t prefaultStackBytes{0};
+};
+
+struct Settings {
+  bool enabled{false};
+  ThreadSettings processThread{
+      .priority = 80, .cpus = {}, .prefaultStackBytes = 512 * 1024};
+  ThreadSettings busWorkers{
+      .priority = 70, .cpus = {}, .prefaultStackBytes = 256 * 1024};
+  bool lockMemory{true};
+  // Sleeps end this much early and busy-wait the rest; 0 disables it.
+  std::chrono::microseconds spinTail{0};
+};
+
+// Parses the `realTime` node under `Machine`; a missing node is disabled.
+Settings parseSettings(const YAML::Node& node);
+Settings loadSettings();
+
+// What a thread ended up with, read back from the kernel.
+struct ThreadReport {
+  std::string policy{"SCHED_OTHER"};
+  int priority{0};
+  // Empty when the thread may run on every CPU.
+  std::vector<int> cpus;
+  std::size_t stackPrefaultedBytes{0};
+  // One entry per request that could not be honoured.
+  std::vector<std::string> failures;
+};
+
+// Applies `settings` to the calling thread, step by step.
+ThreadReport applyToCurrentThread(const ThreadSettings& settings);
+
+// mlockall() of current and future pages, and keeps the allocator from
+// handing memory back. Returns an empty string on success, else why not.
+std::string lockProcessMemory();
+
+std::string describe(const ThreadReport& report);
+nlohmann::json toJson(const ThreadReport& report);
+
+// IClock whose sleepUntil() is an absolute clock_nanosleep() on
+// CLOCK_MONOTONIC (steady_clock's clock), so a preempted sleep does not drift,
+// optionally followed by a busy-wait of up to `spinTail`. Interruptible waits
+// block on the wakeup until the spin tail instead.
+class RealTimeClock final : public IClock {
+ public:
+  explicit RealTimeClock(std::chrono::microseconds spinTail);
+
+  [[nodiscard]] time_point now() const override;
+  void sleepUntil(time_point target) const override;
+  bool waitUntil(time_point target, LoopWakeup& wakeup) const override;
+
+ private:
+  std::chrono::microseconds _spinTail;
+};
+
+// RealTimeClock when real-time mode is enabled, SteadyClockAdapter otherwise.
+std::shared_ptr<IClock> makeClock(const Settings& settings);
+
+}  // namespace realtime
@@ -0,0 +1,10 @@
+#pragma once
+
+// Contiguous block of holding registers, `count` words starting at `start`.
+struct RegisterRange {
+  int start{0};
+  int count{0};
+
+  [[nodiscard]] int end() const { return start + count; }
+  bool operator==(const RegisterRange&) const = default;
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <Motor.hpp>
+#include <RegisterRange.hpp>
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+// Wire-time estimate of one FC03 transaction on an RTU line: a fixed part
+// (request frame, response header/CRC, inter-frame silences, slave turnaround
+// and the configured inter-request delay) plus the time of every register word
+// carried in the response.
+struct RegisterReadCostModel {
+  double perTransactionUs{0.0};
+  double perWordUs{0.0};
+
+  [[nodiscard]] static RegisterReadCostModel fromRtu(const MotorRtuConfig& rtu);
+  [[nodiscard]] double transactionCostUs(int words) const {
+    return perTransactionUs + perWordUs * static_cast<double>(words);
+  }
+};
+
+// Result of planning: the registers that were asked for and the FC03 ranges
+// chosen to cover them.
+class RegisterReadPlan {
+ public:
+  RegisterReadPlan() = default;
+  RegisterReadPlan(std::vector<RegisterRange> required,
+                   std::vector<RegisterRange> ranges, double estimatedCostUs);
+
+  [[nodiscard]] const std::vector<RegisterRange>& required() const {
+    return _required;
+  }
+  [[nodiscard]] const std::vector<RegisterRange>& ranges() const {
+    return _ranges;
+  }
+  [[nodiscard]] double estimatedCostUs() const { return _estimatedCostUs; }
+  [[nodiscard]] int wordCount() const;
+  [[nodiscard]] bool empty() const { return _ranges.empty(); }
+  // e.g. "2 x FC03: 0x007F+1, 0x00C6+16 (~23.1 ms)"
+  [[nodiscard]] std::string describe() const;
+
+ private:
+  std::vector<RegisterRange> _required;
+  std::vector<RegisterRange> _ranges;
+  double _estimatedCostUs{0.0};
+};
+
+// Collects the registers a cycle needs from one slave and merges them into the
+// cheapest set of FC03 reads: two requirements share a transaction when
+// reading the gap between them costs less than a separate round trip.
+class RegisterReadPlanner {
+ public:
+  // Largest register count a single FC03 request may ask for.
+  static constexpr int kMaxReadWords = 125;
+
+  explicit RegisterReadPlanner(RegisterReadCostModel model,
+                               int maxWordsPerRead = kMaxReadWords);
+
+  RegisterReadPlanner& require(int addr, int count = 1);
+  RegisterReadPlanner& requireU32(int upperAddr) { return require(upperAddr, 2); }
+
+  [[nodiscard]] RegisterReadPlan plan() const;
+
+ private:
+  RegisterReadCostModel _model;
+  int _maxWordsPerRead;
+  std::vector<RegisterRange> _required;
+};
+
+// Register words returned by executing a plan, addressed by the device's
+// register addresses so decoders can index it with MotorRegisterMap fields.
+// clear() keeps the storage, so a block reused across cycles stops allocating
+// once it has seen its largest plan.
+class RegisterBlock {
+ public:
+  void clear() noexcept;
+  // Adds `count` words starting at `startAddr` and returns them for filling.
+  // The span is invalidated by the next append()/store().
+  [[nodiscard]] std::span<std::uint16_t> append(int startAddr, int count);
+  void store(int startAddr, std::span<const std::uint16_t> words);
+
+  [[nodiscard]] bool contains(int addr, int count = 1) const;
+  [[nodiscard]] std::uint16_t u16(int addr) const;
+  // 32-bit values are stored upper word first.
+  [[nodiscard]] std::uint32_t u32(int upperAddr) const;
+  [[nodiscard]] std::int32_t i32(int upperAddr) const;
+
+ private:
+  struct Segment {
+    int start{0};
+    int count{0};
+    std::size_t offset{0};
+  };
+  [[nodiscard]] const std::uint16_t* wordsFor(int addr, int count) const;
+
+  std::vector<Segment> _segments;
+  std::vector<std::uint16_t> _words;
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <RegisterRange.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <span>
+#include <vector>
+
+// Last known contents of a slave's writable holding registers plus the writes
+// staged against them. Staging a value the device already holds is a no-op;
+// everything else is flushed as contiguous FC16 writes.
+class RegisterShadow {
+ public:
+  // FC16 carries at most 123 registers per request.
+  static constexpr int kMaxWriteWords = 123;
+
+  using WriteFn =
+      std::function<void(int startAddr, std::span<const std::uint16_t> words)>;
+
+  // Stages `words` at `startAddr`. A group is written as a whole when any of
+  // its words differs, so 32-bit parameters never get half-updated.
+  void stage(int startAddr, std::span<const std::uint16_t> words);
+  void stageU32(int upperAddr, std::uint32_t value);
+
+  [[nodiscard]] bool hasPendingWrites() const { return !_pending.empty(); }
+  // Contiguous runs of pending registers, split at kMaxWriteWords.
+  [[nodiscard]] std::vector<RegisterRange> pendingRanges() const;
+  // Writes every pending range through `write`. Ranges that were written
+  // become the known device value. When `write` throws, the failed range and
+  // everything still pending is forgotten (the device state is then unknown)
+  // and the exception propagates.
+  void flush(const WriteFn& write);
+  // Drops pending writes without sending them; their registers become unknown.
+  void discardPending();
+
+  // Values read back from the device replace what the shadow assumed.
+  void observe(int startAddr, std::span<const std::uint16_t> words);
+  void invalidate(int startAddr, int count);
+  void invalidateAll();
+
+  [[nodiscard]] std::optional<std::uint16_t> known(int addr) const;
+
+ private:
+  std::map<int, std::uint16_t> _known;
+  std::map<int, std::uint16_t> _pending;
+};
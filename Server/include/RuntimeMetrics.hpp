@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+#include <string_view>
+#include <vector>
+
+#include <ControlLoopRunner.hpp>
+#include <LatencyHistogram.hpp>
+#include <ModbusClient.hpp>
+#include <nlohmann/json.hpp>
+
+// JSON building blocks of the server's runtime metrics, as answered by the
+// `metrics` command and published under kMetricsTopic. Latency summaries
+// cover one metrics interval; counters are totals.
+namespace metrics {
+
+// {count, meanUs, p50Us, p90Us, p99Us, p999Us, maxUs}.
+nlohmann::json latencySummary(const utl::LatencySnapshot& snapshot);
+
+// Cycle and overrun counts, work time, duty cycle (work time over the loop
+// interval), wake-up latency, cycle period and its jitter, and per task its
+// schedule, runs, skipped releases, run time and lateness.
+nlohmann::json controlLoop(const ControlLoopRunner& runner,
+                           const ControlLoopMetrics& loop);
+
+// {total, recent: [{agoMs, lateMs, wakeMs, culprit, tasksMs: {name: ms}}]},
+// oldest first; ages are relative to `now`, culprit is a task name or "wake".
+nlohmann::json overrunLog(const ControlLoopRunner& runner,
+                          const ControlLoopOverrunLog& log,
+                          IClock::time_point now);
+
+// {line, slaves: [{slave, transactions, timeouts, crcErrors, otherErrors,
+// roundTrip}]}.
+nlohmann::json modbusLine(
+    std::string_view line,
+    const std::vector<ModbusTrafficStats::SlaveReport>& slaves);
+
+}  // namespace metrics
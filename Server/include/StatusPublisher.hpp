@@ -0,0 +1,59 @@
+#pragma once
+
+#include <CommonDefinitions.hpp>
+#include <LatencyHistogram.hpp>
+#include <LatestValueSlot.hpp>
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+// Serializes and sends robot status on its own thread. The control loop only
+// copies the status into a latest-wins slot; when the publisher falls behind,
+// intermediate snapshots are skipped rather than queued. Metrics snapshots
+// take the same path through a slot of their own.
+class StatusPublisher {
+ public:
+  using SendFn = std::function<void(const utl::RobotStatus&)>;
+  using SendMetricsFn = std::function<void(const nlohmann::json&)>;
+
+  explicit StatusPublisher(SendFn send, SendMetricsFn sendMetrics = {});
+  ~StatusPublisher();
+  StatusPublisher(const StatusPublisher&) = delete;
+  StatusPublisher& operator=(const StatusPublisher&) = delete;
+
+  void start();
+  // Sends the last submitted snapshot if it is still pending, then joins.
+  void stop();
+
+  // Called from the control thread; never blocks on the send.
+  void submit(const utl::RobotStatus& status);
+  // Called from the control thread; sent after the next status snapshot.
+  // Dropped when there is no metrics send function.
+  void submitMetrics(const nlohmann::json& metrics);
+
+  // Time spent in the status send function (serialization and socket write)
+  // since the previous call. One caller at a time.
+  void collectSendTimes(utl::LatencySnapshot& out) {
+    _sendTimes.collectInto(out);
+  }
+
+  [[nodiscard]] std::uint64_t submittedCount() const {
+    return _slot.publishedCount();
+  }
+  // Snapshots replaced before the publisher got to them.
+  [[nodiscard]] std::uint64_t skippedCount() const {
+    return _slot.overwrittenCount();
+  }
+
+ private:
+  void run();
+
+  SendFn _send;
+  SendMetricsFn _sendMetrics;
+  utl::LatestValueSlot<utl::RobotStatus> _slot;
+  utl::LatestValueSlot<nlohmann::json> _metricsSlot;
+  utl::LatencyHistogram _sendTimes;
+  std::thread _thread;
+};
@@ -13,4 +13,8 @@ class SteadyClockAdapter final : public IClock {
   void sleepUntil(const time_point target) const override {
     std::this_thread::sleep_until(target);
   }
+
+  bool waitUntil(const time_point target, LoopWakeup& wakeup) const override {
+    return wakeup.waitUntil(target);
+  }
 };
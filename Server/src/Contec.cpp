@@ -54,6 +54,7 @@ ModbusClient& Contec::ensureModbusClient() {
   }
 
   _modbus.emplace(std::move(*cli_res));
+  _modbus->set_traffic_stats(&_traffic);
 
   // Connect
   if (auto res = _modbus->connect(); !res) {
@@ -1,55 +1,269 @@
 #include "ControlLoopRunner.hpp"
 
+#include <ExceptionUtils.hpp>
 #include <Logger.hpp>
 
+#include <algorithm>
+#include <format>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <utility>
+
 using namespace std::chrono_literals;
 
 ControlLoopRunner::ControlLoopRunner(IClock& clock,
-                                     const std::chrono::milliseconds loopInterval,
-                                     const std::chrono::milliseconds updateInterval)
-    : _clock(clock), _loopInterval(loopInterval), _updateInterval(updateInterval) {}
+                                     const std::chrono::milliseconds loopInterval)
+    : _clock(clock),
+      _loopInterval(std::max(std::chrono::milliseconds{1}, loopInterval)) {}
+
+namespace {
+std::uint64_t toNs(const IClock::duration d) {
+  return static_cast<std::uint64_t>(std::max<std::int64_t>(
+      0, std::chrono::duration_cast<std::chrono::nanoseconds>(d).count()));
+}
+
+double toMs(const IClock::duration d) {
+  return std::chrono::duration<double, std::milli>(d).count();
+}
+
+std::optional<std::size_t> longestTask(const ControlLoopOverrun& overrun,
+                                       const std::size_t taskCount) {
+  std::optional<std::size_t> culprit;
+  auto longest = overrun.wake;
+  for (std::size_t id = 0; id < taskCount; ++id) {
+    if (overrun.tasks[id] > longest) {
+      culprit = id;
+      longest = overrun.tasks[id];
+    }
+  }
+  return culprit;
+}
+
+// Stagger search horizon, in loop intervals.
+constexpr std::int64_t kStaggerHorizon = 4096;
+}  // namespace
+
+ControlLoopRunner::TaskId ControlLoopRunner::addTask(
+    LoopTaskConfig config, std::function<void()> fn) {
+  if (_tasks.size() >= kMaxLoopTasks) {
+    utl::throwRuntimeError(std::format(
+        "Cannot add loop task '{}': all {} task slots are taken", config.name,
+        kMaxLoopTasks));
+  }
+  if (config.period <= IClock::duration::zero()) {
+    utl::throwRuntimeError(std::format(
+        "Loop task '{}' needs a positive period", config.name));
+  }
+  if (config.phase && *config.phase < IClock::duration::zero()) {
+    utl::throwRuntimeError(std::format(
+        "Loop task '{}' has a negative phase", config.name));
+  }
+  if (config.period < _loopInterval) {
+    SPDLOG_WARN("Loop task '{}' period {:.3f} ms is shorter than the loop "
+                "interval; it runs every cycle",
+                config.name, toMs(config.period));
+    config.period = _loopInterval;
+  }
+  if (!config.phase) {
+    config.phase = staggeredPhase(config.period);
+  }
+  const auto id = _tasks.size();
+  _tasks.push_back({std::move(config), std::move(fn)});
+  _runOrder.push_back(id);
+  std::ranges::stable_sort(_runOrder, std::ranges::greater{},
+                           [this](const TaskId task) {
+                             return _tasks[task].config.priority;
+                           });
+  return id;
+}
+
+IClock::duration ControlLoopRunner::staggeredPhase(
+    const IClock::duration period) const {
+  const IClock::duration tick = _loopInterval;
+  if (period <= tick) {
+    return IClock::duration::zero();
+  }
+  const auto cyclesOf = [tick](const IClock::duration at) {
+    return static_cast<std::int64_t>((at + tick - IClock::duration{1}) / tick);
+  };
+  // Releases of the tasks slower than the loop, counted per cycle over one
+  // common multiple of their periods (wrapping around), or a capped window.
+  std::int64_t window = std::min(kStaggerHorizon, cyclesOf(period));
+  for (const auto& task : _tasks) {
+    if (task.config.period > tick) {
+      window = std::min(kStaggerHorizon,
+                        std::lcm(window, cyclesOf(task.config.period)));
+    }
+  }
+  const auto horizon = window * tick;
+  const auto slot = [&](const IClock::duration at) {
+    return static_cast<std::size_t>(cyclesOf(at) % window);
+  };
+  std::vector<int> load(static_cast<std::size_t>(window), 0);
+  for (const auto& task : _tasks) {
+    if (task.config.period <= tick) {
+      continue;
+    }
+    const auto phase = *task.config.phase;
+    for (auto at = phase; at < phase + horizon; at += task.config.period) {
+      ++load[slot(at)];
+    }
+  }
+  // The earliest cycle within one period whose releases meet the fewest.
+  auto best = IClock::duration::zero();
+  auto bestLoad = std::numeric_limits<int>::max();
+  for (auto phase = IClock::duration::zero(); phase < period; phase += tick) {
+    int collisions = 0;
+    for (auto at = phase; at < phase + horizon; at += period) {
+      collisions += load[slot(at)];
+    }
+    if (collisions < bestLoad) {
+      best = phase;
+      bestLoad = collisions;
+    }
+  }
+  return best;
+}
+
+void ControlLoopRunner::setWakeStep(LoopWakeup& wakeup,
+                                    const IClock::duration minSpacing,
+                                    std::function<void()> step) {
+  _wakeStep = WakeStep{.wakeup = &wakeup,
+                       .minSpacing = std::max(IClock::duration::zero(),
+                                              minSpacing),
+                       .fn = std::move(step)};
+}
 
 ControlLoopRunner::State ControlLoopRunner::makeInitialState() const {
   State state;
   const auto now = _clock.now();
   state.nextLoopAt = now;
-  state.nextUpdateAt = now;
   state.nextDutyLogAt = now + 1s;
   state.initialized = true;
+  addMissingTasks(state, now);
   return state;
 }
 
-void ControlLoopRunner::runOneCycle(const std::function<void()>& controlStep,
-                                    const std::function<void()>& commandStep,
-                                    const std::function<void()>& updateStep,
-                                    State& state) const {
+void ControlLoopRunner::addMissingTasks(State& state,
+                                        const IClock::time_point start) const {
+  for (auto id = state.tasks.size(); id < _tasks.size(); ++id) {
+    state.tasks.push_back({.nextReleaseAt = start + *_tasks[id].config.phase});
+  }
+  if (state.metrics.tasks.size() < _tasks.size()) {
+    state.metrics.tasks.resize(_tasks.size());
+  }
+}
+
+bool ControlLoopRunner::sleepUntilTickOrWake(State& state) const {
+  if (!_clock.waitUntil(state.nextLoopAt, *_wakeStep->wakeup)) {
+    return false;
+  }
+  auto previous = state.lastLoopStart;
+  if (state.lastWakeStepAt &&
+      (!previous || *state.lastWakeStepAt > *previous)) {
+    previous = state.lastWakeStepAt;
+  }
+  if (previous) {
+    const auto earliest = *previous + _wakeStep->minSpacing;
+    if (earliest >= state.nextLoopAt) {
+      _clock.sleepUntil(state.nextLoopAt);
+      return false;
+    }
+    if (_clock.now() < earliest) {
+      _clock.sleepUntil(earliest);
+    }
+  }
+  return _clock.now() < state.nextLoopAt;
+}
+
+void ControlLoopRunner::runWakeStep(State& state) const {
+  const auto start = _clock.now();
+  _wakeStep->fn();
+  ++state.metrics.wakeSteps;
+  state.metrics.wakeStepTime.record(toNs(_clock.now() - start));
+  state.lastWakeStepAt = start;
+}
+
+void ControlLoopRunner::runOneCycle(State& state) const {
   if (!state.initialized) {
     state = makeInitialState();
   }
+  addMissingTasks(state, _clock.now());
 
   const auto nowBefore = _clock.now();
   if (nowBefore < state.nextLoopAt) {
-    _clock.sleepUntil(state.nextLoopAt);
+    if (!_wakeStep) {
+      _clock.sleepUntil(state.nextLoopAt);
+    } else if (sleepUntilTickOrWake(state)) {
+      runWakeStep(state);
+      return;
+    }
+  }
+  if (_wakeStep) {
+    // This tick's tasks serve whatever was notified up to now.
+    _wakeStep->wakeup->consume();
   }
   const auto loopStart = _clock.now();
+  const auto wake =
+      std::max(IClock::duration::zero(), loopStart - state.nextLoopAt);
+  auto& metrics = state.metrics;
+  metrics.wakeLatency.record(toNs(wake));
+  if (state.lastLoopStart) {
+    const auto period = loopStart - *state.lastLoopStart;
+    metrics.period.record(toNs(period));
+    const auto offBy = period - _loopInterval;
+    metrics.jitter.record(
+        toNs(offBy < IClock::duration::zero() ? -offBy : offBy));
+  }
+  state.lastLoopStart = loopStart;
 
-  controlStep();
-  commandStep();
+  std::array<IClock::duration, kMaxLoopTasks> spent{};
+  auto taskEnd = loopStart;
+  for (const auto id : _runOrder) {
+    auto& schedule = state.tasks[id];
+    const auto start = taskEnd;
+    if (start < schedule.nextReleaseAt) {
+      continue;
+    }
+    const auto& task = _tasks[id];
+    task.fn();
+    taskEnd = _clock.now();
+    spent[id] = taskEnd - start;
 
-  const auto now = _clock.now();
-  if (now >= state.nextUpdateAt) {
-    updateStep();
-    do {
-      state.nextUpdateAt += _updateInterval;
-    } while (state.nextUpdateAt <= now);
+    auto& taskMetrics = metrics.tasks[id];
+    ++taskMetrics.runs;
+    taskMetrics.time.record(toNs(spent[id]));
+    taskMetrics.lateness.record(toNs(start - schedule.nextReleaseAt));
+    const auto period = task.config.period;
+    switch (task.config.overrun) {
+      case LoopTaskOverrun::Skip: {
+        const auto missed = (start - schedule.nextReleaseAt) / period;
+        schedule.nextReleaseAt += (missed + 1) * period;
+        taskMetrics.skippedReleases += static_cast<std::uint64_t>(missed);
+        break;
+      }
+      case LoopTaskOverrun::CatchUp:
+        schedule.nextReleaseAt += period;
+        break;
+      case LoopTaskOverrun::Restart:
+        schedule.nextReleaseAt = start + period;
+        break;
+    }
   }
+  const auto workEnd = taskEnd;
 
-  const auto loopWork = now - loopStart;
+  // Every task counts towards the duty cycle: whatever it costs is time the
+  // control thread is not available for the next tick.
+  const auto loopWork = workEnd - loopStart;
+  ++metrics.cycles;
+  metrics.work.record(toNs(loopWork));
   const auto dutyCycle = std::chrono::duration<double>(loopWork).count() /
                          std::chrono::duration<double>(_loopInterval).count();
   state.dutyCycleSum += dutyCycle;
   ++state.dutyCycleSamples;
-  if (now >= state.nextDutyLogAt && state.dutyCycleSamples > 0) {
+  if (workEnd >= state.nextDutyLogAt && state.dutyCycleSamples > 0) {
     const auto avgDutyCycle =
         state.dutyCycleSum / static_cast<double>(state.dutyCycleSamples);
     SPDLOG_DEBUG("Machine loop duty cycle avg {:.3f}% (last {:.3f}%)",
@@ -58,16 +272,35 @@ void ControlLoopRunner::runOneCycle(const std::function<void()>& controlStep,
     state.dutyCycleSamples = 0;
     do {
       state.nextDutyLogAt += 1s;
-    } while (state.nextDutyLogAt <= now);
+    } while (state.nextDutyLogAt <= workEnd);
   }
 
+  // Judged once the last task is done, so an overrun is charged to the cycle
+  // that caused it rather than showing up as the next one's late wake-up.
   state.nextLoopAt += _loopInterval;
-  if (state.nextLoopAt <= now) {
-    const auto overrun = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now - state.nextLoopAt + _loopInterval);
-    SPDLOG_WARN("Machine loop overrun by {} ms", overrun.count());
+  if (state.nextLoopAt <= workEnd) {
+    ControlLoopOverrun overrun{.startedAt = loopStart,
+                               .late = workEnd - state.nextLoopAt,
+                               .wake = wake,
+                               .tasks = spent};
+    overrun.culprit = longestTask(overrun, _tasks.size());
+    state.overrunLog.push(overrun);
+    std::string breakdown = std::format("wake {:.3f}", toMs(wake));
+    for (std::size_t id = 0; id < _tasks.size(); ++id) {
+      if (spent[id] > IClock::duration::zero()) {
+        breakdown += std::format(", {} {:.3f}", _tasks[id].config.name,
+                                 toMs(spent[id]));
+      }
+    }
+    SPDLOG_WARN(
+        "Machine loop overrun: ended {:.3f} ms past the next tick ({} ms; {} "
+        "longest)",
+        toMs(overrun.late), breakdown,
+        overrun.culprit ? std::string_view{_tasks[*overrun.culprit].config.name}
+                        : std::string_view{"wake"});
+    ++metrics.overruns;
     do {
       state.nextLoopAt += _loopInterval;
-    } while (state.nextLoopAt <= now);
+    } while (state.nextLoopAt <= workEnd);
   }
 }
@@ -6,6 +6,7 @@
 #include <TimingMetrics.hpp>
 
 #include <array>
+#include <cmath>
 #include <sstream>
 #include <stdexcept>
 #include <utility>
@@ -20,6 +21,34 @@ void loadAxisInvertFlag(const YAML::Node& axesCfg, const char* axisKey, bool& ta
     target = invertAxis.as<bool>();
   }
 }
+
+void loadWakeThresholds(const YAML::Node& cfg,
+                        ControlPanel::WakeThresholds& target) {
+  if (const auto activation = cfg["neutralAxisActivationThreshold"];
+      activation) {
+    target.activation = activation.as<double>();
+  }
+  if (const auto delta = cfg["speedUpdateAxisDeltaThreshold"]; delta) {
+    target.delta = delta.as<double>();
+  }
+}
+
+void loadAxisWakeThresholds(const YAML::Node& axesCfg, const char* axisKey,
+                            ControlPanel::WakeThresholds& target) {
+  const auto axisNode = axesCfg[axisKey];
+  if (axisNode && axisNode.IsMap()) {
+    loadWakeThresholds(axisNode, target);
+  }
+}
+
+// Same comparisons as the motion policy, so the loop wakes exactly when the
+// policy would act on the change.
+bool axisChanged(const double value, const double notified,
+                 const ControlPanel::WakeThresholds& thresholds) {
+  const bool active = std::abs(value) >= thresholds.activation;
+  const bool wasActive = std::abs(notified) >= thresholds.activation;
+  return active != wasActive || std::abs(value - notified) >= thresholds.delta;
+}
 }  // namespace
 
 ControlPanel::ControlPanel(std::unique_ptr<IControlPanelComm> comm,
@@ -92,6 +121,12 @@ ControlPanel::ControlPanel() {
   try {
     const auto machineCfg = cfg.getClassConfig("Machine");
     const auto motionCfg = machineCfg["motion"];
+    if (motionCfg && motionCfg.IsMap()) {
+      WakeThresholds common;
+      loadWakeThresholds(motionCfg, common);
+      _wakeX.fill(common);
+      _wakeY.fill(common);
+    }
     const auto axesCfg = motionCfg ? motionCfg["axes"] : YAML::Node{};
     if (axesCfg && axesCfg.IsMap()) {
       loadAxisInvertFlag(axesCfg, "leftArmX", _invertX[0]);
@@ -100,9 +135,15 @@ ControlPanel::ControlPanel() {
       loadAxisInvertFlag(axesCfg, "rightArmY", _invertY[1]);
       loadAxisInvertFlag(axesCfg, "gantryZ", _invertY[2]);
       loadAxisInvertFlag(axesCfg, "gantryY", _invertY[2]);
+      loadAxisWakeThresholds(axesCfg, "leftArmX", _wakeX[0]);
+      loadAxisWakeThresholds(axesCfg, "leftArmY", _wakeY[0]);
+      loadAxisWakeThresholds(axesCfg, "rightArmX", _wakeX[1]);
+      loadAxisWakeThresholds(axesCfg, "rightArmY", _wakeY[1]);
+      loadAxisWakeThresholds(axesCfg, "gantryZ", _wakeY[2]);
     }
   } catch (const std::exception&) {
-    // Keep default non-inverted joystick axes when motion config is unavailable.
+    // Keep default non-inverted joystick axes and wake thresholds when motion
+    // config is unavailable.
   }
 
   if (!_comm) {
@@ -218,6 +259,7 @@ void ControlPanel::processLine(const std::string& line) {
     return;
   }
 
+  Snapshot current;
   for (std::size_t i = 0; i < 3; ++i) {
     const bool wasReady = _processors[i].isBaselineReady();
     const auto out = _processors[i].process(xRaw[i], yRaw[i], bRaw[i]);
@@ -225,10 +267,34 @@ void ControlPanel::processLine(const std::string& line) {
       SPDLOG_INFO("ControlPanel joystick[{}] baseline ready. x={:.3f} y={:.3f}",
                   i, out.x, out.y);
     }
-    _x[i].store(_invertX[i] ? -out.x : out.x, std::memory_order_release);
-    _y[i].store(_invertY[i] ? -out.y : out.y, std::memory_order_release);
-    _b[i].store(out.button, std::memory_order_release);
+    current.x[i] = _invertX[i] ? -out.x : out.x;
+    current.y[i] = _invertY[i] ? -out.y : out.y;
+    current.b[i] = out.button;
+    _x[i].store(current.x[i], std::memory_order_release);
+    _y[i].store(current.y[i], std::memory_order_release);
+    _b[i].store(current.b[i], std::memory_order_release);
+  }
+  notifyIfChanged(current);
+}
+
+void ControlPanel::notifyIfChanged(const Snapshot& current) {
+  if (!_changeListener) {
+    return;
   }
+  bool changed = false;
+  for (std::size_t i = 0; i < 3 && !changed; ++i) {
+    changed = current.b[i] != _notified.b[i] ||
+              axisChanged(current.x[i], _notified.x[i], _wakeX[i]) ||
+              axisChanged(current.y[i], _notified.y[i], _wakeY[i]);
+  }
+  if (changed) {
+    _notified = current;
+    _changeListener();
+  }
+}
+
+void ControlPanel::setChangeListener(std::function<void()> listener) {
+  _changeListener = std::move(listener);
 }
 
 ControlPanel::Snapshot ControlPanel::getSnapshot() const {
@@ -248,4 +314,5 @@ void ControlPanel::resetSignalProcessingState() {
     _b[i].store(false, std::memory_order_release);
     _processors[i].reconfigure(_movingAverageDepth, _baselineSamples, _buttonDebounceSamples);
   }
+  _notified = Snapshot{};
 }
@@ -2,13 +2,17 @@
 #include <ExceptionUtils.hpp>
 #include <JsonExtensions.hpp>
 #include <Machine.hpp>
+#include <RuntimeMetrics.hpp>
 #include <TimingMetrics.hpp>
 
 #include <magic_enum/magic_enum.hpp>
 
-#include <chrono>
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <future>
+#include <iterator>
+#include <thread>
 
 using namespace std::chrono_literals;
 
@@ -24,6 +28,22 @@ unsigned int requireMappingIndex(
   return it->second;
 }
 
+// Reply from a cached diagnostics dump or metrics snapshot, plus its age.
+std::string withSnapshotAge(nlohmann::json response,
+                            const IClock::duration age) {
+  response["snapshotAgeMs"] =
+      std::chrono::duration_cast<std::chrono::milliseconds>(age).count();
+  return response.dump();
+}
+
+// Commands that read a whole register dump or reconnect a component; only
+// one of them runs per cycle. Motor diagnostics are not among them: they
+// only start a MotorDiagnosticsJob.
+bool isExpensiveCommand(const decltype(cmd::Command::payload)& payload) {
+  return std::holds_alternative<cmd::ContecDiagnosticsCommand>(payload) ||
+         std::holds_alternative<cmd::ReconnectCommand>(payload);
+}
+
 template <typename ESignal>
 void validateSignalMappingKeys(const std::map<std::string, unsigned int>& mapping,
                                 std::string_view mappingName) {
@@ -41,90 +61,6 @@ void validateSignalMappingKeys(const std::map<std::string, unsigned int>& mappin
   }
 }
 
-nlohmann::json makeDefaultIoAssignmentResponse(const utl::EMotor motor) {
-  nlohmann::json response{
-      {"motor", utl::enumToString(motor)},
-      {"driverInputRaw", 0u},
-      {"driverOutputRaw", 0u},
-      {"ioOutputRaw", 0u},
-      {"ioInputRaw", 0u},
-      {"netInputRaw", 0u},
-      {"netOutputRaw", 0u},
-      {"inputFlags", nlohmann::json::array()},
-      {"outputFlags", nlohmann::json::array()},
-      {"ioOutputAssignments", nlohmann::json::array()},
-      {"ioInputAssignments", nlohmann::json::array()},
-      {"netOutputAssignments", nlohmann::json::array()},
-      {"netInputAssignments", nlohmann::json::array()},
-      {"alarm", nlohmann::json::object()},
-      {"warning", nlohmann::json::object()},
-  };
-
-  response["ioOutputAssignments"].push_back(
-      {{"channel", "OUT0"}, {"function", "HOME-P"}, {"functionCode", 70}, {"active", false}});
-  response["ioOutputAssignments"].push_back(
-      {{"channel", "OUT1"}, {"function", "END"}, {"functionCode", 69}, {"active", false}});
-  response["ioOutputAssignments"].push_back(
-      {{"channel", "OUT2"}, {"function", "AREA1"}, {"functionCode", 73}, {"active", false}});
-  response["ioOutputAssignments"].push_back(
-      {{"channel", "OUT3"}, {"function", "READY"}, {"functionCode", 67}, {"active", false}});
-  response["ioOutputAssignments"].push_back(
-      {{"channel", "OUT4"}, {"function", "WNG"}, {"functionCode", 66}, {"active", false}});
-  response["ioOutputAssignments"].push_back(
-      {{"channel", "OUT5"}, {"function", "ALM"}, {"functionCode", 65}, {"active", false}});
-  response["ioOutputAssignments"].push_back(
-      {{"channel", "MB"}, {"function", "MB"}, {"functionCode", 0}, {"active", false}});
-
-  response["ioInputAssignments"].push_back(
-      {{"channel", "IN0"}, {"function", "HOME"}, {"functionCode", 3}, {"active", false}});
-  response["ioInputAssignments"].push_back(
-      {{"channel", "IN1"}, {"function", "START"}, {"functionCode", 4}, {"active", false}});
-  response["ioInputAssignments"].push_back(
-      {{"channel", "IN2"}, {"function", "M0"}, {"functionCode", 48}, {"active", false}});
-  response["ioInputAssignments"].push_back(
-      {{"channel", "IN3"}, {"function", "M1"}, {"functionCode", 49}, {"active", false}});
-  response["ioInputAssignments"].push_back(
-      {{"channel", "IN4"}, {"function", "M2"}, {"functionCode", 50}, {"active", false}});
-  response["ioInputAssignments"].push_back(
-      {{"channel", "IN5"}, {"function", "FREE"}, {"functionCode", 16}, {"active", false}});
-  response["ioInputAssignments"].push_back(
-      {{"channel", "IN6"}, {"function", "STOP"}, {"functionCode", 18}, {"active", false}});
-  response["ioInputAssignments"].push_back(
-      {{"channel", "IN7"}, {"function", "ALM-RST"}, {"functionCode", 24}, {"active", false}});
-  response["ioInputAssignments"].push_back(
-      {{"channel", "+LS"}, {"function", "+LS"}, {"functionCode", 0}, {"active", false}});
-  response["ioInputAssignments"].push_back(
-      {{"channel", "-LS"}, {"function", "-LS"}, {"functionCode", 0}, {"active", false}});
-  response["ioInputAssignments"].push_back(
-      {{"channel", "HOMES"}, {"function", "HOMES"}, {"functionCode", 0}, {"active", false}});
-  response["ioInputAssignments"].push_back(
-      {{"channel", "SLIT"}, {"function", "SLIT"}, {"functionCode", 0}, {"active", false}});
-
-  const std::array<std::pair<const char*, unsigned int>, 16> defaultNetIn{
-      {{"M0", 48},       {"M1", 49},      {"M2", 50},      {"START", 4},
-       {"HOME", 3},      {"STOP", 18},    {"FREE", 16},    {"not used", 0},
-       {"MS0", 8},       {"MS1", 9},      {"MS2", 10},     {"SSTART", 5},
-       {"+JOG", 6},      {"-JOG", 7},     {"FWD", 1},      {"RVS", 2}}};
-  const std::array<std::pair<const char*, unsigned int>, 16> defaultNetOut{
-      {{"M0_R", 48},     {"M1_R", 49},    {"M2_R", 50},    {"START_R", 4},
-       {"HOME-P", 70},   {"READY", 67},   {"WNG", 66},     {"ALM", 65},
-       {"S-BSY", 80},    {"AREA1", 73},   {"AREA2", 74},   {"AREA3", 75},
-       {"TIM", 72},      {"MOVE", 68},    {"END", 69},     {"TLC", 71}}};
-  for (int i = 0; i < 16; ++i) {
-    response["netInputAssignments"].push_back(
-        {{"channel", std::format("NET-IN{}", i)},
-         {"function", defaultNetIn[static_cast<std::size_t>(i)].first},
-         {"functionCode", defaultNetIn[static_cast<std::size_t>(i)].second},
-         {"active", false}});
-    response["netOutputAssignments"].push_back(
-        {{"channel", std::format("NET-OUT{}", i)},
-         {"function", defaultNetOut[static_cast<std::size_t>(i)].first},
-         {"functionCode", defaultNetOut[static_cast<std::size_t>(i)].second},
-         {"active", false}});
-  }
-  return response;
-}
-
 std::vector<std::string> buildContecChannelNames(
     const std::map<std::string, unsigned int>& mapping, const std::size_t count) {
   std::vector<std::string> names(count);
@@ -138,9 +74,10 @@ std::vector<std::string> buildContecChannelNames(
 
 }  // namespace
 
-Machine::Machine() : Machine(std::make_shared<SteadyClockAdapter>()) {}
+Machine::Machine() : Machine(realtime::makeClock(realtime::loadSettings())) {}
 
-Machine::Machine(std::shared_ptr<IClock> clock) : _clock(std::move(clock)) {
+Machine::Machine(std::shared_ptr<IClock> clock)
+    : _motorControl(clock), _clock(std::move(clock)) {
   if (!_clock) {
     utl::throwRuntimeError("Machine requires a non-null clock instance.");
   }
@@ -159,12 +96,33 @@ Machine::Machine(std::shared_ptr<IClock> clock) : _clock(std::move(clock)) {
       cfg.getOptional<int>("Machine", "statusPublishPeriodMS", 50));
   _statusUpdatesEnabled =
       cfg.getOptional<bool>("Machine", "statusUpdatesEnabled", true);
+  _joystickWakeEnabled =
+      cfg.getOptional<bool>("Machine", "joystickWakeEnabled", true);
+  _joystickWakeSpacing = std::chrono::milliseconds{std::max(
+      0, cfg.getOptional<int>("Machine", "joystickWakeSpacingMS", 2))};
 
   _loopInterval = std::chrono::milliseconds{std::max(1, loopIntervalMS)};
   _updateInterval = std::chrono::milliseconds{std::max(1, updateIntervalMS)};
   const auto commandQueueMaxSize =
       cfg.getOptional<std::size_t>("Machine", "commandQueueMaxSize", 16u);
   _commandQueue.setMaxSize(commandQueueMaxSize);
+  _commandWorkers = cfg.getOptional<std::size_t>(
+      "Machine", "commandWorkers", MachineCommandServer::kDefaultWorkerCount);
+  const auto commandBudgetMS =
+      cfg.getOptional<double>("Machine", "commandBudgetMS", 5.0);
+  _commandBudget = std::chrono::microseconds{
+      static_cast<std::int64_t>(std::max(0.0, commandBudgetMS) * 1000.0)};
+  _maxCommandsPerCycle = std::max<std::size_t>(
+      1, cfg.getOptional<std::size_t>("Machine", "maxCommandsPerCycle", 16u));
+  _commandWaitScratch.reserve(kCommandWaitWindow);
+  _diagnosticsRefresh = std::chrono::milliseconds{std::max(
+      1, cfg.getOptional<int>("Machine", "diagnosticsRefreshMS", 1000))};
+  _diagnosticsIdle = std::chrono::milliseconds{std::max(
+      1, cfg.getOptional<int>("Machine", "diagnosticsIdleMS", 5000))};
+  _metricsInterval = std::chrono::milliseconds{std::max(
+      1, cfg.getOptional<int>("Machine", "metricsIntervalMS", 1000))};
+  _publishMetrics = cfg.getOptional<bool>("Machine", "publishMetrics", false);
+  _realTime = realtime::loadSettings();
 
   _components.emplace(_contec.componentType(), &_contec);
   _components.emplace(_controlPanel.componentType(), &_controlPanel);
@@ -268,6 +226,17 @@ void Machine::validateMappedIndex(const std::string_view signal,
 }
 void Machine::processThread() {
   SPDLOG_INFO("Processing thread started");
+  if (_realTime.enabled) {
+    _processThreadRealTime =
+        realtime::applyToCurrentThread(_realTime.processThread);
+    if (_processThreadRealTime->failures.empty()) {
+      SPDLOG_INFO("Processing thread real-time mode: {}",
+                  realtime::describe(*_processThreadRealTime));
+    } else {
+      SPDLOG_WARN("Processing thread real-time mode only partly applied: {}",
+                  realtime::describe(*_processThreadRealTime));
+    }
+  }
   ControlLoopRunner::State loopState;
   while (_isRunning.load(std::memory_order_acquire)) {
     runOneCycle(loopState);
@@ -284,58 +253,8 @@ void Machine::runOneCycle(LoopState& state) {
     ++_ioCacheCycle;
     _inputSignalsCache.valid = false;
     _outputSignalsCache.valid = false;
-    _loopRunner->runOneCycle(
-        [this]() { controlLoopTasks(); },
-        [this]() {
-          if (auto command = _commandQueue.try_pop()) {
-            try {
-              std::string responsePayload;
-              std::visit(Overloaded{[this](const cmd::ToolChangerCommand& c) {
-                                      handleToolChangerCommand(c);
-                                    },
-                                    [this](const cmd::ReconnectCommand& c) {
-                                      handleReconnectCommand(c);
-                                    },
-                                    [this, &responsePayload](
-                                        const cmd::MotorDiagnosticsCommand& c) {
-                                      responsePayload =
-                                          handleMotorDiagnosticsCommand(c).dump();
-                                    },
-                                    [this](const cmd::ResetMotorAlarmCommand& c) {
-                                      handleResetMotorAlarmCommand(c);
-                                    },
-                                    [this](const cmd::SetMotorEnabledCommand& c) {
-                                      handleSetMotorEnabledCommand(c);
-                                    },
-                                    [this](
-                                        const cmd::SetAllMotorsEnabledCommand& c) {
-                                      handleSetAllMotorsEnabledCommand(c);
-                                    },
-                                    [this, &responsePayload](
-                                        const cmd::ContecDiagnosticsCommand& c) {
-                                      responsePayload =
-                                          handleContecDiagnosticsCommand(c).dump();
-                                    },
-                                    [this](const cmd::EmergencyStopCommand& c) {
-                                      handleEmergencyStopCommand(c);
-                                    }},
-                         command->payload);
-              command->reply.set_value(std::move(responsePayload));
-            } catch (const std::exception& e) {
-              SPDLOG_WARN("Exception caught in 'std::visit'! {}", e.what());
-              command->reply.set_value(e.what());
-            } catch (...) {
-              SPDLOG_WARN("Unknown exception caught in 'std::visit'!");
-              command->reply.set_value("Unknown exception while processing command");
-            }
-          }
-        },
-        [this]() {
-          if (_statusUpdatesEnabled) {
-            updateStatus();
-          }
-        },
-        state);
+    _loopRunner->runOneCycle(state);
+    refreshMetrics(state);
   } catch (const std::exception& e) {
     SPDLOG_ERROR(
         "Unhandled exception in machine loop cycle: {}. "
@@ -372,6 +291,301 @@ void Machine::cacheInputSignals(std::optional<signal_map_t> value) {
   _inputSignalsCache.value = std::move(value);
 }
 
+void Machine::runCommandStep() {
+  if (_commandQueue.empty() && _deferredCommands.empty() &&
+      _motorDiagnostics.empty()) {
+    return;
+  }
+  const auto start = _clock->now();
+  std::size_t handled = 0;
+  bool expensiveHandled = false;
+  // Commands held back this cycle rejoin the deferred list afterwards, so
+  // nextCommand() cannot hand them out again before the next cycle.
+  std::deque<PendingCommand> heldBack;
+  while (handled < _maxCommandsPerCycle &&
+         (handled == 0 || _clock->now() - start < _commandBudget)) {
+    auto pending = nextCommand();
+    if (!pending) {
+      break;
+    }
+    const bool expensive = isExpensiveCommand(pending->command.payload);
+    if (expensive && expensiveHandled) {
+      heldBack.push_back(std::move(*pending));
+      continue;
+    }
+    expensiveHandled = expensiveHandled || expensive;
+    recordCommandWait(pending->command);
+    executeCommand(pending->command);
+    ++handled;
+  }
+  std::move(heldBack.begin(), heldBack.end(),
+            std::back_inserter(_deferredCommands));
+  advanceDiagnostics();
+}
+
+void Machine::requestMotorDiagnostics(cmd::Command& command,
+                                      const utl::EMotor motor) {
+  const auto now = _clock->now();
+  auto& snapshot = _motorDiagnostics[motor];
+  snapshot.lastRequestedAt = now;
+  if (snapshot.response && now - snapshot.takenAt < _diagnosticsIdle) {
+    command.reply.set_value(
+        withSnapshotAge(*snapshot.response, now - snapshot.takenAt));
+    return;
+  }
+  snapshot.waiting.push_back(std::move(command));
+}
+
+std::string Machine::serveContecDiagnostics(
+    const cmd::ContecDiagnosticsCommand& c) {
+  const auto now = _clock->now();
+  auto& snapshot = _contecDiagnostics;
+  if (!snapshot.response || now - snapshot.takenAt >= _diagnosticsRefresh) {
+    snapshot.response = handleContecDiagnosticsCommand(c);
+    snapshot.takenAt = now;
+  }
+  return withSnapshotAge(*snapshot.response, now - snapshot.takenAt);
+}
+
+void Machine::advanceDiagnostics() {
+  // Roughly half a second at the default loop interval; past that the read
+  // runs anyway rather than letting the client time out.
+  constexpr int kMaxDiagnosticsDeferrals = 50;
+  const auto now = _clock->now();
+  for (auto it = _motorDiagnostics.begin(); it != _motorDiagnostics.end();) {
+    auto& [motor, snapshot] = *it;
+    const bool watched = !snapshot.waiting.empty() ||
+                         now - snapshot.lastRequestedAt < _diagnosticsIdle;
+    if (!watched && !snapshot.refreshing) {
+      it = _motorDiagnostics.erase(it);
+      continue;
+    }
+    const bool due = !snapshot.response ||
+                     now - snapshot.takenAt >= _diagnosticsRefresh;
+    if (watched && due && !snapshot.refreshing) {
+      _diagnostics.push_back({.job = MotorDiagnosticsJob{motor}});
+      snapshot.refreshing = true;
+    }
+    ++it;
+  }
+  if (_diagnostics.empty()) {
+    return;
+  }
+  auto& current = _diagnostics.front();
+  if (current.deferrals < kMaxDiagnosticsDeferrals &&
+      !_motorControl.admitDiagnostics(current.job.motor())) {
+    ++current.deferrals;
+    return;
+  }
+  current.deferrals = 0;
+  if (!current.job.step(_motorControl)) {
+    return;
+  }
+  auto& snapshot = _motorDiagnostics[current.job.motor()];
+  snapshot.response = current.job.takeResponse();
+  snapshot.takenAt = _clock->now();
+  snapshot.refreshing = false;
+  for (auto& command : snapshot.waiting) {
+    command.reply.set_value(
+        withSnapshotAge(*snapshot.response, IClock::duration::zero()));
+  }
+  snapshot.waiting.clear();
+  _diagnostics.pop_front();
+}
+
+void Machine::executeCommand(cmd::Command& command) {
+  try {
+    std::string responsePayload;
+    std::optional<utl::EMotor> diagnosticsMotor;
+    std::visit(Overloaded{[this](const cmd::ToolChangerCommand& c) {
+                            handleToolChangerCommand(c);
+                          },
+                          [this](const cmd::ReconnectCommand& c) {
+                            handleReconnectCommand(c);
+                          },
+                          [&diagnosticsMotor](
+                              const cmd::MotorDiagnosticsCommand& c) {
+                            diagnosticsMotor = c.motor;
+                          },
+                          [this](const cmd::ResetMotorAlarmCommand& c) {
+                            handleResetMotorAlarmCommand(c);
+                          },
+                          [this](const cmd::SetMotorEnabledCommand& c) {
+                            handleSetMotorEnabledCommand(c);
+                          },
+                          [this](const cmd::SetAllMotorsEnabledCommand& c) {
+                            handleSetAllMotorsEnabledCommand(c);
+                          },
+                          [this, &responsePayload](
+                              const cmd::ContecDiagnosticsCommand& c) {
+                            responsePayload = serveContecDiagnostics(c);
+                          },
+                          [this](const cmd::EmergencyStopCommand& c) {
+                            handleEmergencyStopCommand(c);
+                          },
+                          [this, &responsePayload](const cmd::MetricsCommand&) {
+                            responsePayload = serveMetrics();
+                          }},
+               command.payload);
+    if (diagnosticsMotor) {
+      requestMotorDiagnostics(command, *diagnosticsMotor);
+      return;
+    }
+    command.reply.set_value(std::move(responsePayload));
+  } catch (const std::exception& e) {
+    SPDLOG_WARN("Exception caught in 'std::visit'! {}", e.what());
+    command.reply.set_value(e.what());
+  } catch (...) {
+    SPDLOG_WARN("Unknown exception caught in 'std::visit'!");
+    command.reply.set_value("Unknown exception while processing command");
+  }
+}
+
+void Machine::recordCommandWait(const cmd::Command& command) {
+  if (command.submittedAt == IClock::time_point{}) {
+    return;
+  }
+  const auto wait =
+      std::max(IClock::duration::zero(), _clock->now() - command.submittedAt);
+  _commandWaits[_commandWaitCount % kCommandWaitWindow] = wait;
+  ++_commandWaitCount;
+  _commandWaitMetrics.record(static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count()));
+}
+
+void Machine::refreshMetrics(LoopState& state) {
+  const auto now = _clock->now();
+  if (!_nextMetricsAt) {
+    _nextMetricsAt = now + _metricsInterval;
+    return;
+  }
+  if (now < *_nextMetricsAt) {
+    return;
+  }
+  do {
+    *_nextMetricsAt += _metricsInterval;
+  } while (*_nextMetricsAt <= now);
+
+  nlohmann::json snapshot{{"intervalMs", _metricsInterval.count()}};
+  snapshot["loop"] = metrics::controlLoop(*_loopRunner, state.metrics);
+  snapshot["loop"]["overrunLog"] =
+      metrics::overrunLog(*_loopRunner, state.overrunLog, now);
+  state.metrics.clear();
+
+  nlohmann::json queue = commandQueueStatus();
+  queue["wait"] = metrics::latencySummary(_commandWaitMetrics);
+  _commandWaitMetrics.clear();
+  snapshot["commandQueue"] = std::move(queue);
+
+  utl::LatencySnapshot sendTimes;
+  _statusPublisher->collectSendTimes(sendTimes);
+  snapshot["statusPublisher"] = {
+      {"submitted", _statusPublisher->submittedCount()},
+      {"skipped", _statusPublisher->skippedCount()},
+      {"send", metrics::latencySummary(sendTimes)},
+  };
+
+  auto lines = nlohmann::json::array();
+  lines.push_back(metrics::modbusLine("contec", _contec.collectTraffic()));
+  for (const auto& bus : _motorControl.collectBusTraffic()) {
+    lines.push_back(metrics::modbusLine(bus.bus, bus.slaves));
+  }
+  snapshot["modbus"] = std::move(lines);
+  snapshot["realTime"] = realTimeStatus();
+
+  _metrics = std::move(snapshot);
+  _metricsTakenAt = now;
+  if (_publishMetrics) {
+    _statusPublisher->submitMetrics(*_metrics);
+  }
+}
+
+void Machine::enterRealTimeMode() {
+  if (_realTime.lockMemory) {
+    _memoryLockFailure = realtime::lockProcessMemory();
+    if (_memoryLockFailure.empty()) {
+      SPDLOG_INFO("Process memory locked");
+    } else {
+      SPDLOG_WARN("Process memory not locked: {}", _memoryLockFailure);
+    }
+  }
+  _motorControl.setBusThreadSetup(
+      [settings = _realTime.busWorkers](const std::string& bus) {
+        const auto report = realtime::applyToCurrentThread(settings);
+        if (report.failures.empty()) {
+          SPDLOG_INFO("Motor bus '{}' worker real-time mode: {}", bus,
+                      realtime::describe(report));
+        } else {
+          SPDLOG_WARN(
+              "Motor bus '{}' worker real-time mode only partly applied: {}",
+              bus, realtime::describe(report));
+        }
+      });
+}
+
+nlohmann::json Machine::realTimeStatus() const {
+  nlohmann::json status{{"enabled", _realTime.enabled}};
+  if (!_realTime.enabled) {
+    return status;
+  }
+  status["memoryLocked"] = _realTime.lockMemory && _memoryLockFailure.empty();
+  if (!_memoryLockFailure.empty()) {
+    status["memoryLockFailure"] = _memoryLockFailure;
+  }
+  status["spinTailUs"] = _realTime.spinTail.count();
+  if (_processThreadRealTime) {
+    status["processThread"] = realtime::toJson(*_processThreadRealTime);
+  }
+  return status;
+}
+
+std::string Machine::serveMetrics() const {
+  if (!_metrics) {
+    utl::throwRuntimeError("No metrics gathered yet");
+  }
+  return withSnapshotAge(*_metrics, _clock->now() - _metricsTakenAt);
+}
+
+utl::CommandQueueStatus Machine::commandQueueStatus() {
+  utl::CommandQueueStatus status;
+  status.depth = static_cast<std::uint32_t>(_commandQueue.size());
+  std::size_t deferred = _deferredCommands.size();
+  for (const auto& [motor, snapshot] : _motorDiagnostics) {
+    deferred += snapshot.waiting.size();
+  }
+  status.deferred = static_cast<std::uint32_t>(deferred);
+  const auto samples = std::min(_commandWaitCount, kCommandWaitWindow);
+  if (samples == 0) {
+    return status;
+  }
+  _commandWaitScratch.assign(_commandWaits.begin(),
+                             _commandWaits.begin() + samples);
+  const auto percentileMs = [this](const double fraction) {
+    const auto rank = static_cast<std::size_t>(
+        fraction * static_cast<double>(_commandWaitScratch.size() - 1) + 0.5);
+    std::ranges::nth_element(_commandWaitScratch,
+                             _commandWaitScratch.begin() + rank);
+    return std::chrono::duration<double, std::milli>(_commandWaitScratch[rank])
+        .count();
+  };
+  status.waitP50Ms = percentileMs(0.50);
+  status.waitP95Ms = percentileMs(0.95);
+  status.waitP99Ms = percentileMs(0.99);
+  return status;
+}
+
+std::optional<Machine::PendingCommand> Machine::nextCommand() {
+  if (auto command = _commandQueue.try_pop()) {
+    return PendingCommand{.command = std::move(*command)};
+  }
+  if (_deferredCommands.empty()) {
+    return std::nullopt;
+  }
+  auto pending = std::move(_deferredCommands.front());
+  _deferredCommands.pop_front();
+  return pending;
+}
+
 void Machine::cacheOutputSignals(std::optional<signal_map_t> value) {
   _outputSignalsCache.cycle = _ioCacheCycle;
   _outputSignalsCache.valid = true;
@@ -379,11 +593,23 @@ void Machine::cacheOutputSignals(std::optional<signal_map_t> value) {
 }
 
 bool Machine::submitCommand(cmd::Command command) {
+  command.submittedAt = _clock->now();
   return _commandQueue.push(std::move(command));
 }
 
 std::string Machine::dispatchCommandAndWait(cmd::Command command,
                                             const std::chrono::milliseconds timeout) {
+  if (const auto* stop =
+          std::get_if<cmd::EmergencyStopCommand>(&command.payload)) {
+    // Runs on the caller's thread: waiting behind queued commands and the
+    // current control cycle would only delay the stop.
+    try {
+      handleEmergencyStopCommand(*stop);
+      return {};
+    } catch (const std::exception& e) {
+      return e.what();
+    }
+  }
   auto future = command.reply.get_future();
   if (!submitCommand(std::move(command))) {
     if (_isRunning.load(std::memory_order_acquire)) {
@@ -403,8 +629,29 @@ void Machine::controlLoopTasks() {
   if (!_controller) {
     utl::throwRuntimeError("Machine controller is not wired.");
   }
+  _motorControl.beginBusCycle();
+  runControlStep();
+}
+
+void Machine::joystickWakeStep() {
+  RIMO_TIMED_SCOPE("Machine::joystickWakeStep");
+  if (!_controller) {
+    utl::throwRuntimeError("Machine controller is not wired.");
+  }
+  // Its bus traffic counts towards the cycle of the last tick.
+  runControlStep();
+}
+
+void Machine::runControlStep() {
+  if (_motorControl.emergencyStopActive()) {
+    // Nothing may drive the motors until a reconnect releases the stop.
+    return;
+  }
   try {
     _controller->runControlLoopTasks();
+    if (_motorControl.state() != MachineComponent::State::Error) {
+      _motorControl.servicePulses();
+    }
   } catch (const std::exception& e) {
     SPDLOG_ERROR(
         "Control loop task failed: {}. Putting MotorControl into error state.",
@@ -424,8 +671,33 @@ void Machine::controlLoopTasks() {
 
 void Machine::wire() {
   if (!_loopRunner) {
-    _loopRunner = std::make_unique<ControlLoopRunner>(
-        *_clock, _loopInterval, _updateInterval);
+    _loopRunner = std::make_unique<ControlLoopRunner>(*_clock, _loopInterval);
+    // Motion first, then queued commands; the status follows at its own
+    // rate once both are done.
+    _loopRunner->addTask({.name = "control",
+                          .period = _loopInterval,
+                          .phase = IClock::duration::zero(),
+                          .priority = 2},
+                         [this]() { controlLoopTasks(); });
+    _loopRunner->addTask({.name = "commands",
+                          .period = _loopInterval,
+                          .phase = IClock::duration::zero(),
+                          .priority = 1},
+                         [this]() { runCommandStep(); });
+    if (_statusUpdatesEnabled) {
+      _loopRunner->addTask({.name = "status",
+                            .period = _updateInterval,
+                            .phase = IClock::duration::zero(),
+                            .priority = 0},
+                           [this]() { updateStatus(); });
+    }
+    if (_joystickWakeEnabled) {
+      // A joystick change is acted on right away instead of at the next
+      // tick, without running the loop faster.
+      _loopRunner->setWakeStep(_joystickWakeup, _joystickWakeSpacing,
+                               [this]() { joystickWakeStep(); });
+      _controlPanel.setChangeListener([this]() { _joystickWakeup.notify(); });
+    }
   }
   if (!_controller) {
     _controller = std::make_unique<MachineController>(
@@ -446,6 +718,7 @@ void Machine::wire() {
             .stop = [this](utl::EMotor id) { _motorControl.stopMovement(id); },
             .isConfigured = [this](utl::EMotor id) { return _motorControl.motors().contains(id); },
             .onAlarmCleared = [this](utl::EMotor id) { _motorControl.onAlarmCleared(id); },
+            .batchInputs = [this](const std::function<void()>& fn) { _motorControl.batchDriverInputs(fn); },
         },
         _robotStatus, std::make_unique<RimoKunControlPolicy>());
   }
@@ -453,13 +726,22 @@ void Machine::wire() {
     _statusBuilder = std::make_unique<MachineStatusBuilder>();
   }
   if (!_commandServer) {
-    _commandServer = std::make_unique<MachineCommandServer>(_robotServer);
+    _commandServer =
+        std::make_unique<MachineCommandServer>(_robotServer, _commandWorkers);
+  }
+  if (!_statusPublisher) {
+    _statusPublisher = std::make_unique<StatusPublisher>(
+        [this](const utl::RobotStatus& status) { _robotServer.publish(status); },
+        [this](const nlohmann::json& metrics) {
+          _robotServer.publishMetrics(metrics);
+        });
   }
 }
 
 void Machine::initialize() {
   std::lock_guard<std::mutex> lock(_lifecycleMutex);
-  if (!_loopRunner || !_controller || !_statusBuilder || !_commandServer) {
+  if (!_loopRunner || !_controller || !_statusBuilder || !_commandServer ||
+      !_statusPublisher) {
     utl::throwRuntimeError(
         "Machine collaborators are not wired. Call wire() before initialize().");
   }
@@ -469,12 +751,17 @@ void Machine::initialize() {
     utl::throwRuntimeError("Machine is already running.");
   }
   makeDummyStatus();
+  if (_realTime.enabled) {
+    enterRealTimeMode();
+  }
   initializeComponents();
   try {
+    _statusPublisher->start();
     _commandServerThread = std::thread(&Machine::commandServerThread, this);
     _processThread = std::thread(&Machine::processThread, this);
   } catch (...) {
     _isRunning.store(false, std::memory_order_release);
+    _statusPublisher->stop();
     throw;
   }
 }
@@ -532,87 +819,6 @@ std::string Machine::reconnectComponent(const utl::ERobotComponent component) {
   return "";
 }
 
-nlohmann::json Machine::handleMotorDiagnosticsCommand(
-    const cmd::MotorDiagnosticsCommand& c) {
-  auto response = makeDefaultIoAssignmentResponse(c.motor);
-  try {
-    const auto inputStatus = _motorControl.readInputStatus(c.motor);
-    const auto outputStatus = _motorControl.readOutputStatus(c.motor);
-    const auto directIoStatus = _motorControl.readDirectIoStatus(c.motor);
-    const auto remoteIoStatus = _motorControl.readRemoteIoStatus(c.motor);
-    const auto alarm = _motorControl.diagnoseCurrentAlarm(c.motor);
-    const auto warning = _motorControl.diagnoseCurrentWarning(c.motor);
-
-    response["driverInputRaw"] = inputStatus.raw;
-    response["driverOutputRaw"] = outputStatus.raw;
-    response["ioOutputRaw"] = directIoStatus.reg00D4;
-    response["ioInputRaw"] = directIoStatus.reg00D5;
-    response["netInputRaw"] = remoteIoStatus.reg007D;
-    response["netOutputRaw"] = remoteIoStatus.reg007F;
-    response["inputFlags"] = nlohmann::json::array();
-    for (const auto flag : inputStatus.activeFlags) {
-      response["inputFlags"].push_back(std::string(flag));
-    }
-    response["outputFlags"] = nlohmann::json::array();
-    for (const auto flag : outputStatus.activeFlags) {
-      response["outputFlags"].push_back(std::string(flag));
-    }
-    response["ioOutputAssignments"] = nlohmann::json::array();
-    for (const auto& assignment : directIoStatus.outputAssignments) {
-      response["ioOutputAssignments"].push_back(nlohmann::json{
-          {"channel", assignment.channel},
-          {"function", assignment.function},
-          {"functionCode", assignment.functionCode},
-          {"active", assignment.active},
-      });
-    }
-    response["ioInputAssignments"] = nlohmann::json::array();
-    for (const auto& assignment : directIoStatus.inputAssignments) {
-      response["ioInputAssignments"].push_back(nlohmann::json{
-          {"channel", assignment.channel},
-          {"function", assignment.function},
-          {"functionCode", assignment.functionCode},
-          {"active", assignment.active},
-      });
-    }
-    response["netOutputAssignments"] = nlohmann::json::array();
-    for (const auto& assignment : remoteIoStatus.outputAssignments) {
-      response["netOutputAssignments"].push_back(nlohmann::json{
-          {"channel", assignment.channel},
-          {"function", assignment.function},
-          {"functionCode", assignment.functionCode},
-          {"active", assignment.active},
-      });
-    }
-    response["netInputAssignments"] = nlohmann::json::array();
-    for (const auto& assignment : remoteIoStatus.inputAssignments) {
-      response["netInputAssignments"].push_back(nlohmann::json{
-          {"channel", assignment.channel},
-          {"function", assignment.function},
-          {"functionCode", assignment.functionCode},
-          {"active", assignment.active},
-      });
-    }
-    response["alarm"] = nlohmann::json{
-        {"code", alarm.code},
-        {"known", alarm.known},
-        {"type", alarm.type},
-        {"cause", alarm.cause},
-        {"remedialAction", alarm.remedialAction},
-    };
-    response["warning"] = nlohmann::json{
-        {"code", warning.code},
-        {"known", warning.known},
-        {"type", warning.type},
-        {"cause", warning.cause},
-        {"remedialAction", warning.remedialAction},
-    };
-  } catch (const std::exception& ex) {
-    response["diagnosticsError"] = ex.what();
-  }
-  return response;
-}
-
 void Machine::handleResetMotorAlarmCommand(const cmd::ResetMotorAlarmCommand& c) {
   _motorControl.resetAlarm(c.motor);
 }
@@ -673,8 +879,17 @@ nlohmann::json Machine::handleContecDiagnosticsCommand(
   return response;
 }
 
-void Machine::handleEmergencyStopCommand(const cmd::EmergencyStopCommand&) {
-  SPDLOG_WARN("Emergency stop requested — not yet implemented.");
+void Machine::handleEmergencyStopCommand(const cmd::EmergencyStopCommand& c) {
+  const auto report = _motorControl.emergencyStop(c.requestedAt);
+  if (!report.unconfirmed.empty()) {
+    std::string motors;
+    for (const auto motorId : report.unconfirmed) {
+      motors += std::format("{}{}", motors.empty() ? "" : ", ",
+                            magic_enum::enum_name(motorId));
+    }
+    utl::throwRuntimeError(
+        std::format("Emergency stop not confirmed by: {}", motors));
+  }
 }
 
 void Machine::shutdown() {
@@ -682,10 +897,28 @@ void Machine::shutdown() {
   SPDLOG_INFO("Shutting down. Joining Threads...");
   _isRunning.store(false, std::memory_order_release);
   _commandQueue.shutdown();
-  while (auto command = _commandQueue.try_pop()) {
-    command->reply.set_value("Machine is shutting down");
-  }
+  // The control thread is the queue's only consumer; drain once it is gone.
   if (_processThread.joinable()) _processThread.join();
+  while (_commandQueue.size() > 0) {
+    if (auto command = _commandQueue.try_pop()) {
+      command->reply.set_value("Machine is shutting down");
+    } else {
+      // A push accepted before shutdown() is still being published.
+      std::this_thread::yield();
+    }
+  }
+  for (auto& pending : _deferredCommands) {
+    pending.command.reply.set_value("Machine is shutting down");
+  }
+  _deferredCommands.clear();
+  for (auto& [motor, snapshot] : _motorDiagnostics) {
+    for (auto& command : snapshot.waiting) {
+      command.reply.set_value("Machine is shutting down");
+    }
+  }
+  _motorDiagnostics.clear();
+  _diagnostics.clear();
+  if (_statusPublisher) _statusPublisher->stop();
   if (_commandServerThread.joinable()) _commandServerThread.join();
 }
 
@@ -724,10 +957,13 @@ void Machine::makeDummyStatus() {
 
 void Machine::updateStatus() {
   RIMO_TIMED_SCOPE("Machine::updateStatus");
+  _robotStatus.commandQueue = commandQueueStatus();
   _statusBuilder->updateAndPublish(
       _robotStatus, _components,
       [this]() { return _controlPanel.getSnapshot(); },
       [this]() { return readInputSignals(); },
       [this]() { return readOutputSignals(); },
-      [this](const utl::RobotStatus& status) { _robotServer.publish(status); });
+      [this](const utl::RobotStatus& status) {
+        _statusPublisher->submit(status);
+      });
 }
@@ -149,6 +149,24 @@ nlohmann::json cmd::processCommand(
     return response;
   }
 
+  if (type == "metrics") {
+    try {
+      cmd::Command c;
+      c.payload = cmd::MetricsCommand{};
+      const auto reply = dispatch(std::move(c), 2s);
+      try {
+        response["response"] = nlohmann::json::parse(reply);
+      } catch (...) {
+        response["status"] = "Error";
+        response["message"] = reply;
+      }
+    } catch (const std::exception& e) {
+      response["status"] = "Error";
+      response["message"] = std::format("Invalid metrics command: {}", e.what());
+    }
+    return response;
+  }
+
   if (type == "setMotorEnabled") {
     if (!command.contains("motor") || !command.contains("enabled") ||
         !command.at("enabled").is_boolean()) {
@@ -3,43 +3,108 @@
 
 #include <Logger.hpp>
 
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
 namespace {
 class RimoServerCommandChannel final : public ICommandChannel {
  public:
   explicit RimoServerCommandChannel(utl::RimoServer<utl::RobotStatus>& server)
       : _server(server) {}
 
-  std::optional<nlohmann::json> receiveCommand() override {
+  std::optional<utl::ReceivedCommand> receiveCommand() override {
     return _server.receiveCommand();
   }
-  void sendResponse(const nlohmann::json& response) override {
-    _server.sendResponse(response);
+  void sendResponse(const std::uint64_t replyTo,
+                    const nlohmann::json& response) override {
+    _server.sendResponse(replyTo, response);
   }
+  void flushResponses() override { _server.flushResponses(); }
 
  private:
   utl::RimoServer<utl::RobotStatus>& _server;
 };
+
+bool isEmergencyStop(const nlohmann::json& command) {
+  if (!command.is_object()) {
+    return false;
+  }
+  const auto type = command.find("type");
+  return type != command.end() && type->is_string() &&
+         type->get_ref<const std::string&>() == "emergencyStop";
+}
 }  // namespace
 
-MachineCommandServer::MachineCommandServer(utl::RimoServer<utl::RobotStatus>& server)
+MachineCommandServer::MachineCommandServer(
+    utl::RimoServer<utl::RobotStatus>& server, const std::size_t workerCount)
     : _ownedChannel(std::make_unique<RimoServerCommandChannel>(server)),
-      _channel(_ownedChannel.get()) {}
+      _channel(_ownedChannel.get()),
+      _workerCount(std::max<std::size_t>(1, workerCount)) {}
 
-MachineCommandServer::MachineCommandServer(ICommandChannel& channel)
-    : _channel(&channel) {}
+MachineCommandServer::MachineCommandServer(ICommandChannel& channel,
+                                           const std::size_t workerCount)
+    : _channel(&channel), _workerCount(std::max<std::size_t>(1, workerCount)) {}
+
+void MachineCommandServer::runLoop(const std::atomic<bool>& running,
+                                   const cmd::DispatchFn& dispatch) const {
+  SPDLOG_INFO("Command Server Thread Started with {} workers!", _workerCount);
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::queue<utl::ReceivedCommand> pending;
+  bool draining = false;
+
+  std::vector<std::thread> workers;
+  workers.reserve(_workerCount);
+  for (std::size_t i = 0; i < _workerCount; ++i) {
+    workers.emplace_back([&]() {
+      for (;;) {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&]() { return draining || !pending.empty(); });
+        if (pending.empty()) {
+          return;
+        }
+        auto request = std::move(pending.front());
+        pending.pop();
+        lock.unlock();
+        SPDLOG_INFO("Received command: {}", request.command.dump());
+        const auto response = cmd::processCommand(request.command, dispatch);
+        _channel->sendResponse(request.replyTo, response);
+      }
+    });
+  }
 
-void MachineCommandServer::runLoop(
-    const std::atomic<bool>& running,
-    const cmd::DispatchFn& dispatch) const {
-  SPDLOG_INFO("Command Server Thread Started!");
   while (running.load(std::memory_order_acquire)) {
     auto command = _channel->receiveCommand();
     if (!command) {
       continue;
     }
-    SPDLOG_INFO("Received command: {}", command->dump());
-    const auto response = cmd::processCommand(*command, dispatch);
-    _channel->sendResponse(response);
+    if (isEmergencyStop(command->command)) {
+      // Handled right here, ahead of whatever the workers are busy with.
+      SPDLOG_WARN("Received emergency stop");
+      _channel->sendResponse(command->replyTo,
+                             cmd::processCommand(command->command, dispatch));
+      continue;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      pending.push(std::move(*command));
+    }
+    cv.notify_one();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    draining = true;
+  }
+  cv.notify_all();
+  for (auto& worker : workers) {
+    worker.join();
   }
+  _channel->flushResponses();
   SPDLOG_INFO("Command Server thread finished!");
 }
@@ -56,43 +56,50 @@ void MachineController::runControlLoopTasks() {
   if (decision.outputs) {
     _io.setOutputs(*decision.outputs);
   }
-  for (const auto& intent : decision.motorIntents) {
-    if (!_motorOps.isConfigured(intent.motorId)) {
-      if (!_missingMotorWarned[intent.motorId]) {
-        SPDLOG_WARN(
-            "Control policy emitted command for motor {} which is not configured. "
-            "Ignoring commands for this motor.",
-            magic_enum::enum_name(intent.motorId));
-        _missingMotorWarned[intent.motorId] = true;
+  const auto applyIntents = [&]() {
+    for (const auto& intent : decision.motorIntents) {
+      if (!_motorOps.isConfigured(intent.motorId)) {
+        if (!_missingMotorWarned[intent.motorId]) {
+          SPDLOG_WARN(
+              "Control policy emitted command for motor {} which is not configured. "
+              "Ignoring commands for this motor.",
+              magic_enum::enum_name(intent.motorId));
+          _missingMotorWarned[intent.motorId] = true;
+        }
+        continue;
+      }
+      _missingMotorWarned[intent.motorId] = false;
+      if (intent.mode && _motorOps.setMode) {
+        _motorOps.setMode(intent.motorId, *intent.mode);
+      }
+      if (intent.direction && _motorOps.setDirection) {
+        _motorOps.setDirection(intent.motorId, *intent.direction);
+      }
+      if (intent.speed && _motorOps.setSpeed) {
+        _motorOps.setSpeed(intent.motorId, *intent.speed);
+      }
+      if (intent.acceleration && _motorOps.setAcceleration) {
+        _motorOps.setAcceleration(intent.motorId, *intent.acceleration);
+      }
+      if (intent.deceleration && _motorOps.setDeceleration) {
+        _motorOps.setDeceleration(intent.motorId, *intent.deceleration);
+      }
+      if (intent.position && _motorOps.setPosition) {
+        _motorOps.setPosition(intent.motorId, *intent.position);
+      }
+      if (intent.stopMovement) {
+        if (_motorOps.stop) _motorOps.stop(intent.motorId);
+        continue;
+      }
+      if (intent.startMovement) {
+        if (_motorOps.start) _motorOps.start(intent.motorId);
       }
-      continue;
-    }
-    _missingMotorWarned[intent.motorId] = false;
-    if (intent.mode && _motorOps.setMode) {
-      _motorOps.setMode(intent.motorId, *intent.mode);
-    }
-    if (intent.direction && _motorOps.setDirection) {
-      _motorOps.setDirection(intent.motorId, *intent.direction);
-    }
-    if (intent.speed && _motorOps.setSpeed) {
-      _motorOps.setSpeed(intent.motorId, *intent.speed);
-    }
-    if (intent.acceleration && _motorOps.setAcceleration) {
-      _motorOps.setAcceleration(intent.motorId, *intent.acceleration);
-    }
-    if (intent.deceleration && _motorOps.setDeceleration) {
-      _motorOps.setDeceleration(intent.motorId, *intent.deceleration);
-    }
-    if (intent.position && _motorOps.setPosition) {
-      _motorOps.setPosition(intent.motorId, *intent.position);
-    }
-    if (intent.stopMovement) {
-      if (_motorOps.stop) _motorOps.stop(intent.motorId);
-      continue;
-    }
-    if (intent.startMovement) {
-      if (_motorOps.start) _motorOps.start(intent.motorId);
     }
+  };
+  if (_motorOps.batchInputs) {
+    _motorOps.batchInputs(applyIntents);
+  } else {
+    applyIntents();
   }
 }
 
@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <exception>
 #include <format>
+#include <stdexcept>
+#include <vector>
 
 #include <Logger.hpp>
 #include <Motor.hpp>
@@ -111,8 +113,20 @@ void MachineStatusBuilder::updateAndPublish(
       const auto componentState = motorControlIt->second->state();
       bool hasAnyMotorWarningOrAlarm = false;
       const auto configuredMotorIds = motorControl->configuredMotorIds();
+      std::vector<utl::EMotor> pollableMotorIds;
+      if (componentState != MachineComponent::State::Error) {
+        for (const auto motorId : configuredMotorIds) {
+          if (motorControl->motors().contains(motorId)) {
+            pollableMotorIds.push_back(motorId);
+          }
+        }
+      }
+      // One poll for all motors: each bus worker reads its own motors, so
+      // motors on separate lines are read in parallel.
+      auto polls = motorControl->pollStatus(pollableMotorIds);
       for (const auto motorId : configuredMotorIds) {
         auto& motorStatus = status.motors[motorId];
+        motorStatus.linkState = motorControl->linkState(motorId);
 
         if (componentState == MachineComponent::State::Error) {
           motorStatus.state = utl::ELEDState::Error;
@@ -144,9 +158,30 @@ void MachineStatusBuilder::updateAndPublish(
           continue;
         }
 
+        if (const auto pollIt = polls.find(motorId);
+            pollIt != polls.end() && pollIt->second.skipped) {
+          // Breaker open: already logged when it opened, so no per-cycle
+          // warning here.
+          motorStatus.state = utl::ELEDState::Error;
+          motorStatus.flags[utl::EMotorStatusFlags::BrakeApplied] =
+              utl::ELEDState::Error;
+          motorStatus.flags[utl::EMotorStatusFlags::Enabled] =
+              utl::ELEDState::Error;
+          motorStatus.flags[utl::EMotorStatusFlags::Warning] = utl::ELEDState::Off;
+          motorStatus.flags[utl::EMotorStatusFlags::Alarm] = utl::ELEDState::Error;
+          motorStatus.warningDescription.clear();
+          motorStatus.alarmDescription = pollIt->second.error;
+          hasAnyMotorWarningOrAlarm = true;
+          continue;
+        }
+
         try {
-          const auto outputStatus = motorControl->readOutputStatus(motorId);
-          const auto monitor = motorControl->readMonitorSnapshot(motorId);
+          const auto& poll = polls.at(motorId);
+          if (!poll.error.empty()) {
+            throw std::runtime_error(poll.error);
+          }
+          const auto& outputStatus = *poll.outputStatus;
+          const auto& monitor = *poll.monitor;
           motorStatus.targetPosition =
               positionMmFromSteps(motorId, monitor.commandPosition);
           motorStatus.currentPosition =
@@ -198,15 +233,15 @@ void MachineStatusBuilder::updateAndPublish(
           motorStatus.warningDescription.clear();
           motorStatus.alarmDescription.clear();
 
-          if (hasWarning) {
-            const auto warning = motorControl->diagnoseCurrentWarning(motorId);
+          if (hasWarning && poll.warning) {
+            const auto& warning = *poll.warning;
             motorStatus.warningDescription =
                 warning.cause.empty()
                     ? warning.type
                     : std::format("{}: {}", warning.type, warning.cause);
           }
-          if (hasAlarm) {
-            const auto alarm = motorControl->diagnoseCurrentAlarm(motorId);
+          if (hasAlarm && poll.alarm) {
+            const auto& alarm = *poll.alarm;
             motorStatus.alarmDescription =
                 alarm.cause.empty()
                     ? alarm.type
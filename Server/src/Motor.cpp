@@ -4,6 +4,7 @@
 #include <ArKd2Diagnostics.hpp>
 #include <ArKd2FullRegisterMap.hpp>
 #include <Logger.hpp>
+#include <RegisterReadPlanner.hpp>
 #include <TimingMetrics.hpp>
 #include <magic_enum/magic_enum.hpp>
 
@@ -347,35 +348,43 @@ void Motor::initialize(ModbusClient& bus) const {
 std::uint32_t Motor::readU32(ModbusClient& bus, int upperAddr) const {
   RIMO_TIMED_SCOPE("Motor::readU32");
   selectSlave(bus, SlaveTarget::Device);
-  auto regs = bus.read_holding_registers(upperAddr, 2);
-  if (!regs || regs->size() != 2) {
-    auto reason = regs ? "Unexpected register count" : regs.error().message;
+  std::array<std::uint16_t, 2> regs{};
+  auto rc = bus.read_holding_registers(upperAddr, regs);
+  if (!rc || *rc != 2) {
+    auto reason = rc ? "Unexpected register count" : rc.error().message;
     auto msg = std::format("Motor {} (slave {}) readU32({}) failed: {}",
                            magic_enum::enum_name(_id), _slaveAddress,
                            registerLabel(upperAddr), reason);
     utl::throwRuntimeError(msg);
   }
-  return (static_cast<std::uint32_t>((*regs)[0]) << 16) |
-         static_cast<std::uint32_t>((*regs)[1]);
+  _shadow.observe(upperAddr, regs);
+  return (static_cast<std::uint32_t>(regs[0]) << 16) |
+         static_cast<std::uint32_t>(regs[1]);
 }
 
 std::uint16_t Motor::readU16(ModbusClient& bus, const int addr) const {
   RIMO_TIMED_SCOPE("Motor::readU16");
   selectSlave(bus, SlaveTarget::Device);
-  auto regs = bus.read_holding_registers(addr, 1);
-  if (!regs || regs->size() != 1) {
-    auto reason = regs ? "Unexpected register count" : regs.error().message;
+  std::array<std::uint16_t, 1> regs{};
+  auto rc = bus.read_holding_registers(addr, regs);
+  if (!rc || *rc != 1) {
+    auto reason = rc ? "Unexpected register count" : rc.error().message;
     auto msg = std::format("Motor {} (slave {}) readU16(0x{:04X}) failed: {}",
                            magic_enum::enum_name(_id), _slaveAddress, addr,
                            reason);
     utl::throwRuntimeError(msg);
   }
-  return (*regs)[0];
+  _shadow.observe(addr, regs);
+  return regs[0];
 }
 
 void Motor::writeU16(ModbusClient& bus, const int addr,
                      const std::uint16_t value) const {
   RIMO_TIMED_SCOPE("Motor::writeU16");
+  flushRegisterShadow(bus);
+  if (targetsOwnRegisters(SlaveTarget::Command)) {
+    _shadow.invalidate(addr, 1);
+  }
   selectSlave(bus, SlaveTarget::Command);
   const std::array<std::uint16_t, 1> singleWord{value};
   ModbusResult<void> wr = _forceFunction10ForSingleRegisterWrites
@@ -397,9 +406,13 @@ void Motor::writeInt32(ModbusClient& bus, int upperAddr, std::int32_t value) con
 void Motor::writeInt32(ModbusClient& bus, int upperAddr, std::int32_t value,
                        const SlaveTarget target) const {
   RIMO_TIMED_SCOPE("Motor::writeInt32");
+  flushRegisterShadow(bus);
+  if (targetsOwnRegisters(target)) {
+    _shadow.invalidate(upperAddr, 2);
+  }
   selectSlave(bus, target);
   std::uint32_t raw = static_cast<std::uint32_t>(value);
-  std::vector<std::uint16_t> words = {
+  const std::array<std::uint16_t, 2> words{
       static_cast<std::uint16_t>((raw >> 16) & 0xFFFFu),
       static_cast<std::uint16_t>(raw & 0xFFFFu)};
   auto wr = bus.write_multiple_registers(upperAddr, words);
@@ -414,6 +427,48 @@ void Motor::writeInt32(ModbusClient& bus, int upperAddr, std::int32_t value,
   }
 }
 
+bool Motor::targetsOwnRegisters(const SlaveTarget target) const {
+  return target == SlaveTarget::Device || _commandSlaveAddress == _slaveAddress;
+}
+
+void Motor::writeShadowedInt32(ModbusClient& bus, const int upperAddr,
+                               const std::int32_t value,
+                               const SlaveTarget target) const {
+  if (!targetsOwnRegisters(target)) {
+    // A shared command slave (group/broadcast) also changes other drivers, so
+    // its writes can't be judged against this motor's shadow.
+    writeInt32(bus, upperAddr, value, target);
+    return;
+  }
+  _shadow.stageU32(upperAddr, static_cast<std::uint32_t>(value));
+  if (_writeBatchDepth == 0) {
+    flushRegisterShadow(bus);
+  }
+}
+
+void Motor::flushRegisterShadow(ModbusClient& bus) const {
+  if (!_shadow.hasPendingWrites()) {
+    return;
+  }
+  RIMO_TIMED_SCOPE("Motor::flushRegisterShadow");
+  selectSlave(bus, SlaveTarget::Device);
+  _shadow.flush([&](const int startAddr,
+                    std::span<const std::uint16_t> words) {
+    auto wr = bus.write_multiple_registers(startAddr, words);
+    if (!wr) {
+      utl::throwRuntimeError(std::format(
+          "Motor {} (slave {}) write of {} register(s) at {} failed: {}",
+          magic_enum::enum_name(_id), _slaveAddress, words.size(),
+          registerLabel(startAddr), wr.error().message));
+    }
+  });
+}
+
+void Motor::invalidateRegisterShadow() const noexcept {
+  _shadow.discardPending();
+  _shadow.invalidateAll();
+}
+
 std::uint8_t Motor::readAlarmCode(ModbusClient& bus) const {
   const auto alarm = readU32(bus, _map.presentAlarm);
   return static_cast<std::uint8_t>(alarm & 0xFFu);
@@ -429,6 +484,20 @@ std::uint8_t Motor::readCommunicationErrorCode(ModbusClient& bus) const {
   return static_cast<std::uint8_t>(commErr & 0xFFu);
 }
 
+std::uint8_t Motor::decodeAlarmCode(const RegisterBlock& block) const {
+  return static_cast<std::uint8_t>(block.u32(_map.presentAlarm) & 0xFFu);
+}
+
+std::uint8_t Motor::decodeWarningCode(const RegisterBlock& block) const {
+  return static_cast<std::uint8_t>(block.u32(_map.presentWarning) & 0xFFu);
+}
+
+std::uint8_t Motor::decodeCommunicationErrorCode(
+    const RegisterBlock& block) const {
+  return static_cast<std::uint8_t>(block.u32(_map.communicationErrorCode) &
+                                   0xFFu);
+}
+
 MotorCodeDiagnostic Motor::diagnoseAlarm(const std::uint8_t code) const {
   return asDiagnostic(MotorDiagnosticDomain::Alarm, code, arKd2FindAlarm(code));
 }
@@ -446,9 +515,20 @@ MotorCodeDiagnostic Motor::diagnoseCommunicationError(
 
 std::uint16_t Motor::readDriverInputCommandRaw(ModbusClient& bus) const {
   const auto raw = readU16(bus, _map.driverInputCommandLower);
+  observeDriverInputCommandRaw(raw);
+  return raw;
+}
+
+void Motor::observeDriverInputCommandRaw(const std::uint16_t raw) const {
+  const bool hasStagedChanges =
+      _stagingDriverInputs &&
+      _driverInputCommandRawCache != _driverInputCommandRawDevice;
+  _driverInputCommandRawDevice = raw;
+  if (hasStagedChanges) {
+    return;
+  }
   _driverInputCommandRawCache = raw;
   _selectedOperationIdCache = decodeOperationIdFromInputRawMapped(raw);
-  return raw;
 }
 
 std::uint16_t Motor::readDriverOutputStatusRaw(ModbusClient& bus) const {
@@ -457,16 +537,98 @@ std::uint16_t Motor::readDriverOutputStatusRaw(ModbusClient& bus) const {
 
 void Motor::writeDriverInputCommandRaw(ModbusClient& bus,
                                        const std::uint16_t raw) const {
+  if (_stagingDriverInputs) {
+    _driverInputCommandRawCache = raw;
+    _selectedOperationIdCache = decodeOperationIdFromInputRawMapped(raw);
+    return;
+  }
+  sendDriverInputCommandRaw(bus, raw);
+}
+
+void Motor::sendDriverInputCommandRaw(ModbusClient& bus,
+                                      const std::uint16_t raw) const {
   writeU16(bus, _map.driverInputCommandLower, raw);
   _driverInputCommandRawCache = raw;
+  _driverInputCommandRawDevice = raw;
   _selectedOperationIdCache = decodeOperationIdFromInputRawMapped(raw);
 }
 
-void Motor::setDriverInputFlag(ModbusClient& bus, const MotorInputFlag flag,
-                               const bool enabled) const {
-  auto raw = _driverInputCommandRawCache.has_value()
-                 ? *_driverInputCommandRawCache
-                 : readDriverInputCommandRawCommandTarget(bus);
+void Motor::stageDriverInputs() const noexcept {
+  _stagingDriverInputs = true;
+}
+
+void Motor::commitDriverInputs(ModbusClient& bus) const {
+  _stagingDriverInputs = false;
+  sendStagedDriverInputs(bus);
+}
+
+void Motor::sendStagedDriverInputs(ModbusClient& bus) const {
+  if (!_driverInputCommandRawCache.has_value() ||
+      _driverInputCommandRawCache == _driverInputCommandRawDevice) {
+    return;
+  }
+  RIMO_TIMED_SCOPE("Motor::sendStagedDriverInputs");
+  const auto staged = *_driverInputCommandRawCache;
+  try {
+    if (_driverInputCommandRawDevice.has_value()) {
+      // The AR-KD2 takes the operation number on the rising edge of START,
+      // FWD, ... so a new selection has to be on the inputs before that edge.
+      const auto device = *_driverInputCommandRawDevice;
+      const auto rising =
+          static_cast<std::uint16_t>(staged & ~device & motionTriggerMask());
+      if (rising != 0 && ((staged ^ device) & operationIdMask()) != 0) {
+        sendDriverInputCommandRaw(bus,
+                                  static_cast<std::uint16_t>(staged & ~rising));
+      }
+    }
+    sendDriverInputCommandRaw(bus, staged);
+  } catch (...) {
+    // Whether the driver took the word is unknown; re-read before next use.
+    invalidateDriverInputCommandCache();
+    throw;
+  }
+}
+
+std::uint16_t Motor::motionTriggerMask() const {
+  std::uint16_t mask = 0;
+  for (const auto flag :
+       {MotorInputFlag::Start, MotorInputFlag::SStart, MotorInputFlag::Home,
+        MotorInputFlag::Stop, MotorInputFlag::PlusJog, MotorInputFlag::MinusJog,
+        MotorInputFlag::Fwd, MotorInputFlag::Rvs}) {
+    mask = static_cast<std::uint16_t>(mask | inputFlagMask(flag));
+  }
+  return mask;
+}
+
+void Motor::discardStagedDriverInputs() const noexcept {
+  _stagingDriverInputs = false;
+  _driverInputCommandRawCache = _driverInputCommandRawDevice;
+  if (_driverInputCommandRawDevice.has_value()) {
+    _selectedOperationIdCache =
+        decodeOperationIdFromInputRawMapped(*_driverInputCommandRawDevice);
+  } else {
+    _selectedOperationIdCache.reset();
+  }
+}
+
+std::optional<std::uint16_t> Motor::broadcastStopWord() const {
+  if (netInputBitForFunction(kFunctionCOn).has_value()) {
+    return std::nullopt;
+  }
+  return inputFlagMask(MotorInputFlag::Stop);
+}
+
+void Motor::applyEmergencyStop(ModbusClient& bus) const {
+  discardStagedDriverInputs();
+  const auto raw = _driverInputCommandRawDevice.has_value()
+                       ? *_driverInputCommandRawDevice
+                       : readDriverInputCommandRawCommandTarget(bus);
+  sendDriverInputCommandRaw(
+      bus, static_cast<std::uint16_t>((raw & ~motionTriggerMask()) |
+                                      inputFlagMask(MotorInputFlag::Stop)));
+}
+
+std::uint16_t Motor::inputFlagMask(const MotorInputFlag flag) const {
   std::optional<std::uint16_t> bit;
   const auto bitMaskFromMapped = [&](const std::uint16_t functionCode)
       -> std::optional<std::uint16_t> {
@@ -508,11 +670,25 @@ void Motor::setDriverInputFlag(ModbusClient& bus, const MotorInputFlag flag,
     default:
       break;
   }
-  if (!bit.has_value()) {
-    bit = static_cast<std::uint16_t>(flag);
+  return bit.value_or(static_cast<std::uint16_t>(flag));
+}
+
+void Motor::setDriverInputFlag(ModbusClient& bus, const MotorInputFlag flag,
+                               const bool enabled) const {
+  auto raw = _driverInputCommandRawCache.has_value()
+                 ? *_driverInputCommandRawCache
+                 : readDriverInputCommandRawCommandTarget(bus);
+  const auto bit = inputFlagMask(flag);
+  if (_stagingDriverInputs && enabled && (raw & bit) == 0 &&
+      _driverInputCommandRawDevice.has_value() &&
+      (*_driverInputCommandRawDevice & bit) != 0 &&
+      (motionTriggerMask() & bit) != 0) {
+    // Re-triggering an input that is still high: the driver only sees the
+    // new edge once the staged low level has reached it.
+    sendStagedDriverInputs(bus);
   }
-  raw = enabled ? static_cast<std::uint16_t>(raw | *bit)
-                : static_cast<std::uint16_t>(raw & ~(*bit));
+  raw = enabled ? static_cast<std::uint16_t>(raw | bit)
+                : static_cast<std::uint16_t>(raw & ~bit);
   writeDriverInputCommandRaw(bus, raw);
 }
 
@@ -576,6 +752,7 @@ void Motor::setEnabled(ModbusClient& bus, const bool enabled) const {
 
 void Motor::invalidateDriverInputCommandCache() const noexcept {
   _driverInputCommandRawCache.reset();
+  _driverInputCommandRawDevice.reset();
 }
 
 std::uint8_t Motor::decodeOperationIdFromInputRaw(const std::uint16_t raw) {
@@ -634,76 +811,80 @@ void Motor::setSelectedOperationId(ModbusClient& bus, const std::uint8_t opId) c
 
 void Motor::setOperationMode(ModbusClient& bus, const std::uint8_t opId,
                              const MotorOperationMode mode) const {
-  writeInt32(bus, operationAddr(_map.operationModeNo0, opId),
-             static_cast<std::int32_t>(mode));
+  writeShadowedInt32(bus, operationAddr(_map.operationModeNo0, opId),
+                     static_cast<std::int32_t>(mode), SlaveTarget::Command);
 }
 
 void Motor::setOperationFunction(ModbusClient& bus, const std::uint8_t opId,
                                  const MotorOperationFunction function) const {
   // Operation function starts at 0x0580 and is contiguous.
-  writeInt32(bus, operationAddr(_map.operationModeNo0 + 0x80, opId),
-             static_cast<std::int32_t>(function));
+  writeShadowedInt32(bus, operationAddr(_map.operationModeNo0 + 0x80, opId),
+                     static_cast<std::int32_t>(function), SlaveTarget::Command);
 }
 
 void Motor::setOperationPosition(ModbusClient& bus, const std::uint8_t opId,
                                  const std::int32_t position) const {
-  writeInt32(bus, operationAddr(_map.positionNo0, opId), position);
+  writeShadowedInt32(bus, operationAddr(_map.positionNo0, opId), position,
+                     SlaveTarget::Command);
 }
 
 void Motor::setOperationSpeed(ModbusClient& bus, const std::uint8_t opId,
                               const std::int32_t speed) const {
-  writeInt32(bus, operationAddr(_map.speedNo0, opId), speed);
+  writeShadowedInt32(bus, operationAddr(_map.speedNo0, opId), speed,
+                     SlaveTarget::Command);
 }
 
 void Motor::setOperationAcceleration(ModbusClient& bus, const std::uint8_t opId,
                                      const std::int32_t acceleration) const {
-  writeInt32(bus, operationAddr(_map.accelerationNo0, opId), acceleration);
+  writeShadowedInt32(bus, operationAddr(_map.accelerationNo0, opId),
+                     acceleration, SlaveTarget::Command);
 }
 
 void Motor::setOperationDeceleration(ModbusClient& bus, const std::uint8_t opId,
                                      const std::int32_t deceleration) const {
-  writeInt32(bus, operationAddr(_map.decelerationNo0, opId), deceleration);
+  writeShadowedInt32(bus, operationAddr(_map.decelerationNo0, opId),
+                     deceleration, SlaveTarget::Command);
 }
 
 void Motor::setRunCurrent(ModbusClient& bus, const std::int32_t current) const {
-  writeInt32(bus, _map.runCurrent, current, SlaveTarget::Device);
+  writeShadowedInt32(bus, _map.runCurrent, current, SlaveTarget::Device);
 }
 
 void Motor::setStopCurrent(ModbusClient& bus, const std::int32_t current) const {
-  writeInt32(bus, _map.stopCurrent, current, SlaveTarget::Device);
+  writeShadowedInt32(bus, _map.stopCurrent, current, SlaveTarget::Device);
 }
 
 void Motor::setStopInputAction(ModbusClient& bus, const std::int32_t value) const {
-  writeInt32(bus, _map.stopInputAction, value, SlaveTarget::Device);
+  writeShadowedInt32(bus, _map.stopInputAction, value, SlaveTarget::Device);
 }
 
 void Motor::setStartingSpeed(ModbusClient& bus, const std::int32_t speed) const {
-  writeInt32(bus, _map.startingSpeed, speed, SlaveTarget::Device);
+  writeShadowedInt32(bus, _map.startingSpeed, speed, SlaveTarget::Device);
 }
 
 void Motor::setOverloadAlarm(ModbusClient& bus, const std::int32_t value) const {
-  writeInt32(bus, _map.overloadAlarm, value, SlaveTarget::Device);
+  writeShadowedInt32(bus, _map.overloadAlarm, value, SlaveTarget::Device);
 }
 
 void Motor::setExcessivePositionDeviationAlarm(ModbusClient& bus,
                                                const std::int32_t value) const {
-  writeInt32(bus, _map.excessivePositionDeviationAlarm, value,
-             SlaveTarget::Device);
+  writeShadowedInt32(bus, _map.excessivePositionDeviationAlarm, value,
+                     SlaveTarget::Device);
 }
 
 void Motor::setOverloadWarning(ModbusClient& bus, const std::int32_t value) const {
-  writeInt32(bus, _map.overloadWarning, value, SlaveTarget::Device);
+  writeShadowedInt32(bus, _map.overloadWarning, value, SlaveTarget::Device);
 }
 
 void Motor::setExcessivePositionDeviationWarning(ModbusClient& bus,
                                                  const std::int32_t value) const {
-  writeInt32(bus, _map.excessivePositionDeviationWarning, value,
-             SlaveTarget::Device);
+  writeShadowedInt32(bus, _map.excessivePositionDeviationWarning, value,
+                     SlaveTarget::Device);
 }
 
 void Motor::setMotorRotationDirection(ModbusClient& bus,
                                       const std::int32_t value) const {
-  writeInt32(bus, _map.motorRotationDirection, value, SlaveTarget::Device);
+  writeShadowedInt32(bus, _map.motorRotationDirection, value, SlaveTarget::Device);
 }
 
 void Motor::executeConfiguration(ModbusClient& bus) const {
@@ -715,7 +896,7 @@ std::int32_t Motor::readGroupId(ModbusClient& bus) const {
 }
 
 void Motor::setGroupId(ModbusClient& bus, const std::int32_t value) const {
-  writeInt32(bus, _map.groupId, value, SlaveTarget::Device);
+  writeShadowedInt32(bus, _map.groupId, value, SlaveTarget::Device);
 }
 
 void Motor::configureConstantSpeedPair(ModbusClient& bus,
@@ -724,16 +905,19 @@ void Motor::configureConstantSpeedPair(ModbusClient& bus,
                                        const std::int32_t acceleration,
                                        const std::int32_t deceleration) const {
   RIMO_TIMED_SCOPE("Motor::configureConstantSpeedPair");
-  setOperationMode(bus, 0, MotorOperationMode::Incremental);
-  setOperationMode(bus, 1, MotorOperationMode::Incremental);
-  setOperationFunction(bus, 0, MotorOperationFunction::SingleMotion);
-  setOperationFunction(bus, 1, MotorOperationFunction::SingleMotion);
-  setOperationSpeed(bus, 0, speedOp0);
-  setOperationSpeed(bus, 1, speedOp1);
-  setOperationAcceleration(bus, 0, acceleration);
-  setOperationAcceleration(bus, 1, acceleration);
-  setOperationDeceleration(bus, 0, deceleration);
-  setOperationDeceleration(bus, 1, deceleration);
+  // op0/op1 of each field are adjacent, so this is one FC16 per field.
+  batchWrites(bus, [&]() {
+    setOperationMode(bus, 0, MotorOperationMode::Incremental);
+    setOperationMode(bus, 1, MotorOperationMode::Incremental);
+    setOperationFunction(bus, 0, MotorOperationFunction::SingleMotion);
+    setOperationFunction(bus, 1, MotorOperationFunction::SingleMotion);
+    setOperationSpeed(bus, 0, speedOp0);
+    setOperationSpeed(bus, 1, speedOp1);
+    setOperationAcceleration(bus, 0, acceleration);
+    setOperationAcceleration(bus, 1, acceleration);
+    setOperationDeceleration(bus, 0, deceleration);
+    setOperationDeceleration(bus, 1, deceleration);
+  });
   setSelectedOperationId(bus, 0);
 }
 
@@ -782,38 +966,66 @@ MotorMonitorSnapshot Motor::readMonitorSnapshot(ModbusClient& bus) const {
   }
 
   selectSlave(bus, SlaveTarget::Device);
-  auto regs = bus.read_holding_registers(baseAddr, wordCount);
-  if (!regs || regs->size() != static_cast<std::size_t>(wordCount)) {
-    const auto reason = regs ? "Unexpected register count" : regs.error().message;
+  RegisterBlock block;
+  auto rc = bus.read_holding_registers(baseAddr, block.append(baseAddr, wordCount));
+  if (!rc || *rc != wordCount) {
+    const auto reason = rc ? "Unexpected register count" : rc.error().message;
     auto msg = std::format(
         "Motor {} (slave {}) read monitor snapshot 0x{:04X}-0x{:04X} failed: {}",
         magic_enum::enum_name(_id), _slaveAddress, baseAddr, lastAddr, reason);
     utl::throwRuntimeError(msg);
   }
+  return decodeMonitorSnapshot(block);
+}
 
-  const auto readI32At = [&](const int upperAddr) -> std::int32_t {
-    const auto idx = upperAddr - baseAddr;
-    if (idx < 0 || idx + 1 >= wordCount) {
-      utl::throwRuntimeError(std::format(
-          "Motor {} (slave {}) monitor snapshot index out of range for 0x{:04X}",
-          magic_enum::enum_name(_id), _slaveAddress, upperAddr));
-    }
-    const std::uint32_t raw =
-        (static_cast<std::uint32_t>((*regs)[static_cast<std::size_t>(idx)]) << 16) |
-        static_cast<std::uint32_t>((*regs)[static_cast<std::size_t>(idx + 1)]);
-    return static_cast<std::int32_t>(raw);
-  };
-
-  const auto idxD4 = _map.directIoAndBrakeStatus - baseAddr;
+MotorMonitorSnapshot Motor::decodeMonitorSnapshot(
+    const RegisterBlock& block) const {
+  const int baseAddr = _map.commandPosition;
+  const int lastAddr = _map.directIoAndBrakeStatus + 1;
+  if (!block.contains(baseAddr, lastAddr - baseAddr + 1)) {
+    utl::throwRuntimeError(std::format(
+        "Motor {} (slave {}) monitor snapshot 0x{:04X}-0x{:04X} not covered by "
+        "the register read plan",
+        magic_enum::enum_name(_id), _slaveAddress, baseAddr, lastAddr));
+  }
   return {
-      .commandPosition = readI32At(_map.commandPosition),
-      .actualSpeed = readI32At(_map.actualSpeed),
-      .actualPosition = readI32At(_map.actualPosition),
-      .reg00D4 = (*regs)[static_cast<std::size_t>(idxD4)],
-      .reg00D5 = (*regs)[static_cast<std::size_t>(idxD4 + 1)],
+      .commandPosition = block.i32(_map.commandPosition),
+      .actualSpeed = block.i32(_map.actualSpeed),
+      .actualPosition = block.i32(_map.actualPosition),
+      .reg00D4 = block.u16(_map.directIoAndBrakeStatus),
+      .reg00D5 = block.u16(_map.directIoAndBrakeStatus + 1),
   };
 }
 
+RegisterBlock Motor::readRegisterBlock(ModbusClient& bus,
+                                       const RegisterReadPlan& plan) const {
+  RegisterBlock block;
+  readRegisterBlock(bus, plan, block);
+  return block;
+}
+
+void Motor::readRegisterBlock(ModbusClient& bus, const RegisterReadPlan& plan,
+                              RegisterBlock& out) const {
+  RIMO_TIMED_SCOPE("Motor::readRegisterBlock");
+  out.clear();
+  if (plan.empty()) {
+    return;
+  }
+  selectSlave(bus, SlaveTarget::Device);
+  for (const auto& range : plan.ranges()) {
+    auto rc = bus.read_holding_registers(range.start,
+                                         out.append(range.start, range.count));
+    if (!rc || *rc != range.count) {
+      const auto reason = rc ? "Unexpected register count" : rc.error().message;
+      auto msg = std::format(
+          "Motor {} (slave {}) read registers 0x{:04X}+{} failed: {}",
+          magic_enum::enum_name(_id), _slaveAddress, range.start, range.count,
+          reason);
+      utl::throwRuntimeError(msg);
+    }
+  }
+}
+
 MotorDirectIoStatus Motor::decodeDirectIoAndBrakeStatus(
     const std::uint32_t raw) const {
   const auto reg00D4 = static_cast<std::uint16_t>((raw >> 16) & 0xFFFFu);
@@ -1162,21 +1374,22 @@ void Motor::resetAlarm(ModbusClient& bus) const {
   // Alarm reset is a 0->1 edge on 0x0180.
   writeInt32(bus, _map.alarmResetCommand, 0u, SlaveTarget::Device);
   writeInt32(bus, _map.alarmResetCommand, 1u, SlaveTarget::Device);
+  invalidateRegisterShadow();
 }
 
 std::uint16_t Motor::readDriverInputCommandRawCommandTarget(ModbusClient& bus) const {
   selectSlave(bus, SlaveTarget::Command);
-  auto regs = bus.read_holding_registers(_map.driverInputCommandLower, 1);
-  if (!regs || regs->size() != 1) {
-    const auto reason = regs ? "Unexpected register count" : regs.error().message;
+  std::array<std::uint16_t, 1> regs{};
+  auto rc = bus.read_holding_registers(_map.driverInputCommandLower, regs);
+  if (!rc || *rc != 1) {
+    const auto reason = rc ? "Unexpected register count" : rc.error().message;
     auto msg = std::format(
         "Motor {} (command slave {}) read command driver input raw failed: {}",
         magic_enum::enum_name(_id), _commandSlaveAddress, reason);
     utl::throwRuntimeError(msg);
   }
-  const auto raw = (*regs)[0];
-  _driverInputCommandRawCache = raw;
-  _selectedOperationIdCache = decodeOperationIdFromInputRawMapped(raw);
+  const auto raw = regs[0];
+  observeDriverInputCommandRaw(raw);
   return raw;
 }
 
@@ -0,0 +1,124 @@
+#include <MotorBusWorker.hpp>
+#include <ExceptionUtils.hpp>
+
+#include <Logger.hpp>
+
+#include <format>
+
+std::chrono::microseconds BusCycleUsage::total() const {
+  std::chrono::microseconds sum{0};
+  for (const auto value : used) {
+    sum += value;
+  }
+  return sum;
+}
+
+MotorBusWorker::MotorBusWorker(std::string name) : _name(std::move(name)) {}
+
+MotorBusWorker::~MotorBusWorker() {
+  try {
+    stop();
+  } catch (...) {
+    SPDLOG_ERROR("Unexpected exception while stopping motor bus worker '{}'.",
+                 _name);
+  }
+}
+
+void MotorBusWorker::start(std::function<void()> onThreadStart) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_running) {
+    return;
+  }
+  _running = true;
+  _thread = std::thread(&MotorBusWorker::loop, this, std::move(onThreadStart));
+  _threadId = _thread.get_id();
+}
+
+void MotorBusWorker::stop() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _running = false;
+  }
+  _cv.notify_all();
+  if (_thread.joinable()) {
+    _thread.join();
+  }
+  std::lock_guard<std::mutex> lock(_mutex);
+  _threadId = std::thread::id{};
+}
+
+bool MotorBusWorker::isRunning() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _running;
+}
+
+BusCycleUsage MotorBusWorker::beginCycle() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return std::exchange(_cycleUsage, BusCycleUsage{});
+}
+
+BusCycleUsage MotorBusWorker::cycleUsage() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _cycleUsage;
+}
+
+void MotorBusWorker::enqueue(const BusPriority priority,
+                             std::function<void()> job) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_running) {
+      utl::throwRuntimeError(
+          std::format("Motor bus worker '{}' is not running", _name));
+    }
+    _jobs[static_cast<std::size_t>(priority)].push_back(std::move(job));
+  }
+  _cv.notify_one();
+}
+
+bool MotorBusWorker::isWorkerThread() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _threadId == std::this_thread::get_id();
+}
+
+void MotorBusWorker::loop(const std::function<void()>& onThreadStart) {
+  if (onThreadStart) {
+    try {
+      onThreadStart();
+    } catch (const std::exception& e) {
+      SPDLOG_ERROR("Motor bus worker '{}' thread setup failed: {}", _name,
+                   e.what());
+    }
+  }
+  const auto nextQueue = [this]() -> std::size_t {
+    for (std::size_t i = 0; i < _jobs.size(); ++i) {
+      if (!_jobs[i].empty()) {
+        return i;
+      }
+    }
+    return _jobs.size();
+  };
+  while (true) {
+    std::function<void()> job;
+    std::size_t priority = 0;
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _cv.wait(lock, [this, &nextQueue]() {
+        return !_running || nextQueue() < _jobs.size();
+      });
+      priority = nextQueue();
+      if (priority == _jobs.size()) {
+        return;
+      }
+      job = std::move(_jobs[priority].front());
+      _jobs[priority].pop_front();
+    }
+    // packaged_task captures job exceptions into the caller's future.
+    const auto start = std::chrono::steady_clock::now();
+    job();
+    const auto elapsed =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+    std::lock_guard<std::mutex> lock(_mutex);
+    _cycleUsage.used[priority] += elapsed;
+  }
+}
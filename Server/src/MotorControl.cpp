@@ -4,13 +4,18 @@
 #include <ArKd2RegisterMap.hpp>
 #include <Config.hpp>
 #include <Logger.hpp>
+#include <SteadyClockAdapter.hpp>
 #include <TimingMetrics.hpp>
 #include <magic_enum/magic_enum.hpp>
+#include <algorithm>
 #include <cstdlib>
 #include <chrono>
+#include <exception>
 #include <format>
+#include <future>
 #include <string_view>
 #include <stdexcept>
+#include <utility>
 
 namespace {
 const Motor& requireMotor(const std::map<utl::EMotor, Motor>& motors,
@@ -44,9 +49,20 @@ void validateCurrentRange(const std::int32_t current, const std::string_view fie
 bool isTemporaryCommunicationFailure(const std::string_view message) {
   return message.find("Resource temporarily unavailable") != std::string_view::npos;
 }
+
+bool isResponseTimeout(const std::string_view message) {
+  return message.find("timed out") != std::string_view::npos;
+}
 }  // namespace
 
-MotorControl::MotorControl() {
+MotorControl::MotorControl()
+    : MotorControl(std::make_shared<SteadyClockAdapter>()) {}
+
+MotorControl::MotorControl(std::shared_ptr<IClock> clock)
+    : _clock(std::move(clock)) {
+  if (!_clock) {
+    utl::throwRuntimeError("MotorControl requires a non-null clock instance.");
+  }
   auto& cfg = utl::Config::instance();
   const auto model =
       cfg.getOptional<std::string>("MotorControl", "model", "AR-KD2");
@@ -56,53 +72,130 @@ MotorControl::MotorControl() {
     utl::throwRuntimeError(
         std::format("Unsupported MotorControl model '{}'", model));
   }
-  _rtuConfig.device.clear();
-  _rtuConfig.baud = 9600;
-  _rtuConfig.parity = 'N';
-  _rtuConfig.dataBits = 8;
-  _rtuConfig.stopBits = 1;
-  _rtuConfig.responseTimeoutMS =
+  MotorRtuConfig busDefaults;
+  busDefaults.responseTimeoutMS =
       cfg.getOptional<unsigned>("MotorControl", "responseTimeoutMS", 1000u);
-  _rtuConfig.connectTimeoutMS =
+  busDefaults.connectTimeoutMS =
       cfg.getOptional<unsigned>("MotorControl", "connectTimeoutMS", 1000u);
-  _rtuConfig.interRequestDelayMS =
+  busDefaults.interRequestDelayMS =
       cfg.getOptional<unsigned>("MotorControl", "interRequestDelayMS", 0u);
+  const auto cycleBudgetMS =
+      cfg.getOptional<double>("MotorControl", "busCycleBudgetMS", 0.0);
+  const auto pulseHoldMS = cfg.getOptional<int>("MotorControl", "pulseHoldMS", 30);
+  if (pulseHoldMS <= 0) {
+    utl::throwRuntimeError(std::format(
+        "MotorControl.pulseHoldMS must be > 0 (got {})", pulseHoldMS));
+  }
+  _pulseHold = std::chrono::milliseconds{pulseHoldMS};
+  _breakerTimeouts =
+      cfg.getOptional<unsigned>("MotorControl", "breakerTimeouts", 3u);
+  const auto breakerProbeMS =
+      cfg.getOptional<int>("MotorControl", "breakerProbeMS", 500);
+  const auto breakerProbeMaxMS =
+      cfg.getOptional<int>("MotorControl", "breakerProbeMaxMS", 8000);
+  if (breakerProbeMS <= 0 || breakerProbeMaxMS < breakerProbeMS) {
+    utl::throwRuntimeError(std::format(
+        "MotorControl.breakerProbeMS must be > 0 and <= breakerProbeMaxMS "
+        "(got {} and {})",
+        breakerProbeMS, breakerProbeMaxMS));
+  }
+  _breakerProbeMin = std::chrono::milliseconds{breakerProbeMS};
+  _breakerProbeMax = std::chrono::milliseconds{breakerProbeMaxMS};
   const auto globalForceFunction10ForSingleRegisterWrites =
       cfg.getOptional<bool>("MotorControl",
                             "forceFunction10ForSingleRegisterWrites", false);
 
   const auto motorCfg = cfg.getClassConfig("MotorControl");
-  const auto transportCfg = motorCfg["transport"];
-  if (!transportCfg || !transportCfg.IsMap()) {
-    utl::throwRuntimeError(
-        "MotorControl.transport map is required (type + tcp/serial settings).");
-  }
-  const auto type = transportCfg["type"].as<std::string>("rawTcpRtu");
-  if (type == "rawTcpRtu") {
-    _transportType = TransportType::RawTcpRtu;
-    const auto tcpCfg = transportCfg["tcp"];
-    if (!tcpCfg || !tcpCfg.IsMap()) {
-      utl::throwRuntimeError(
-          "MotorControl.transport.tcp is required for rawTcpRtu transport.");
-    }
-    _rawTcpConfig.host = tcpCfg["host"].as<std::string>();
-    _rawTcpConfig.port = tcpCfg["port"].as<int>();
-  } else if (type == "serialRtu") {
-    _transportType = TransportType::SerialRtu;
-    const auto serialCfg = transportCfg["serial"];
-    if (!serialCfg || !serialCfg.IsMap()) {
+  const auto parseBus = [this, &busDefaults, cycleBudgetMS](
+                            const YAML::Node& transportCfg, std::string name) {
+    MotorBusConfig bus;
+    bus.name = std::move(name);
+    bus.rtu = busDefaults;
+    const auto type = transportCfg["type"].as<std::string>("rawTcpRtu");
+    if (type == "rawTcpRtu") {
+      bus.type = TransportType::RawTcpRtu;
+      const auto tcpCfg = transportCfg["tcp"];
+      if (!tcpCfg || !tcpCfg.IsMap()) {
+        utl::throwRuntimeError(std::format(
+            "MotorControl.transport.tcp is required for rawTcpRtu transport "
+            "(bus '{}').",
+            bus.name));
+      }
+      bus.tcp.host = tcpCfg["host"].as<std::string>();
+      bus.tcp.port = tcpCfg["port"].as<int>();
+      // Baud of the RS-485 line behind the device server; only used to plan
+      // status reads, the gateway owns the actual serial settings.
+      bus.rtu.baud = tcpCfg["baud"].as<int>(bus.rtu.baud);
+    } else if (type == "serialRtu") {
+      bus.type = TransportType::SerialRtu;
+      const auto serialCfg = transportCfg["serial"];
+      if (!serialCfg || !serialCfg.IsMap()) {
+        utl::throwRuntimeError(std::format(
+            "MotorControl.transport.serial is required for serialRtu transport "
+            "(bus '{}').",
+            bus.name));
+      }
+      bus.rtu.device = serialCfg["device"].as<std::string>();
+      bus.rtu.baud = serialCfg["baud"].as<int>(9600);
+      const auto parity = serialCfg["parity"].as<std::string>("N");
+      bus.rtu.parity = parity.empty() ? 'N' : parity.front();
+      bus.rtu.dataBits = serialCfg["dataBits"].as<int>(8);
+      bus.rtu.stopBits = serialCfg["stopBits"].as<int>(1);
+    } else {
       utl::throwRuntimeError(
-          "MotorControl.transport.serial is required for serialRtu transport.");
-    }
-    _rtuConfig.device = serialCfg["device"].as<std::string>();
-    _rtuConfig.baud = serialCfg["baud"].as<int>(9600);
-    const auto parity = serialCfg["parity"].as<std::string>("N");
-    _rtuConfig.parity = parity.empty() ? 'N' : parity.front();
-    _rtuConfig.dataBits = serialCfg["dataBits"].as<int>(8);
-    _rtuConfig.stopBits = serialCfg["stopBits"].as<int>(1);
+          std::format("Unsupported MotorControl transport type '{}'", type));
+    }
+    // Per-bus timing overrides; a slow device server may need longer timeouts
+    // than the serial lines next to it.
+    bus.rtu.responseTimeoutMS = transportCfg["responseTimeoutMS"].as<unsigned>(
+        bus.rtu.responseTimeoutMS);
+    bus.rtu.connectTimeoutMS = transportCfg["connectTimeoutMS"].as<unsigned>(
+        bus.rtu.connectTimeoutMS);
+    bus.rtu.interRequestDelayMS =
+        transportCfg["interRequestDelayMS"].as<unsigned>(
+            bus.rtu.interRequestDelayMS);
+    const auto busBudgetMS =
+        transportCfg["cycleBudgetMS"].as<double>(cycleBudgetMS);
+    if (busBudgetMS < 0.0) {
+      utl::throwRuntimeError(std::format(
+          "MotorControl cycle budget must be >= 0 ms (bus '{}', got {})",
+          bus.name, busBudgetMS));
+    }
+    bus.cycleBudget = std::chrono::microseconds{
+        static_cast<std::int64_t>(busBudgetMS * 1000.0)};
+    bus.statusReadPlans = planStatusReads(_registerMap, bus.rtu);
+    return bus;
+  };
+
+  _busConfigs.clear();
+  const auto transportCfg = motorCfg["transport"];
+  if (transportCfg && transportCfg.IsMap()) {
+    // Legacy single-bus form: all motors share one line.
+    _busConfigs.push_back(parseBus(transportCfg, "default"));
+  } else if (transportCfg && transportCfg.IsSequence() &&
+             transportCfg.size() > 0) {
+    for (std::size_t i = 0; i < transportCfg.size(); ++i) {
+      const auto busCfg = transportCfg[i];
+      if (!busCfg.IsMap()) {
+        utl::throwRuntimeError(std::format(
+            "MotorControl.transport[{}] must be a map (name + type + "
+            "tcp/serial settings).",
+            i));
+      }
+      auto name = busCfg["name"].as<std::string>(std::format("bus{}", i));
+      for (const auto& existing : _busConfigs) {
+        if (existing.name == name) {
+          utl::throwRuntimeError(std::format(
+              "MotorControl.transport bus name '{}' is used more than once.",
+              name));
+        }
+      }
+      _busConfigs.push_back(parseBus(busCfg, std::move(name)));
+    }
   } else {
     utl::throwRuntimeError(
-        std::format("Unsupported MotorControl transport type '{}'", type));
+        "MotorControl.transport is required: either a map (type + tcp/serial "
+        "settings) or a non-empty list of such maps with a 'name' each.");
   }
 
   _motorConfigs.clear();
@@ -125,6 +218,24 @@ MotorControl::MotorControl() {
           "MotorControl.motors.{}.address must be in range 0..247 (got {})",
           magic_enum::enum_name(motorId), address));
     }
+    std::size_t busIndex = 0;
+    if (const auto busNode = entry["bus"]; busNode) {
+      const auto busName = busNode.as<std::string>();
+      const auto busIt = std::find_if(
+          _busConfigs.begin(), _busConfigs.end(),
+          [&busName](const auto& bus) { return bus.name == busName; });
+      if (busIt == _busConfigs.end()) {
+        utl::throwRuntimeError(std::format(
+            "MotorControl.motors.{}.bus refers to unknown bus '{}'",
+            magic_enum::enum_name(motorId), busName));
+      }
+      busIndex = static_cast<std::size_t>(busIt - _busConfigs.begin());
+    } else if (_busConfigs.size() > 1) {
+      utl::throwRuntimeError(std::format(
+          "MotorControl.motors.{}.bus is required when more than one "
+          "transport bus is configured.",
+          magic_enum::enum_name(motorId)));
+    }
     std::optional<int> commandAddress;
     if (const auto commandAddressNode = entry["commandAddress"]; commandAddressNode) {
       commandAddress = commandAddressNode.as<int>();
@@ -232,6 +343,7 @@ MotorControl::MotorControl() {
     }
     _motorConfigs[motorId] = MotorConfig{
         .address = address,
+        .bus = busIndex,
         .commandAddress = commandAddress,
         .groupId = groupId,
         .forceFunction10ForSingleRegisterWrites =
@@ -257,101 +369,371 @@ std::vector<utl::EMotor> MotorControl::configuredMotorIds() const {
   return ids;
 }
 
+std::vector<std::string> MotorControl::busNames() const {
+  std::vector<std::string> names;
+  names.reserve(_busConfigs.size());
+  for (const auto& bus : _busConfigs) {
+    names.push_back(bus.name);
+  }
+  return names;
+}
+
+std::string MotorControl::busNameFor(const utl::EMotor motorId) const {
+  const auto it = _motorConfigs.find(motorId);
+  if (it == _motorConfigs.end()) {
+    utl::throwRuntimeError(
+        std::format("Motor {} is not configured in MotorControl",
+                    magic_enum::enum_name(motorId)));
+  }
+  return _busConfigs.at(it->second.bus).name;
+}
+
+const MotorStatusReadPlans& MotorControl::statusReadPlans(
+    const utl::EMotor motorId) const {
+  const auto it = _motorConfigs.find(motorId);
+  if (it == _motorConfigs.end()) {
+    utl::throwRuntimeError(
+        std::format("Motor {} is not configured in MotorControl",
+                    magic_enum::enum_name(motorId)));
+  }
+  return _busConfigs.at(it->second.bus).statusReadPlans;
+}
+
+MotorStatusReadPlans MotorControl::planStatusReads(const MotorRegisterMap& map,
+                                                   const MotorRtuConfig& rtu) {
+  const auto model = RegisterReadCostModel::fromRtu(rtu);
+  const auto monitorWords =
+      map.directIoAndBrakeStatus + 2 - map.commandPosition;
+  return {
+      .status = RegisterReadPlanner(model)
+                    .require(map.driverOutputCommandLower)
+                    .require(map.commandPosition, monitorWords)
+                    .plan(),
+      .warning = RegisterReadPlanner(model).requireU32(map.presentWarning).plan(),
+      .alarm = RegisterReadPlanner(model).requireU32(map.presentAlarm).plan(),
+      .warningAndAlarm = RegisterReadPlanner(model)
+                             .requireU32(map.presentWarning)
+                             .requireU32(map.presentAlarm)
+                             .plan(),
+  };
+}
+
+ModbusClient MotorControl::openBusClient(const MotorBusConfig& config) {
+  ModbusResult<ModbusClient> busRes =
+      std::unexpected(ModbusError{EINVAL, "Motor transport is not configured"});
+  if (config.type == TransportType::SerialRtu) {
+    busRes = ModbusClient::rtu(config.rtu.device, config.rtu.baud,
+                               config.rtu.parity, config.rtu.dataBits,
+                               config.rtu.stopBits, 1);
+  } else {
+    busRes = ModbusClient::rtu_over_tcp(config.tcp.host, config.tcp.port, 1);
+  }
+  if (!busRes) {
+    auto msg = std::format("Failed to create motor bus client '{}': {}",
+                           config.name, busRes.error().message);
+    utl::throwRuntimeError(msg);
+  }
+  auto client = std::move(*busRes);
+  if (auto ct = client.set_connect_timeout(
+          std::chrono::milliseconds{config.rtu.connectTimeoutMS});
+      !ct) {
+    auto msg = std::format("Failed to set motor bus connect timeout: {}",
+                           ct.error().message);
+    utl::throwRuntimeError(msg);
+  }
+  if (auto c = client.connect(); !c) {
+    const auto endpoint =
+        config.type == TransportType::SerialRtu
+            ? config.rtu.device
+            : std::format("{}:{}", config.tcp.host, config.tcp.port);
+    auto msg = std::format("Failed to connect motor bus '{}' on '{}': {}",
+                           config.name, endpoint, c.error().message);
+    utl::throwRuntimeError(msg);
+  }
+  if (auto t = client.set_response_timeout(
+          std::chrono::milliseconds{config.rtu.responseTimeoutMS});
+      !t) {
+    auto msg = std::format("Failed to set RTU bus timeout: {}",
+                           t.error().message);
+    client.close();
+    utl::throwRuntimeError(msg);
+  }
+  if (auto d = client.set_inter_request_delay(
+          std::chrono::milliseconds{config.rtu.interRequestDelayMS});
+      !d) {
+    auto msg = std::format("Failed to set inter-request delay: {}",
+                           d.error().message);
+    client.close();
+    utl::throwRuntimeError(msg);
+  }
+  return client;
+}
+
+MotorControl::MotorBus& MotorControl::busFor(const utl::EMotor motorId) {
+  const auto cfgIt = _motorConfigs.find(motorId);
+  if (cfgIt == _motorConfigs.end() || cfgIt->second.bus >= _buses.size()) {
+    utl::throwRuntimeError("MotorControl bus is not initialized");
+  }
+  return *_buses[cfgIt->second.bus];
+}
+
+template <typename Fn>
+auto MotorControl::withBus(const utl::EMotor motorId, Fn&& fn) {
+  return withBus(motorId, BusPriority::Motion, std::forward<Fn>(fn));
+}
+
+template <typename Fn>
+auto MotorControl::withBus(const utl::EMotor motorId,
+                           const BusPriority priority, Fn&& fn) {
+  auto& bus = busFor(motorId);
+  if (priority == BusPriority::Diagnostics &&
+      linkState(motorId) != utl::EMotorLinkState::Online) {
+    utl::throwRuntimeError(std::format(
+        "Motor {} is not responding; its slave is skipped until a status "
+        "probe succeeds",
+        magic_enum::enum_name(motorId)));
+  }
+  const auto refuseMotionWhileStopped = [this, priority]() {
+    if (priority == BusPriority::Motion && emergencyStopActive()) {
+      utl::throwRuntimeError(
+          "Emergency stop is active; motion commands are refused until "
+          "MotorControl is re-initialized");
+    }
+  };
+  refuseMotionWhileStopped();
+  const Motor* staged = nullptr;
+  if (_batchingDriverInputs && priority == BusPriority::Motion) {
+    staged = &requireMotor(_motors, motorId);
+    if (std::ranges::find(_driverInputBatchBuses, &bus) ==
+        _driverInputBatchBuses.end()) {
+      _driverInputBatchBuses.push_back(&bus);
+    }
+  }
+  return bus.worker.run(priority, [this, &bus, &fn, staged,
+                                   &refuseMotionWhileStopped]() {
+    if (!bus.client) {
+      utl::throwRuntimeError("MotorControl bus is not initialized");
+    }
+    // Queued before the stop was latched.
+    refuseMotionWhileStopped();
+    if (staged) {
+      staged->stageDriverInputs();
+      if (std::ranges::find(bus.stagedInputMotors, staged) ==
+          bus.stagedInputMotors.end()) {
+        bus.stagedInputMotors.push_back(staged);
+      }
+    }
+    serviceDuePulses(bus);
+    return fn(*bus.client);
+  });
+}
+
+void MotorControl::schedulePulse(MotorBus& bus, ModbusClient& client,
+                                 const Motor& motor,
+                                 const MotorInputFlag flag) const {
+  const auto it = std::find_if(
+      bus.pendingPulses.begin(), bus.pendingPulses.end(),
+      [&](const PendingPulse& p) { return p.motor == &motor && p.flag == flag; });
+  if (it != bus.pendingPulses.end()) {
+    // Still high from the previous pulse: drop it first so the driver sees a
+    // fresh rising edge.
+    bus.pendingPulses.erase(it);
+    bus.pendingPulseCount.store(bus.pendingPulses.size(),
+                                std::memory_order_release);
+    motor.setDriverInputFlag(client, flag, false);
+  }
+  motor.setDriverInputFlag(client, flag, true);
+  bus.pendingPulses.push_back(PendingPulse{
+      .motor = &motor, .flag = flag, .deassertAt = _clock->now() + _pulseHold});
+  bus.pendingPulseCount.store(bus.pendingPulses.size(),
+                              std::memory_order_release);
+}
+
+void MotorControl::serviceDuePulses(MotorBus& bus) const {
+  if (bus.pendingPulses.empty() || !bus.client) {
+    return;
+  }
+  const auto now = _clock->now();
+  while (true) {
+    const auto due = std::find_if(
+        bus.pendingPulses.begin(), bus.pendingPulses.end(),
+        [now](const PendingPulse& p) { return p.deassertAt <= now; });
+    if (due == bus.pendingPulses.end()) {
+      break;
+    }
+    const auto pulse = *due;
+    // Forget the pulse before writing; a failed write closes the bus anyway.
+    bus.pendingPulses.erase(due);
+    bus.pendingPulseCount.store(bus.pendingPulses.size(),
+                                std::memory_order_release);
+    pulse.motor->setDriverInputFlag(*bus.client, pulse.flag, false);
+  }
+}
+
+void MotorControl::finishDriverInputBatch(const bool commit) {
+  std::exception_ptr firstError;
+  for (auto* bus : std::exchange(_driverInputBatchBuses, {})) {
+    try {
+      bus->worker.run([this, bus, commit]() {
+        const auto motors = std::exchange(bus->stagedInputMotors, {});
+        for (std::size_t i = 0; i < motors.size(); ++i) {
+          if (!commit || !bus->client || emergencyStopActive()) {
+            motors[i]->discardStagedDriverInputs();
+            continue;
+          }
+          try {
+            motors[i]->commitDriverInputs(*bus->client);
+          } catch (...) {
+            for (auto j = i + 1; j < motors.size(); ++j) {
+              motors[j]->discardStagedDriverInputs();
+            }
+            throw;
+          }
+        }
+      });
+    } catch (...) {
+      if (!firstError) {
+        firstError = std::current_exception();
+      }
+    }
+  }
+  if (firstError) {
+    std::rethrow_exception(firstError);
+  }
+}
+
+void MotorControl::closeBus(MotorBus& bus) {
+  const auto close = [&bus]() {
+    if (bus.client) {
+      bus.client->close();
+      bus.client.reset();
+    }
+    for (const auto* motor : std::exchange(bus.stagedInputMotors, {})) {
+      motor->discardStagedDriverInputs();
+    }
+    // The device state is unknown after a reconnect; initialize() rewrites
+    // the driver input word anyway.
+    bus.pendingPulses.clear();
+    bus.pendingPulseCount.store(0, std::memory_order_release);
+  };
+  if (bus.worker.isRunning()) {
+    bus.worker.run(close);
+  } else {
+    close();
+  }
+}
+
+void MotorControl::closeAllBuses() {
+  _driverInputBatchBuses.clear();
+  for (auto& bus : _buses) {
+    closeBus(*bus);
+    bus->worker.stop();
+  }
+  _buses.clear();
+}
+
 void MotorControl::initialize() {
+  std::lock_guard<std::mutex> lifecycleLock(_lifecycleMutex);
+  // Re-initializing is how an emergency stop is released: every drive gets
+  // its STOP input cleared below.
+  const bool releaseStop = emergencyStopActive();
+  closeAllBuses();
   _motors.clear();
   _runtime.clear();
+  {
+    std::lock_guard<std::mutex> lock(_breakerMutex);
+    _breakers.clear();
+  }
   try {
-    ModbusResult<ModbusClient> busRes =
-        std::unexpected(ModbusError{EINVAL, "Motor transport is not configured"});
-    if (_transportType == TransportType::SerialRtu) {
-      busRes = ModbusClient::rtu(_rtuConfig.device, _rtuConfig.baud,
-                                 _rtuConfig.parity, _rtuConfig.dataBits,
-                                 _rtuConfig.stopBits, 1);
-    } else {
-      busRes = ModbusClient::rtu_over_tcp(_rawTcpConfig.host, _rawTcpConfig.port,
-                                          1);
-    }
-    if (!busRes) {
-      auto msg = std::format("Failed to create motor bus client: {}",
-                             busRes.error().message);
-      utl::throwRuntimeError(msg);
-    }
-    _bus.emplace(std::move(*busRes));
-    if (auto ct = _bus->set_connect_timeout(
-            std::chrono::milliseconds{_rtuConfig.connectTimeoutMS});
-        !ct) {
-      auto msg = std::format("Failed to set motor bus connect timeout: {}",
-                             ct.error().message);
-      _bus.reset();
-      utl::throwRuntimeError(msg);
-    }
-    if (auto c = _bus->connect(); !c) {
-      const auto endpoint =
-          _transportType == TransportType::SerialRtu
-              ? _rtuConfig.device
-              : std::format("{}:{}", _rawTcpConfig.host, _rawTcpConfig.port);
-      auto msg = std::format("Failed to connect motor bus on '{}': {}",
-                             endpoint, c.error().message);
-      _bus.reset();
-      utl::throwRuntimeError(msg);
-    }
-    if (auto t = _bus->set_response_timeout(
-            std::chrono::milliseconds{_rtuConfig.responseTimeoutMS});
-        !t) {
-      auto msg = std::format("Failed to set RTU bus timeout: {}",
-                             t.error().message);
-      _bus->close();
-      _bus.reset();
-      utl::throwRuntimeError(msg);
-    }
-    if (auto d = _bus->set_inter_request_delay(
-            std::chrono::milliseconds{_rtuConfig.interRequestDelayMS});
-        !d) {
-      auto msg = std::format("Failed to set inter-request delay: {}",
-                             d.error().message);
-      _bus->close();
-      _bus.reset();
-      utl::throwRuntimeError(msg);
+    for (const auto& busConfig : _busConfigs) {
+      auto bus = std::make_unique<MotorBus>(busConfig.name);
+      // Keep the bus registered before connecting so a failure below still
+      // gets its worker stopped by closeAllBuses().
+      _buses.push_back(std::move(bus));
+      _buses.back()->client.emplace(openBusClient(busConfig));
+      _buses.back()->client->set_traffic_stats(&_buses.back()->traffic);
+      if (_busThreadSetup) {
+        _buses.back()->worker.start(
+            [setup = _busThreadSetup, bus = busConfig.name]() { setup(bus); });
+      } else {
+        _buses.back()->worker.start();
+      }
+      SPDLOG_INFO("MotorControl bus '{}' status reads: {}", busConfig.name,
+                  busConfig.statusReadPlans.status.describe());
+      if (busConfig.cycleBudget.count() > 0) {
+        SPDLOG_INFO("MotorControl bus '{}' cycle budget: {:.1f} ms",
+                    busConfig.name, busConfig.cycleBudget.count() / 1000.0);
+      }
     }
 
     for (const auto& [motorId, motorCfg] : _motorConfigs) {
-      auto [it, inserted] = _motors.emplace(
+      _motors.emplace(
           motorId,
           Motor(motorId, motorCfg.address, _registerMap,
                 motorCfg.commandAddress.value_or(motorCfg.address),
                 motorCfg.forceFunction10ForSingleRegisterWrites.value_or(false)));
-      (void)inserted;
       _runtime.emplace(motorId, MotorRuntimeState{});
-      {
-        std::lock_guard<std::mutex> lock(_busMutex);
-        it->second.initialize(*_bus);
-        applyConfiguredParameters(it->second, motorCfg, *_bus);
-        const auto inputRaw = it->second.readDriverInputCommandRaw(*_bus);
-        const auto outputRaw = it->second.readDriverOutputStatusRaw(*_bus);
-        const bool hasAlarm =
-            Motor::isDriverOutputFlagSet(outputRaw, MotorOutputFlag::Alarm);
-        const auto remoteIoStatus =
-            it->second.decodeRemoteIoStatus(inputRaw, outputRaw);
-        const auto cOnIt = std::find_if(
-            remoteIoStatus.inputAssignments.begin(),
-            remoteIoStatus.inputAssignments.end(),
-            [](const auto& assignment) { return assignment.functionCode == 17u; });
-        const bool cOnDefined =
-            cOnIt != remoteIoStatus.inputAssignments.end();
-        const bool cOnActive = cOnDefined ? cOnIt->active : true;
-        auto runtimeIt = _runtime.find(motorId);
-        runtimeIt->second.enableControllable = cOnDefined;
-        // Initialize runtime enabled state from actual startup C-ON + alarm state.
-        runtimeIt->second.enabled = !hasAlarm && cOnActive;
+    }
+
+    // Bring up every bus concurrently; motors sharing a bus are initialized
+    // in order on that bus' worker.
+    std::vector<std::future<void>> pending;
+    pending.reserve(_buses.size());
+    for (std::size_t busIndex = 0; busIndex < _buses.size(); ++busIndex) {
+      auto& bus = *_buses[busIndex];
+      pending.push_back(bus.worker.submit([this, &bus, busIndex,
+                                           releaseStop]() {
+        for (const auto& [motorId, motorCfg] : _motorConfigs) {
+          if (motorCfg.bus != busIndex) {
+            continue;
+          }
+          const auto& motor = _motors.at(motorId);
+          auto& runtime = _runtime.at(motorId);
+          motor.initialize(*bus.client);
+          applyConfiguredParameters(motor, motorCfg, *bus.client);
+          if (releaseStop) {
+            motor.setDriverInputFlag(*bus.client, MotorInputFlag::Stop, false);
+          }
+          const auto inputRaw = motor.readDriverInputCommandRaw(*bus.client);
+          const auto outputRaw = motor.readDriverOutputStatusRaw(*bus.client);
+          const bool hasAlarm =
+              Motor::isDriverOutputFlagSet(outputRaw, MotorOutputFlag::Alarm);
+          const auto remoteIoStatus =
+              motor.decodeRemoteIoStatus(inputRaw, outputRaw);
+          const auto cOnIt = std::find_if(
+              remoteIoStatus.inputAssignments.begin(),
+              remoteIoStatus.inputAssignments.end(),
+              [](const auto& assignment) { return assignment.functionCode == 17u; });
+          const bool cOnDefined =
+              cOnIt != remoteIoStatus.inputAssignments.end();
+          const bool cOnActive = cOnDefined ? cOnIt->active : true;
+          runtime.enableControllable = cOnDefined;
+          // Initialize runtime enabled state from actual startup C-ON + alarm state.
+          runtime.enabled = !hasAlarm && cOnActive;
+        }
+      }));
+    }
+    std::exception_ptr firstFailure;
+    for (auto& future : pending) {
+      try {
+        future.get();
+      } catch (...) {
+        if (!firstFailure) {
+          firstFailure = std::current_exception();
+        }
       }
     }
+    if (firstFailure) {
+      std::rethrow_exception(firstFailure);
+    }
+    if (releaseStop) {
+      SPDLOG_WARN("Emergency stop released; STOP cleared on all drives");
+      _emergencyStopActive.store(false, std::memory_order_release);
+    }
     setState(State::Normal);
   } catch (const std::exception& e) {
     SPDLOG_ERROR("MotorControl initialize failed: {}", e.what());
-    if (_bus) {
-      _bus->close();
-      _bus.reset();
-    }
+    closeAllBuses();
     _motors.clear();
     _runtime.clear();
     setState(State::Error);
@@ -361,15 +743,149 @@ void MotorControl::initialize() {
 
 void MotorControl::reset() {
   SPDLOG_INFO("Resetting MotorControl component.");
-  if (_bus) {
-    _bus->close();
-    _bus.reset();
-  }
+  std::lock_guard<std::mutex> lifecycleLock(_lifecycleMutex);
+  closeAllBuses();
   _motors.clear();
   _runtime.clear();
+  {
+    std::lock_guard<std::mutex> lock(_breakerMutex);
+    _breakers.clear();
+  }
   setState(State::Error);
 }
 
+EmergencyStopReport MotorControl::emergencyStop(
+    const std::chrono::steady_clock::time_point requestedAt) {
+  RIMO_TIMED_SCOPE("MotorControl::emergencyStop");
+  // Latched before anything else so motion queued from now on is refused
+  // even while initialize() still holds the lifecycle lock.
+  _emergencyStopActive.store(true, std::memory_order_release);
+  std::lock_guard<std::mutex> lifecycleLock(_lifecycleMutex);
+  _emergencyStopActive.store(true, std::memory_order_release);
+
+  EmergencyStopReport report;
+  std::vector<std::future<BusStopOutcome>> pending;
+  pending.reserve(_buses.size());
+  for (std::size_t busIndex = 0; busIndex < _buses.size(); ++busIndex) {
+    std::vector<std::pair<utl::EMotor, const Motor*>> motors;
+    for (const auto& [motorId, motorCfg] : _motorConfigs) {
+      if (motorCfg.bus != busIndex) {
+        continue;
+      }
+      if (const auto it = _motors.find(motorId); it != _motors.end()) {
+        motors.emplace_back(motorId, &it->second);
+      } else {
+        report.unconfirmed.push_back(motorId);
+      }
+    }
+    auto& bus = *_buses[busIndex];
+    bus.stopPending.store(true, std::memory_order_release);
+    pending.push_back(bus.worker.submit(
+        BusPriority::EmergencyStop,
+        [this, &bus, motors = std::move(motors)]() {
+          return stopBus(bus, motors);
+        }));
+  }
+  if (_buses.empty()) {
+    report.unconfirmed = configuredMotorIds();
+  }
+
+  std::optional<std::chrono::steady_clock::time_point> firstFrameAt;
+  auto confirmedAt = requestedAt;
+  for (auto& future : pending) {
+    const auto outcome = future.get();
+    if (outcome.firstFrameAt &&
+        (!firstFrameAt || *outcome.firstFrameAt < *firstFrameAt)) {
+      firstFrameAt = outcome.firstFrameAt;
+    }
+    confirmedAt = std::max(confirmedAt, outcome.confirmedAt);
+    report.broadcastBuses += outcome.broadcast ? 1 : 0;
+    report.unconfirmed.insert(report.unconfirmed.end(),
+                              outcome.unconfirmed.begin(),
+                              outcome.unconfirmed.end());
+  }
+  const auto since = [requestedAt](const auto at) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(at -
+                                                                 requestedAt);
+  };
+  report.toFirstFrame = since(firstFrameAt.value_or(confirmedAt));
+  report.toAllConfirmed = since(confirmedAt);
+  SPDLOG_WARN(
+      "Emergency stop: first stop frame after {} us, drives confirmed after "
+      "{} us ({} of {} buses broadcast, {} drives unconfirmed)",
+      report.toFirstFrame.count(), report.toAllConfirmed.count(),
+      report.broadcastBuses, _buses.size(), report.unconfirmed.size());
+  {
+    std::lock_guard<std::mutex> lock(_emergencyStopReportMutex);
+    _lastEmergencyStop = report;
+  }
+  return report;
+}
+
+std::optional<EmergencyStopReport> MotorControl::lastEmergencyStop() const {
+  std::lock_guard<std::mutex> lock(_emergencyStopReportMutex);
+  return _lastEmergencyStop;
+}
+
+MotorControl::BusStopOutcome MotorControl::stopBus(
+    MotorBus& bus,
+    const std::vector<std::pair<utl::EMotor, const Motor*>>& motors) {
+  BusStopOutcome outcome;
+  const auto frameSent = [&outcome]() {
+    if (!outcome.firstFrameAt) {
+      outcome.firstFrameAt = std::chrono::steady_clock::now();
+    }
+  };
+  // A pending pulse deassert must not clear the STOP written below.
+  bus.pendingPulses.clear();
+  bus.pendingPulseCount.store(0, std::memory_order_release);
+  for (const auto* motor : std::exchange(bus.stagedInputMotors, {})) {
+    motor->discardStagedDriverInputs();
+  }
+
+  if (bus.client && !motors.empty()) {
+    auto word = motors.front().second->broadcastStopWord();
+    for (const auto& [motorId, motor] : motors) {
+      if (word != motor->broadcastStopWord()) {
+        word.reset();
+        break;
+      }
+    }
+    if (word) {
+      const auto sent = bus.client->broadcast_write_register(
+          motors.front().second->map().driverInputCommandLower, *word);
+      if (sent) {
+        frameSent();
+        outcome.broadcast = true;
+      } else {
+        SPDLOG_ERROR(
+            "Emergency stop broadcast on bus '{}' failed: {}; stopping the "
+            "drives one by one",
+            bus.worker.name(), sent.error().message);
+      }
+    }
+  }
+
+  for (const auto& [motorId, motor] : motors) {
+    // An offline slave would only burn a response timeout per attempt.
+    if (!bus.client || linkState(motorId) != utl::EMotorLinkState::Online) {
+      outcome.unconfirmed.push_back(motorId);
+      continue;
+    }
+    try {
+      motor->applyEmergencyStop(*bus.client);
+      frameSent();
+    } catch (const std::exception& e) {
+      SPDLOG_ERROR("Emergency stop of motor {} not confirmed: {}",
+                   magic_enum::enum_name(motorId), e.what());
+      outcome.unconfirmed.push_back(motorId);
+    }
+  }
+  outcome.confirmedAt = std::chrono::steady_clock::now();
+  bus.stopPending.store(false, std::memory_order_release);
+  return outcome;
+}
+
 void MotorControl::setMode(const utl::EMotor motorId, const MotorControlMode mode) {
   RIMO_TIMED_SCOPE("MotorControl::setMode");
   const auto& motor = requireMotor(_motors, motorId);
@@ -380,27 +896,29 @@ void MotorControl::setMode(const utl::EMotor motorId, const MotorControlMode mod
         magic_enum::enum_name(motorId)));
   }
   auto& runtime = rtIt->second;
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-
-  runtime.mode = mode;
-  if (mode == MotorControlMode::Speed) {
-    if (!runtime.speedPairPrepared) {
-      motor.configureConstantSpeedPair(*_bus, runtime.speed, runtime.speed,
-                                       runtime.acceleration,
-                                       runtime.deceleration);
-      runtime.speedPairPrepared = true;
-    }
-  } else {
-    if (!runtime.positionPrepared) {
-      motor.setOperationMode(*_bus, 2, MotorOperationMode::Incremental);
-      motor.setOperationFunction(*_bus, 2, MotorOperationFunction::SingleMotion);
-      motor.setOperationSpeed(*_bus, 2, runtime.speed);
-      motor.setOperationAcceleration(*_bus, 2, runtime.acceleration);
-      motor.setOperationDeceleration(*_bus, 2, runtime.deceleration);
-      runtime.positionPrepared = true;
+  withBus(motorId, [&](ModbusClient& bus) {
+    runtime.mode = mode;
+    if (mode == MotorControlMode::Speed) {
+      if (!runtime.speedPairPrepared) {
+        motor.configureConstantSpeedPair(bus, runtime.speed, runtime.speed,
+                                         runtime.acceleration,
+                                         runtime.deceleration);
+        runtime.speedPairPrepared = true;
+      }
+    } else {
+      if (!runtime.positionPrepared) {
+        motor.batchWrites(bus, [&]() {
+          motor.setOperationMode(bus, 2, MotorOperationMode::Incremental);
+          motor.setOperationFunction(bus, 2,
+                                     MotorOperationFunction::SingleMotion);
+          motor.setOperationSpeed(bus, 2, runtime.speed);
+          motor.setOperationAcceleration(bus, 2, runtime.acceleration);
+          motor.setOperationDeceleration(bus, 2, runtime.deceleration);
+        });
+        runtime.positionPrepared = true;
+      }
     }
-  }
+  });
 }
 
 void MotorControl::setSpeed(const utl::EMotor motorId, const std::int32_t speed) {
@@ -414,19 +932,18 @@ void MotorControl::setSpeed(const utl::EMotor motorId, const std::int32_t speed)
   }
   auto& runtime = rtIt->second;
   runtime.speed = std::abs(speed);
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-
-  if (runtime.mode == MotorControlMode::Speed) {
-    if (!runtime.speedPairPrepared) {
-      motor.configureConstantSpeedPair(*_bus, runtime.speed, runtime.speed,
-                                       runtime.acceleration,
-                                       runtime.deceleration);
-      runtime.speedPairPrepared = true;
-    } else {
-      motor.updateConstantSpeedBuffered(*_bus, runtime.speed);
+  withBus(motorId, [&](ModbusClient& bus) {
+    if (runtime.mode == MotorControlMode::Speed) {
+      if (!runtime.speedPairPrepared) {
+        motor.configureConstantSpeedPair(bus, runtime.speed, runtime.speed,
+                                         runtime.acceleration,
+                                         runtime.deceleration);
+        runtime.speedPairPrepared = true;
+      } else {
+        motor.updateConstantSpeedBuffered(bus, runtime.speed);
+      }
     }
-  }
+  });
 }
 
 void MotorControl::setAcceleration(const utl::EMotor motorId,
@@ -444,16 +961,18 @@ void MotorControl::setAcceleration(const utl::EMotor motorId,
     return;
   }
   runtime.acceleration = acceleration;
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-
-  if (runtime.speedPairPrepared) {
-    motor.setOperationAcceleration(*_bus, 0, runtime.acceleration);
-    motor.setOperationAcceleration(*_bus, 1, runtime.acceleration);
-  }
-  if (runtime.positionPrepared) {
-    motor.setOperationAcceleration(*_bus, 2, runtime.acceleration);
-  }
+  withBus(motorId, [&](ModbusClient& bus) {
+    // op0..op2 are adjacent: a single FC16 covers whichever are prepared.
+    motor.batchWrites(bus, [&]() {
+      if (runtime.speedPairPrepared) {
+        motor.setOperationAcceleration(bus, 0, runtime.acceleration);
+        motor.setOperationAcceleration(bus, 1, runtime.acceleration);
+      }
+      if (runtime.positionPrepared) {
+        motor.setOperationAcceleration(bus, 2, runtime.acceleration);
+      }
+    });
+  });
 }
 
 void MotorControl::setDeceleration(const utl::EMotor motorId,
@@ -471,16 +990,18 @@ void MotorControl::setDeceleration(const utl::EMotor motorId,
     return;
   }
   runtime.deceleration = deceleration;
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-
-  if (runtime.speedPairPrepared) {
-    motor.setOperationDeceleration(*_bus, 0, runtime.deceleration);
-    motor.setOperationDeceleration(*_bus, 1, runtime.deceleration);
-  }
-  if (runtime.positionPrepared) {
-    motor.setOperationDeceleration(*_bus, 2, runtime.deceleration);
-  }
+  withBus(motorId, [&](ModbusClient& bus) {
+    // op0..op2 are adjacent: a single FC16 covers whichever are prepared.
+    motor.batchWrites(bus, [&]() {
+      if (runtime.speedPairPrepared) {
+        motor.setOperationDeceleration(bus, 0, runtime.deceleration);
+        motor.setOperationDeceleration(bus, 1, runtime.deceleration);
+      }
+      if (runtime.positionPrepared) {
+        motor.setOperationDeceleration(bus, 2, runtime.deceleration);
+      }
+    });
+  });
 }
 
 void MotorControl::setPosition(const utl::EMotor motorId,
@@ -495,20 +1016,22 @@ void MotorControl::setPosition(const utl::EMotor motorId,
   }
   auto& runtime = rtIt->second;
   runtime.position = position;
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-
-  if (runtime.mode == MotorControlMode::Position) {
-    if (!runtime.positionPrepared) {
-      motor.setOperationMode(*_bus, 2, MotorOperationMode::Incremental);
-      motor.setOperationFunction(*_bus, 2, MotorOperationFunction::SingleMotion);
-      motor.setOperationSpeed(*_bus, 2, runtime.speed);
-      motor.setOperationAcceleration(*_bus, 2, runtime.acceleration);
-      motor.setOperationDeceleration(*_bus, 2, runtime.deceleration);
-      runtime.positionPrepared = true;
+  withBus(motorId, [&](ModbusClient& bus) {
+    if (runtime.mode == MotorControlMode::Position) {
+      if (!runtime.positionPrepared) {
+        motor.batchWrites(bus, [&]() {
+          motor.setOperationMode(bus, 2, MotorOperationMode::Incremental);
+          motor.setOperationFunction(bus, 2,
+                                     MotorOperationFunction::SingleMotion);
+          motor.setOperationSpeed(bus, 2, runtime.speed);
+          motor.setOperationAcceleration(bus, 2, runtime.acceleration);
+          motor.setOperationDeceleration(bus, 2, runtime.deceleration);
+        });
+        runtime.positionPrepared = true;
+      }
+      motor.setOperationPosition(bus, 2, runtime.position);
     }
-    motor.setOperationPosition(*_bus, 2, runtime.position);
-  }
+  });
 }
 
 void MotorControl::setDirection(const utl::EMotor motorId,
@@ -523,16 +1046,15 @@ void MotorControl::setDirection(const utl::EMotor motorId,
   }
   auto& runtime = rtIt->second;
   runtime.direction = direction;
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-
-  if (direction == MotorControlDirection::Forward) {
-    motor.setReverse(*_bus, false);
-    motor.setForward(*_bus, true);
-  } else {
-    motor.setForward(*_bus, false);
-    motor.setReverse(*_bus, true);
-  }
+  withBus(motorId, [&](ModbusClient& bus) {
+    if (direction == MotorControlDirection::Forward) {
+      motor.setReverse(bus, false);
+      motor.setForward(bus, true);
+    } else {
+      motor.setForward(bus, false);
+      motor.setReverse(bus, true);
+    }
+  });
 }
 
 void MotorControl::startMovement(const utl::EMotor motorId) {
@@ -550,37 +1072,39 @@ void MotorControl::startMovement(const utl::EMotor motorId) {
                 magic_enum::enum_name(motorId));
     return;
   }
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-
-  if (runtime.mode == MotorControlMode::Speed) {
-    if (!runtime.speedPairPrepared) {
-      motor.configureConstantSpeedPair(*_bus, runtime.speed, runtime.speed,
-                                       runtime.acceleration,
-                                       runtime.deceleration);
-      runtime.speedPairPrepared = true;
-    }
-    if (runtime.direction == MotorControlDirection::Forward) {
-      motor.setReverse(*_bus, false);
-      motor.setForward(*_bus, true);
+  withBus(motorId, [&](ModbusClient& bus) {
+    if (runtime.mode == MotorControlMode::Speed) {
+      if (!runtime.speedPairPrepared) {
+        motor.configureConstantSpeedPair(bus, runtime.speed, runtime.speed,
+                                         runtime.acceleration,
+                                         runtime.deceleration);
+        runtime.speedPairPrepared = true;
+      }
+      if (runtime.direction == MotorControlDirection::Forward) {
+        motor.setReverse(bus, false);
+        motor.setForward(bus, true);
+      } else {
+        motor.setForward(bus, false);
+        motor.setReverse(bus, true);
+      }
+      return;
     } else {
-      motor.setForward(*_bus, false);
-      motor.setReverse(*_bus, true);
-    }
-    return;
-  } else {
-    if (!runtime.positionPrepared) {
-      motor.setOperationMode(*_bus, 2, MotorOperationMode::Incremental);
-      motor.setOperationFunction(*_bus, 2, MotorOperationFunction::SingleMotion);
-      motor.setOperationSpeed(*_bus, 2, runtime.speed);
-      motor.setOperationAcceleration(*_bus, 2, runtime.acceleration);
-      motor.setOperationDeceleration(*_bus, 2, runtime.deceleration);
-      runtime.positionPrepared = true;
+      if (!runtime.positionPrepared) {
+        motor.batchWrites(bus, [&]() {
+          motor.setOperationMode(bus, 2, MotorOperationMode::Incremental);
+          motor.setOperationFunction(bus, 2,
+                                     MotorOperationFunction::SingleMotion);
+          motor.setOperationSpeed(bus, 2, runtime.speed);
+          motor.setOperationAcceleration(bus, 2, runtime.acceleration);
+          motor.setOperationDeceleration(bus, 2, runtime.deceleration);
+        });
+        runtime.positionPrepared = true;
+      }
+      motor.setOperationPosition(bus, 2, runtime.position);
+      motor.setSelectedOperationId(bus, 2);
     }
-    motor.setOperationPosition(*_bus, 2, runtime.position);
-    motor.setSelectedOperationId(*_bus, 2);
-  }
-  motor.pulseStart(*_bus);
+    schedulePulse(busFor(motorId), bus, motor, MotorInputFlag::Start);
+  });
 }
 
 void MotorControl::stopMovement(const utl::EMotor motorId) {
@@ -593,16 +1117,16 @@ void MotorControl::stopMovement(const utl::EMotor motorId) {
         magic_enum::enum_name(motorId)));
   }
   const auto& runtime = rtIt->second;
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-  if (runtime.mode == MotorControlMode::Speed) {
-    // AR-KD2 speed mode: stop by deasserting direction bits only.
-    // Do not clear the whole register because that would overwrite C-ON and other inputs.
-    motor.setForward(*_bus, false);
-    motor.setReverse(*_bus, false);
-    return;
-  }
-  motor.pulseStop(*_bus);
+  withBus(motorId, [&](ModbusClient& bus) {
+    if (runtime.mode == MotorControlMode::Speed) {
+      // AR-KD2 speed mode: stop by deasserting direction bits only.
+      // Do not clear the whole register because that would overwrite C-ON and other inputs.
+      motor.setForward(bus, false);
+      motor.setReverse(bus, false);
+      return;
+    }
+    schedulePulse(busFor(motorId), bus, motor, MotorInputFlag::Stop);
+  });
 }
 
 void MotorControl::pulseStart(const utl::EMotor motorId) {
@@ -618,23 +1142,53 @@ void MotorControl::pulseStart(const utl::EMotor motorId) {
                 magic_enum::enum_name(motorId));
     return;
   }
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-  motor.pulseStart(*_bus);
+  withBus(motorId, [&](ModbusClient& bus) {
+    schedulePulse(busFor(motorId), bus, motor, MotorInputFlag::Start);
+  });
 }
 
 void MotorControl::pulseStop(const utl::EMotor motorId) {
   const auto& motor = requireMotor(_motors, motorId);
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-  motor.pulseStop(*_bus);
+  withBus(motorId, [&](ModbusClient& bus) {
+    schedulePulse(busFor(motorId), bus, motor, MotorInputFlag::Stop);
+  });
 }
 
 void MotorControl::pulseHome(const utl::EMotor motorId) {
   const auto& motor = requireMotor(_motors, motorId);
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-  motor.pulseHome(*_bus);
+  withBus(motorId, [&](ModbusClient& bus) {
+    schedulePulse(busFor(motorId), bus, motor, MotorInputFlag::Home);
+  });
+}
+
+void MotorControl::servicePulses() {
+  RIMO_TIMED_SCOPE("MotorControl::servicePulses");
+  for (auto& bus : _buses) {
+    if (bus->pendingPulseCount.load(std::memory_order_acquire) == 0 ||
+        !bus->worker.isRunning()) {
+      continue;
+    }
+    auto& busRef = *bus;
+    busRef.worker.run([this, &busRef]() { serviceDuePulses(busRef); });
+  }
+}
+
+void MotorControl::batchDriverInputs(const std::function<void()>& fn) {
+  RIMO_TIMED_SCOPE("MotorControl::batchDriverInputs");
+  _batchingDriverInputs = true;
+  try {
+    fn();
+  } catch (...) {
+    _batchingDriverInputs = false;
+    try {
+      finishDriverInputBatch(false);
+    } catch (const std::exception& e) {
+      SPDLOG_WARN("Dropping staged driver inputs failed: {}", e.what());
+    }
+    throw;
+  }
+  _batchingDriverInputs = false;
+  finishDriverInputBatch(true);
 }
 
 void MotorControl::setForward(const utl::EMotor motorId, const bool enabled) {
@@ -650,9 +1204,7 @@ void MotorControl::setForward(const utl::EMotor motorId, const bool enabled) {
                 magic_enum::enum_name(motorId));
     return;
   }
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-  motor.setForward(*_bus, enabled);
+  withBus(motorId, [&](ModbusClient& bus) { motor.setForward(bus, enabled); });
 }
 
 void MotorControl::setReverse(const utl::EMotor motorId, const bool enabled) {
@@ -668,9 +1220,7 @@ void MotorControl::setReverse(const utl::EMotor motorId, const bool enabled) {
                 magic_enum::enum_name(motorId));
     return;
   }
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-  motor.setReverse(*_bus, enabled);
+  withBus(motorId, [&](ModbusClient& bus) { motor.setReverse(bus, enabled); });
 }
 
 void MotorControl::setJogPlus(const utl::EMotor motorId, const bool enabled) {
@@ -686,9 +1236,7 @@ void MotorControl::setJogPlus(const utl::EMotor motorId, const bool enabled) {
                 magic_enum::enum_name(motorId));
     return;
   }
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-  motor.setJogPlus(*_bus, enabled);
+  withBus(motorId, [&](ModbusClient& bus) { motor.setJogPlus(bus, enabled); });
 }
 
 void MotorControl::setJogMinus(const utl::EMotor motorId, const bool enabled) {
@@ -704,9 +1252,7 @@ void MotorControl::setJogMinus(const utl::EMotor motorId, const bool enabled) {
                 magic_enum::enum_name(motorId));
     return;
   }
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-  motor.setJogMinus(*_bus, enabled);
+  withBus(motorId, [&](ModbusClient& bus) { motor.setJogMinus(bus, enabled); });
 }
 
 void MotorControl::setEnabled(const utl::EMotor motorId, const bool enabled) {
@@ -726,10 +1272,10 @@ void MotorControl::setEnabled(const utl::EMotor motorId, const bool enabled) {
   if (rtIt->second.enabled == enabled) {
     return;
   }
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-  motor.setEnabled(*_bus, enabled);
-  rtIt->second.enabled = enabled;
+  withBus(motorId, [&](ModbusClient& bus) {
+    motor.setEnabled(bus, enabled);
+    rtIt->second.enabled = enabled;
+  });
 }
 
 void MotorControl::setAllEnabled(const bool enabled) {
@@ -747,13 +1293,15 @@ void MotorControl::onAlarmCleared(const utl::EMotor motorId) {
   SPDLOG_INFO("Motor {} alarm cleared — forcing C-ON=0 for safe recovery",
               magic_enum::enum_name(motorId));
   motor.invalidateDriverInputCommandCache();
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) {
+  motor.invalidateRegisterShadow();
+  if (_buses.empty()) {
     rtIt->second.enabled = false;
     return;
   }
-  motor.setEnabled(*_bus, false);
-  rtIt->second.enabled = false;
+  withBus(motorId, [&](ModbusClient& bus) {
+    motor.setEnabled(bus, false);
+    rtIt->second.enabled = false;
+  });
 }
 
 bool MotorControl::isEnabled(const utl::EMotor motorId) const {
@@ -775,11 +1323,11 @@ bool MotorControl::isEnableControllable(const utl::EMotor motorId) const {
 std::uint8_t MotorControl::readSelectedOperationId(const utl::EMotor motorId) {
   const auto& motor = requireMotor(_motors, motorId);
   try {
-    std::lock_guard<std::mutex> lock(_busMutex);
-    if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-    return motor.readSelectedOperationId(*_bus);
+    return withBus(motorId, [&](ModbusClient& bus) {
+      return motor.readSelectedOperationId(bus);
+    });
   } catch (const std::exception& ex) {
-    handleCommunicationFailure("readSelectedOperationId", ex);
+    handleCommunicationFailure(motorId, "readSelectedOperationId", ex.what());
     throw;
   }
 }
@@ -787,15 +1335,18 @@ std::uint8_t MotorControl::readSelectedOperationId(const utl::EMotor motorId) {
 void MotorControl::resetAlarm(const utl::EMotor motorId) {
   const auto& motor = requireMotor(_motors, motorId);
   try {
-    std::lock_guard<std::mutex> lock(_busMutex);
-    if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-    motor.resetAlarm(*_bus);
-    const auto cfgIt = _motorConfigs.find(motorId);
-    if (cfgIt != _motorConfigs.end()) {
-      applyConfiguredParameters(motor, cfgIt->second, *_bus);
-    }
+    withBus(motorId, [&](ModbusClient& bus) {
+      motor.resetAlarm(bus);
+      // Parameters are reapplied because the driver may have lost them; the
+      // shadow must not skip them as already written.
+      motor.invalidateRegisterShadow();
+      const auto cfgIt = _motorConfigs.find(motorId);
+      if (cfgIt != _motorConfigs.end()) {
+        applyConfiguredParameters(motor, cfgIt->second, bus);
+      }
+    });
   } catch (const std::exception& ex) {
-    handleCommunicationFailure("resetAlarm", ex);
+    handleCommunicationFailure(motorId, "resetAlarm", ex.what());
     throw;
   }
 }
@@ -803,81 +1354,81 @@ void MotorControl::resetAlarm(const utl::EMotor motorId) {
 void MotorControl::setSelectedOperationId(const utl::EMotor motorId,
                                           const std::uint8_t opId) {
   const auto& motor = requireMotor(_motors, motorId);
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-  motor.setSelectedOperationId(*_bus, opId);
+  withBus(motorId, [&](ModbusClient& bus) {
+    motor.setSelectedOperationId(bus, opId);
+  });
 }
 
 void MotorControl::setOperationMode(const utl::EMotor motorId,
                                     const std::uint8_t opId,
                                     const MotorOperationMode mode) {
   const auto& motor = requireMotor(_motors, motorId);
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-  motor.setOperationMode(*_bus, opId, mode);
+  withBus(motorId, [&](ModbusClient& bus) {
+    motor.setOperationMode(bus, opId, mode);
+  });
 }
 
 void MotorControl::setOperationFunction(const utl::EMotor motorId,
                                         const std::uint8_t opId,
                                         const MotorOperationFunction function) {
   const auto& motor = requireMotor(_motors, motorId);
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-  motor.setOperationFunction(*_bus, opId, function);
+  withBus(motorId, [&](ModbusClient& bus) {
+    motor.setOperationFunction(bus, opId, function);
+  });
 }
 
 void MotorControl::setOperationPosition(const utl::EMotor motorId,
                                         const std::uint8_t opId,
                                         const std::int32_t position) {
   const auto& motor = requireMotor(_motors, motorId);
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-  motor.setOperationPosition(*_bus, opId, position);
+  withBus(motorId, [&](ModbusClient& bus) {
+    motor.setOperationPosition(bus, opId, position);
+  });
 }
 
 void MotorControl::setOperationSpeed(const utl::EMotor motorId,
                                      const std::uint8_t opId,
                                      const std::int32_t speed) {
   const auto& motor = requireMotor(_motors, motorId);
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-  motor.setOperationSpeed(*_bus, opId, speed);
+  withBus(motorId, [&](ModbusClient& bus) {
+    motor.setOperationSpeed(bus, opId, speed);
+  });
 }
 
 void MotorControl::setOperationAcceleration(const utl::EMotor motorId,
                                             const std::uint8_t opId,
                                             const std::int32_t acceleration) {
   const auto& motor = requireMotor(_motors, motorId);
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-  motor.setOperationAcceleration(*_bus, opId, acceleration);
+  withBus(motorId, [&](ModbusClient& bus) {
+    motor.setOperationAcceleration(bus, opId, acceleration);
+  });
 }
 
 void MotorControl::setOperationDeceleration(const utl::EMotor motorId,
                                             const std::uint8_t opId,
                                             const std::int32_t deceleration) {
   const auto& motor = requireMotor(_motors, motorId);
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-  motor.setOperationDeceleration(*_bus, opId, deceleration);
+  withBus(motorId, [&](ModbusClient& bus) {
+    motor.setOperationDeceleration(bus, opId, deceleration);
+  });
 }
 
 void MotorControl::setRunCurrent(const utl::EMotor motorId,
                                  const std::int32_t current) {
   validateCurrentRange(current, "runCurrent", magic_enum::enum_name(motorId));
   const auto& motor = requireMotor(_motors, motorId);
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-  motor.setRunCurrent(*_bus, current);
+  withBus(motorId, [&](ModbusClient& bus) {
+    motor.setRunCurrent(bus, current);
+  });
 }
 
 void MotorControl::setStopCurrent(const utl::EMotor motorId,
                                   const std::int32_t current) {
   validateCurrentRange(current, "stopCurrent", magic_enum::enum_name(motorId));
   const auto& motor = requireMotor(_motors, motorId);
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-  motor.setStopCurrent(*_bus, current);
+  withBus(motorId, [&](ModbusClient& bus) {
+    motor.setStopCurrent(bus, current);
+  });
 }
 
 void MotorControl::configureConstantSpeedPair(const utl::EMotor motorId,
@@ -886,28 +1437,28 @@ void MotorControl::configureConstantSpeedPair(const utl::EMotor motorId,
                                               const std::int32_t acceleration,
                                               const std::int32_t deceleration) {
   const auto& motor = requireMotor(_motors, motorId);
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-  motor.configureConstantSpeedPair(*_bus, speedOp0, speedOp1, acceleration,
-                                   deceleration);
+  withBus(motorId, [&](ModbusClient& bus) {
+    motor.configureConstantSpeedPair(bus, speedOp0, speedOp1, acceleration,
+                                     deceleration);
+  });
 }
 
 void MotorControl::updateConstantSpeedBuffered(const utl::EMotor motorId,
                                                const std::int32_t speed) {
   const auto& motor = requireMotor(_motors, motorId);
-  std::lock_guard<std::mutex> lock(_busMutex);
-  if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-  motor.updateConstantSpeedBuffered(*_bus, speed);
+  withBus(motorId, [&](ModbusClient& bus) {
+    motor.updateConstantSpeedBuffered(bus, speed);
+  });
 }
 
 MotorFlagStatus MotorControl::readInputStatus(const utl::EMotor motorId) {
   const auto& motor = requireMotor(_motors, motorId);
   try {
-    std::lock_guard<std::mutex> lock(_busMutex);
-    if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-    return motor.decodeDriverInputStatus(motor.readDriverInputCommandRaw(*_bus));
+    return withBus(motorId, BusPriority::Diagnostics, [&](ModbusClient& bus) {
+      return motor.decodeDriverInputStatus(motor.readDriverInputCommandRaw(bus));
+    });
   } catch (const std::exception& ex) {
-    handleCommunicationFailure("readInputStatus", ex);
+    handleCommunicationFailure(motorId, "readInputStatus", ex.what());
     throw;
   }
 }
@@ -915,11 +1466,11 @@ MotorFlagStatus MotorControl::readInputStatus(const utl::EMotor motorId) {
 MotorFlagStatus MotorControl::readOutputStatus(const utl::EMotor motorId) {
   const auto& motor = requireMotor(_motors, motorId);
   try {
-    std::lock_guard<std::mutex> lock(_busMutex);
-    if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-    return motor.decodeDriverOutputStatus(motor.readDriverOutputStatusRaw(*_bus));
+    return withBus(motorId, BusPriority::Diagnostics, [&](ModbusClient& bus) {
+      return motor.decodeDriverOutputStatus(motor.readDriverOutputStatusRaw(bus));
+    });
   } catch (const std::exception& ex) {
-    handleCommunicationFailure("readOutputStatus", ex);
+    handleCommunicationFailure(motorId, "readOutputStatus", ex.what());
     throw;
   }
 }
@@ -927,12 +1478,12 @@ MotorFlagStatus MotorControl::readOutputStatus(const utl::EMotor motorId) {
 MotorDirectIoStatus MotorControl::readDirectIoStatus(const utl::EMotor motorId) {
   const auto& motor = requireMotor(_motors, motorId);
   try {
-    std::lock_guard<std::mutex> lock(_busMutex);
-    if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-    return motor.decodeDirectIoAndBrakeStatus(
-        motor.readDirectIoAndBrakeStatusRaw(*_bus));
+    return withBus(motorId, BusPriority::Diagnostics, [&](ModbusClient& bus) {
+      return motor.decodeDirectIoAndBrakeStatus(
+          motor.readDirectIoAndBrakeStatusRaw(bus));
+    });
   } catch (const std::exception& ex) {
-    handleCommunicationFailure("readDirectIoStatus", ex);
+    handleCommunicationFailure(motorId, "readDirectIoStatus", ex.what());
     throw;
   }
 }
@@ -940,11 +1491,11 @@ MotorDirectIoStatus MotorControl::readDirectIoStatus(const utl::EMotor motorId)
 MotorMonitorSnapshot MotorControl::readMonitorSnapshot(const utl::EMotor motorId) {
   const auto& motor = requireMotor(_motors, motorId);
   try {
-    std::lock_guard<std::mutex> lock(_busMutex);
-    if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-    return motor.readMonitorSnapshot(*_bus);
+    return withBus(motorId, BusPriority::Diagnostics, [&](ModbusClient& bus) {
+      return motor.readMonitorSnapshot(bus);
+    });
   } catch (const std::exception& ex) {
-    handleCommunicationFailure("readMonitorSnapshot", ex);
+    handleCommunicationFailure(motorId, "readMonitorSnapshot", ex.what());
     throw;
   }
 }
@@ -952,34 +1503,246 @@ MotorMonitorSnapshot MotorControl::readMonitorSnapshot(const utl::EMotor motorId
 MotorRemoteIoStatus MotorControl::readRemoteIoStatus(const utl::EMotor motorId) {
   const auto& motor = requireMotor(_motors, motorId);
   try {
-    std::lock_guard<std::mutex> lock(_busMutex);
-    if (!_bus) utl::throwRuntimeError("MotorControl bus is not initialized");
-    return motor.decodeRemoteIoStatus(motor.readDriverInputCommandRaw(*_bus),
-                                      motor.readDriverOutputStatusRaw(*_bus));
+    return withBus(motorId, BusPriority::Diagnostics, [&](ModbusClient& bus) {
+      return motor.decodeRemoteIoStatus(motor.readDriverInputCommandRaw(bus),
+                                        motor.readDriverOutputStatusRaw(bus));
+    });
   } catch (const std::exception& ex) {
-    handleCommunicationFailure("readRemoteIoStatus", ex);
+    handleCommunicationFailure(motorId, "readRemoteIoStatus", ex.what());
     throw;
   }
 }
 
+std::map<utl::EMotor, MotorStatusPoll> MotorControl::pollStatus(
+    const std::vector<utl::EMotor>& motorIds) {
+  RIMO_TIMED_SCOPE("MotorControl::pollStatus");
+  std::map<utl::EMotor, MotorStatusPoll> polls;
+  // Entries are created up front so bus workers only write into existing
+  // nodes and never modify the map structure concurrently.
+  std::vector<std::vector<std::pair<const Motor*, MotorStatusPoll*>>> byBus(
+      _buses.size());
+  for (const auto motorId : motorIds) {
+    auto& poll = polls[motorId];
+    const auto motorIt = _motors.find(motorId);
+    const auto cfgIt = _motorConfigs.find(motorId);
+    if (motorIt == _motors.end() || cfgIt == _motorConfigs.end() ||
+        cfgIt->second.bus >= _buses.size()) {
+      poll.error = "MotorControl bus is not initialized";
+      continue;
+    }
+    const auto admission = admitStatusPoll(motorId);
+    if (admission != PollAdmission::Poll) {
+      poll.skipped = true;
+      poll.error = std::format(
+          "Motor {} (slave {}) is not responding; status reads are skipped",
+          magic_enum::enum_name(motorId), motorIt->second.slaveAddress());
+      if (admission == PollAdmission::Probe) {
+        submitProbe(motorId, cfgIt->second.bus);
+      }
+      continue;
+    }
+    byBus[cfgIt->second.bus].emplace_back(&motorIt->second, &poll);
+  }
+
+  std::vector<std::future<void>> pending;
+  pending.reserve(_buses.size());
+  for (std::size_t busIndex = 0; busIndex < _buses.size(); ++busIndex) {
+    if (byBus[busIndex].empty()) {
+      continue;
+    }
+    auto& bus = *_buses[busIndex];
+    const auto& plans = _busConfigs[busIndex].statusReadPlans;
+    const auto pollBus = [this, &bus, &plans, &targets = byBus[busIndex]]() {
+      for (const auto& [motor, poll] : targets) {
+        if (bus.stopPending.load(std::memory_order_acquire)) {
+          // Leaves the line to the emergency stop job queued behind us.
+          poll->skipped = true;
+          poll->error = "Status poll cut short by an emergency stop";
+          continue;
+        }
+        try {
+          if (!bus.client) {
+            utl::throwRuntimeError("MotorControl bus is not initialized");
+          }
+          serviceDuePulses(bus);
+          auto& block = bus.statusBlock;
+          motor->readRegisterBlock(*bus.client, plans.status, block);
+          poll->outputStatus = motor->decodeDriverOutputStatus(
+              block.u16(motor->map().driverOutputCommandLower));
+          poll->monitor = motor->decodeMonitorSnapshot(block);
+          const bool warning = Motor::isDriverOutputFlagSet(
+              poll->outputStatus->raw, MotorOutputFlag::Warning);
+          const bool alarm = Motor::isDriverOutputFlagSet(
+              poll->outputStatus->raw, MotorOutputFlag::Alarm);
+          if (!warning && !alarm) {
+            continue;
+          }
+          const auto& diagnosticPlan = warning && alarm ? plans.warningAndAlarm
+                                       : warning        ? plans.warning
+                                                        : plans.alarm;
+          auto& diagnostics = bus.diagnosticBlock;
+          motor->readRegisterBlock(*bus.client, diagnosticPlan, diagnostics);
+          if (warning) {
+            poll->warning =
+                motor->diagnoseWarning(motor->decodeWarningCode(diagnostics));
+          }
+          if (alarm) {
+            poll->alarm =
+                motor->diagnoseAlarm(motor->decodeAlarmCode(diagnostics));
+          }
+        } catch (const std::exception& ex) {
+          poll->error = ex.what();
+        }
+      }
+    };
+    pending.push_back(bus.worker.submit(BusPriority::StatusPoll, pollBus));
+  }
+  for (auto& future : pending) {
+    future.get();
+  }
+
+  for (const auto& [motorId, poll] : polls) {
+    if (poll.skipped) {
+      continue;
+    }
+    recordPollOutcome(motorId, poll.error);
+    if (!poll.error.empty()) {
+      handleCommunicationFailure(motorId, "pollStatus", poll.error);
+    }
+  }
+  return polls;
+}
+
+MotorControl::PollAdmission MotorControl::admitStatusPoll(
+    const utl::EMotor motorId) {
+  std::lock_guard<std::mutex> lock(_breakerMutex);
+  const auto it = _breakers.find(motorId);
+  if (it == _breakers.end() ||
+      it->second.health.state == utl::EMotorLinkState::Online) {
+    return PollAdmission::Poll;
+  }
+  auto& breaker = it->second;
+  if (breaker.health.state == utl::EMotorLinkState::Skipped &&
+      _clock->now() >= breaker.nextProbeAt) {
+    breaker.health.state = utl::EMotorLinkState::Probing;
+    return PollAdmission::Probe;
+  }
+  ++breaker.health.skippedPolls;
+  return PollAdmission::Skip;
+}
+
+void MotorControl::recordPollOutcome(const utl::EMotor motorId,
+                                     const std::string_view error) {
+  if (_breakerTimeouts == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(_breakerMutex);
+  auto& breaker = _breakers[motorId];
+  if (error.empty()) {
+    breaker.health.consecutiveTimeouts = 0;
+    return;
+  }
+  if (!isResponseTimeout(error)) {
+    return;
+  }
+  if (++breaker.health.consecutiveTimeouts < _breakerTimeouts) {
+    return;
+  }
+  breaker.health.state = utl::EMotorLinkState::Skipped;
+  breaker.health.backoff = _breakerProbeMin;
+  breaker.nextProbeAt = _clock->now() + breaker.health.backoff;
+  SPDLOG_WARN(
+      "Motor {} timed out {} times in a row; skipping its status reads, next "
+      "probe in {} ms",
+      magic_enum::enum_name(motorId), breaker.health.consecutiveTimeouts,
+      breaker.health.backoff.count());
+}
+
+void MotorControl::recordProbeOutcome(const utl::EMotor motorId,
+                                      const std::string_view error) {
+  std::lock_guard<std::mutex> lock(_breakerMutex);
+  const auto it = _breakers.find(motorId);
+  if (it == _breakers.end()) {
+    // Reset or re-initialized while the probe was queued.
+    return;
+  }
+  auto& breaker = it->second;
+  if (error.empty()) {
+    SPDLOG_INFO("Motor {} responds again after {} skipped status polls",
+                magic_enum::enum_name(motorId), breaker.health.skippedPolls);
+    breaker = SlaveBreaker{};
+    return;
+  }
+  breaker.health.state = utl::EMotorLinkState::Skipped;
+  breaker.health.backoff = std::min(2 * breaker.health.backoff, _breakerProbeMax);
+  breaker.nextProbeAt = _clock->now() + breaker.health.backoff;
+  SPDLOG_DEBUG("Probe of motor {} failed ({}); next probe in {} ms",
+               magic_enum::enum_name(motorId), error,
+               breaker.health.backoff.count());
+}
+
+void MotorControl::submitProbe(const utl::EMotor motorId,
+                               const std::size_t busIndex) {
+  auto& bus = *_buses[busIndex];
+  const auto& motor = _motors.at(motorId);
+  const auto& plan = _busConfigs[busIndex].statusReadPlans.status;
+  // Not awaited: a dead slave holds up only its own bus, at diagnostics
+  // priority, and the outcome is picked up by a later poll.
+  (void)bus.worker.submit(
+      BusPriority::Diagnostics, [this, &bus, &motor, &plan, motorId]() {
+        std::string error;
+        try {
+          if (!bus.client) {
+            utl::throwRuntimeError("MotorControl bus is not initialized");
+          }
+          serviceDuePulses(bus);
+          motor.readRegisterBlock(*bus.client, plan, bus.statusBlock);
+        } catch (const std::exception& ex) {
+          error = ex.what();
+        }
+        recordProbeOutcome(motorId, error);
+      });
+}
+
+utl::EMotorLinkState MotorControl::linkState(const utl::EMotor motorId) const {
+  std::lock_guard<std::mutex> lock(_breakerMutex);
+  const auto it = _breakers.find(motorId);
+  return it == _breakers.end() ? utl::EMotorLinkState::Online
+                               : it->second.health.state;
+}
+
+std::map<utl::EMotor, MotorLinkHealth> MotorControl::linkHealth() const {
+  std::lock_guard<std::mutex> lock(_breakerMutex);
+  std::map<utl::EMotor, MotorLinkHealth> out;
+  for (const auto& [motorId, breaker] : _breakers) {
+    out[motorId] = breaker.health;
+  }
+  return out;
+}
+
 bool MotorControl::hasAnyWarningOrAlarm() {
-  try {
-    std::lock_guard<std::mutex> lock(_busMutex);
-    if (!_bus) {
-      utl::throwRuntimeError("MotorControl bus is not initialized");
+  if (_buses.empty()) {
+    utl::throwRuntimeError("MotorControl bus is not initialized");
+  }
+  for (const auto& [motorId, motor] : _motors) {
+    if (linkState(motorId) != utl::EMotorLinkState::Online) {
+      continue;
     }
-    for (const auto& [_, motor] : _motors) {
-      const auto raw = motor.readDriverOutputStatusRaw(*_bus);
+    try {
+      const auto raw =
+          withBus(motorId, BusPriority::StatusPoll, [&](ModbusClient& bus) {
+            return motor.readDriverOutputStatusRaw(bus);
+          });
       if (Motor::isDriverOutputFlagSet(raw, MotorOutputFlag::Warning) ||
           Motor::isDriverOutputFlagSet(raw, MotorOutputFlag::Alarm)) {
         return true;
       }
+    } catch (const std::exception& ex) {
+      handleCommunicationFailure(motorId, "hasAnyWarningOrAlarm", ex.what());
+      throw;
     }
-    return false;
-  } catch (const std::exception& ex) {
-    handleCommunicationFailure("hasAnyWarningOrAlarm", ex);
-    throw;
   }
+  return false;
 }
 
 void MotorControl::setWarningState(const bool warningActive) {
@@ -993,13 +1756,11 @@ MotorCodeDiagnostic MotorControl::diagnoseCurrentAlarm(
     const utl::EMotor motorId) {
   const auto& motor = requireMotor(_motors, motorId);
   try {
-    std::lock_guard<std::mutex> lock(_busMutex);
-    if (!_bus) {
-      utl::throwRuntimeError("MotorControl bus is not initialized");
-    }
-    return motor.diagnoseAlarm(motor.readAlarmCode(*_bus));
+    return withBus(motorId, BusPriority::Diagnostics, [&](ModbusClient& bus) {
+      return motor.diagnoseAlarm(motor.readAlarmCode(bus));
+    });
   } catch (const std::exception& ex) {
-    handleCommunicationFailure("diagnoseCurrentAlarm", ex);
+    handleCommunicationFailure(motorId, "diagnoseCurrentAlarm", ex.what());
     throw;
   }
 }
@@ -1008,13 +1769,11 @@ MotorCodeDiagnostic MotorControl::diagnoseCurrentWarning(
     const utl::EMotor motorId) {
   const auto& motor = requireMotor(_motors, motorId);
   try {
-    std::lock_guard<std::mutex> lock(_busMutex);
-    if (!_bus) {
-      utl::throwRuntimeError("MotorControl bus is not initialized");
-    }
-    return motor.diagnoseWarning(motor.readWarningCode(*_bus));
+    return withBus(motorId, BusPriority::Diagnostics, [&](ModbusClient& bus) {
+      return motor.diagnoseWarning(motor.readWarningCode(bus));
+    });
   } catch (const std::exception& ex) {
-    handleCommunicationFailure("diagnoseCurrentWarning", ex);
+    handleCommunicationFailure(motorId, "diagnoseCurrentWarning", ex.what());
     throw;
   }
 }
@@ -1023,14 +1782,12 @@ MotorCodeDiagnostic MotorControl::diagnoseCurrentCommunicationError(
     const utl::EMotor motorId) {
   const auto& motor = requireMotor(_motors, motorId);
   try {
-    std::lock_guard<std::mutex> lock(_busMutex);
-    if (!_bus) {
-      utl::throwRuntimeError("MotorControl bus is not initialized");
-    }
-    return motor.diagnoseCommunicationError(
-        motor.readCommunicationErrorCode(*_bus));
+    return withBus(motorId, BusPriority::Diagnostics, [&](ModbusClient& bus) {
+      return motor.diagnoseCommunicationError(
+          motor.readCommunicationErrorCode(bus));
+    });
   } catch (const std::exception& ex) {
-    handleCommunicationFailure("diagnoseCurrentCommunicationError", ex);
+    handleCommunicationFailure(motorId, "diagnoseCurrentCommunicationError", ex.what());
     throw;
   }
 }
@@ -1038,61 +1795,167 @@ MotorCodeDiagnostic MotorControl::diagnoseCurrentCommunicationError(
 std::int32_t MotorControl::readGroupId(const utl::EMotor motorId) {
   const auto& motor = requireMotor(_motors, motorId);
   try {
-    std::lock_guard<std::mutex> lock(_busMutex);
-    if (!_bus) {
-      utl::throwRuntimeError("MotorControl bus is not initialized");
-    }
-    return motor.readGroupId(*_bus);
+    return withBus(motorId, BusPriority::Diagnostics, [&](ModbusClient& bus) {
+      return motor.readGroupId(bus);
+    });
   } catch (const std::exception& ex) {
-    handleCommunicationFailure("readGroupId", ex);
+    handleCommunicationFailure(motorId, "readGroupId", ex.what());
     throw;
   }
 }
 
-void MotorControl::applyConfiguredParameters(const Motor& motor,
-                                             const MotorConfig& config,
-                                             ModbusClient& bus) const {
-  if (config.groupId.has_value()) {
-    motor.setGroupId(bus, *config.groupId);
-  }
-  // Fixed startup policy: STOP input triggers deceleration and current-off.
-  // This is intentionally hardcoded for all active motors, not config-driven.
-  motor.setStopInputAction(bus, 3);
-  motor.setRunCurrent(bus, config.runCurrent);
-  motor.setStopCurrent(bus, config.stopCurrent);
-  if (config.startingSpeed.has_value()) {
-    motor.setStartingSpeed(bus, *config.startingSpeed);
-  }
-  if (config.overloadWarning.has_value()) {
-    motor.setOverloadWarning(bus, *config.overloadWarning);
-  }
-  if (config.overloadAlarm.has_value()) {
-    motor.setOverloadAlarm(bus, *config.overloadAlarm);
+void MotorControl::beginBusCycle() {
+  {
+    std::lock_guard<std::mutex> lock(_cycleUsageMutex);
+    for (auto& bus : _buses) {
+      const auto usage = bus->worker.beginCycle();
+      bus->lastCycleUsage = usage;
+      for (std::size_t i = 0; i < kBusPriorityCount; ++i) {
+        bus->usageSum.used[i] += usage.used[i];
+        bus->usagePeak.used[i] = std::max(bus->usagePeak.used[i], usage.used[i]);
+      }
+      ++bus->usageCycles;
+    }
   }
-  if (config.excessivePositionDeviationWarning.has_value()) {
-    motor.setExcessivePositionDeviationWarning(
-        bus, *config.excessivePositionDeviationWarning);
+  const auto now = _clock->now();
+  if (now >= _nextUsageLogAt) {
+    logBusCycleUsage();
+    _nextUsageLogAt = now + std::chrono::seconds{1};
   }
-  if (config.excessivePositionDeviationAlarm.has_value()) {
-    motor.setExcessivePositionDeviationAlarm(
-        bus, *config.excessivePositionDeviationAlarm);
+}
+
+bool MotorControl::admitDiagnostics(const utl::EMotor motorId) {
+  const auto cfgIt = _motorConfigs.find(motorId);
+  if (cfgIt == _motorConfigs.end() || cfgIt->second.bus >= _buses.size()) {
+    // Let the diagnostics call itself report the missing bus.
+    return true;
+  }
+  const auto budget = _busConfigs[cfgIt->second.bus].cycleBudget;
+  if (budget.count() <= 0) {
+    return true;
+  }
+  auto& bus = *_buses[cfgIt->second.bus];
+  const auto used = bus.worker.cycleUsage();
+  std::lock_guard<std::mutex> lock(_cycleUsageMutex);
+  // Until this cycle's status poll has run, keep what it took last cycle free.
+  const auto pollReserve = used[BusPriority::StatusPoll].count() == 0
+                               ? bus.lastCycleUsage[BusPriority::StatusPoll]
+                               : std::chrono::microseconds{0};
+  if (used.total() + pollReserve < budget) {
+    return true;
+  }
+  ++bus.deferredDiagnostics;
+  return false;
+}
+
+std::vector<MotorBusCycleReport> MotorControl::busCycleReports() const {
+  std::lock_guard<std::mutex> lock(_cycleUsageMutex);
+  std::vector<MotorBusCycleReport> reports;
+  reports.reserve(_buses.size());
+  for (std::size_t i = 0; i < _buses.size(); ++i) {
+    reports.push_back({.bus = _buses[i]->worker.name(),
+                       .budget = _busConfigs[i].cycleBudget,
+                       .lastCycle = _buses[i]->lastCycleUsage,
+                       .deferredDiagnostics = _buses[i]->deferredDiagnostics});
+  }
+  return reports;
+}
+
+std::vector<MotorBusTraffic> MotorControl::collectBusTraffic() {
+  std::vector<MotorBusTraffic> traffic;
+  traffic.reserve(_buses.size());
+  for (const auto& bus : _buses) {
+    traffic.push_back(
+        {.bus = bus->worker.name(), .slaves = bus->traffic.collect()});
   }
-  if (config.motorRotationDirection.has_value()) {
-    motor.setMotorRotationDirection(bus, *config.motorRotationDirection);
-    motor.executeConfiguration(bus);
+  return traffic;
+}
+
+void MotorControl::setBusThreadSetup(
+    std::function<void(const std::string& bus)> setup) {
+  std::lock_guard<std::mutex> lock(_lifecycleMutex);
+  _busThreadSetup = std::move(setup);
+}
+
+void MotorControl::logBusCycleUsage() {
+  std::lock_guard<std::mutex> lock(_cycleUsageMutex);
+  const auto ms = [](const std::chrono::microseconds value) {
+    return static_cast<double>(value.count()) / 1000.0;
+  };
+  for (std::size_t i = 0; i < _buses.size(); ++i) {
+    auto& bus = *_buses[i];
+    if (bus.usageCycles == 0) {
+      continue;
+    }
+    const auto cycles = static_cast<double>(bus.usageCycles);
+    std::string classes;
+    for (const auto priority : magic_enum::enum_values<BusPriority>()) {
+      classes += std::format("{}{} {:.2f}/{:.2f}", classes.empty() ? "" : ", ",
+                             magic_enum::enum_name(priority),
+                             ms(bus.usageSum[priority]) / cycles,
+                             ms(bus.usagePeak[priority]));
+    }
+    SPDLOG_DEBUG(
+        "Bus '{}' time per cycle avg/max ms over {} cycles: {} (budget {:.1f} "
+        "ms, {} diagnostics deferred)",
+        bus.worker.name(), bus.usageCycles, classes,
+        ms(_busConfigs[i].cycleBudget), bus.deferredDiagnostics);
+    bus.usageSum = {};
+    bus.usagePeak = {};
+    bus.usageCycles = 0;
   }
 }
 
-void MotorControl::handleCommunicationFailure(const std::string_view action,
-                                              const std::exception& ex) {
-  if (!isTemporaryCommunicationFailure(ex.what())) {
+void MotorControl::applyConfiguredParameters(const Motor& motor,
+                                             const MotorConfig& config,
+                                             ModbusClient& bus) const {
+  // Staged together so adjacent registers (run/stop current, overload and
+  // deviation alarms) share an FC16 write and unchanged values are skipped.
+  motor.batchWrites(bus, [&]() {
+    if (config.groupId.has_value()) {
+      motor.setGroupId(bus, *config.groupId);
+    }
+    // Fixed startup policy: STOP input triggers deceleration and current-off.
+    // This is intentionally hardcoded for all active motors, not
+    // config-driven.
+    motor.setStopInputAction(bus, 3);
+    motor.setRunCurrent(bus, config.runCurrent);
+    motor.setStopCurrent(bus, config.stopCurrent);
+    if (config.startingSpeed.has_value()) {
+      motor.setStartingSpeed(bus, *config.startingSpeed);
+    }
+    if (config.overloadWarning.has_value()) {
+      motor.setOverloadWarning(bus, *config.overloadWarning);
+    }
+    if (config.overloadAlarm.has_value()) {
+      motor.setOverloadAlarm(bus, *config.overloadAlarm);
+    }
+    if (config.excessivePositionDeviationWarning.has_value()) {
+      motor.setExcessivePositionDeviationWarning(
+          bus, *config.excessivePositionDeviationWarning);
+    }
+    if (config.excessivePositionDeviationAlarm.has_value()) {
+      motor.setExcessivePositionDeviationAlarm(
+          bus, *config.excessivePositionDeviationAlarm);
+    }
+    if (config.motorRotationDirection.has_value()) {
+      motor.setMotorRotationDirection(bus, *config.motorRotationDirection);
+      motor.executeConfiguration(bus);
+    }
+  });
+}
+
+void MotorControl::handleCommunicationFailure(const utl::EMotor motorId,
+                                              const std::string_view action,
+                                              const std::string_view message) {
+  if (!isTemporaryCommunicationFailure(message)) {
     return;
   }
-  SPDLOG_ERROR("MotorControl communication failure during {}: {}", action,
-               ex.what());
-  if (_bus.has_value()) {
-    _bus->close();
-    _bus.reset();
+  SPDLOG_ERROR("MotorControl communication failure during {} on {}: {}",
+               action, magic_enum::enum_name(motorId), message);
+  const auto cfgIt = _motorConfigs.find(motorId);
+  if (cfgIt != _motorConfigs.end() && cfgIt->second.bus < _buses.size()) {
+    closeBus(*_buses[cfgIt->second.bus]);
   }
   setState(State::Error);
 }
@@ -0,0 +1,193 @@
+#include "MotorDiagnosticsJob.hpp"
+
+#include <array>
+#include <exception>
+#include <format>
+#include <string>
+#include <utility>
+
+#include <JsonExtensions.hpp>
+#include <MotorControl.hpp>
+
+namespace {
+nlohmann::json makeDefaultIoAssignmentResponse(const utl::EMotor motor) {
+  nlohmann::json response{
+      {"motor", utl::enumToString(motor)},
+      {"driverInputRaw", 0u},
+      {"driverOutputRaw", 0u},
+      {"ioOutputRaw", 0u},
+      {"ioInputRaw", 0u},
+      {"netInputRaw", 0u},
+      {"netOutputRaw", 0u},
+      {"inputFlags", nlohmann::json::array()},
+      {"outputFlags", nlohmann::json::array()},
+      {"ioOutputAssignments", nlohmann::json::array()},
+      {"ioInputAssignments", nlohmann::json::array()},
+      {"netOutputAssignments", nlohmann::json::array()},
+      {"netInputAssignments", nlohmann::json::array()},
+      {"alarm", nlohmann::json::object()},
+      {"warning", nlohmann::json::object()},
+  };
+
+  response["ioOutputAssignments"].push_back(
+      {{"channel", "OUT0"}, {"function", "HOME-P"}, {"functionCode", 70}, {"active", false}});
+  response["ioOutputAssignments"].push_back(
+      {{"channel", "OUT1"}, {"function", "END"}, {"functionCode", 69}, {"active", false}});
+  response["ioOutputAssignments"].push_back(
+      {{"channel", "OUT2"}, {"function", "AREA1"}, {"functionCode", 73}, {"active", false}});
+  response["ioOutputAssignments"].push_back(
+      {{"channel", "OUT3"}, {"function", "READY"}, {"functionCode", 67}, {"active", false}});
+  response["ioOutputAssignments"].push_back(
+      {{"channel", "OUT4"}, {"function", "WNG"}, {"functionCode", 66}, {"active", false}});
+  response["ioOutputAssignments"].push_back(
+      {{"channel", "OUT5"}, {"function", "ALM"}, {"functionCode", 65}, {"active", false}});
+  response["ioOutputAssignments"].push_back(
+      {{"channel", "MB"}, {"function", "MB"}, {"functionCode", 0}, {"active", false}});
+
+  response["ioInputAssignments"].push_back(
+      {{"channel", "IN0"}, {"function", "HOME"}, {"functionCode", 3}, {"active", false}});
+  response["ioInputAssignments"].push_back(
+      {{"channel", "IN1"}, {"function", "START"}, {"functionCode", 4}, {"active", false}});
+  response["ioInputAssignments"].push_back(
+      {{"channel", "IN2"}, {"function", "M0"}, {"functionCode", 48}, {"active", false}});
+  response["ioInputAssignments"].push_back(
+      {{"channel", "IN3"}, {"function", "M1"}, {"functionCode", 49}, {"active", false}});
+  response["ioInputAssignments"].push_back(
+      {{"channel", "IN4"}, {"function", "M2"}, {"functionCode", 50}, {"active", false}});
+  response["ioInputAssignments"].push_back(
+      {{"channel", "IN5"}, {"function", "FREE"}, {"functionCode", 16}, {"active", false}});
+  response["ioInputAssignments"].push_back(
+      {{"channel", "IN6"}, {"function", "STOP"}, {"functionCode", 18}, {"active", false}});
+  response["ioInputAssignments"].push_back(
+      {{"channel", "IN7"}, {"function", "ALM-RST"}, {"functionCode", 24}, {"active", false}});
+  response["ioInputAssignments"].push_back(
+      {{"channel", "+LS"}, {"function", "+LS"}, {"functionCode", 0}, {"active", false}});
+  response["ioInputAssignments"].push_back(
+      {{"channel", "-LS"}, {"function", "-LS"}, {"functionCode", 0}, {"active", false}});
+  response["ioInputAssignments"].push_back(
+      {{"channel", "HOMES"}, {"function", "HOMES"}, {"functionCode", 0}, {"active", false}});
+  response["ioInputAssignments"].push_back(
+      {{"channel", "SLIT"}, {"function", "SLIT"}, {"functionCode", 0}, {"active", false}});
+
+  const std::array<std::pair<const char*, unsigned int>, 16> defaultNetIn{
+      {{"M0", 48},       {"M1", 49},      {"M2", 50},      {"START", 4},
+       {"HOME", 3},      {"STOP", 18},    {"FREE", 16},    {"not used", 0},
+       {"MS0", 8},       {"MS1", 9},      {"MS2", 10},     {"SSTART", 5},
+       {"+JOG", 6},      {"-JOG", 7},     {"FWD", 1},      {"RVS", 2}}};
+  const std::array<std::pair<const char*, unsigned int>, 16> defaultNetOut{
+      {{"M0_R", 48},     {"M1_R", 49},    {"M2_R", 50},    {"START_R", 4},
+       {"HOME-P", 70},   {"READY", 67},   {"WNG", 66},     {"ALM", 65},
+       {"S-BSY", 80},    {"AREA1", 73},   {"AREA2", 74},   {"AREA3", 75},
+       {"TIM", 72},      {"MOVE", 68},    {"END", 69},     {"TLC", 71}}};
+  for (int i = 0; i < 16; ++i) {
+    response["netInputAssignments"].push_back(
+        {{"channel", std::format("NET-IN{}", i)},
+         {"function", defaultNetIn[static_cast<std::size_t>(i)].first},
+         {"functionCode", defaultNetIn[static_cast<std::size_t>(i)].second},
+         {"active", false}});
+    response["netOutputAssignments"].push_back(
+        {{"channel", std::format("NET-OUT{}", i)},
+         {"function", defaultNetOut[static_cast<std::size_t>(i)].first},
+         {"functionCode", defaultNetOut[static_cast<std::size_t>(i)].second},
+         {"active", false}});
+  }
+  return response;
+}
+
+nlohmann::json assignmentsToJson(const auto& assignments) {
+  auto out = nlohmann::json::array();
+  for (const auto& assignment : assignments) {
+    out.push_back(nlohmann::json{
+        {"channel", assignment.channel},
+        {"function", assignment.function},
+        {"functionCode", assignment.functionCode},
+        {"active", assignment.active},
+    });
+  }
+  return out;
+}
+
+nlohmann::json flagsToJson(const auto& flags) {
+  auto out = nlohmann::json::array();
+  for (const auto flag : flags) {
+    out.push_back(std::string(flag));
+  }
+  return out;
+}
+
+nlohmann::json codeToJson(const MotorCodeDiagnostic& diagnostic) {
+  return nlohmann::json{
+      {"code", diagnostic.code},
+      {"known", diagnostic.known},
+      {"type", diagnostic.type},
+      {"cause", diagnostic.cause},
+      {"remedialAction", diagnostic.remedialAction},
+  };
+}
+}  // namespace
+
+MotorDiagnosticsJob::MotorDiagnosticsJob(const utl::EMotor motor)
+    : _motor(motor), _response(makeDefaultIoAssignmentResponse(motor)) {}
+
+bool MotorDiagnosticsJob::step(MotorControl& motorControl) {
+  if (_done) {
+    return true;
+  }
+  try {
+    readStep(motorControl, _nextStep);
+    ++_nextStep;
+    _done = _nextStep == kStepCount;
+  } catch (const std::exception& ex) {
+    _response["diagnosticsError"] = ex.what();
+    _done = true;
+  }
+  return _done;
+}
+
+void MotorDiagnosticsJob::readStep(MotorControl& motorControl,
+                                   const std::size_t index) {
+  switch (index) {
+    case 0: {
+      const auto status = motorControl.readInputStatus(_motor);
+      _response["driverInputRaw"] = status.raw;
+      _response["inputFlags"] = flagsToJson(status.activeFlags);
+      break;
+    }
+    case 1: {
+      const auto status = motorControl.readOutputStatus(_motor);
+      _response["driverOutputRaw"] = status.raw;
+      _response["outputFlags"] = flagsToJson(status.activeFlags);
+      break;
+    }
+    case 2: {
+      const auto status = motorControl.readDirectIoStatus(_motor);
+      _response["ioOutputRaw"] = status.reg00D4;
+      _response["ioInputRaw"] = status.reg00D5;
+      _response["ioOutputAssignments"] =
+          assignmentsToJson(status.outputAssignments);
+      _response["ioInputAssignments"] =
+          assignmentsToJson(status.inputAssignments);
+      break;
+    }
+    case 3: {
+      const auto status = motorControl.readRemoteIoStatus(_motor);
+      _response["netInputRaw"] = status.reg007D;
+      _response["netOutputRaw"] = status.reg007F;
+      _response["netOutputAssignments"] =
+          assignmentsToJson(status.outputAssignments);
+      _response["netInputAssignments"] =
+          assignmentsToJson(status.inputAssignments);
+      break;
+    }
+    case 4:
+      _response["alarm"] =
+          codeToJson(motorControl.diagnoseCurrentAlarm(_motor));
+      break;
+    case 5:
+      _response["warning"] =
+          codeToJson(motorControl.diagnoseCurrentWarning(_motor));
+      break;
+    default:
+      break;
+  }
+}
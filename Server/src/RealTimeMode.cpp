@@ -0,0 +1,242 @@
+#include "RealTimeMode.hpp"
+
+#include <Config.hpp>
+#include <ExceptionUtils.hpp>
+#include <SteadyClockAdapter.hpp>
+
+#include <alloca.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <format>
+
+namespace {
+constexpr int kMinPriority = 1;
+constexpr int kMaxPriority = 99;
+
+// Keys of the process thread are plain ("priority"); the bus workers' carry
+// a prefix ("busWorkerPriority").
+std::string settingKey(const std::string_view prefix,
+                       const std::string_view name) {
+  if (prefix.empty()) {
+    return std::string(name);
+  }
+  auto key = std::format("{}{}", prefix, name);
+  key[prefix.size()] = static_cast<char>(
+      std::toupper(static_cast<unsigned char>(key[prefix.size()])));
+  return key;
+}
+
+realtime::ThreadSettings parseThreadSettings(
+    const YAML::Node& node, const std::string_view prefix,
+    realtime::ThreadSettings settings) {
+  const auto priorityKey = settingKey(prefix, "priority");
+  settings.priority = node[priorityKey].as<int>(settings.priority);
+  if (settings.priority != 0 &&
+      (settings.priority < kMinPriority || settings.priority > kMaxPriority)) {
+    utl::throwRuntimeError(std::format(
+        "Machine.realTime.{} must be 0 or between {} and {}, got {}",
+        priorityKey, kMinPriority, kMaxPriority, settings.priority));
+  }
+  const auto cpusKey = settingKey(prefix, "cpus");
+  settings.cpus = node[cpusKey].as<std::vector<int>>(settings.cpus);
+  for (const auto cpu : settings.cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      utl::throwRuntimeError(std::format(
+          "Machine.realTime.{} entry {} is not a valid CPU index", cpusKey,
+          cpu));
+    }
+  }
+  settings.prefaultStackBytes =
+      node[settingKey(prefix, "prefaultStackKB")].as<std::size_t>(
+          settings.prefaultStackBytes / 1024) *
+      1024;
+  return settings;
+}
+
+std::string errnoText(const int error) {
+  return std::strerror(error);
+}
+
+// Touches every page of `bytes` below the current frame, so the stack is
+// mapped (and, under mlockall, locked) before the loop needs it.
+[[gnu::noinline]] void touchStack(const std::size_t bytes) {
+  auto* stack = static_cast<volatile unsigned char*>(alloca(bytes));
+  const auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  for (std::size_t offset = 0; offset < bytes; offset += page) {
+    stack[offset] = 0;
+  }
+}
+
+void readBack(realtime::ThreadReport& report) {
+  int policy = SCHED_OTHER;
+  sched_param param{};
+  if (pthread_getschedparam(pthread_self(), &policy, &param) == 0) {
+    report.policy = policy == SCHED_FIFO  ? "SCHED_FIFO"
+                    : policy == SCHED_RR ? "SCHED_RR"
+                                         : "SCHED_OTHER";
+    report.priority = param.sched_priority;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0) {
+    const auto online = sysconf(_SC_NPROCESSORS_ONLN);
+    std::vector<int> cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &set)) {
+        cpus.push_back(cpu);
+      }
+    }
+    if (static_cast<long>(cpus.size()) < online) {
+      report.cpus = std::move(cpus);
+    }
+  }
+}
+}  // namespace
+
+realtime::Settings realtime::parseSettings(const YAML::Node& node) {
+  Settings settings;
+  if (!node || !node.IsMap()) {
+    return settings;
+  }
+  settings.enabled = node["enabled"].as<bool>(settings.enabled);
+  settings.processThread = parseThreadSettings(node, "", settings.processThread);
+  settings.busWorkers =
+      parseThreadSettings(node, "busWorker", settings.busWorkers);
+  settings.lockMemory = node["lockMemory"].as<bool>(settings.lockMemory);
+  settings.spinTail = std::chrono::microseconds{
+      std::max(0, node["spinTailUS"].as<int>(0))};
+  return settings;
+}
+
+realtime::Settings realtime::loadSettings() {
+  return parseSettings(
+      utl::Config::instance().getClassConfig("Machine")["realTime"]);
+}
+
+realtime::ThreadReport realtime::applyToCurrentThread(
+    const ThreadSettings& settings) {
+  ThreadReport report;
+  if (!settings.cpus.empty()) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const auto cpu : settings.cpus) {
+      CPU_SET(cpu, &set);
+    }
+    if (const auto error =
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set)) {
+      report.failures.push_back(
+          std::format("CPU affinity: {}", errnoText(error)));
+    }
+  }
+  if (settings.priority > 0) {
+    sched_param param{};
+    param.sched_priority = settings.priority;
+    if (const auto error =
+            pthread_setschedparam(pthread_self(), SCHED_FIFO, &param)) {
+      report.failures.push_back(std::format("SCHED_FIFO priority {}: {}",
+                                            settings.priority,
+                                            errnoText(error)));
+    }
+  }
+  if (settings.prefaultStackBytes > 0) {
+    touchStack(settings.prefaultStackBytes);
+    report.stackPrefaultedBytes = settings.prefaultStackBytes;
+  }
+  readBack(report);
+  return report;
+}
+
+std::string realtime::lockProcessMemory() {
+  if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+    return std::format("mlockall: {}", errnoText(errno));
+  }
+  // Freed memory stays in the (locked) heap instead of going back to the
+  // kernel and faulting in again on the next allocation.
+  mallopt(M_TRIM_THRESHOLD, -1);
+  mallopt(M_MMAP_MAX, 0);
+  return {};
+}
+
+std::string realtime::describe(const ThreadReport& report) {
+  std::string text = report.policy;
+  if (report.priority > 0) {
+    text += std::format(" priority {}", report.priority);
+  }
+  if (report.cpus.empty()) {
+    text += ", all CPUs";
+  } else {
+    text += ", CPUs";
+    for (const auto cpu : report.cpus) {
+      text += std::format(" {}", cpu);
+    }
+  }
+  if (report.stackPrefaultedBytes > 0) {
+    text += std::format(", {} KiB stack prefaulted",
+                        report.stackPrefaultedBytes / 1024);
+  }
+  for (const auto& failure : report.failures) {
+    text += std::format("; failed: {}", failure);
+  }
+  return text;
+}
+
+nlohmann::json realtime::toJson(const ThreadReport& report) {
+  return {
+      {"policy", report.policy},
+      {"priority", report.priority},
+      {"cpus", report.cpus},
+      {"stackPrefaultedKB", report.stackPrefaultedBytes / 1024},
+      {"failures", report.failures},
+  };
+}
+
+realtime::RealTimeClock::RealTimeClock(const std::chrono::microseconds spinTail)
+    : _spinTail(std::max(std::chrono::microseconds::zero(), spinTail)) {}
+
+IClock::time_point realtime::RealTimeClock::now() const {
+  return std::chrono::steady_clock::now();
+}
+
+void realtime::RealTimeClock::sleepUntil(const time_point target) const {
+  const auto wakeAt = target - _spinTail;
+  const auto sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      wakeAt.time_since_epoch());
+  timespec deadline{};
+  deadline.tv_sec = static_cast<time_t>(sinceEpoch.count() / 1'000'000'000);
+  deadline.tv_nsec = static_cast<long>(sinceEpoch.count() % 1'000'000'000);
+  if (sinceEpoch.count() > 0) {
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline,
+                           nullptr) == EINTR) {
+    }
+  }
+  while (now() < target) {
+  }
+}
+
+bool realtime::RealTimeClock::waitUntil(const time_point target,
+                                        LoopWakeup& wakeup) const {
+  // The condition variable waits on CLOCK_MONOTONIC with an absolute timeout
+  // too, so this drifts no more than sleepUntil().
+  if (wakeup.waitUntil(target - _spinTail)) {
+    return true;
+  }
+  while (now() < target) {
+  }
+  return false;
+}
+
+std::shared_ptr<IClock> realtime::makeClock(const Settings& settings) {
+  if (settings.enabled) {
+    return std::make_shared<RealTimeClock>(settings.spinTail);
+  }
+  return std::make_shared<SteadyClockAdapter>();
+}
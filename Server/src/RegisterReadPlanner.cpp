@@ -0,0 +1,192 @@
+#include <RegisterReadPlanner.hpp>
+#include <ExceptionUtils.hpp>
+
+#include <algorithm>
+#include <format>
+#include <limits>
+
+namespace {
+// FC03 request: slave, function, start(2), count(2), CRC(2).
+constexpr int kRequestFrameChars = 8;
+// FC03 response without data: slave, function, byte count, CRC(2).
+constexpr int kResponseOverheadChars = 5;
+// Modbus RTU fixes t3.5 at 1.75 ms above 19200 baud.
+constexpr double kFixedSilenceUs = 1750.0;
+// Typical AR-KD2 reply latency after the request frame has been received.
+constexpr double kSlaveTurnaroundUs = 500.0;
+}  // namespace
+
+RegisterReadCostModel RegisterReadCostModel::fromRtu(const MotorRtuConfig& rtu) {
+  if (rtu.baud <= 0) {
+    utl::throwRuntimeError(
+        std::format("Cannot build register read cost model for baud {}",
+                    rtu.baud));
+  }
+  const int parityBits = (rtu.parity == 'N' || rtu.parity == 'n') ? 0 : 1;
+  const int bitsPerChar = 1 + rtu.dataBits + parityBits + rtu.stopBits;
+  const double charUs = 1e6 * bitsPerChar / static_cast<double>(rtu.baud);
+  const double silenceUs = rtu.baud > 19200 ? kFixedSilenceUs : 3.5 * charUs;
+
+  RegisterReadCostModel model;
+  model.perTransactionUs =
+      charUs * (kRequestFrameChars + kResponseOverheadChars) + 2.0 * silenceUs +
+      kSlaveTurnaroundUs + 1000.0 * static_cast<double>(rtu.interRequestDelayMS);
+  model.perWordUs = 2.0 * charUs;
+  return model;
+}
+
+RegisterReadPlan::RegisterReadPlan(std::vector<RegisterRange> required,
+                                   std::vector<RegisterRange> ranges,
+                                   const double estimatedCostUs)
+    : _required(std::move(required)),
+      _ranges(std::move(ranges)),
+      _estimatedCostUs(estimatedCostUs) {}
+
+int RegisterReadPlan::wordCount() const {
+  int words = 0;
+  for (const auto& range : _ranges) {
+    words += range.count;
+  }
+  return words;
+}
+
+std::string RegisterReadPlan::describe() const {
+  std::string out = std::format("{} x FC03:", _ranges.size());
+  for (std::size_t i = 0; i < _ranges.size(); ++i) {
+    out += std::format("{} 0x{:04X}+{}", i == 0 ? "" : ",", _ranges[i].start,
+                       _ranges[i].count);
+  }
+  out += std::format(" (~{:.1f} ms)", _estimatedCostUs / 1000.0);
+  return out;
+}
+
+RegisterReadPlanner::RegisterReadPlanner(RegisterReadCostModel model,
+                                         const int maxWordsPerRead)
+    : _model(model), _maxWordsPerRead(maxWordsPerRead) {
+  if (_maxWordsPerRead <= 0 || _maxWordsPerRead > kMaxReadWords) {
+    utl::throwRuntimeError(std::format(
+        "Register read planner word limit {} outside 1..{}", _maxWordsPerRead,
+        kMaxReadWords));
+  }
+}
+
+RegisterReadPlanner& RegisterReadPlanner::require(const int addr,
+                                                  const int count) {
+  if (addr < 0 || count <= 0 || addr + count > 0x10000) {
+    utl::throwRuntimeError(std::format(
+        "Invalid register requirement 0x{:04X}+{}", addr, count));
+  }
+  _required.push_back({.start = addr, .count = count});
+  return *this;
+}
+
+RegisterReadPlan RegisterReadPlanner::plan() const {
+  auto sorted = _required;
+  std::ranges::sort(sorted, {}, &RegisterRange::start);
+
+  // Overlapping or touching requirements always share a read; anything longer
+  // than one request is split up front.
+  std::vector<RegisterRange> blocks;
+  for (const auto& range : sorted) {
+    if (!blocks.empty() && range.start <= blocks.back().end()) {
+      const auto end = std::max(blocks.back().end(), range.end());
+      blocks.back().count = end - blocks.back().start;
+    } else {
+      blocks.push_back(range);
+    }
+  }
+  std::vector<RegisterRange> pieces;
+  for (const auto& block : blocks) {
+    for (int start = block.start; start < block.end();
+         start += _maxWordsPerRead) {
+      pieces.push_back({.start = start,
+                        .count = std::min(_maxWordsPerRead, block.end() - start)});
+    }
+  }
+
+  // best[i]: cheapest cover of pieces[0..i); from[i]: first piece of the last
+  // read in that cover. A read spanning pieces j..i-1 also carries the gaps.
+  const auto n = pieces.size();
+  std::vector<double> best(n + 1, std::numeric_limits<double>::infinity());
+  std::vector<std::size_t> from(n + 1, 0);
+  best[0] = 0.0;
+  for (std::size_t i = 1; i <= n; ++i) {
+    for (std::size_t j = i; j-- > 0;) {
+      const int span = pieces[i - 1].end() - pieces[j].start;
+      if (span > _maxWordsPerRead) {
+        break;
+      }
+      const double cost = best[j] + _model.transactionCostUs(span);
+      if (cost < best[i]) {
+        best[i] = cost;
+        from[i] = j;
+      }
+    }
+  }
+
+  std::vector<RegisterRange> ranges;
+  for (std::size_t i = n; i > 0; i = from[i]) {
+    const auto first = pieces[from[i]].start;
+    ranges.push_back({.start = first, .count = pieces[i - 1].end() - first});
+  }
+  std::ranges::reverse(ranges);
+  return RegisterReadPlan(std::move(sorted), std::move(ranges), best[n]);
+}
+
+void RegisterBlock::clear() noexcept {
+  _segments.clear();
+  _words.clear();
+}
+
+std::span<std::uint16_t> RegisterBlock::append(const int startAddr,
+                                               const int count) {
+  const auto offset = _words.size();
+  _segments.push_back({.start = startAddr, .count = count, .offset = offset});
+  _words.resize(offset + static_cast<std::size_t>(count));
+  return {_words.data() + offset, static_cast<std::size_t>(count)};
+}
+
+void RegisterBlock::store(const int startAddr,
+                          std::span<const std::uint16_t> words) {
+  const auto dest = append(startAddr, static_cast<int>(words.size()));
+  std::ranges::copy(words, dest.begin());
+}
+
+const std::uint16_t* RegisterBlock::wordsFor(const int addr,
+                                             const int count) const {
+  for (const auto& segment : _segments) {
+    if (addr >= segment.start && addr + count <= segment.start + segment.count) {
+      return _words.data() + segment.offset +
+             static_cast<std::size_t>(addr - segment.start);
+    }
+  }
+  return nullptr;
+}
+
+bool RegisterBlock::contains(const int addr, const int count) const {
+  return wordsFor(addr, count) != nullptr;
+}
+
+std::uint16_t RegisterBlock::u16(const int addr) const {
+  const auto* words = wordsFor(addr, 1);
+  if (!words) {
+    utl::throwRuntimeError(
+        std::format("Register 0x{:04X} was not part of the read plan", addr));
+  }
+  return words[0];
+}
+
+std::uint32_t RegisterBlock::u32(const int upperAddr) const {
+  const auto* words = wordsFor(upperAddr, 2);
+  if (!words) {
+    utl::throwRuntimeError(std::format(
+        "Registers 0x{:04X}/0x{:04X} were not part of the read plan", upperAddr,
+        upperAddr + 1));
+  }
+  return (static_cast<std::uint32_t>(words[0]) << 16) |
+         static_cast<std::uint32_t>(words[1]);
+}
+
+std::int32_t RegisterBlock::i32(const int upperAddr) const {
+  return static_cast<std::int32_t>(u32(upperAddr));
+}
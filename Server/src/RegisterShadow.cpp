@@ -0,0 +1,96 @@
+#include <RegisterShadow.hpp>
+
+#include <array>
+
+void RegisterShadow::stage(const int startAddr,
+                           std::span<const std::uint16_t> words) {
+  bool changed = false;
+  for (std::size_t i = 0; i < words.size() && !changed; ++i) {
+    const auto addr = startAddr + static_cast<int>(i);
+    const auto pending = _pending.find(addr);
+    const auto expected = pending != _pending.end() ? std::optional(pending->second)
+                                                    : known(addr);
+    changed = expected != words[i];
+  }
+  if (!changed) {
+    return;
+  }
+  for (std::size_t i = 0; i < words.size(); ++i) {
+    _pending[startAddr + static_cast<int>(i)] = words[i];
+  }
+}
+
+void RegisterShadow::stageU32(const int upperAddr, const std::uint32_t value) {
+  const std::array<std::uint16_t, 2> words{
+      static_cast<std::uint16_t>((value >> 16) & 0xFFFFu),
+      static_cast<std::uint16_t>(value & 0xFFFFu)};
+  stage(upperAddr, words);
+}
+
+std::vector<RegisterRange> RegisterShadow::pendingRanges() const {
+  std::vector<RegisterRange> ranges;
+  for (const auto& [addr, value] : _pending) {
+    if (!ranges.empty() && ranges.back().end() == addr &&
+        ranges.back().count < kMaxWriteWords) {
+      ++ranges.back().count;
+    } else {
+      ranges.push_back({.start = addr, .count = 1});
+    }
+  }
+  return ranges;
+}
+
+void RegisterShadow::flush(const WriteFn& write) {
+  if (_pending.empty()) {
+    return;
+  }
+  std::array<std::uint16_t, kMaxWriteWords> words{};
+  for (const auto& range : pendingRanges()) {
+    for (int i = 0; i < range.count; ++i) {
+      words[static_cast<std::size_t>(i)] = _pending.at(range.start + i);
+    }
+    const std::span<const std::uint16_t> payload(
+        words.data(), static_cast<std::size_t>(range.count));
+    try {
+      write(range.start, payload);
+    } catch (...) {
+      discardPending();
+      throw;
+    }
+    for (int i = 0; i < range.count; ++i) {
+      const auto addr = range.start + i;
+      _known[addr] = payload[static_cast<std::size_t>(i)];
+      _pending.erase(addr);
+    }
+  }
+}
+
+void RegisterShadow::discardPending() {
+  for (const auto& [addr, value] : _pending) {
+    _known.erase(addr);
+  }
+  _pending.clear();
+}
+
+void RegisterShadow::observe(const int startAddr,
+                             std::span<const std::uint16_t> words) {
+  for (std::size_t i = 0; i < words.size(); ++i) {
+    _known[startAddr + static_cast<int>(i)] = words[i];
+  }
+}
+
+void RegisterShadow::invalidate(const int startAddr, const int count) {
+  _known.erase(_known.lower_bound(startAddr), _known.lower_bound(startAddr + count));
+}
+
+void RegisterShadow::invalidateAll() {
+  _known.clear();
+}
+
+std::optional<std::uint16_t> RegisterShadow::known(const int addr) const {
+  const auto it = _known.find(addr);
+  if (it == _known.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
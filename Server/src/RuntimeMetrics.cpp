@@ -0,0 +1,118 @@
+#include "RuntimeMetrics.hpp"
+
+#include <magic_enum/magic_enum.hpp>
+
+namespace {
+double toUs(const std::uint64_t ns) { return static_cast<double>(ns) / 1'000.0; }
+
+double toMs(const IClock::duration d) {
+  return std::chrono::duration<double, std::milli>(d).count();
+}
+}  // namespace
+
+nlohmann::json metrics::latencySummary(const utl::LatencySnapshot& snapshot) {
+  const auto meanNs =
+      snapshot.count == 0
+          ? 0.0
+          : static_cast<double>(snapshot.totalNs) /
+                static_cast<double>(snapshot.count);
+  return {
+      {"count", snapshot.count},
+      {"meanUs", meanNs / 1'000.0},
+      {"p50Us", toUs(snapshot.percentileNs(0.50))},
+      {"p90Us", toUs(snapshot.percentileNs(0.90))},
+      {"p99Us", toUs(snapshot.percentileNs(0.99))},
+      {"p999Us", toUs(snapshot.percentileNs(0.999))},
+      {"maxUs", toUs(snapshot.maxNs)},
+  };
+}
+
+nlohmann::json metrics::controlLoop(const ControlLoopRunner& runner,
+                                    const ControlLoopMetrics& loop) {
+  const auto loopInterval = runner.loopInterval();
+  const auto intervalNs = static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(loopInterval)
+          .count());
+  const auto duty = [intervalNs](const double ns) {
+    return intervalNs > 0.0 ? ns / intervalNs : 0.0;
+  };
+  const auto& work = loop.work;
+  const auto meanWorkNs =
+      work.count == 0 ? 0.0
+                      : static_cast<double>(work.totalNs) /
+                            static_cast<double>(work.count);
+  auto tasks = nlohmann::json::array();
+  for (std::size_t id = 0; id < runner.taskCount(); ++id) {
+    const auto& config = runner.task(id);
+    static const LoopTaskMetrics kNotRun;
+    const auto& stats = id < loop.tasks.size() ? loop.tasks[id] : kNotRun;
+    tasks.push_back({
+        {"name", config.name},
+        {"periodMs", toMs(config.period)},
+        {"phaseMs", toMs(config.phase.value_or(IClock::duration::zero()))},
+        {"priority", config.priority},
+        {"overrun", magic_enum::enum_name(config.overrun)},
+        {"runs", stats.runs},
+        {"skippedReleases", stats.skippedReleases},
+        {"time", latencySummary(stats.time)},
+        {"lateness", latencySummary(stats.lateness)},
+    });
+  }
+  return {
+      {"intervalMs", loopInterval.count()},
+      {"cycles", loop.cycles},
+      {"overruns", loop.overruns},
+      {"work", latencySummary(work)},
+      {"dutyCycle",
+       {
+           {"mean", duty(meanWorkNs)},
+           {"p50", duty(static_cast<double>(work.percentileNs(0.50)))},
+           {"p99", duty(static_cast<double>(work.percentileNs(0.99)))},
+           {"max", duty(static_cast<double>(work.maxNs))},
+       }},
+      {"tasks", std::move(tasks)},
+      {"wakeLatency", latencySummary(loop.wakeLatency)},
+      {"period", latencySummary(loop.period)},
+      {"jitter", latencySummary(loop.jitter)},
+      {"wakeSteps", loop.wakeSteps},
+      {"wakeStepTime", latencySummary(loop.wakeStepTime)},
+  };
+}
+
+nlohmann::json metrics::overrunLog(const ControlLoopRunner& runner,
+                                   const ControlLoopOverrunLog& log,
+                                   const IClock::time_point now) {
+  auto recent = nlohmann::json::array();
+  for (const auto& overrun : log.recent()) {
+    auto tasks = nlohmann::json::object();
+    for (std::size_t id = 0; id < runner.taskCount(); ++id) {
+      tasks[runner.task(id).name] = toMs(overrun.tasks[id]);
+    }
+    recent.push_back({
+        {"agoMs", toMs(now - overrun.startedAt)},
+        {"lateMs", toMs(overrun.late)},
+        {"wakeMs", toMs(overrun.wake)},
+        {"culprit", overrun.culprit ? runner.task(*overrun.culprit).name
+                                    : std::string{"wake"}},
+        {"tasksMs", std::move(tasks)},
+    });
+  }
+  return {{"total", log.total()}, {"recent", std::move(recent)}};
+}
+
+nlohmann::json metrics::modbusLine(
+    const std::string_view line,
+    const std::vector<ModbusTrafficStats::SlaveReport>& slaves) {
+  auto slaveList = nlohmann::json::array();
+  for (const auto& slave : slaves) {
+    slaveList.push_back({
+        {"slave", slave.slave},
+        {"transactions", slave.transactions},
+        {"timeouts", slave.timeouts},
+        {"crcErrors", slave.crc_errors},
+        {"otherErrors", slave.other_errors},
+        {"roundTrip", latencySummary(slave.round_trip)},
+    });
+  }
+  return {{"line", line}, {"slaves", std::move(slaveList)}};
+}
@@ -0,0 +1,71 @@
+#include <StatusPublisher.hpp>
+
+#include <ExceptionUtils.hpp>
+#include <Logger.hpp>
+#include <TimingMetrics.hpp>
+
+#include <chrono>
+#include <exception>
+
+StatusPublisher::StatusPublisher(SendFn send, SendMetricsFn sendMetrics)
+    : _send(std::move(send)), _sendMetrics(std::move(sendMetrics)) {
+  if (!_send) {
+    utl::throwRuntimeError("StatusPublisher requires a send function");
+  }
+}
+
+StatusPublisher::~StatusPublisher() { stop(); }
+
+void StatusPublisher::start() {
+  if (_thread.joinable()) {
+    return;
+  }
+  _slot.reopen();
+  _thread = std::thread(&StatusPublisher::run, this);
+}
+
+void StatusPublisher::stop() {
+  _slot.close();
+  if (_thread.joinable()) {
+    _thread.join();
+  }
+}
+
+void StatusPublisher::submit(const utl::RobotStatus& status) {
+  _slot.writeBuffer() = status;
+  _slot.publish();
+}
+
+void StatusPublisher::submitMetrics(const nlohmann::json& metrics) {
+  if (!_sendMetrics) {
+    return;
+  }
+  _metricsSlot.writeBuffer() = metrics;
+  _metricsSlot.publish();
+}
+
+void StatusPublisher::run() {
+  SPDLOG_INFO("Status publisher thread started");
+  while (const auto* status = _slot.waitAndTake()) {
+    RIMO_TIMED_SCOPE("StatusPublisher::send");
+    const auto start = std::chrono::steady_clock::now();
+    try {
+      _send(*status);
+    } catch (const std::exception& e) {
+      SPDLOG_WARN("Failed to publish status: {}", e.what());
+    }
+    _sendTimes.record(static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count()));
+    if (const auto* metrics = _metricsSlot.take()) {
+      try {
+        _sendMetrics(*metrics);
+      } catch (const std::exception& e) {
+        SPDLOG_WARN("Failed to publish metrics: {}", e.what());
+      }
+    }
+  }
+  SPDLOG_INFO("Status publisher thread finished ({} snapshots, {} skipped)",
+              submittedCount(), skippedCount());
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace utl {
+
+// Bounded multi-producer/single-consumer FIFO on a pre-allocated ring, using
+// per-cell sequence numbers (D. Vyukov's bounded queue). A producer claims a
+// position with one CAS on the tail and publishes the cell with a release
+// store; the consumer only touches the head and the cell it empties. Nothing
+// allocates after construction and no side ever takes a lock.
+//
+// close() makes every later push() fail; elements pushed before stay
+// poppable.
+template <typename T>
+class BoundedMpscQueue {
+ public:
+  explicit BoundedMpscQueue(std::size_t capacity) { reset(capacity); }
+
+  // Replaces the ring with an empty, open one of `capacity` cells. The
+  // sequence scheme needs at least two, so smaller requests get two. Only
+  // call while no other thread uses the queue.
+  void reset(std::size_t capacity) {
+    _capacity = std::max<std::size_t>(2, capacity);
+    _cells = std::make_unique<Cell[]>(_capacity);
+    for (std::size_t i = 0; i < _capacity; ++i) {
+      _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    _tail.store(0, std::memory_order_relaxed);
+    _head.store(0, std::memory_order_relaxed);
+  }
+
+  // Any thread. Returns false, leaving `value` untouched, when the queue is
+  // full or closed.
+  bool push(T&& value) {
+    auto position = _tail.load(std::memory_order_relaxed);
+    for (;;) {
+      if (position & kClosed) {
+        return false;
+      }
+      auto& cell = _cells[position % _capacity];
+      const auto sequence = cell.sequence.load(std::memory_order_acquire);
+      const auto lag = static_cast<std::int64_t>(sequence - position);
+      if (lag == 0) {
+        if (_tail.compare_exchange_weak(position, position + 1,
+                                        std::memory_order_relaxed)) {
+          cell.value = std::move(value);
+          cell.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (lag < 0) {
+        // The cell still holds the element pushed one lap ago.
+        return false;
+      } else {
+        position = _tail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Consumer thread only.
+  std::optional<T> try_pop() {
+    const auto position = _head.load(std::memory_order_relaxed);
+    auto& cell = _cells[position % _capacity];
+    if (cell.sequence.load(std::memory_order_acquire) != position + 1) {
+      return std::nullopt;
+    }
+    std::optional<T> value{std::move(cell.value)};
+    cell.sequence.store(position + _capacity, std::memory_order_release);
+    _head.store(position + 1, std::memory_order_release);
+    return value;
+  }
+
+  // Consumer thread; wait-free. A push that has claimed its cell but not yet
+  // published it still counts as empty.
+  [[nodiscard]] bool empty() const {
+    const auto position = _head.load(std::memory_order_relaxed);
+    return _cells[position % _capacity].sequence.load(
+               std::memory_order_acquire) != position + 1;
+  }
+
+  // Claimed cells not popped yet, including pushes still being published.
+  // Exact on the consumer thread once the queue is closed; a snapshot
+  // otherwise.
+  [[nodiscard]] std::size_t size() const {
+    const auto head = _head.load(std::memory_order_acquire);
+    const auto tail = _tail.load(std::memory_order_acquire) & ~kClosed;
+    return tail > head ? static_cast<std::size_t>(tail - head) : 0;
+  }
+
+  [[nodiscard]] std::size_t capacity() const { return _capacity; }
+
+  void close() { _tail.fetch_or(kClosed, std::memory_order_acq_rel); }
+  [[nodiscard]] bool closed() const {
+    return (_tail.load(std::memory_order_acquire) & kClosed) != 0;
+  }
+
+ private:
+  static constexpr std::uint64_t kClosed = std::uint64_t{1} << 63;
+
+  struct Cell {
+    std::atomic<std::uint64_t> sequence{0};
+    T value{};
+  };
+
+  std::unique_ptr<Cell[]> _cells;
+  std::size_t _capacity{0};
+  // Producers hammer the tail, the consumer the head; keep them on separate
+  // cache lines.
+  alignas(64) std::atomic<std::uint64_t> _tail{0};
+  alignas(64) std::atomic<std::uint64_t> _head{0};
+};
+
+}  // namespace utl
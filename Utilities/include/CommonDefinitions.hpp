@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <map>
 #include <optional>
 #include <string>
@@ -23,6 +24,10 @@ enum class ERobotComponent {Contec, MotorControl, ControlPanel};
 
 enum class EAxisState { Locked, Slow, Fast };
 
+// Whether the server still talks to a motor's slave: Skipped once its circuit
+// breaker opened after repeated timeouts, Probing while a retry is in flight.
+enum class EMotorLinkState { Online, Skipped, Probing };
+
 // Known Contec digital input signal names.  All keys in Machine.inputMapping
 // must correspond to one of these values (validated at startup).
 enum class EInputSignal {
@@ -63,6 +68,7 @@ struct SingleMotorStatus {
   std::map<EMotorStatusFlags, ELEDState> flags;
   double speedCommandPercent{0};         // [-100, 100]; 0 when locked/idle
   double modeMaxLinearSpeedMmPerSec{0};  // max speed for the current mode
+  EMotorLinkState linkState{EMotorLinkState::Online};
 };
 
 struct JoystickStatus {
@@ -76,6 +82,18 @@ struct ToolChangerStatus {
   std::map<EToolChangerStatusFlags, ELEDState> flags;
 };
 
+// Command intake of the control loop. Wait percentiles cover the most
+// recently dispatched commands, from submission to the start of handling.
+struct CommandQueueStatus {
+  std::uint32_t depth{0};     // waiting in the queue
+  std::uint32_t deferred{0};  // held back for a later cycle
+  double waitP50Ms{0};
+  double waitP95Ms{0};
+  double waitP99Ms{0};
+
+  bool operator==(const CommandQueueStatus&) const = default;
+};
+
 struct RobotStatus {
   std::map<EMotor, SingleMotorStatus> motors;
   std::map<EArm, ToolChangerStatus> toolChangers;
@@ -83,6 +101,7 @@ struct RobotStatus {
   std::map<EArm, JoystickStatus> joystics;
   std::optional<bool> safetyOn;
   std::map<EArm, EAxisState> armStates;
+  CommandQueueStatus commandQueue;
 };
 
 }  // namespace utl
@@ -121,6 +121,16 @@ struct adl_serializer<utl::EAxisState> {
   }
 };
 
+template <>
+struct adl_serializer<utl::EMotorLinkState> {
+  static void to_json(json& j, const utl::EMotorLinkState& v) {
+    j = utl::enumToString(v);
+  }
+  static void from_json(const json& j, utl::EMotorLinkState& v) {
+    v = utl::stringToEnum<utl::EMotorLinkState>(j.get<std::string>());
+  }
+};
+
 template <>
 struct adl_serializer<utl::SingleMotorStatus> {
   static void to_json(json& j, const utl::SingleMotorStatus& v) {
@@ -136,6 +146,7 @@ struct adl_serializer<utl::SingleMotorStatus> {
         {"flags", utl::enumKeyedMapToJson(v.flags)},
         {"speedCommandPercent", v.speedCommandPercent},
         {"modeMaxLinearSpeedMmPerSec", v.modeMaxLinearSpeedMmPerSec},
+        {"linkState", v.linkState},
     };
   }
 
@@ -153,6 +164,9 @@ struct adl_serializer<utl::SingleMotorStatus> {
         j.at("flags"));
     v.speedCommandPercent = j.value("speedCommandPercent", 0.0);
     v.modeMaxLinearSpeedMmPerSec = j.value("modeMaxLinearSpeedMmPerSec", 0.0);
+    v.linkState = j.contains("linkState")
+                      ? j.at("linkState").get<utl::EMotorLinkState>()
+                      : utl::EMotorLinkState::Online;
   }
 };
 
@@ -181,6 +195,27 @@ struct adl_serializer<utl::JoystickStatus> {
   }
 };
 
+template <>
+struct adl_serializer<utl::CommandQueueStatus> {
+  static void to_json(json& j, const utl::CommandQueueStatus& v) {
+    j = json{
+        {"depth", v.depth},
+        {"deferred", v.deferred},
+        {"waitP50Ms", v.waitP50Ms},
+        {"waitP95Ms", v.waitP95Ms},
+        {"waitP99Ms", v.waitP99Ms},
+    };
+  }
+
+  static void from_json(const json& j, utl::CommandQueueStatus& v) {
+    v.depth = j.at("depth").get<std::uint32_t>();
+    v.deferred = j.at("deferred").get<std::uint32_t>();
+    v.waitP50Ms = j.at("waitP50Ms").get<double>();
+    v.waitP95Ms = j.at("waitP95Ms").get<double>();
+    v.waitP99Ms = j.at("waitP99Ms").get<double>();
+  }
+};
+
 template <>
 struct adl_serializer<utl::RobotStatus> {
   static void to_json(json& j, const utl::RobotStatus& v) {
@@ -190,6 +225,7 @@ struct adl_serializer<utl::RobotStatus> {
         {"robotComponents", utl::enumKeyedMapToJson(v.robotComponents)},
         {"joystics", utl::enumKeyedMapToJson(v.joystics)},
         {"armStates", utl::enumKeyedMapToJson(v.armStates)},
+        {"commandQueue", v.commandQueue},
     };
     if (v.safetyOn.has_value()) {
       j["safetyOn"] = *v.safetyOn;
@@ -217,6 +253,9 @@ struct adl_serializer<utl::RobotStatus> {
       v.armStates = utl::enumKeyedMapFromJson<utl::EArm, utl::EAxisState>(
           j.at("armStates"));
     }
+    if (j.contains("commandQueue")) {
+      v.commandQueue = j.at("commandQueue").get<utl::CommandQueueStatus>();
+    }
   }
 };
 
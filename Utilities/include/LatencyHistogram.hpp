@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace utl {
+
+// Log-linear (HDR-style) buckets over nanoseconds: values below 8 are exact,
+// every power of two above is split into 8 buckets, so a bucket is at most
+// 12.5% wide. Values from about 550 s on share the last bucket.
+struct LatencyBuckets {
+  static constexpr unsigned kSubBits = 3;
+  static constexpr std::size_t kSubCount = std::size_t{1} << kSubBits;
+  static constexpr unsigned kMaxExponent = 39;
+  static constexpr std::size_t kCount =
+      (kMaxExponent - kSubBits + 1) * kSubCount + kSubCount;
+
+  static constexpr std::size_t indexFor(const std::uint64_t ns) {
+    if (ns < kSubCount) {
+      return static_cast<std::size_t>(ns);
+    }
+    const auto exponent = static_cast<unsigned>(std::bit_width(ns) - 1);
+    if (exponent > kMaxExponent) {
+      return kCount - 1;
+    }
+    const auto sub = (ns >> (exponent - kSubBits)) & (kSubCount - 1);
+    return (exponent - kSubBits + 1) * kSubCount + static_cast<std::size_t>(sub);
+  }
+
+  static constexpr std::uint64_t lowerBound(const std::size_t index) {
+    if (index < kSubCount) {
+      return index;
+    }
+    const auto exponent =
+        static_cast<unsigned>(index / kSubCount) + kSubBits - 1;
+    const auto sub = index % kSubCount;
+    return (kSubCount + sub) << (exponent - kSubBits);
+  }
+
+  static constexpr std::uint64_t upperBound(const std::size_t index) {
+    if (index < kSubCount) {
+      return index;
+    }
+    const auto exponent =
+        static_cast<unsigned>(index / kSubCount) + kSubBits - 1;
+    return lowerBound(index) + (std::uint64_t{1} << (exponent - kSubBits)) - 1;
+  }
+};
+
+// Plain counts of one or more LatencyHistograms over some interval. Also
+// usable on its own where recording and reading happen on one thread.
+struct LatencySnapshot {
+  std::array<std::uint64_t, LatencyBuckets::kCount> buckets{};
+  std::uint64_t count{0};
+  std::uint64_t totalNs{0};
+  std::uint64_t maxNs{0};
+
+  void record(const std::uint64_t ns) {
+    ++buckets[LatencyBuckets::indexFor(ns)];
+    ++count;
+    totalNs += ns;
+    maxNs = std::max(maxNs, ns);
+  }
+
+  void merge(const LatencySnapshot& other) {
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+      buckets[i] += other.buckets[i];
+    }
+    count += other.count;
+    totalNs += other.totalNs;
+    maxNs = std::max(maxNs, other.maxNs);
+  }
+
+  // Upper bound of the bucket holding the given fraction of samples, capped
+  // at the largest value seen; 0 without samples.
+  [[nodiscard]] std::uint64_t percentileNs(const double fraction) const {
+    if (count == 0) {
+      return 0;
+    }
+    const auto rank = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(fraction * static_cast<double>(count) +
+                                      0.5));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+      seen += buckets[i];
+      if (seen >= rank) {
+        return std::min(LatencyBuckets::upperBound(i), maxNs);
+      }
+    }
+    return maxNs;
+  }
+
+  void clear() { *this = LatencySnapshot{}; }
+};
+
+// Latency histogram written by one thread and read by another. The writer
+// only does relaxed loads and stores (no read-modify-write), so record() is a
+// handful of instructions; collectInto() reports what was recorded since its
+// previous call. Only one collector may run at a time.
+class LatencyHistogram {
+ public:
+  // Owning thread only.
+  void record(const std::uint64_t ns) noexcept {
+    bump(_buckets[LatencyBuckets::indexFor(ns)], 1);
+    bump(_totalNs, ns);
+    if (ns > _maxNs.load(std::memory_order_relaxed)) {
+      _maxNs.store(ns, std::memory_order_relaxed);
+    }
+  }
+
+  // Adds everything recorded since the previous collectInto() to `out`.
+  void collectInto(LatencySnapshot& out) {
+    std::uint64_t count = 0;
+    std::size_t highest = 0;
+    for (std::size_t i = 0; i < _buckets.size(); ++i) {
+      const auto now = _buckets[i].load(std::memory_order_relaxed);
+      const auto delta = now - _reportedBuckets[i];
+      _reportedBuckets[i] = now;
+      if (delta > 0) {
+        out.buckets[i] += delta;
+        count += delta;
+        highest = i;
+      }
+    }
+    const auto total = _totalNs.load(std::memory_order_relaxed);
+    out.totalNs += total - _reportedTotalNs;
+    _reportedTotalNs = total;
+    out.count += count;
+    // A sample racing with this exchange may lower the interval maximum;
+    // its bucket still bounds it from below.
+    auto maxNs = _maxNs.exchange(0, std::memory_order_relaxed);
+    if (count > 0) {
+      maxNs = std::max(maxNs, LatencyBuckets::lowerBound(highest));
+    }
+    out.maxNs = std::max(out.maxNs, maxNs);
+  }
+
+ private:
+  static void bump(std::atomic<std::uint64_t>& counter,
+                   const std::uint64_t by) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + by,
+                  std::memory_order_relaxed);
+  }
+
+  std::array<std::atomic<std::uint64_t>, LatencyBuckets::kCount> _buckets{};
+  std::atomic<std::uint64_t> _totalNs{0};
+  std::atomic<std::uint64_t> _maxNs{0};
+  // Collector side.
+  std::array<std::uint64_t, LatencyBuckets::kCount> _reportedBuckets{};
+  std::uint64_t _reportedTotalNs{0};
+};
+
+}  // namespace utl
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace utl {
+
+// Single-producer/single-consumer hand-off that keeps only the newest value
+// (a triple buffer). The producer fills writeBuffer() and publish()es it; the
+// consumer take()s whatever was published last. Neither side ever blocks the
+// other: a value the consumer has not taken yet is simply replaced.
+//
+// Buffers are reused, so assigning into writeBuffer() stops allocating once
+// each of the three has held a value of typical size.
+template <typename T>
+class LatestValueSlot {
+ public:
+  // Producer side. The buffer belongs to the producer until publish().
+  T& writeBuffer() { return _buffers[_writeIndex]; }
+
+  void publish() {
+    auto expected = _shared.load(std::memory_order_relaxed);
+    while (!_shared.compare_exchange_weak(
+        expected, (expected & kClosed) | kFresh | _writeIndex,
+        std::memory_order_acq_rel, std::memory_order_relaxed)) {
+    }
+    _writeIndex = expected & kIndexMask;
+    _published.fetch_add(1, std::memory_order_relaxed);
+    if (expected & kFresh) {
+      _overwritten.fetch_add(1, std::memory_order_relaxed);
+    }
+    _shared.notify_one();
+  }
+
+  // Consumer side. Returns the newest value, or nullptr when nothing was
+  // published since the previous take(). The value stays valid until the
+  // next take()/waitAndTake().
+  const T* take() {
+    auto expected = _shared.load(std::memory_order_relaxed);
+    do {
+      if (!(expected & kFresh)) {
+        return nullptr;
+      }
+    } while (!_shared.compare_exchange_weak(
+        expected, (expected & kClosed) | _readIndex, std::memory_order_acq_rel,
+        std::memory_order_relaxed));
+    _readIndex = expected & kIndexMask;
+    return &_buffers[_readIndex];
+  }
+
+  // Blocks until a value is published or the slot is closed. A value
+  // published before close() is still handed out; after that nullptr means
+  // the slot was closed.
+  const T* waitAndTake() {
+    for (;;) {
+      if (const auto* value = take()) {
+        return value;
+      }
+      const auto observed = _shared.load(std::memory_order_acquire);
+      if (observed & kClosed) {
+        return nullptr;
+      }
+      if (!(observed & kFresh)) {
+        _shared.wait(observed, std::memory_order_acquire);
+      }
+    }
+  }
+
+  // Wakes a consumer blocked in waitAndTake(). Either side may call these.
+  void close() {
+    _shared.fetch_or(kClosed, std::memory_order_release);
+    _shared.notify_all();
+  }
+  void reopen() { _shared.fetch_and(~kClosed, std::memory_order_release); }
+
+  // Number of publish() calls, and how many of those replaced a value the
+  // consumer never took.
+  [[nodiscard]] std::uint64_t publishedCount() const {
+    return _published.load(std::memory_order_relaxed);
+  }
+  [[nodiscard]] std::uint64_t overwrittenCount() const {
+    return _overwritten.load(std::memory_order_relaxed);
+  }
+
+ private:
+  static constexpr std::uint8_t kIndexMask = 0x3;
+  static constexpr std::uint8_t kFresh = 0x4;
+  static constexpr std::uint8_t kClosed = 0x8;
+
+  std::array<T, 3> _buffers{};
+  // Index of the buffer between producer and consumer, plus flags.
+  std::atomic<std::uint8_t> _shared{1};
+  std::uint8_t _writeIndex{0};
+  std::uint8_t _readIndex{2};
+  std::atomic<std::uint64_t> _published{0};
+  std::atomic<std::uint64_t> _overwritten{0};
+};
+
+}  // namespace utl
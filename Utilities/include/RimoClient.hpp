@@ -1,15 +1,36 @@
 #pragma once
 
 #include <Logger.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <map>
 #include <optional>
+#include <vector>
 
 #include "Config.hpp"
 #include "JsonExtensions.hpp"
+#include "StatusWireFormat.hpp"
 #include "nlohmann/json.hpp"
 #include "zmq.hpp"
+#include "zmq_addon.hpp"
 
 namespace utl {
 
+// Outcome of a submitted command. `response` is empty when no reply arrived
+// within commandTimeoutMS or the reply could not be decoded.
+struct CommandReply {
+  std::uint64_t requestId{0};
+  std::optional<nlohmann::json> response;
+};
+
+// Commands go out on a DEALER socket as [requestId, "", payload]; RimoServer
+// echoes the envelope, so replies are matched by id and any number of
+// commands may be in flight. A command that timed out does not poison the
+// socket: its late reply is simply dropped.
 template <typename T>
 class RimoClient {
  public:
@@ -36,65 +57,201 @@ class RimoClient {
     _statusSocket.set(zmq::sockopt::rcvtimeo, _statusTimeoutMS);
 
     SPDLOG_INFO("Starting command client at '{}'", _commandAddress);
-    _commandSocket = zmq::socket_t(_context, zmq::socket_type::req);
+    _commandSocket = zmq::socket_t(_context, zmq::socket_type::dealer);
     _commandSocket.set(zmq::sockopt::sndtimeo, _commandTimeoutMS);
-    _commandSocket.set(zmq::sockopt::rcvtimeo, _commandTimeoutMS);
     _commandSocket.set(zmq::sockopt::linger, 0);
     _commandSocket.connect(_commandAddress);
   }
+  // Binary status arrives as keyframes and deltas; the full state is rebuilt
+  // here. After a gap in the stream a keyframe is requested and frames are
+  // read until one arrives.
   std::optional<T> receiveRobotStatus() {
-    zmq::message_t message;
-    if (const auto status = _statusSocket.recv(message); !status) {
-      SPDLOG_WARN(
-          "RimoClient message receive timeout. Make sure rimoServer is "
-          "running!");
-      return std::nullopt;
+    for (;;) {
+      zmq::message_t message;
+      if (const auto status = _statusSocket.recv(message); !status) {
+        SPDLOG_WARN(
+            "RimoClient message receive timeout. Make sure rimoServer is "
+            "running!");
+        return std::nullopt;
+      }
+      if (message.more()) {
+        // A topic message such as metrics; status is always one frame.
+        while (message.more() && _statusSocket.recv(message)) {
+        }
+        continue;
+      }
+      try {
+        const std::span payload(
+            static_cast<const std::uint8_t*>(message.data()), message.size());
+        if (!isBinaryStatus(payload)) {
+          const auto json =
+              nlohmann::json::from_msgpack(payload.begin(), payload.end());
+          return json.get<T>();
+        }
+        if (_statusDecoder.apply(payload)) {
+          _keyframeRequested = false;
+          return _statusDecoder.state();
+        }
+      } catch (const std::exception& e) {
+        SPDLOG_WARN("Failed to decode status message: {}", e.what());
+        requestStatusKeyframe();
+        return std::nullopt;
+      }
+      requestStatusKeyframe();
     }
-    try {
-      const auto json = nlohmann::json::from_msgpack(
-          static_cast<const std::uint8_t*>(message.data()),
-          static_cast<const std::uint8_t*>(message.data()) + message.size());
-      return json.get<T>();
-    } catch (const std::exception& e) {
-      SPDLOG_WARN("Failed to decode status message: {}", e.what());
+  }
+
+  // Sends `command` without waiting for the reply; returns its request id,
+  // or nullopt when it could not be sent.
+  [[nodiscard]] std::optional<std::uint64_t> submitCommand(
+      const nlohmann::json& command) {
+    const auto requestId = _nextRequestId++;
+    const auto payload = nlohmann::json::to_msgpack(command);
+    if (!_commandSocket.send(zmq::buffer(&requestId, sizeof(requestId)),
+                             zmq::send_flags::sndmore) ||
+        !_commandSocket.send(zmq::message_t{}, zmq::send_flags::sndmore) ||
+        !_commandSocket.send(zmq::buffer(payload), zmq::send_flags::none)) {
+      SPDLOG_ERROR("Communication with command server impossible!");
       return std::nullopt;
     }
+    _inFlight.emplace(
+        requestId, Clock::now() + std::chrono::milliseconds{_commandTimeoutMS});
+    return requestId;
   }
 
+  // Next reply to a submitted command, in arrival order, waiting at most
+  // `wait`. Commands that timed out are reported with an empty response.
+  [[nodiscard]] std::optional<CommandReply> pollCommandReply(
+      const std::chrono::milliseconds wait = std::chrono::milliseconds{0}) {
+    if (!_readyReplies.empty()) {
+      auto reply = std::move(_readyReplies.front());
+      _readyReplies.pop_front();
+      return reply;
+    }
+    return readCommandReply(wait);
+  }
+
+  // Blocking round trip. Replies to other commands that arrive meanwhile
+  // are kept for pollCommandReply().
   [[nodiscard]] std::optional<nlohmann::json> sendCommand(
       const nlohmann::json& command) {
-    const auto commandPayload = nlohmann::json::to_msgpack(command);
+    const auto requestId = submitCommand(command);
+    if (!requestId) {
+      return std::nullopt;
+    }
+    const auto deadline =
+        Clock::now() + std::chrono::milliseconds{_commandTimeoutMS};
+    for (;;) {
+      auto reply = readCommandReply(remainingUntil(deadline));
+      if (!reply) {
+        continue;
+      }
+      if (reply->requestId == *requestId) {
+        return std::move(reply->response);
+      }
+      _readyReplies.push_back(std::move(*reply));
+    }
+  }
 
-    if (const auto status = _commandSocket.send(zmq::buffer(commandPayload));
-        !status) {
-      SPDLOG_ERROR("Communication with command server impossible!");
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  static std::chrono::milliseconds remainingUntil(
+      const Clock::time_point deadline) {
+    return std::max(std::chrono::ceil<std::chrono::milliseconds>(
+                        deadline - Clock::now()),
+                    std::chrono::milliseconds{0});
+  }
+
+  std::optional<CommandReply> readCommandReply(
+      const std::chrono::milliseconds wait) {
+    const auto deadline = Clock::now() + wait;
+    for (;;) {
+      if (auto expired = takeExpiredCommand()) {
+        return expired;
+      }
+      std::vector<zmq::pollitem_t> items{
+          {static_cast<void*>(_commandSocket), 0, ZMQ_POLLIN, 0}};
+      zmq::poll(items, remainingUntil(deadline));
+      if (items[0].revents & ZMQ_POLLIN) {
+        if (auto reply = receiveCommandReply()) {
+          return reply;
+        }
+        continue;
+      }
+      if (Clock::now() >= deadline) {
+        return takeExpiredCommand();
+      }
+    }
+  }
+
+  // Reads one reply off the socket. Late replies to commands that already
+  // timed out, and replies to keyframe requests, yield nullopt.
+  std::optional<CommandReply> receiveCommandReply() {
+    std::vector<zmq::message_t> frames;
+    if (!zmq::recv_multipart(_commandSocket, std::back_inserter(frames),
+                             zmq::recv_flags::dontwait)) {
+      return std::nullopt;
+    }
+    if (frames.size() != 3 || frames[0].size() != sizeof(std::uint64_t) ||
+        frames[1].size() != 0) {
+      SPDLOG_WARN("Dropping malformed command reply ({} frames)",
+                  frames.size());
+      return std::nullopt;
+    }
+    std::uint64_t requestId{0};
+    std::memcpy(&requestId, frames[0].data(), sizeof(requestId));
+    if (_inFlight.erase(requestId) == 0) {
+      SPDLOG_DEBUG("Dropping late reply to command {}", requestId);
       return std::nullopt;
     }
-    zmq::message_t response;
-    if (const auto status = _commandSocket.recv(response); !status) {
-      SPDLOG_ERROR(
-          "Communication with command server impossible! Killing and "
-          "respawning the socket!");
-      _commandSocket.close();
-      _commandSocket = zmq::socket_t(_context, zmq::socket_type::req);
-      _commandSocket.set(zmq::sockopt::rcvtimeo, _commandTimeoutMS);
-      _commandSocket.set(zmq::sockopt::sndtimeo, _commandTimeoutMS);
-      _commandSocket.set(zmq::sockopt::linger, 0);
-      _commandSocket.connect(_commandAddress);
+    if (requestId == _keyframeRequestId) {
+      _keyframeRequestId.reset();
       return std::nullopt;
     }
+    CommandReply reply{.requestId = requestId};
     try {
-      const auto json = nlohmann::json::from_msgpack(
-          static_cast<const std::uint8_t*>(response.data()),
-          static_cast<const std::uint8_t*>(response.data()) + response.size());
-      return json;
+      const auto* data = static_cast<const std::uint8_t*>(frames[2].data());
+      reply.response =
+          nlohmann::json::from_msgpack(data, data + frames[2].size());
     } catch (const std::exception& e) {
       SPDLOG_ERROR("Failed to decode command response: {}", e.what());
-      return std::nullopt;
     }
+    return reply;
+  }
+
+  std::optional<CommandReply> takeExpiredCommand() {
+    const auto now = Clock::now();
+    for (auto it = _inFlight.begin(); it != _inFlight.end();) {
+      if (it->second > now) {
+        ++it;
+        continue;
+      }
+      const auto requestId = it->first;
+      it = _inFlight.erase(it);
+      if (requestId == _keyframeRequestId) {
+        _keyframeRequestId.reset();
+        continue;
+      }
+      SPDLOG_ERROR("Command {} got no response from the command server",
+                   requestId);
+      return CommandReply{.requestId = requestId};
+    }
+    return std::nullopt;
+  }
+
+  // Does not wait for the reply; it is swallowed when it arrives.
+  void requestStatusKeyframe() {
+    if (_keyframeRequested) {
+      return;
+    }
+    SPDLOG_INFO("Status stream interrupted after frame {}; requesting keyframe",
+                _statusDecoder.lastSequence());
+    const nlohmann::json request{{"type", kStatusKeyframeCommand}};
+    _keyframeRequestId = submitCommand(request);
+    _keyframeRequested = _keyframeRequestId.has_value();
   }
 
- private:
   bool m_running = false;
   zmq::context_t _context;
   zmq::socket_t _statusSocket;
@@ -103,6 +260,13 @@ class RimoClient {
   std::string _commandAddress = "ipc:///tmp/rimoCommand";
   int _statusTimeoutMS{1000};
   int _commandTimeoutMS{3000};
+  StatusDeltaDecoder _statusDecoder;
+  bool _keyframeRequested{false};
+  std::optional<std::uint64_t> _keyframeRequestId;
+  std::uint64_t _nextRequestId{1};
+  // Deadline of every command still waiting for its reply.
+  std::map<std::uint64_t, Clock::time_point> _inFlight;
+  std::deque<CommandReply> _readyReplies;
 };
 
 }  // namespace utl
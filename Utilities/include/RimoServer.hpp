@@ -1,16 +1,38 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <optional>
 #include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include <zmq.hpp>
+#include <zmq_addon.hpp>
 
 #include "Config.hpp"
 #include "JsonExtensions.hpp"
 #include "Logger.hpp"
+#include "StatusWireFormat.hpp"
 #include "nlohmann/json.hpp"
 
 namespace utl {
 
+// A command as handed to the application. `replyTo` identifies the sender's
+// envelope and is passed back to RimoServer::sendResponse.
+struct ReceivedCommand {
+  std::uint64_t replyTo{0};
+  nlohmann::json command;
+};
+
+// Commands arrive on a ROUTER socket, so any number of clients may keep
+// several requests in flight. Everything up to the empty delimiter frame is
+// the reply envelope and is echoed back verbatim: REQ clients get their
+// routing id back, DEALER clients (RimoClient) also get the request id frame
+// they put in front of the delimiter. Responses may be sent in any order and
+// from any thread.
 template <typename T>
 class RimoServer {
  public:
@@ -21,59 +43,183 @@ class RimoServer {
     if (configNode.IsDefined()) {
       _statusAddress = configNode["statusAddress"].as<std::string>();
       _commandAddress = configNode["commandAddress"].as<std::string>();
+      if (const auto encoding = configNode["statusEncoding"];
+          encoding.IsDefined()) {
+        _statusEncoding = parseStatusEncoding(encoding.as<std::string>());
+      }
+      _keyframeInterval =
+          configNode["keyframeInterval"].as<unsigned>(_keyframeInterval);
       SPDLOG_INFO("Found entry for RimoServer in the config file");
     }
 
-    SPDLOG_INFO("Starting status publisher at '{}'", _statusAddress);
+    _deltaEncoder.emplace(_keyframeInterval);
+    SPDLOG_INFO(
+        "Starting status publisher at '{}' ({} encoding, keyframe every {})",
+        _statusAddress, magic_enum::enum_name(_statusEncoding),
+        _keyframeInterval);
     _statusSocket = zmq::socket_t(_context, zmq::socket_type::pub);
     _statusSocket.bind(_statusAddress);
 
     SPDLOG_INFO("Starting command server at '{}'", _commandAddress);
-    _commandSocket = zmq::socket_t(_context, zmq::socket_type::rep);
+    _commandSocket = zmq::socket_t(_context, zmq::socket_type::router);
     _commandSocket.bind(_commandAddress);
-    _commandSocket.set(zmq::sockopt::rcvtimeo, 1000);
+
+    // Worker threads cannot touch the ROUTER socket; they queue the response
+    // and poke the receiving thread through this pipe instead.
+    _replyWakeReceiver = zmq::socket_t(_context, zmq::socket_type::pull);
+    _replyWakeReceiver.bind(kReplyWakeAddress);
+    _replyWakeSender = zmq::socket_t(_context, zmq::socket_type::push);
+    _replyWakeSender.connect(kReplyWakeAddress);
   }
   ~RimoServer() = default;
+  // The payload buffer is reused between calls, so publish() must stay on a
+  // single thread.
   void publish(const T &robot) {
-    const auto json = nlohmann::json(robot);
-    const auto payload = nlohmann::json::to_msgpack(json);
-    _statusSocket.send(zmq::buffer(payload), zmq::send_flags::none);
+    if (_statusEncoding == EStatusEncoding::Binary) {
+      _deltaEncoder->encode(robot, _statusPayload);
+    } else {
+      _statusPayload.clear();
+      nlohmann::json::to_msgpack(nlohmann::json(robot), _statusPayload);
+    }
+    _statusSocket.send(zmq::buffer(_statusPayload), zmq::send_flags::none);
   }
 
-  std::optional<nlohmann::json> receiveCommand() {
-    zmq::message_t msg;
-    if (const auto status = _commandSocket.recv(msg); !status) {
-      SPDLOG_TRACE("Timeout waiting for message from RimoClient...");
-      return std::nullopt;
+  // Sends `metrics` under kMetricsTopic. Same thread as publish().
+  void publishMetrics(const nlohmann::json& metrics) {
+    _metricsPayload.clear();
+    nlohmann::json::to_msgpack(metrics, _metricsPayload);
+    _statusSocket.send(zmq::buffer(kMetricsTopic), zmq::send_flags::sndmore);
+    _statusSocket.send(zmq::buffer(_metricsPayload), zmq::send_flags::none);
+  }
+
+  // Waits up to a second for the next command, sending queued responses
+  // meanwhile. Must always be called from the same thread.
+  std::optional<ReceivedCommand> receiveCommand() {
+    const auto deadline = std::chrono::steady_clock::now() + kReceiveTimeout;
+    for (;;) {
+      flushResponses();
+      const auto remaining =
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              deadline - std::chrono::steady_clock::now());
+      if (remaining.count() <= 0) {
+        SPDLOG_TRACE("Timeout waiting for message from RimoClient...");
+        return std::nullopt;
+      }
+      std::vector<zmq::pollitem_t> items{
+          {static_cast<void*>(_commandSocket), 0, ZMQ_POLLIN, 0},
+          {static_cast<void*>(_replyWakeReceiver), 0, ZMQ_POLLIN, 0},
+      };
+      zmq::poll(items, remaining);
+      if (items[1].revents & ZMQ_POLLIN) {
+        zmq::message_t wake;
+        while (_replyWakeReceiver.recv(wake, zmq::recv_flags::dontwait)) {
+        }
+      }
+      if (!(items[0].revents & ZMQ_POLLIN)) {
+        continue;
+      }
+      if (auto command = readCommand()) {
+        return command;
+      }
     }
+  }
+
+  // Thread safe. The response is delivered on the next pass of the thread
+  // blocked in receiveCommand().
+  void sendResponse(std::uint64_t replyTo, const nlohmann::json& response) {
+    std::vector<std::uint8_t> payload;
     try {
-      const auto json = nlohmann::json::from_msgpack(
-          static_cast<const std::uint8_t*>(msg.data()),
-          static_cast<const std::uint8_t*>(msg.data()) + msg.size());
-      return json;
+      payload = nlohmann::json::to_msgpack(response);
     } catch (const std::exception& e) {
-      SPDLOG_WARN("Invalid command payload format: {}", e.what());
-      return std::nullopt;
+      SPDLOG_ERROR("Failed to serialize command response: {}", e.what());
     }
+    std::lock_guard<std::mutex> lock(_outboxMutex);
+    _outbox.emplace_back(replyTo, std::move(payload));
+    _replyWakeSender.send(zmq::message_t{}, zmq::send_flags::dontwait);
   }
 
-  void sendResponse(const nlohmann::json& response) {
-    try {
-      const auto payload = nlohmann::json::to_msgpack(response);
+  // Sends queued responses now. Receiving-thread only; receiveCommand() does
+  // this on its own.
+  void flushResponses() {
+    std::vector<std::pair<std::uint64_t, std::vector<std::uint8_t>>> ready;
+    {
+      std::lock_guard<std::mutex> lock(_outboxMutex);
+      ready.swap(_outbox);
+    }
+    for (auto& [replyTo, payload] : ready) {
+      const auto envelope = _envelopes.find(replyTo);
+      if (envelope == _envelopes.end()) {
+        SPDLOG_WARN("Dropping response to unknown command {}", replyTo);
+        continue;
+      }
+      for (auto& frame : envelope->second) {
+        _commandSocket.send(frame, zmq::send_flags::sndmore);
+      }
       _commandSocket.send(zmq::buffer(payload), zmq::send_flags::none);
-    } catch (const std::exception& e) {
-      SPDLOG_ERROR("Failed to serialize command response: {}", e.what());
-      _commandSocket.send(zmq::buffer(std::vector<std::uint8_t>{}),
-                          zmq::send_flags::none);
+      _envelopes.erase(envelope);
     }
   }
 
  private:
+  static constexpr auto kReceiveTimeout = std::chrono::milliseconds{1000};
+  static constexpr const char* kReplyWakeAddress = "inproc://rimoReplyWake";
+
+  std::optional<ReceivedCommand> readCommand() {
+    std::vector<zmq::message_t> frames;
+    if (!zmq::recv_multipart(_commandSocket, std::back_inserter(frames),
+                             zmq::recv_flags::dontwait)) {
+      return std::nullopt;
+    }
+    auto delimiter = frames.begin();
+    while (delimiter != frames.end() && delimiter->size() != 0) {
+      ++delimiter;
+    }
+    if (delimiter == frames.end() || std::next(delimiter) == frames.end()) {
+      SPDLOG_WARN("Dropping command without a reply envelope");
+      return std::nullopt;
+    }
+    const auto& body = *std::next(delimiter);
+    const auto replyTo = _nextReplyToken++;
+    _envelopes.emplace(replyTo,
+                       std::vector<zmq::message_t>(
+                           std::make_move_iterator(frames.begin()),
+                           std::make_move_iterator(std::next(delimiter))));
+    try {
+      auto json = nlohmann::json::from_msgpack(
+          static_cast<const std::uint8_t*>(body.data()),
+          static_cast<const std::uint8_t*>(body.data()) + body.size());
+      if (json.is_object() && json.value("type", "") == kStatusKeyframeCommand) {
+        _deltaEncoder->requestKeyframe();
+        sendResponse(replyTo, {{"status", "OK"}, {"message", ""}});
+        return std::nullopt;
+      }
+      return ReceivedCommand{replyTo, std::move(json)};
+    } catch (const std::exception& e) {
+      SPDLOG_WARN("Invalid command payload format: {}", e.what());
+      sendResponse(replyTo, {{"status", "Error"},
+                             {"message", "Invalid command payload format"}});
+      return std::nullopt;
+    }
+  }
+
   zmq::context_t _context;
   zmq::socket_t _statusSocket;
   zmq::socket_t _commandSocket;
+  zmq::socket_t _replyWakeReceiver;
+  zmq::socket_t _replyWakeSender;
   std::string _statusAddress = "ipc:///tmp/rimoStatus";
   std::string _commandAddress = "ipc:///tmp/rimoCommand";
+  EStatusEncoding _statusEncoding{EStatusEncoding::Json};
+  unsigned _keyframeInterval{25};
+  std::optional<StatusDeltaEncoder> _deltaEncoder;
+  std::vector<std::uint8_t> _statusPayload;
+  std::vector<std::uint8_t> _metricsPayload;
+  // Reply envelopes of commands still being processed, by reply token. Only
+  // touched by the receiving thread.
+  std::unordered_map<std::uint64_t, std::vector<zmq::message_t>> _envelopes;
+  std::uint64_t _nextReplyToken{1};
+  std::mutex _outboxMutex;
+  std::vector<std::pair<std::uint64_t, std::vector<std::uint8_t>>> _outbox;
 };
 
 }  // namespace utl
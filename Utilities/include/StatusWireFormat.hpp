@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "CommonDefinitions.hpp"
+
+namespace utl {
+
+// How RimoServer puts RobotStatus on the wire. Json is msgpack of the
+// nlohmann representation (self-describing, handy for debugging tools);
+// Binary is the framed layout below.
+enum class EStatusEncoding { Json, Binary };
+
+// Accepts the config spellings "json" and "binary".
+EStatusEncoding parseStatusEncoding(std::string_view text);
+
+// Binary status frame, little endian:
+//   header   'R' 'S' version:u8 kind:u8 sequence:u32
+//   strings  count:u16, then count x (length:u16, bytes) - alarm and warning
+//            text only, each distinct text stored once
+//
+// A keyframe then carries the whole status:
+//   motors   count:u8, then per motor: id:u8, currentPosition:f64,
+//            targetPosition:f64, speed:f64, speedRpm:f64, torque:i32,
+//            state:u8, warning:u16, alarm:u16 (string index, 0xFFFF = empty),
+//            flagCount:u8 + (flag:u8, led:u8) pairs, speedCommandPercent:f64,
+//            modeMaxLinearSpeedMmPerSec:f64, linkState:u8
+//   tool changers  count:u8, then arm:u8, flagCount:u8 + (flag:u8, led:u8)
+//   components     count:u8, then (component:u8, led:u8)
+//   joysticks      count:u8, then arm:u8, x:f64, y:f64, btn:u8
+//   safetyOn       u8: 0 = unknown, 1 = off, 2 = on
+//   arm states     count:u8, then (arm:u8, state:u8)
+//   command queue  depth:u32, deferred:u32, waitP50Ms:f64, waitP95Ms:f64,
+//                  waitP99Ms:f64
+//
+// A delta carries only what changed since the previous frame, in the same
+// section order: motors as id:u8, fields:u16 (bit n = n-th motor field
+// above, after id) followed by those fields; tool changers with their full
+// flag list; changed components, joysticks and arm states; safetyOn 0xFF
+// when unchanged; the command queue as u8 0 when unchanged, else 1 followed
+// by all its fields. A delta never adds or removes entries - when the set of
+// motors, arms or components changes the encoder sends a keyframe.
+//
+// Enums travel as their ordinals, so reordering an enum needs a version bump.
+inline constexpr std::uint8_t kStatusWireVersion = 3;
+
+enum class EStatusFrameKind : std::uint8_t { Keyframe, Delta };
+
+// Command type a client sends on the command channel to ask for a keyframe.
+// RimoServer answers it itself; it never reaches the machine.
+inline constexpr std::string_view kStatusKeyframeCommand = "statusKeyframe";
+
+// First frame of the two-frame metrics messages on the status socket (the
+// second is msgpack). Status messages are single frames, so a subscriber
+// filtering on this topic only gets metrics.
+inline constexpr std::string_view kMetricsTopic = "metrics";
+
+// Replaces `out` with a standalone keyframe; `out` keeps its capacity.
+void encodeBinaryStatus(const RobotStatus& status,
+                        std::vector<std::uint8_t>& out,
+                        std::uint32_t sequence = 0);
+// Decodes a keyframe. Throws std::runtime_error on a delta, or on a
+// truncated, foreign or newer frame.
+RobotStatus decodeBinaryStatus(std::span<const std::uint8_t> frame);
+// True when `payload` starts with the binary header. A msgpack status always
+// starts with a map marker, so the two can be told apart on receipt.
+bool isBinaryStatus(std::span<const std::uint8_t> payload);
+
+// Publisher side of the delta stream: a keyframe every `keyframeInterval`
+// frames (1 = keyframes only) or after requestKeyframe(), deltas against the
+// previously encoded status otherwise.
+class StatusDeltaEncoder {
+ public:
+  explicit StatusDeltaEncoder(unsigned keyframeInterval = 25);
+
+  // May be called from any thread; the next frame becomes a keyframe.
+  void requestKeyframe() {
+    _keyframeRequested.store(true, std::memory_order_relaxed);
+  }
+  EStatusFrameKind encode(const RobotStatus& status,
+                          std::vector<std::uint8_t>& out);
+
+ private:
+  unsigned _keyframeInterval;
+  unsigned _framesSinceKeyframe{0};
+  std::uint32_t _sequence{0};
+  bool _hasPrevious{false};
+  RobotStatus _previous;
+  std::atomic<bool> _keyframeRequested{false};
+};
+
+// Subscriber side: rebuilds the full status from keyframes and deltas.
+class StatusDeltaDecoder {
+ public:
+  // Returns true when state() reflects the frame. False means the frame
+  // could not be applied - a delta arrived before any keyframe or after a
+  // sequence gap - and the decoder waits for a keyframe. Throws on a
+  // malformed frame (the decoder then also waits for a keyframe).
+  bool apply(std::span<const std::uint8_t> frame);
+
+  [[nodiscard]] const RobotStatus& state() const { return _state; }
+  [[nodiscard]] bool hasState() const { return _hasState; }
+  [[nodiscard]] std::uint32_t lastSequence() const { return _lastSequence; }
+  [[nodiscard]] std::uint64_t gapCount() const { return _gaps; }
+
+ private:
+  RobotStatus _state;
+  bool _hasState{false};
+  std::uint32_t _lastSequence{0};
+  std::uint64_t _gaps{0};
+};
+
+}  // namespace utl
@@ -1,14 +1,18 @@
 #pragma once
 
-#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <mutex>
-#include <string>
-#include <unordered_map>
+#include <string_view>
+#include <thread>
 #include <vector>
 
+#include "LatencyHistogram.hpp"
 #include "Logger.hpp"
 
 #ifndef RIMOKUN_TIMING_ENABLED
@@ -17,120 +21,146 @@
 
 namespace utl {
 
-#if RIMOKUN_TIMING_ENABLED
+// One call site's timings over a collection interval.
+struct TimingSummary {
+  std::string_view name;
+  std::uint64_t count{0};
+  std::uint64_t totalNs{0};
+  std::uint64_t p50Ns{0};
+  std::uint64_t p90Ns{0};
+  std::uint64_t p99Ns{0};
+  std::uint64_t p999Ns{0};
+  std::uint64_t maxNs{0};
+};
+
+// Timings of RIMO_TIMED_SCOPE call sites. Each site registers once and gets a
+// slot; every thread records into its own histogram per slot without locks
+// or allocations (after the first sample of a site on a thread). collect()
+// merges all threads; with reporting started, a background thread logs the
+// merged percentiles every few seconds, so the timed threads never sort or
+// log themselves.
 class TimingMetricsRegistry {
  public:
+  static constexpr std::size_t kMaxSites = 256;
+
   static TimingMetricsRegistry& instance() {
     static TimingMetricsRegistry registry;
     return registry;
   }
 
-  void record(const char* name, const std::chrono::nanoseconds duration) {
-    const auto nowNs = nowInNs();
-    {
-      std::lock_guard<std::mutex> lock(_mutex);
-      auto& stat = _stats[std::string(name)];
-      stat.count += 1;
-      stat.totalNs += static_cast<std::uint64_t>(duration.count());
-      stat.maxNs = std::max(stat.maxNs, static_cast<std::uint64_t>(duration.count()));
-    }
-    maybeReport(nowNs);
-  }
+  ~TimingMetricsRegistry();
 
- private:
-  struct Stat {
-    std::uint64_t count{0};
-    std::uint64_t totalNs{0};
-    std::uint64_t maxNs{0};
-  };
+  // Returns the site's slot; kMaxSites when all slots are taken, which
+  // record() ignores. `name` must outlive the registry (a literal).
+  std::size_t registerSite(const char* name);
 
-  static std::uint64_t nowInNs() {
-    return static_cast<std::uint64_t>(
-        std::chrono::duration_cast<std::chrono::nanoseconds>(
-            std::chrono::steady_clock::now().time_since_epoch())
-            .count());
-  }
-
-  void maybeReport(const std::uint64_t nowNs) {
-    if (nowNs < _nextReportNs) {
+  void record(const std::size_t site, const std::uint64_t ns) noexcept {
+    if (site >= kMaxSites) {
       return;
     }
-    std::lock_guard<std::mutex> lock(_reportMutex);
-    if (nowNs < _nextReportNs) {
-      return;
+    auto& timings = threadTimings();
+    auto* histogram = timings.sites[site].load(std::memory_order_relaxed);
+    if (histogram == nullptr) {
+      histogram = addHistogram(timings, site);
     }
-    _nextReportNs = nowNs + kReportEveryNs;
-    reportAndReset();
+    histogram->record(ns);
   }
 
-  void reportAndReset() {
-    std::vector<std::pair<std::string, Stat>> snapshot;
-    {
-      std::lock_guard<std::mutex> lock(_mutex);
-      snapshot.reserve(_stats.size());
-      for (const auto& [name, stat] : _stats) {
-        snapshot.emplace_back(name, stat);
-      }
-      _stats.clear();
-    }
-    if (snapshot.empty()) {
-      return;
-    }
-    std::sort(snapshot.begin(), snapshot.end(),
-              [](const auto& lhs, const auto& rhs) {
-                return lhs.second.totalNs > rhs.second.totalNs;
-              });
-    SPDLOG_INFO("Timing report (top {}):", std::min<std::size_t>(snapshot.size(), kTopN));
-    const auto entries = std::min<std::size_t>(snapshot.size(), kTopN);
-    for (std::size_t i = 0; i < entries; ++i) {
-      const auto& [name, stat] = snapshot[i];
-      const auto totalMs = static_cast<double>(stat.totalNs) / 1'000'000.0;
-      const auto avgUs = stat.count == 0
-                             ? 0.0
-                             : static_cast<double>(stat.totalNs) /
-                                   static_cast<double>(stat.count) / 1'000.0;
-      const auto maxUs = static_cast<double>(stat.maxNs) / 1'000.0;
-      SPDLOG_INFO("  {:<40} count={:<8} total={:>10.3f} ms avg={:>10.3f} us max={:>10.3f} us",
-                  name, stat.count, totalMs, avgUs, maxUs);
-    }
-  }
+  // Per site with samples: what all threads recorded since the previous
+  // collect(), busiest (by total time) first.
+  std::vector<TimingSummary> collect();
 
-  TimingMetricsRegistry()
-      : _nextReportNs(nowInNs() + kReportEveryNs) {}
+  // Starts the background report (once); stopReporting() joins it.
+  void startReporting(std::chrono::milliseconds every = kReportEvery);
+  void stopReporting();
 
-  static constexpr std::uint64_t kReportEveryNs = 5ull * 1'000'000'000ull;
+ private:
+  static constexpr std::chrono::milliseconds kReportEvery{5000};
   static constexpr std::size_t kTopN = 32;
 
+  struct ThreadTimings {
+    ~ThreadTimings();
+    std::array<std::atomic<LatencyHistogram*>, kMaxSites> sites{};
+    std::atomic<bool> inUse{true};
+  };
+
+  // Hands a thread its timings block for as long as it runs; blocks of
+  // finished threads are reused, and their counts carry over.
+  struct ThreadSlot {
+    ThreadSlot();
+    ~ThreadSlot();
+    ThreadTimings* timings;
+  };
+
+  TimingMetricsRegistry() = default;
+
+  static ThreadTimings& threadTimings() {
+    thread_local ThreadSlot slot;
+    return *slot.timings;
+  }
+  ThreadTimings* claimThreadTimings();
+  LatencyHistogram* addHistogram(ThreadTimings& timings, std::size_t site);
+  void reportLoop(std::chrono::milliseconds every);
+
   std::mutex _mutex;
-  std::unordered_map<std::string, Stat> _stats;
+  std::vector<const char*> _siteNames;
+  std::vector<std::unique_ptr<ThreadTimings>> _threads;
+  // Merge buffer of collect(); guarded by _collectMutex.
+  std::mutex _collectMutex;
+  std::vector<LatencySnapshot> _merged;
+
   std::mutex _reportMutex;
-  std::uint64_t _nextReportNs{0};
+  std::condition_variable _reportCv;
+  bool _stopReporting{false};
+  std::thread _reportThread;
+};
+
+// One per RIMO_TIMED_SCOPE expansion; registers the call site on first use.
+class TimingSite {
+ public:
+  explicit TimingSite(const char* name)
+      : _index(TimingMetricsRegistry::instance().registerSite(name)) {
+    TimingMetricsRegistry::instance().startReporting();
+  }
+  [[nodiscard]] std::size_t index() const { return _index; }
+
+ private:
+  std::size_t _index;
 };
 
 class ScopedTiming {
  public:
-  explicit ScopedTiming(const char* name)
-      : _name(name), _start(std::chrono::steady_clock::now()) {}
+  explicit ScopedTiming(const TimingSite& site)
+      : _site(site.index()), _start(std::chrono::steady_clock::now()) {}
 
   ~ScopedTiming() {
+    const auto elapsed = std::chrono::steady_clock::now() - _start;
     TimingMetricsRegistry::instance().record(
-        _name, std::chrono::duration_cast<std::chrono::nanoseconds>(
-                   std::chrono::steady_clock::now() - _start));
+        _site, static_cast<std::uint64_t>(
+                   std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                       .count()));
   }
 
+  ScopedTiming(const ScopedTiming&) = delete;
+  ScopedTiming& operator=(const ScopedTiming&) = delete;
+
  private:
-  const char* _name;
+  std::size_t _site;
   std::chrono::steady_clock::time_point _start;
 };
-#endif
 
 }  // namespace utl
 
 #if RIMOKUN_TIMING_ENABLED
 #define RIMO_TIMING_CONCAT_IMPL(a, b) a##b
 #define RIMO_TIMING_CONCAT(a, b) RIMO_TIMING_CONCAT_IMPL(a, b)
+#define RIMO_TIMED_SCOPE_IMPL(name_literal, id)                        \
+  static const ::utl::TimingSite RIMO_TIMING_CONCAT(_rimo_timing_site_, \
+                                                    id){name_literal};  \
+  const ::utl::ScopedTiming RIMO_TIMING_CONCAT(_rimo_timed_scope_, id)( \
+      RIMO_TIMING_CONCAT(_rimo_timing_site_, id))
 #define RIMO_TIMED_SCOPE(name_literal) \
-  ::utl::ScopedTiming RIMO_TIMING_CONCAT(_rimo_timed_scope_, __COUNTER__)(name_literal)
+  RIMO_TIMED_SCOPE_IMPL(name_literal, __COUNTER__)
 #else
 #define RIMO_TIMED_SCOPE(name_literal) ((void)0)
 #endif
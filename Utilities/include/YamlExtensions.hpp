@@ -68,6 +68,9 @@ struct convert<utl::ERobotComponent> : convert_enum<utl::ERobotComponent> {
 template <>
 struct convert<utl::EAxisState> : convert_enum<utl::EAxisState> {};
 
+template <>
+struct convert<utl::EMotorLinkState> : convert_enum<utl::EMotorLinkState> {};
+
 #if __has_include(<libserial/SerialPortConstants.h>)
 template <>
 struct convert<LibSerial::BaudRate> : convert_enum<LibSerial::BaudRate> {};
@@ -102,6 +105,7 @@ struct convert<utl::SingleMotorStatus> {
     node["flags"] = rhs.flags;
     node["speedCommandPercent"] = rhs.speedCommandPercent;
     node["modeMaxLinearSpeedMmPerSec"] = rhs.modeMaxLinearSpeedMmPerSec;
+    node["linkState"] = rhs.linkState;
     return node;
   }
 
@@ -128,6 +132,9 @@ struct convert<utl::SingleMotorStatus> {
         node["modeMaxLinearSpeedMmPerSec"]
             ? node["modeMaxLinearSpeedMmPerSec"].as<double>()
             : 0.0;
+    rhs.linkState = node["linkState"]
+                        ? node["linkState"].as<utl::EMotorLinkState>()
+                        : utl::EMotorLinkState::Online;
     return true;
   }
 };
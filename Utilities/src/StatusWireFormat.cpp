@@ -0,0 +1,652 @@
+#include "StatusWireFormat.hpp"
+
+#include <ExceptionUtils.hpp>
+
+#include <magic_enum/magic_enum.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <format>
+#include <limits>
+
+namespace utl {
+namespace {
+constexpr std::uint8_t kMagic0 = 'R';
+constexpr std::uint8_t kMagic1 = 'S';
+constexpr std::uint16_t kNoString = 0xFFFF;
+
+class FrameWriter {
+ public:
+  explicit FrameWriter(std::vector<std::uint8_t>& out) : _out(out) {}
+
+  void u8(const std::uint8_t v) { _out.push_back(v); }
+  void u16(const std::uint16_t v) {
+    _out.push_back(static_cast<std::uint8_t>(v & 0xFFu));
+    _out.push_back(static_cast<std::uint8_t>(v >> 8));
+  }
+  void u32(const std::uint32_t v) {
+    for (int shift = 0; shift < 32; shift += 8) {
+      _out.push_back(static_cast<std::uint8_t>((v >> shift) & 0xFFu));
+    }
+  }
+  void u64(const std::uint64_t v) {
+    for (int shift = 0; shift < 64; shift += 8) {
+      _out.push_back(static_cast<std::uint8_t>((v >> shift) & 0xFFu));
+    }
+  }
+  void i32(const std::int32_t v) { u32(static_cast<std::uint32_t>(v)); }
+  void f64(const double v) { u64(std::bit_cast<std::uint64_t>(v)); }
+  void bytes(std::string_view text) {
+    _out.insert(_out.end(), text.begin(), text.end());
+  }
+  template <typename TEnum>
+  void ordinal(const TEnum v) {
+    u8(static_cast<std::uint8_t>(magic_enum::enum_integer(v)));
+  }
+  template <typename TEnum, typename TValue>
+  void count(const std::map<TEnum, TValue>& map) {
+    u8(static_cast<std::uint8_t>(map.size()));
+  }
+
+ private:
+  std::vector<std::uint8_t>& _out;
+};
+
+class FrameReader {
+ public:
+  explicit FrameReader(std::span<const std::uint8_t> frame) : _frame(frame) {}
+
+  std::uint8_t u8() { return take(1)[0]; }
+  std::uint16_t u16() {
+    const auto b = take(2);
+    return static_cast<std::uint16_t>(b[0] | (b[1] << 8));
+  }
+  std::uint32_t u32() {
+    const auto b = take(4);
+    std::uint32_t v = 0;
+    for (int i = 3; i >= 0; --i) {
+      v = (v << 8) | b[static_cast<std::size_t>(i)];
+    }
+    return v;
+  }
+  std::uint64_t u64() {
+    const auto b = take(8);
+    std::uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) {
+      v = (v << 8) | b[static_cast<std::size_t>(i)];
+    }
+    return v;
+  }
+  std::int32_t i32() { return static_cast<std::int32_t>(u32()); }
+  double f64() { return std::bit_cast<double>(u64()); }
+  std::string text(const std::size_t length) {
+    const auto b = take(length);
+    return {reinterpret_cast<const char*>(b.data()), b.size()};
+  }
+  template <typename TEnum>
+  TEnum ordinal() {
+    const auto raw = u8();
+    const auto value = magic_enum::enum_cast<TEnum>(
+        static_cast<std::underlying_type_t<TEnum>>(raw));
+    if (!value) {
+      utl::throwRuntimeError(
+          std::format("Status frame has invalid enum ordinal {}", raw));
+    }
+    return *value;
+  }
+  [[nodiscard]] bool atEnd() const { return _offset == _frame.size(); }
+
+ private:
+  std::span<const std::uint8_t> take(const std::size_t n) {
+    if (_frame.size() - _offset < n) {
+      utl::throwRuntimeError(std::format(
+          "Status frame truncated at byte {} of {}", _offset, _frame.size()));
+    }
+    const auto out = _frame.subspan(_offset, n);
+    _offset += n;
+    return out;
+  }
+
+  std::span<const std::uint8_t> _frame;
+  std::size_t _offset{0};
+};
+
+// Alarm and warning text is the only free-form data in a status. Motors
+// usually share a handful of texts (or none), so each distinct one is sent
+// once and referenced by index.
+class StringTable {
+ public:
+  std::uint16_t indexOf(const std::string& text) {
+    if (text.empty()) {
+      return kNoString;
+    }
+    const auto it = std::ranges::find(_entries, std::string_view(text));
+    if (it != _entries.end()) {
+      return static_cast<std::uint16_t>(it - _entries.begin());
+    }
+    _entries.emplace_back(text);
+    return static_cast<std::uint16_t>(_entries.size() - 1);
+  }
+  void write(FrameWriter& w) const {
+    w.u16(static_cast<std::uint16_t>(_entries.size()));
+    for (const auto text : _entries) {
+      const auto length = std::min<std::size_t>(
+          text.size(), std::numeric_limits<std::uint16_t>::max());
+      w.u16(static_cast<std::uint16_t>(length));
+      w.bytes(text.substr(0, length));
+    }
+  }
+
+ private:
+  std::vector<std::string_view> _entries;
+};
+
+template <typename TFlag>
+void writeFlags(FrameWriter& w, const std::map<TFlag, ELEDState>& flags) {
+  w.count(flags);
+  for (const auto& [flag, led] : flags) {
+    w.ordinal(flag);
+    w.ordinal(led);
+  }
+}
+
+template <typename TFlag>
+std::map<TFlag, ELEDState> readFlags(FrameReader& r) {
+  std::map<TFlag, ELEDState> flags;
+  for (auto n = r.u8(); n > 0; --n) {
+    const auto flag = r.ordinal<TFlag>();
+    flags[flag] = r.ordinal<ELEDState>();
+  }
+  return flags;
+}
+
+const std::string& lookup(const std::vector<std::string>& strings,
+                          const std::uint16_t index) {
+  static const std::string empty;
+  if (index == kNoString) {
+    return empty;
+  }
+  if (index >= strings.size()) {
+    utl::throwRuntimeError(std::format(
+        "Status frame references string {} of {}", index, strings.size()));
+  }
+  return strings[index];
+}
+
+constexpr std::uint8_t kSafetyUnchanged = 0xFF;
+
+void writeCommandQueue(FrameWriter& w, const CommandQueueStatus& queue) {
+  w.u32(queue.depth);
+  w.u32(queue.deferred);
+  w.f64(queue.waitP50Ms);
+  w.f64(queue.waitP95Ms);
+  w.f64(queue.waitP99Ms);
+}
+
+CommandQueueStatus readCommandQueue(FrameReader& r) {
+  CommandQueueStatus queue;
+  queue.depth = r.u32();
+  queue.deferred = r.u32();
+  queue.waitP50Ms = r.f64();
+  queue.waitP95Ms = r.f64();
+  queue.waitP99Ms = r.f64();
+  return queue;
+}
+
+// Bits of the per-motor field mask in a delta, in wire order.
+enum MotorField : std::uint16_t {
+  kCurrentPosition = 1u << 0,
+  kTargetPosition = 1u << 1,
+  kSpeed = 1u << 2,
+  kSpeedRpm = 1u << 3,
+  kTorque = 1u << 4,
+  kState = 1u << 5,
+  kWarning = 1u << 6,
+  kAlarm = 1u << 7,
+  kFlags = 1u << 8,
+  kSpeedCommandPercent = 1u << 9,
+  kModeMaxLinearSpeed = 1u << 10,
+  kLinkState = 1u << 11,
+  kAllMotorFields = (1u << 12) - 1,
+};
+
+struct FrameHeader {
+  EStatusFrameKind kind{EStatusFrameKind::Keyframe};
+  std::uint32_t sequence{0};
+};
+
+void writeHeader(FrameWriter& w, const EStatusFrameKind kind,
+                 const std::uint32_t sequence) {
+  w.u8(kMagic0);
+  w.u8(kMagic1);
+  w.u8(kStatusWireVersion);
+  w.ordinal(kind);
+  w.u32(sequence);
+}
+
+FrameHeader readHeader(FrameReader& r) {
+  r.u8();
+  r.u8();
+  if (const auto version = r.u8(); version != kStatusWireVersion) {
+    utl::throwRuntimeError(std::format(
+        "Unsupported status frame version {} (expected {})", version,
+        kStatusWireVersion));
+  }
+  FrameHeader header;
+  header.kind = r.ordinal<EStatusFrameKind>();
+  header.sequence = r.u32();
+  return header;
+}
+
+std::vector<std::string> readStrings(FrameReader& r) {
+  std::vector<std::string> strings(r.u16());
+  for (auto& text : strings) {
+    text = r.text(r.u16());
+  }
+  return strings;
+}
+
+std::uint8_t safetyCode(const std::optional<bool>& safetyOn) {
+  return !safetyOn.has_value() ? 0 : (*safetyOn ? 2 : 1);
+}
+
+std::optional<bool> safetyFromCode(const std::uint8_t code) {
+  switch (code) {
+    case 0:
+      return std::nullopt;
+    case 1:
+      return false;
+    default:
+      return true;
+  }
+}
+
+std::uint16_t changedMotorFields(const SingleMotorStatus& before,
+                                 const SingleMotorStatus& after) {
+  std::uint16_t mask = 0;
+  const auto mark = [&mask](const bool changed, const MotorField field) {
+    if (changed) {
+      mask |= field;
+    }
+  };
+  mark(before.currentPosition != after.currentPosition, kCurrentPosition);
+  mark(before.targetPosition != after.targetPosition, kTargetPosition);
+  mark(before.speed != after.speed, kSpeed);
+  mark(before.speedRpm != after.speedRpm, kSpeedRpm);
+  mark(before.torque != after.torque, kTorque);
+  mark(before.state != after.state, kState);
+  mark(before.warningDescription != after.warningDescription, kWarning);
+  mark(before.alarmDescription != after.alarmDescription, kAlarm);
+  mark(before.flags != after.flags, kFlags);
+  mark(before.speedCommandPercent != after.speedCommandPercent,
+       kSpeedCommandPercent);
+  mark(before.modeMaxLinearSpeedMmPerSec != after.modeMaxLinearSpeedMmPerSec,
+       kModeMaxLinearSpeed);
+  mark(before.linkState != after.linkState, kLinkState);
+  return mask;
+}
+
+void writeMotorFields(FrameWriter& w, StringTable& strings,
+                      const SingleMotorStatus& motor, const std::uint16_t mask) {
+  if (mask & kCurrentPosition) w.f64(motor.currentPosition);
+  if (mask & kTargetPosition) w.f64(motor.targetPosition);
+  if (mask & kSpeed) w.f64(motor.speed);
+  if (mask & kSpeedRpm) w.f64(motor.speedRpm);
+  if (mask & kTorque) w.i32(motor.torque);
+  if (mask & kState) w.ordinal(motor.state);
+  if (mask & kWarning) w.u16(strings.indexOf(motor.warningDescription));
+  if (mask & kAlarm) w.u16(strings.indexOf(motor.alarmDescription));
+  if (mask & kFlags) writeFlags(w, motor.flags);
+  if (mask & kSpeedCommandPercent) w.f64(motor.speedCommandPercent);
+  if (mask & kModeMaxLinearSpeed) w.f64(motor.modeMaxLinearSpeedMmPerSec);
+  if (mask & kLinkState) w.ordinal(motor.linkState);
+}
+
+void readMotorFields(FrameReader& r, const std::vector<std::string>& strings,
+                     SingleMotorStatus& motor, const std::uint16_t mask) {
+  if (mask & ~kAllMotorFields) {
+    utl::throwRuntimeError(
+        std::format("Status frame has unknown motor fields 0x{:04X}", mask));
+  }
+  if (mask & kCurrentPosition) motor.currentPosition = r.f64();
+  if (mask & kTargetPosition) motor.targetPosition = r.f64();
+  if (mask & kSpeed) motor.speed = r.f64();
+  if (mask & kSpeedRpm) motor.speedRpm = r.f64();
+  if (mask & kTorque) motor.torque = r.i32();
+  if (mask & kState) motor.state = r.ordinal<ELEDState>();
+  if (mask & kWarning) motor.warningDescription = lookup(strings, r.u16());
+  if (mask & kAlarm) motor.alarmDescription = lookup(strings, r.u16());
+  if (mask & kFlags) motor.flags = readFlags<EMotorStatusFlags>(r);
+  if (mask & kSpeedCommandPercent) motor.speedCommandPercent = r.f64();
+  if (mask & kModeMaxLinearSpeed) motor.modeMaxLinearSpeedMmPerSec = r.f64();
+  if (mask & kLinkState) motor.linkState = r.ordinal<EMotorLinkState>();
+}
+
+void writeKeyframe(FrameWriter& w, const RobotStatus& status,
+                   const std::uint32_t sequence) {
+  writeHeader(w, EStatusFrameKind::Keyframe, sequence);
+
+  // The string table precedes the records that use it.
+  StringTable strings;
+  for (const auto& [id, motor] : status.motors) {
+    strings.indexOf(motor.warningDescription);
+    strings.indexOf(motor.alarmDescription);
+  }
+  strings.write(w);
+
+  w.count(status.motors);
+  for (const auto& [id, motor] : status.motors) {
+    w.ordinal(id);
+    writeMotorFields(w, strings, motor, kAllMotorFields);
+  }
+
+  w.count(status.toolChangers);
+  for (const auto& [arm, toolChanger] : status.toolChangers) {
+    w.ordinal(arm);
+    writeFlags(w, toolChanger.flags);
+  }
+
+  w.count(status.robotComponents);
+  for (const auto& [component, led] : status.robotComponents) {
+    w.ordinal(component);
+    w.ordinal(led);
+  }
+
+  w.count(status.joystics);
+  for (const auto& [arm, joystick] : status.joystics) {
+    w.ordinal(arm);
+    w.f64(joystick.x);
+    w.f64(joystick.y);
+    w.u8(joystick.btn ? 1 : 0);
+  }
+
+  w.u8(safetyCode(status.safetyOn));
+
+  w.count(status.armStates);
+  for (const auto& [arm, state] : status.armStates) {
+    w.ordinal(arm);
+    w.ordinal(state);
+  }
+
+  writeCommandQueue(w, status.commandQueue);
+}
+
+RobotStatus readKeyframeBody(FrameReader& r) {
+  const auto strings = readStrings(r);
+
+  RobotStatus status;
+  for (auto n = r.u8(); n > 0; --n) {
+    auto& motor = status.motors[r.ordinal<EMotor>()];
+    readMotorFields(r, strings, motor, kAllMotorFields);
+  }
+
+  for (auto n = r.u8(); n > 0; --n) {
+    auto& toolChanger = status.toolChangers[r.ordinal<EArm>()];
+    toolChanger.flags = readFlags<EToolChangerStatusFlags>(r);
+  }
+
+  for (auto n = r.u8(); n > 0; --n) {
+    const auto component = r.ordinal<ERobotComponent>();
+    status.robotComponents[component] = r.ordinal<ELEDState>();
+  }
+
+  for (auto n = r.u8(); n > 0; --n) {
+    auto& joystick = status.joystics[r.ordinal<EArm>()];
+    joystick.x = r.f64();
+    joystick.y = r.f64();
+    joystick.btn = r.u8() != 0;
+  }
+
+  status.safetyOn = safetyFromCode(r.u8());
+
+  for (auto n = r.u8(); n > 0; --n) {
+    const auto arm = r.ordinal<EArm>();
+    status.armStates[arm] = r.ordinal<EAxisState>();
+  }
+
+  status.commandQueue = readCommandQueue(r);
+
+  if (!r.atEnd()) {
+    utl::throwRuntimeError("Status frame has trailing bytes");
+  }
+  return status;
+}
+
+template <typename TKey, typename TValue>
+bool sameKeys(const std::map<TKey, TValue>& lhs,
+              const std::map<TKey, TValue>& rhs) {
+  return std::ranges::equal(lhs, rhs, {}, [](const auto& e) { return e.first; },
+                            [](const auto& e) { return e.first; });
+}
+
+bool sameShape(const RobotStatus& lhs, const RobotStatus& rhs) {
+  return sameKeys(lhs.motors, rhs.motors) &&
+         sameKeys(lhs.toolChangers, rhs.toolChangers) &&
+         sameKeys(lhs.robotComponents, rhs.robotComponents) &&
+         sameKeys(lhs.joystics, rhs.joystics) &&
+         sameKeys(lhs.armStates, rhs.armStates);
+}
+
+// Writes the changed entries of two same-shaped maps as (key, value...).
+template <typename TKey, typename TValue, typename TChanged, typename TWrite>
+void writeChangedEntries(FrameWriter& w, const std::map<TKey, TValue>& before,
+                         const std::map<TKey, TValue>& after,
+                         const TChanged& changed, const TWrite& write) {
+  std::uint8_t count = 0;
+  for (const auto& [key, value] : after) {
+    count += changed(before.at(key), value) ? 1 : 0;
+  }
+  w.u8(count);
+  for (const auto& [key, value] : after) {
+    if (changed(before.at(key), value)) {
+      w.ordinal(key);
+      write(value);
+    }
+  }
+}
+
+template <typename TKey, typename TValue>
+TValue& existingEntry(std::map<TKey, TValue>& map, const TKey key) {
+  const auto it = map.find(key);
+  if (it == map.end()) {
+    utl::throwRuntimeError(
+        std::format("Status delta updates unknown entry {}",
+                    magic_enum::enum_integer(key)));
+  }
+  return it->second;
+}
+
+void writeDelta(FrameWriter& w, const RobotStatus& before,
+                const RobotStatus& after, const std::uint32_t sequence) {
+  writeHeader(w, EStatusFrameKind::Delta, sequence);
+
+  std::vector<std::pair<EMotor, std::uint16_t>> motorChanges;
+  StringTable strings;
+  for (const auto& [id, motor] : after.motors) {
+    const auto mask = changedMotorFields(before.motors.at(id), motor);
+    if (mask == 0) {
+      continue;
+    }
+    motorChanges.emplace_back(id, mask);
+    if (mask & kWarning) strings.indexOf(motor.warningDescription);
+    if (mask & kAlarm) strings.indexOf(motor.alarmDescription);
+  }
+  strings.write(w);
+
+  w.u8(static_cast<std::uint8_t>(motorChanges.size()));
+  for (const auto& [id, mask] : motorChanges) {
+    w.ordinal(id);
+    w.u16(mask);
+    writeMotorFields(w, strings, after.motors.at(id), mask);
+  }
+
+  writeChangedEntries(
+      w, before.toolChangers, after.toolChangers,
+      [](const auto& lhs, const auto& rhs) { return lhs.flags != rhs.flags; },
+      [&w](const ToolChangerStatus& v) { writeFlags(w, v.flags); });
+  writeChangedEntries(
+      w, before.robotComponents, after.robotComponents,
+      [](const auto lhs, const auto rhs) { return lhs != rhs; },
+      [&w](const ELEDState v) { w.ordinal(v); });
+  writeChangedEntries(
+      w, before.joystics, after.joystics,
+      [](const auto& lhs, const auto& rhs) {
+        return lhs.x != rhs.x || lhs.y != rhs.y || lhs.btn != rhs.btn;
+      },
+      [&w](const JoystickStatus& v) {
+        w.f64(v.x);
+        w.f64(v.y);
+        w.u8(v.btn ? 1 : 0);
+      });
+
+  w.u8(before.safetyOn == after.safetyOn ? kSafetyUnchanged
+                                         : safetyCode(after.safetyOn));
+
+  writeChangedEntries(
+      w, before.armStates, after.armStates,
+      [](const auto lhs, const auto rhs) { return lhs != rhs; },
+      [&w](const EAxisState v) { w.ordinal(v); });
+
+  if (before.commandQueue == after.commandQueue) {
+    w.u8(0);
+  } else {
+    w.u8(1);
+    writeCommandQueue(w, after.commandQueue);
+  }
+}
+
+void applyDeltaBody(FrameReader& r, RobotStatus& status) {
+  const auto strings = readStrings(r);
+
+  for (auto n = r.u8(); n > 0; --n) {
+    auto& motor = existingEntry(status.motors, r.ordinal<EMotor>());
+    readMotorFields(r, strings, motor, r.u16());
+  }
+
+  for (auto n = r.u8(); n > 0; --n) {
+    auto& toolChanger = existingEntry(status.toolChangers, r.ordinal<EArm>());
+    toolChanger.flags = readFlags<EToolChangerStatusFlags>(r);
+  }
+
+  for (auto n = r.u8(); n > 0; --n) {
+    auto& led =
+        existingEntry(status.robotComponents, r.ordinal<ERobotComponent>());
+    led = r.ordinal<ELEDState>();
+  }
+
+  for (auto n = r.u8(); n > 0; --n) {
+    auto& joystick = existingEntry(status.joystics, r.ordinal<EArm>());
+    joystick.x = r.f64();
+    joystick.y = r.f64();
+    joystick.btn = r.u8() != 0;
+  }
+
+  if (const auto safety = r.u8(); safety != kSafetyUnchanged) {
+    status.safetyOn = safetyFromCode(safety);
+  }
+
+  for (auto n = r.u8(); n > 0; --n) {
+    auto& state = existingEntry(status.armStates, r.ordinal<EArm>());
+    state = r.ordinal<EAxisState>();
+  }
+
+  if (r.u8() != 0) {
+    status.commandQueue = readCommandQueue(r);
+  }
+
+  if (!r.atEnd()) {
+    utl::throwRuntimeError("Status frame has trailing bytes");
+  }
+}
+}  // namespace
+
+EStatusEncoding parseStatusEncoding(const std::string_view text) {
+  if (text == "json") {
+    return EStatusEncoding::Json;
+  }
+  if (text == "binary") {
+    return EStatusEncoding::Binary;
+  }
+  utl::throwRuntimeError(std::format(
+      "Unknown status encoding '{}' (expected 'json' or 'binary')", text));
+}
+
+bool isBinaryStatus(std::span<const std::uint8_t> payload) {
+  return payload.size() >= 3 && payload[0] == kMagic0 && payload[1] == kMagic1;
+}
+
+void encodeBinaryStatus(const RobotStatus& status,
+                        std::vector<std::uint8_t>& out,
+                        const std::uint32_t sequence) {
+  out.clear();
+  FrameWriter w(out);
+  writeKeyframe(w, status, sequence);
+}
+
+RobotStatus decodeBinaryStatus(std::span<const std::uint8_t> frame) {
+  if (!isBinaryStatus(frame)) {
+    utl::throwRuntimeError("Status frame has no binary status header");
+  }
+  FrameReader r(frame);
+  if (readHeader(r).kind != EStatusFrameKind::Keyframe) {
+    utl::throwRuntimeError("Status delta cannot be decoded on its own");
+  }
+  return readKeyframeBody(r);
+}
+
+StatusDeltaEncoder::StatusDeltaEncoder(const unsigned keyframeInterval)
+    : _keyframeInterval(keyframeInterval) {
+  if (_keyframeInterval == 0) {
+    utl::throwRuntimeError("Status keyframe interval must be at least 1");
+  }
+}
+
+EStatusFrameKind StatusDeltaEncoder::encode(const RobotStatus& status,
+                                            std::vector<std::uint8_t>& out) {
+  const bool requested =
+      _keyframeRequested.exchange(false, std::memory_order_relaxed);
+  const bool keyframe = requested || !_hasPrevious ||
+                        _framesSinceKeyframe + 1 >= _keyframeInterval ||
+                        !sameShape(_previous, status);
+  out.clear();
+  FrameWriter w(out);
+  if (keyframe) {
+    writeKeyframe(w, status, _sequence);
+    _framesSinceKeyframe = 0;
+  } else {
+    writeDelta(w, _previous, status, _sequence);
+    ++_framesSinceKeyframe;
+  }
+  ++_sequence;
+  _previous = status;
+  _hasPrevious = true;
+  return keyframe ? EStatusFrameKind::Keyframe : EStatusFrameKind::Delta;
+}
+
+bool StatusDeltaDecoder::apply(std::span<const std::uint8_t> frame) {
+  if (!isBinaryStatus(frame)) {
+    utl::throwRuntimeError("Status frame has no binary status header");
+  }
+  FrameReader r(frame);
+  const auto header = readHeader(r);
+  if (header.kind == EStatusFrameKind::Keyframe) {
+    _hasState = false;
+    _state = readKeyframeBody(r);
+  } else {
+    if (!_hasState) {
+      return false;
+    }
+    if (header.sequence != _lastSequence + 1) {
+      ++_gaps;
+      _hasState = false;
+      return false;
+    }
+    _hasState = false;  // stays false if the delta turns out malformed
+    applyDeltaBody(r, _state);
+  }
+  _hasState = true;
+  _lastSequence = header.sequence;
+  return true;
+}
+
+}  // namespace utl
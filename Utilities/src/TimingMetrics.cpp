@@ -0,0 +1,148 @@
+#include "TimingMetrics.hpp"
+
+#include <algorithm>
+#include <ranges>
+
+namespace utl {
+
+TimingMetricsRegistry::~TimingMetricsRegistry() { stopReporting(); }
+
+TimingMetricsRegistry::ThreadTimings::~ThreadTimings() {
+  for (auto& site : sites) {
+    delete site.load(std::memory_order_relaxed);
+  }
+}
+
+TimingMetricsRegistry::ThreadSlot::ThreadSlot()
+    : timings(instance().claimThreadTimings()) {}
+
+TimingMetricsRegistry::ThreadSlot::~ThreadSlot() {
+  timings->inUse.store(false, std::memory_order_release);
+}
+
+std::size_t TimingMetricsRegistry::registerSite(const char* name) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_siteNames.size() >= kMaxSites) {
+    SPDLOG_WARN("Timing site '{}' not recorded: all {} slots are taken", name,
+                kMaxSites);
+    return kMaxSites;
+  }
+  _siteNames.push_back(name);
+  return _siteNames.size() - 1;
+}
+
+TimingMetricsRegistry::ThreadTimings*
+TimingMetricsRegistry::claimThreadTimings() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  for (auto& timings : _threads) {
+    bool expected = false;
+    if (timings->inUse.compare_exchange_strong(expected, true,
+                                               std::memory_order_acquire)) {
+      return timings.get();
+    }
+  }
+  _threads.push_back(std::make_unique<ThreadTimings>());
+  return _threads.back().get();
+}
+
+LatencyHistogram* TimingMetricsRegistry::addHistogram(ThreadTimings& timings,
+                                                      const std::size_t site) {
+  auto* histogram = new LatencyHistogram;
+  timings.sites[site].store(histogram, std::memory_order_release);
+  return histogram;
+}
+
+std::vector<TimingSummary> TimingMetricsRegistry::collect() {
+  std::lock_guard<std::mutex> collectLock(_collectMutex);
+  std::vector<const char*> names;
+  std::vector<ThreadTimings*> threads;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    names = _siteNames;
+    threads.reserve(_threads.size());
+    for (const auto& timings : _threads) {
+      threads.push_back(timings.get());
+    }
+  }
+  _merged.resize(names.size());
+  for (auto* timings : threads) {
+    for (std::size_t site = 0; site < names.size(); ++site) {
+      if (auto* histogram =
+              timings->sites[site].load(std::memory_order_acquire)) {
+        histogram->collectInto(_merged[site]);
+      }
+    }
+  }
+  std::vector<TimingSummary> summaries;
+  for (std::size_t site = 0; site < names.size(); ++site) {
+    auto& merged = _merged[site];
+    if (merged.count == 0) {
+      merged.clear();
+      continue;
+    }
+    summaries.push_back({.name = names[site],
+                         .count = merged.count,
+                         .totalNs = merged.totalNs,
+                         .p50Ns = merged.percentileNs(0.50),
+                         .p90Ns = merged.percentileNs(0.90),
+                         .p99Ns = merged.percentileNs(0.99),
+                         .p999Ns = merged.percentileNs(0.999),
+                         .maxNs = merged.maxNs});
+    merged.clear();
+  }
+  std::ranges::sort(summaries, std::ranges::greater{},
+                    &TimingSummary::totalNs);
+  return summaries;
+}
+
+void TimingMetricsRegistry::startReporting(
+    const std::chrono::milliseconds every) {
+  std::lock_guard<std::mutex> lock(_reportMutex);
+  if (_reportThread.joinable()) {
+    return;
+  }
+  _stopReporting = false;
+  _reportThread = std::thread([this, every] { reportLoop(every); });
+}
+
+void TimingMetricsRegistry::stopReporting() {
+  {
+    std::lock_guard<std::mutex> lock(_reportMutex);
+    _stopReporting = true;
+  }
+  _reportCv.notify_all();
+  if (_reportThread.joinable()) {
+    _reportThread.join();
+  }
+}
+
+void TimingMetricsRegistry::reportLoop(const std::chrono::milliseconds every) {
+  const auto toUs = [](const std::uint64_t ns) {
+    return static_cast<double>(ns) / 1'000.0;
+  };
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(_reportMutex);
+      if (_reportCv.wait_for(lock, every, [this] { return _stopReporting; })) {
+        return;
+      }
+    }
+    const auto summaries = collect();
+    if (summaries.empty()) {
+      continue;
+    }
+    const auto entries = std::min(summaries.size(), kTopN);
+    SPDLOG_INFO("Timing report (top {}):", entries);
+    for (const auto& stat : summaries | std::views::take(entries)) {
+      SPDLOG_INFO(
+          "  {:<40} count={:<8} total={:>10.3f} ms p50={:>9.3f} us "
+          "p90={:>9.3f} us p99={:>9.3f} us p99.9={:>9.3f} us max={:>9.3f} us",
+          stat.name, stat.count,
+          static_cast<double>(stat.totalNs) / 1'000'000.0, toUs(stat.p50Ns),
+          toUs(stat.p90Ns), toUs(stat.p99Ns), toUs(stat.p999Ns),
+          toUs(stat.maxNs));
+    }
+  }
+}
+
+}  // namespace utl
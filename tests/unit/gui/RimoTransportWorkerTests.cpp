@@ -7,6 +7,7 @@
 #include <mutex>
 #include <nlohmann/json.hpp>
 #include <thread>
+#include <vector>
 
 namespace {
 class FakeRimoGuiClient final : public IRimoGuiClient {
@@ -23,16 +24,42 @@ class FakeRimoGuiClient final : public IRimoGuiClient {
     return status;
   }
 
-  std::optional<nlohmann::json> sendCommand(
+  std::optional<std::uint64_t> submitCommand(
       const nlohmann::json& command) override {
     std::lock_guard<std::mutex> lock(mutex);
     sentCommands.push_back(command);
-    if (commandResponses.empty()) {
+    const auto requestId = ++lastRequestId;
+    utl::CommandReply reply{.requestId = requestId};
+    if (!commandResponses.empty()) {
+      reply.response = commandResponses.front();
+      commandResponses.pop();
+    }
+    if (holdReplies) {
+      heldReplies.push_back(std::move(reply));
+    } else {
+      replies.push(std::move(reply));
+    }
+    return requestId;
+  }
+
+  std::optional<utl::CommandReply> pollCommandReply(
+      std::chrono::milliseconds) override {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (replies.empty()) {
       return std::nullopt;
     }
-    auto response = commandResponses.front();
-    commandResponses.pop();
-    return response;
+    auto reply = replies.front();
+    replies.pop();
+    return reply;
+  }
+
+  // Delivers held replies in reverse submission order.
+  void releaseHeldReplies() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = heldReplies.rbegin(); it != heldReplies.rend(); ++it) {
+      replies.push(*it);
+    }
+    heldReplies.clear();
   }
 
   std::atomic<int> initCalls{0};
@@ -40,6 +67,10 @@ class FakeRimoGuiClient final : public IRimoGuiClient {
   std::queue<utl::RobotStatus> statuses;
   std::queue<nlohmann::json> commandResponses;
   std::vector<nlohmann::json> sentCommands;
+  std::uint64_t lastRequestId{100};
+  bool holdReplies{false};
+  std::vector<utl::CommandReply> heldReplies;
+  std::queue<utl::CommandReply> replies;
 };
 
 bool waitFor(const std::function<bool()>& predicate, const int timeoutMs = 500) {
@@ -69,7 +100,7 @@ TEST(RimoTransportWorkerTests, EmitsStatusAndConnectionLostCallbacks) {
   RimoTransportWorker worker(std::move(fakeClient));
   std::atomic<int> statusCalls{0};
   std::atomic<int> lostCalls{0};
-  worker.start([&](const utl::RobotStatus&) { ++statusCalls; },
+  worker.start([&](RobotStatusPtr) { ++statusCalls; },
                [&]() { ++lostCalls; }, [&](const ITransportWorker::ResponseEvent&) {});
 
   ASSERT_TRUE(waitFor([&]() { return statusCalls.load() > 0; }));
@@ -98,7 +129,7 @@ TEST(RimoTransportWorkerTests, ProcessesQueuedCommandAndEmitsResponse) {
   std::optional<ITransportWorker::ResponseEvent> responseEvent;
 
   worker.start(
-      [](const utl::RobotStatus&) {}, []() {},
+      [](RobotStatusPtr) {}, []() {},
       [&](const ITransportWorker::ResponseEvent& event) {
         {
           std::lock_guard<std::mutex> lock(responseMutex);
@@ -127,3 +158,48 @@ TEST(RimoTransportWorkerTests, ProcessesQueuedCommandAndEmitsResponse) {
   std::lock_guard<std::mutex> lock(clientRaw->mutex);
   ASSERT_EQ(clientRaw->sentCommands.size(), 1U);
 }
+
+TEST(RimoTransportWorkerTests, PipelinesCommandsAndMatchesRepliesById) {
+  auto fakeClient = std::make_unique<FakeRimoGuiClient>();
+  auto* clientRaw = fakeClient.get();
+  {
+    std::lock_guard<std::mutex> lock(clientRaw->mutex);
+    clientRaw->holdReplies = true;
+    clientRaw->commandResponses.push({{"status", "OK"}, {"message", "first"}});
+    clientRaw->commandResponses.push({{"status", "OK"}, {"message", "second"}});
+  }
+
+  RimoTransportWorker worker(std::move(fakeClient));
+  std::mutex responseMutex;
+  std::vector<ITransportWorker::ResponseEvent> events;
+  worker.start([](RobotStatusPtr) {}, []() {},
+               [&](const ITransportWorker::ResponseEvent& event) {
+                 std::lock_guard<std::mutex> lock(responseMutex);
+                 events.push_back(event);
+               });
+
+  GuiCommand command;
+  command.payload =
+      GuiReconnectCommand{.component = utl::ERobotComponent::Contec};
+  worker.enqueue({.id = 1, .command = command});
+  worker.enqueue({.id = 2, .command = command});
+
+  // Both requests go out before either is answered.
+  ASSERT_TRUE(waitFor([&]() {
+    std::lock_guard<std::mutex> lock(clientRaw->mutex);
+    return clientRaw->heldReplies.size() == 2;
+  }));
+  clientRaw->releaseHeldReplies();
+  ASSERT_TRUE(waitFor([&]() {
+    std::lock_guard<std::mutex> lock(responseMutex);
+    return events.size() == 2;
+  }));
+  worker.stop();
+
+  ASSERT_EQ(events[0].id, 2U);
+  ASSERT_TRUE(events[0].response.has_value());
+  EXPECT_EQ(events[0].response->message, "second");
+  ASSERT_EQ(events[1].id, 1U);
+  ASSERT_TRUE(events[1].response.has_value());
+  EXPECT_EQ(events[1].response->message, "first");
+}
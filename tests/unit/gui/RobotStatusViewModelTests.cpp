@@ -30,7 +30,7 @@ TEST(RobotStatusViewModelTests, ResetControlsMapsServerAndComponentStates) {
   status.robotComponents[utl::ERobotComponent::ControlPanel] = utl::ELEDState::Off;
 
   const auto vm =
-      RobotStatusViewModel::resetControlsForStatus(std::make_optional(status));
+      RobotStatusViewModel::resetControlsForStatus(&status);
   EXPECT_EQ(vm.server, utl::ELEDState::On);
   EXPECT_EQ(vm.contec, utl::ELEDState::Error);
   EXPECT_EQ(vm.motor, utl::ELEDState::On);
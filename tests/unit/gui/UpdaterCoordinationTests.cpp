@@ -26,7 +26,7 @@ class FakeTransportWorker final : public ITransportWorker {
 
   void emitStatus(const utl::RobotStatus& status) const {
     if (statusCb) {
-      statusCb(status);
+      statusCb(std::make_shared<const utl::RobotStatus>(status));
     }
   }
 
@@ -135,3 +135,37 @@ TEST(UpdaterCoordinationTests, ForwardsStatusConnectionAndResponses) {
   updater.stopUpdaterThread();
   EXPECT_TRUE(workerRaw->stopped);
 }
+
+TEST(UpdaterCoordinationTests, BusyGuiThreadOnlySeesNewestStatus) {
+  (void)ensureApp();
+  auto fakeWorker = std::make_unique<FakeTransportWorker>();
+  auto* workerRaw = fakeWorker.get();
+
+  Updater updater(nullptr, std::move(fakeWorker),
+                  [](const QString&, const QString&) {});
+  QSignalSpy statusSpy(&updater, &Updater::newDataArrived);
+  updater.startUpdaterThread();
+
+  // Frames arriving while the event loop is not running are conflated.
+  for (int i = 1; i <= 5; ++i) {
+    utl::RobotStatus status;
+    status.motors[utl::EMotor::XLeft].currentPosition = i;
+    workerRaw->emitStatus(status);
+  }
+  pumpEvents();
+
+  ASSERT_EQ(statusSpy.count(), 1);
+  const auto delivered = statusSpy.takeFirst().at(0).value<RobotStatusPtr>();
+  ASSERT_NE(delivered, nullptr);
+  EXPECT_EQ(delivered->motors.at(utl::EMotor::XLeft).currentPosition, 5.0);
+  EXPECT_EQ(updater.queuedStatusFrames(), 5U);
+  EXPECT_EQ(updater.droppedStatusFrames(), 4U);
+
+  utl::RobotStatus next;
+  workerRaw->emitStatus(next);
+  pumpEvents();
+  EXPECT_EQ(statusSpy.count(), 1);
+  EXPECT_EQ(updater.droppedStatusFrames(), 4U);
+
+  updater.stopUpdaterThread();
+}
@@ -8,6 +8,7 @@ class GuiStateStoreQtTests final : public QObject {
  private slots:
   void firstStatusMarksConnectedAndEmitsSignals();
   void disconnectEmitsConnectionChangedFalseOnce();
+  void statusIsSharedNotCopied();
 };
 
 void GuiStateStoreQtTests::firstStatusMarksConnectedAndEmitsSignals() {
@@ -17,22 +18,21 @@ void GuiStateStoreQtTests::firstStatusMarksConnectedAndEmitsSignals() {
 
   utl::RobotStatus status;
   status.robotComponents[utl::ERobotComponent::Contec] = utl::ELEDState::On;
-  store.onStatusReceived(status);
+  store.onStatusReceived(std::make_shared<const utl::RobotStatus>(status));
 
   QCOMPARE(statusSpy.count(), 1);
   QCOMPARE(connSpy.count(), 1);
   const auto args = connSpy.takeFirst();
   QCOMPARE(args.at(0).toBool(), true);
   QVERIFY(store.isConnected());
-  QVERIFY(store.latestStatus().has_value());
+  QVERIFY(store.latestStatus() != nullptr);
 }
 
 void GuiStateStoreQtTests::disconnectEmitsConnectionChangedFalseOnce() {
   GuiStateStore store;
   QSignalSpy connSpy(&store, &GuiStateStore::connectionChanged);
 
-  utl::RobotStatus status;
-  store.onStatusReceived(status);
+  store.onStatusReceived(std::make_shared<const utl::RobotStatus>());
   QCOMPARE(connSpy.count(), 1);
   connSpy.clear();
 
@@ -46,5 +46,18 @@ void GuiStateStoreQtTests::disconnectEmitsConnectionChangedFalseOnce() {
   QCOMPARE(connSpy.count(), 0);
 }
 
+void GuiStateStoreQtTests::statusIsSharedNotCopied() {
+  GuiStateStore store;
+  QSignalSpy statusSpy(&store, &GuiStateStore::statusUpdated);
+
+  const auto status = std::make_shared<const utl::RobotStatus>();
+  store.onStatusReceived(status);
+  store.onStatusReceived(nullptr);
+
+  QCOMPARE(statusSpy.count(), 1);
+  QCOMPARE(statusSpy.takeFirst().at(0).value<RobotStatusPtr>(), status);
+  QCOMPARE(store.latestStatus(), status);
+}
+
 QTEST_MAIN(GuiStateStoreQtTests)
 #include "GuiStateStoreQtTests.moc"
@@ -50,7 +50,7 @@ void ResetControlsPresenterQtTests::mapsStatusAndConnectionStateIntoView() {
   status.robotComponents[utl::ERobotComponent::MotorControl] = utl::ELEDState::On;
   status.robotComponents[utl::ERobotComponent::ControlPanel] =
       utl::ELEDState::Off;
-  store.onStatusReceived(status);
+  store.onStatusReceived(std::make_shared<const utl::RobotStatus>(status));
 
   QCOMPARE(server->state(), utl::ELEDState::On);
   QCOMPARE(contec->state(), utl::ELEDState::Error);
@@ -29,7 +29,7 @@ void ToolChangerPresenterQtTests::mapsStatusIntoViewAndResetsOnDisconnect() {
   tc.flags[utl::EToolChangerStatusFlags::ClosedValve] = utl::ELEDState::On;
   status.toolChangers[utl::EArm::Left] = tc;
 
-  store.onStatusReceived(status);
+  store.onStatusReceived(std::make_shared<const utl::RobotStatus>(status));
 
   auto* prox = view.findChild<LedIndicator*>("proxLamp");
   auto* open = view.findChild<LedIndicator*>("openLamp");
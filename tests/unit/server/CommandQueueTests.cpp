@@ -5,6 +5,7 @@
 #include <atomic>
 #include <chrono>
 #include <future>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -121,3 +122,75 @@ TEST(CommandQueueTests, ShutdownRejectsNewPushesUnderLoad) {
   }
   EXPECT_EQ(drained, accepted.load(std::memory_order_relaxed));
 }
+
+TEST(CommandQueueTests, PushBeyondMaxSizeIsRejected) {
+  cmd::CommandQueue queue(2);
+  ASSERT_TRUE(queue.push(makeReconnectCommand()));
+  ASSERT_TRUE(queue.push(makeReconnectCommand()));
+
+  EXPECT_FALSE(queue.push(makeReconnectCommand()));
+  EXPECT_EQ(queue.size(), 2u);
+
+  ASSERT_TRUE(queue.try_pop().has_value());
+  EXPECT_TRUE(queue.push(makeReconnectCommand()));
+}
+
+TEST(CommandQueueTests, EmptyTracksPushAndPop) {
+  cmd::CommandQueue queue;
+  EXPECT_TRUE(queue.empty());
+
+  ASSERT_TRUE(queue.push(makeReconnectCommand()));
+  EXPECT_FALSE(queue.empty());
+
+  ASSERT_TRUE(queue.try_pop().has_value());
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(CommandQueueTests, ReplyReachesFutureThroughQueue) {
+  cmd::CommandQueue queue;
+  auto command = makeReconnectCommand();
+  auto future = command.reply.get_future();
+  ASSERT_TRUE(queue.push(std::move(command)));
+
+  auto popped = queue.try_pop();
+  ASSERT_TRUE(popped.has_value());
+  EXPECT_EQ(future.wait_for(0ms), std::future_status::timeout);
+  popped->reply.set_value("done");
+
+  ASSERT_EQ(future.wait_for(0ms), std::future_status::ready);
+  EXPECT_EQ(future.get(), "done");
+}
+
+TEST(CommandQueueTests, ReplyToAbandonedFutureIsHarmless) {
+  auto command = makeReconnectCommand();
+  {
+    auto future = command.reply.get_future();
+    EXPECT_EQ(future.wait_for(1ms), std::future_status::timeout);
+  }
+  command.reply.set_value("late");
+}
+
+TEST(CommandQueueTests, DroppedCommandWakesItsFuture) {
+  cmd::ReplyFuture future;
+  {
+    auto command = makeReconnectCommand();
+    future = command.reply.get_future();
+  }
+  ASSERT_EQ(future.wait_for(0ms), std::future_status::ready);
+  EXPECT_FALSE(future.get().empty());
+}
+
+TEST(CommandQueueTests, MoreOutstandingRepliesThanPooledSlots) {
+  constexpr int kOutstanding = 3 * cmd::detail::ReplySlotPool::kSlots;
+  std::vector<cmd::Command> commands(kOutstanding);
+  std::vector<cmd::ReplyFuture> futures;
+  for (auto& command : commands) {
+    futures.push_back(command.reply.get_future());
+  }
+  for (int i = 0; i < kOutstanding; ++i) {
+    commands[i].reply.set_value(std::to_string(i));
+  }
+  for (int i = 0; i < kOutstanding; ++i) {
+    EXPECT_EQ(futures[i].get(), std::to_string(i));
+  }
+}
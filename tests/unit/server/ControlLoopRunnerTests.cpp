@@ -3,14 +3,70 @@
 #include <ControlLoopRunner.hpp>
 
 #include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "server/fakes/FakeClock.hpp"
 
 using namespace std::chrono_literals;
 
+namespace {
+// The loop as Machine registers it: control and command steps every cycle,
+// the status update every `updateInterval`; each cycle supplies its steps.
+class StepLoop {
+ public:
+  static constexpr ControlLoopRunner::TaskId kControl = 0;
+  static constexpr ControlLoopRunner::TaskId kCommand = 1;
+  static constexpr ControlLoopRunner::TaskId kUpdate = 2;
+
+  StepLoop(IClock& clock, const std::chrono::milliseconds loopInterval,
+           const std::chrono::milliseconds updateInterval)
+      : _runner(clock, loopInterval) {
+    _runner.addTask({.name = "control",
+                     .period = loopInterval,
+                     .phase = 0ms,
+                     .priority = 2},
+                    [this]() { _control(); });
+    _runner.addTask({.name = "commands",
+                     .period = loopInterval,
+                     .phase = 0ms,
+                     .priority = 1},
+                    [this]() { _command(); });
+    _runner.addTask({.name = "status",
+                     .period = updateInterval,
+                     .phase = 0ms,
+                     .priority = 0},
+                    [this]() { _update(); });
+  }
+
+  [[nodiscard]] ControlLoopRunner::State makeInitialState() const {
+    return _runner.makeInitialState();
+  }
+
+  void runOneCycle(std::function<void()> control,
+                   std::function<void()> command,
+                   std::function<void()> update,
+                   ControlLoopRunner::State& state) {
+    _control = std::move(control);
+    _command = std::move(command);
+    _update = std::move(update);
+    _runner.runOneCycle(state);
+  }
+
+ private:
+  ControlLoopRunner _runner;
+  std::function<void()> _control;
+  std::function<void()> _command;
+  std::function<void()> _update;
+};
+}  // namespace
+
 TEST(ControlLoopRunnerTests, RunsControlAndCommandEachCycleAndThrottlesUpdate) {
   FakeClock clock;
-  ControlLoopRunner runner(clock, 10ms, 50ms);
+  StepLoop runner(clock, 10ms, 50ms);
   auto state = runner.makeInitialState();
 
   int controlCalls = 0;
@@ -29,7 +85,7 @@ TEST(ControlLoopRunnerTests, RunsControlAndCommandEachCycleAndThrottlesUpdate) {
 
 TEST(ControlLoopRunnerTests, OverrunResynchronizesNextLoopTick) {
   FakeClock clock;
-  ControlLoopRunner runner(clock, 10ms, 50ms);
+  StepLoop runner(clock, 10ms, 50ms);
   auto state = runner.makeInitialState();
 
   runner.runOneCycle([&]() { clock.advanceBy(25ms); }, []() {}, []() {}, state);
@@ -41,7 +97,7 @@ TEST(ControlLoopRunnerTests, OverrunResynchronizesNextLoopTick) {
 
 TEST(ControlLoopRunnerTests, DutyCycleWindowResetsAndSchedulesNextLogSecond) {
   FakeClock clock;
-  ControlLoopRunner runner(clock, 10ms, 50ms);
+  StepLoop runner(clock, 10ms, 50ms);
   auto state = runner.makeInitialState();
   state.nextDutyLogAt = IClock::time_point{0ms};
 
@@ -52,16 +108,28 @@ TEST(ControlLoopRunnerTests, DutyCycleWindowResetsAndSchedulesNextLogSecond) {
   EXPECT_EQ(state.nextDutyLogAt, IClock::time_point{1s});
 }
 
+TEST(ControlLoopRunnerTests, DutyCycleIncludesStatusUpdateStep) {
+  FakeClock clock;
+  StepLoop runner(clock, 10ms, 50ms);
+  auto state = runner.makeInitialState();
+
+  runner.runOneCycle([&]() { clock.advanceBy(2ms); }, []() {},
+                     [&]() { clock.advanceBy(3ms); }, state);
+
+  EXPECT_EQ(state.dutyCycleSamples, 1u);
+  EXPECT_DOUBLE_EQ(state.dutyCycleSum, 0.5);
+}
+
 TEST(ControlLoopRunnerTests, LargeOverrunTriggersAtMostOneUpdatePerCycle) {
   FakeClock clock;
-  ControlLoopRunner runner(clock, 10ms, 50ms);
+  StepLoop runner(clock, 10ms, 50ms);
   auto state = runner.makeInitialState();
   int updateCalls = 0;
 
   runner.runOneCycle([&]() { clock.advanceBy(220ms); }, []() {},
                      [&]() { ++updateCalls; }, state);
   EXPECT_EQ(updateCalls, 1);
-  EXPECT_EQ(state.nextUpdateAt, IClock::time_point{250ms});
+  EXPECT_EQ(state.tasks[StepLoop::kUpdate].nextReleaseAt, IClock::time_point{250ms});
 
   runner.runOneCycle([]() {}, []() {}, [&]() { ++updateCalls; }, state);
   EXPECT_EQ(updateCalls, 1);
@@ -69,7 +137,7 @@ TEST(ControlLoopRunnerTests, LargeOverrunTriggersAtMostOneUpdatePerCycle) {
 
 TEST(ControlLoopRunnerTests, OneMillisecondIntervalsStayMonotonicUnderRepeatedOverrun) {
   FakeClock clock;
-  ControlLoopRunner runner(clock, 1ms, 1ms);
+  StepLoop runner(clock, 1ms, 1ms);
   auto state = runner.makeInitialState();
 
   int updateCalls = 0;
@@ -85,3 +153,241 @@ TEST(ControlLoopRunnerTests, OneMillisecondIntervalsStayMonotonicUnderRepeatedOv
 
   EXPECT_EQ(updateCalls, 10);
 }
+
+TEST(ControlLoopRunnerTests, MetricsRecordWorkWakeLatencyAndOverruns) {
+  FakeClock clock;
+  StepLoop runner(clock, 10ms, 50ms);
+  auto state = runner.makeInitialState();
+
+  runner.runOneCycle([&]() { clock.advanceBy(4ms); }, []() {}, []() {}, state);
+  runner.runOneCycle([&]() { clock.advanceBy(12ms); }, []() {}, []() {}, state);
+
+  EXPECT_EQ(state.metrics.cycles, 2u);
+  EXPECT_EQ(state.metrics.overruns, 1u);
+  EXPECT_EQ(state.metrics.work.count, 2u);
+  EXPECT_EQ(state.metrics.work.maxNs, 12'000'000u);
+  EXPECT_EQ(state.metrics.wakeLatency.count, 2u);
+  EXPECT_EQ(state.metrics.wakeLatency.maxNs, 0u);
+}
+
+TEST(ControlLoopRunnerTests, TasksAreTimedAndOverrunsNameTheLongestTask) {
+  FakeClock clock;
+  StepLoop runner(clock, 10ms, 50ms);
+  auto state = runner.makeInitialState();
+
+  runner.runOneCycle([&]() { clock.advanceBy(1ms); },
+                     [&]() { clock.advanceBy(2ms); },
+                     [&]() { clock.advanceBy(9ms); }, state);
+  runner.runOneCycle([]() {}, [&]() { clock.advanceBy(15ms); }, []() {},
+                     state);
+
+  EXPECT_EQ(state.metrics.tasks[StepLoop::kControl].time.count, 2u);
+  EXPECT_EQ(state.metrics.tasks[StepLoop::kControl].time.maxNs, 1'000'000u);
+  EXPECT_EQ(state.metrics.tasks[StepLoop::kCommand].time.maxNs, 15'000'000u);
+  EXPECT_EQ(state.metrics.tasks[StepLoop::kUpdate].time.count, 1u);
+  EXPECT_EQ(state.metrics.tasks[StepLoop::kUpdate].time.maxNs, 9'000'000u);
+  EXPECT_EQ(state.metrics.overruns, 2u);
+
+  const auto overruns = state.overrunLog.recent();
+  ASSERT_EQ(overruns.size(), 2u);
+  EXPECT_EQ(overruns[0].culprit, StepLoop::kUpdate);
+  EXPECT_EQ(overruns[0].late, 2ms);
+  EXPECT_EQ(overruns[1].culprit, StepLoop::kCommand);
+  EXPECT_EQ(overruns[1].startedAt, IClock::time_point{20ms});
+  EXPECT_EQ(overruns[1].late, 5ms);
+  EXPECT_EQ(state.nextLoopAt, IClock::time_point{40ms});
+}
+
+TEST(ControlLoopRunnerTests, PeriodAndJitterFollowCycleStarts) {
+  FakeClock clock;
+  StepLoop runner(clock, 10ms, 50ms);
+  auto state = runner.makeInitialState();
+
+  runner.runOneCycle([]() {}, []() {}, []() {}, state);
+  runner.runOneCycle([&]() { clock.advanceBy(13ms); }, []() {}, []() {},
+                     state);
+  runner.runOneCycle([]() {}, []() {}, []() {}, state);
+
+  EXPECT_EQ(state.metrics.period.count, 2u);
+  EXPECT_EQ(state.metrics.period.maxNs, 20'000'000u);
+  EXPECT_EQ(state.metrics.jitter.count, 2u);
+  EXPECT_EQ(state.metrics.jitter.maxNs, 10'000'000u);
+}
+
+TEST(ControlLoopRunnerTests, OverrunLogKeepsTheMostRecent) {
+  ControlLoopOverrunLog log;
+  for (int i = 0; i < 40; ++i) {
+    log.push({.startedAt = IClock::time_point{std::chrono::milliseconds{i}}});
+  }
+
+  const auto overruns = log.recent();
+  EXPECT_EQ(log.total(), 40u);
+  ASSERT_EQ(overruns.size(), ControlLoopOverrunLog::kCapacity);
+  EXPECT_EQ(overruns.front().startedAt, IClock::time_point{8ms});
+  EXPECT_EQ(overruns.back().startedAt, IClock::time_point{39ms});
+}
+
+TEST(ControlLoopRunnerTests, TasksRunAtTheirOwnPeriodsByPriority) {
+  FakeClock clock;
+  ControlLoopRunner runner(clock, 10ms);
+  std::vector<std::string> order;
+  runner.addTask({.name = "slow", .period = 50ms, .phase = 0ms},
+                 [&]() { order.emplace_back("slow"); });
+  runner.addTask({.name = "fast", .period = 20ms, .phase = 0ms, .priority = 1},
+                 [&]() { order.emplace_back("fast"); });
+  auto state = runner.makeInitialState();
+
+  runner.runOneCycle(state);
+  EXPECT_EQ(order, (std::vector<std::string>{"fast", "slow"}));
+  for (int i = 1; i < 10; ++i) {
+    runner.runOneCycle(state);
+  }
+
+  EXPECT_EQ(state.metrics.tasks[0].runs, 2u);
+  EXPECT_EQ(state.metrics.tasks[1].runs, 5u);
+  EXPECT_EQ(state.metrics.cycles, 10u);
+}
+
+TEST(ControlLoopRunnerTests, TasksWithoutPhaseAreStaggered) {
+  FakeClock clock;
+  ControlLoopRunner runner(clock, 10ms);
+  const auto every = runner.addTask({.name = "every", .period = 10ms}, []() {});
+  const auto a = runner.addTask({.name = "a", .period = 20ms}, []() {});
+  const auto b = runner.addTask({.name = "b", .period = 20ms}, []() {});
+  const auto c = runner.addTask({.name = "c", .period = 40ms}, []() {});
+  const auto pinned =
+      runner.addTask({.name = "pinned", .period = 40ms, .phase = 30ms}, []() {});
+  const auto d = runner.addTask({.name = "d", .period = 40ms}, []() {});
+
+  EXPECT_EQ(runner.task(every).phase, 0ms);
+  EXPECT_EQ(runner.task(a).phase, 0ms);
+  EXPECT_EQ(runner.task(b).phase, 10ms);
+  EXPECT_EQ(runner.task(c).phase, 0ms);
+  EXPECT_EQ(runner.task(pinned).phase, 30ms);
+  // Of the four cycles c and d repeat over, 0 and 3 already hold two
+  // releases; 1 is the first of the quieter ones.
+  EXPECT_EQ(runner.task(d).phase, 10ms);
+}
+
+TEST(ControlLoopRunnerTests, OverrunPoliciesHandleMissedReleases) {
+  FakeClock clock;
+  ControlLoopRunner runner(clock, 10ms);
+  auto stall = 0ms;
+  runner.addTask({.name = "stall", .period = 10ms, .priority = 1},
+                 [&]() { clock.advanceBy(stall); });
+  const auto skip = runner.addTask(
+      {.name = "skip", .period = 30ms, .phase = 0ms}, []() {});
+  const auto catchUp = runner.addTask({.name = "catchUp",
+                                       .period = 30ms,
+                                       .phase = 0ms,
+                                       .overrun = LoopTaskOverrun::CatchUp},
+                                      []() {});
+  const auto restart = runner.addTask({.name = "restart",
+                                       .period = 30ms,
+                                       .phase = 0ms,
+                                       .overrun = LoopTaskOverrun::Restart},
+                                      []() {});
+  auto state = runner.makeInitialState();
+
+  runner.runOneCycle(state);  // t=0
+  stall = 75ms;
+  runner.runOneCycle(state);  // t=10, every task runs late at t=85
+  stall = 0ms;
+  EXPECT_EQ(state.nextLoopAt, IClock::time_point{90ms});
+  EXPECT_EQ(state.tasks[skip].nextReleaseAt, IClock::time_point{90ms});
+  EXPECT_EQ(state.tasks[catchUp].nextReleaseAt, IClock::time_point{60ms});
+  EXPECT_EQ(state.tasks[restart].nextReleaseAt, IClock::time_point{115ms});
+  for (int i = 0; i < 4; ++i) {  // t=90, 100, 110, 120
+    runner.runOneCycle(state);
+  }
+
+  const auto& tasks = state.metrics.tasks;
+  EXPECT_EQ(tasks[skip].runs, 4u);
+  EXPECT_EQ(tasks[skip].skippedReleases, 1u);
+  EXPECT_EQ(tasks[catchUp].runs, 5u);
+  EXPECT_EQ(tasks[catchUp].skippedReleases, 0u);
+  EXPECT_EQ(tasks[restart].runs, 3u);
+  EXPECT_EQ(tasks[restart].lateness.maxNs, 55'000'000u);
+}
+
+TEST(ControlLoopRunnerTests, AddTaskValidatesTheSchedule) {
+  FakeClock clock;
+  ControlLoopRunner runner(clock, 10ms);
+  EXPECT_THROW(runner.addTask({.name = "none", .period = 0ms}, []() {}),
+               std::runtime_error);
+  EXPECT_THROW(
+      runner.addTask({.name = "early", .period = 20ms, .phase = -5ms}, []() {}),
+      std::runtime_error);
+  const auto fast = runner.addTask({.name = "fast", .period = 2ms}, []() {});
+  EXPECT_EQ(runner.task(fast).period, 10ms);
+  while (runner.taskCount() < kMaxLoopTasks) {
+    runner.addTask({.name = "filler", .period = 10ms}, []() {});
+  }
+  EXPECT_THROW(runner.addTask({.name = "extra", .period = 10ms}, []() {}),
+               std::runtime_error);
+}
+
+TEST(ControlLoopRunnerTests, WakeupRunsTheWakeStepBeforeTheTick) {
+  FakeClock clock;
+  ControlLoopRunner runner(clock, 10ms);
+  LoopWakeup wakeup;
+  int ticks = 0;
+  int wakeSteps = 0;
+  runner.addTask({.name = "control", .period = 10ms, .phase = 0ms},
+                 [&]() { ++ticks; });
+  runner.setWakeStep(wakeup, 2ms, [&]() { ++wakeSteps; });
+  auto state = runner.makeInitialState();
+
+  runner.runOneCycle(state);  // t=0
+  clock.advanceBy(1ms);
+  wakeup.notify();
+  runner.runOneCycle(state);  // held back until t=2 by the spacing
+  EXPECT_EQ(clock.now(), IClock::time_point{2ms});
+  EXPECT_EQ(wakeSteps, 1);
+  EXPECT_EQ(ticks, 1);
+  runner.runOneCycle(state);  // t=10, the tick stays on its grid
+
+  EXPECT_EQ(clock.now(), IClock::time_point{10ms});
+  EXPECT_EQ(wakeSteps, 1);
+  EXPECT_EQ(ticks, 2);
+  EXPECT_EQ(state.metrics.cycles, 2u);
+  EXPECT_EQ(state.metrics.wakeSteps, 1u);
+  EXPECT_EQ(state.metrics.wakeStepTime.count, 1u);
+}
+
+TEST(ControlLoopRunnerTests, WakeupsTheTickServesRunNoWakeStep) {
+  FakeClock clock;
+  ControlLoopRunner runner(clock, 10ms);
+  LoopWakeup wakeup;
+  int wakeSteps = 0;
+  runner.addTask({.name = "control", .period = 10ms, .phase = 0ms}, []() {});
+  runner.setWakeStep(wakeup, 10ms, [&]() { ++wakeSteps; });
+  auto state = runner.makeInitialState();
+
+  // Already due: the tick takes the notification along.
+  wakeup.notify();
+  runner.runOneCycle(state);  // t=0
+  EXPECT_FALSE(wakeup.consume());
+  // The spacing reaches the next tick, so that tick serves it.
+  wakeup.notify();
+  runner.runOneCycle(state);
+
+  EXPECT_EQ(clock.now(), IClock::time_point{10ms});
+  EXPECT_EQ(wakeSteps, 0);
+  EXPECT_EQ(state.metrics.cycles, 2u);
+}
+
+TEST(ControlLoopRunnerTests, LoopWakeupEndsAWaitEarly) {
+  LoopWakeup wakeup;
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(wakeup.waitUntil(start + 5ms));
+  EXPECT_GE(std::chrono::steady_clock::now(), start + 5ms);
+
+  std::thread notifier([&]() {
+    std::this_thread::sleep_for(5ms);
+    wakeup.notify();
+  });
+  EXPECT_TRUE(wakeup.waitUntil(std::chrono::steady_clock::now() + 10s));
+  notifier.join();
+  EXPECT_FALSE(wakeup.consume());
+}
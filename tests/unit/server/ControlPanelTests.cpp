@@ -413,3 +413,25 @@ TEST(ControlPanelTests, ConcurrentSnapshotReadsAreStableDuringUpdates) {
   EXPECT_FALSE(badValue.load(std::memory_order_acquire));
   panel.reset();
 }
+
+TEST(ControlPanelTests, ChangeListenerFiresOnThresholdsAndButtonEdges) {
+  auto fake = std::make_unique<FakeControlPanelComm>();
+  auto* fakeRaw = fake.get();
+  ControlPanel panel(std::move(fake), 1, 1, 1);
+  std::atomic<int> changes{0};
+  panel.setChangeListener([&] { changes.fetch_add(1); });
+
+  panel.initialize();
+  fakeRaw->pushLine(makeLine(512, 512, 0));  // baseline, all neutral
+  fakeRaw->pushLine(makeLine(520, 512, 0));  // moved less than the delta
+  fakeRaw->pushLine(makeLine(526, 512, 0));  // past the delta
+  fakeRaw->pushLine(makeLine(530, 512, 0));  // within the delta of 526
+  fakeRaw->pushLine(makeLine(572, 512, 0));  // across the activation threshold
+  fakeRaw->pushLine(makeLine(572, 512, 0, 512, 512, 1));  // button edge
+
+  ASSERT_TRUE(waitUntil([&] { return changes.load() >= 3; }));
+  std::this_thread::sleep_for(30ms);
+  EXPECT_EQ(changes.load(), 3);
+
+  panel.reset();
+}
@@ -342,6 +342,28 @@ TEST(MachineCommandProcessorTests,
   EXPECT_TRUE(response["response"].contains("outputs"));
 }
 
+TEST(MachineCommandProcessorTests, MetricsCommandReturnsStructuredResponse) {
+  nlohmann::json command{
+      {"type", "metrics"},
+  };
+
+  const auto response = cmd::processCommand(
+      command, [&](cmd::Command c, const std::chrono::milliseconds) {
+        EXPECT_TRUE(std::holds_alternative<cmd::MetricsCommand>(c.payload));
+        return std::string(R"({"loop":{"cycles":3},"snapshotAgeMs":12})");
+      });
+
+  EXPECT_EQ(response["status"].get<std::string>(), "OK");
+  EXPECT_EQ(response["response"]["loop"]["cycles"].get<int>(), 3);
+
+  const auto failed = cmd::processCommand(
+      command, [&](cmd::Command, const std::chrono::milliseconds) {
+        return std::string("No metrics gathered yet");
+      });
+  EXPECT_EQ(failed["status"].get<std::string>(), "Error");
+  EXPECT_EQ(failed["message"].get<std::string>(), "No metrics gathered yet");
+}
+
 TEST(MachineCommandProcessorTests, SetMotorEnabledCommandParsesAndDispatches) {
   
   nlohmann::json command{
@@ -11,6 +11,7 @@
 #include <queue>
 #include <string>
 #include <thread>
+#include <vector>
 
 using namespace std::chrono_literals;
 
@@ -20,7 +21,7 @@ class FakeCommandChannel final : public ICommandChannel {
   explicit FakeCommandChannel(const std::chrono::milliseconds receiveWait)
       : _receiveWait(receiveWait) {}
 
-  std::optional<nlohmann::json> receiveCommand() override {
+  std::optional<utl::ReceivedCommand> receiveCommand() override {
     std::unique_lock<std::mutex> lock(_mutex);
     _cv.wait_for(lock, _receiveWait, [this]() { return !_commands.empty(); });
     if (_commands.empty()) {
@@ -31,20 +32,30 @@ class FakeCommandChannel final : public ICommandChannel {
     return cmd;
   }
 
-  void sendResponse(const nlohmann::json& response) override {
+  void sendResponse(const std::uint64_t replyTo,
+                    const nlohmann::json& response) override {
     {
       std::lock_guard<std::mutex> lock(_mutex);
       _responses.push(response);
+      _replyOrder.push_back(replyTo);
     }
     _cv.notify_all();
   }
 
-  void enqueueCommand(const nlohmann::json& command) {
+  std::uint64_t enqueueCommand(const nlohmann::json& command) {
+    std::uint64_t replyTo = 0;
     {
       std::lock_guard<std::mutex> lock(_mutex);
-      _commands.push(command);
+      replyTo = ++_lastReplyTo;
+      _commands.push({.replyTo = replyTo, .command = command});
     }
     _cv.notify_all();
+    return replyTo;
+  }
+
+  std::vector<std::uint64_t> replyOrder() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _replyOrder;
   }
 
   std::optional<nlohmann::json> popResponseWaitFor(
@@ -63,8 +74,10 @@ class FakeCommandChannel final : public ICommandChannel {
   std::chrono::milliseconds _receiveWait;
   std::mutex _mutex;
   std::condition_variable _cv;
-  std::queue<nlohmann::json> _commands;
+  std::queue<utl::ReceivedCommand> _commands;
   std::queue<nlohmann::json> _responses;
+  std::vector<std::uint64_t> _replyOrder;
+  std::uint64_t _lastReplyTo{0};
 };
 }  // namespace
 
@@ -188,3 +201,122 @@ TEST(MachineCommandServerTests, MalformedCommandsReturnErrorsAndLoopKeepsServing
   running.store(false, std::memory_order_release);
   serverThread.join();
 }
+
+TEST(MachineCommandServerTests, SlowCommandDoesNotBlockOtherCommands) {
+  FakeCommandChannel channel(20ms);
+  MachineCommandServer commandServer(channel, 2);
+  std::atomic<bool> running{true};
+
+  std::mutex releaseMutex;
+  std::condition_variable releaseCv;
+  bool released = false;
+  std::thread serverThread([&]() {
+    commandServer.runLoop(
+        running, [&](cmd::Command command, const std::chrono::milliseconds) {
+          if (std::holds_alternative<cmd::MotorDiagnosticsCommand>(
+                  command.payload)) {
+            std::unique_lock<std::mutex> lock(releaseMutex);
+            releaseCv.wait(lock, [&]() { return released; });
+            return std::string{R"({"ok":true})"};
+          }
+          return std::string{};
+        });
+  });
+
+  const auto slowId = channel.enqueueCommand(
+      {{"type", "motorDiagnostics"}, {"motor", "XLeft"}});
+  const auto fastId =
+      channel.enqueueCommand({{"type", "reset"}, {"system", "ControlPanel"}});
+
+  const auto fast = channel.popResponseWaitFor(500ms);
+  ASSERT_TRUE(fast.has_value());
+  EXPECT_EQ((*fast)["status"].get<std::string>(), "OK");
+  EXPECT_EQ(channel.replyOrder(), std::vector<std::uint64_t>{fastId});
+
+  {
+    std::lock_guard<std::mutex> lock(releaseMutex);
+    released = true;
+  }
+  releaseCv.notify_all();
+  const auto slow = channel.popResponseWaitFor(500ms);
+  ASSERT_TRUE(slow.has_value());
+  EXPECT_EQ((*slow)["status"].get<std::string>(), "OK");
+  EXPECT_EQ(channel.replyOrder(),
+            (std::vector<std::uint64_t>{fastId, slowId}));
+
+  running.store(false, std::memory_order_release);
+  serverThread.join();
+}
+
+TEST(MachineCommandServerTests, AnswersCommandsStillQueuedAtShutdown) {
+  FakeCommandChannel channel(20ms);
+  MachineCommandServer commandServer(channel, 1);
+  std::atomic<bool> running{true};
+
+  std::atomic<int> dispatchCalls{0};
+  std::thread serverThread([&]() {
+    commandServer.runLoop(
+        running, [&](cmd::Command, const std::chrono::milliseconds) {
+          std::this_thread::sleep_for(30ms);
+          ++dispatchCalls;
+          return std::string{};
+        });
+  });
+
+  for (int i = 0; i < 3; ++i) {
+    channel.enqueueCommand({{"type", "reset"}, {"system", "ControlPanel"}});
+  }
+  ASSERT_TRUE(channel.popResponseWaitFor(500ms).has_value());
+  running.store(false, std::memory_order_release);
+  serverThread.join();
+
+  EXPECT_EQ(dispatchCalls.load(), 3);
+  EXPECT_EQ(channel.replyOrder().size(), 3U);
+}
+
+TEST(MachineCommandServerTests, EmergencyStopIsNotQueuedBehindBusyWorkers) {
+  FakeCommandChannel channel(20ms);
+  MachineCommandServer commandServer(channel, 1);
+  std::atomic<bool> running{true};
+
+  std::mutex releaseMutex;
+  std::condition_variable releaseCv;
+  bool released = false;
+  std::thread serverThread([&]() {
+    commandServer.runLoop(
+        running, [&](cmd::Command command, const std::chrono::milliseconds) {
+          if (std::holds_alternative<cmd::MotorDiagnosticsCommand>(
+                  command.payload)) {
+            std::unique_lock<std::mutex> lock(releaseMutex);
+            releaseCv.wait(lock, [&]() { return released; });
+            return std::string{R"({"ok":true})"};
+          }
+          return std::string{};
+        });
+  });
+
+  // The only worker is stuck and a second command waits behind it.
+  const auto slowId = channel.enqueueCommand(
+      {{"type", "motorDiagnostics"}, {"motor", "XLeft"}});
+  const auto queuedId =
+      channel.enqueueCommand({{"type", "reset"}, {"system", "ControlPanel"}});
+  const auto stopId = channel.enqueueCommand({{"type", "emergencyStop"}});
+
+  const auto stop = channel.popResponseWaitFor(500ms);
+  ASSERT_TRUE(stop.has_value());
+  EXPECT_EQ((*stop)["status"].get<std::string>(), "OK");
+  EXPECT_EQ(channel.replyOrder(), std::vector<std::uint64_t>{stopId});
+
+  {
+    std::lock_guard<std::mutex> lock(releaseMutex);
+    released = true;
+  }
+  releaseCv.notify_all();
+  ASSERT_TRUE(channel.popResponseWaitFor(500ms).has_value());
+  ASSERT_TRUE(channel.popResponseWaitFor(500ms).has_value());
+  EXPECT_EQ(channel.replyOrder(),
+            (std::vector<std::uint64_t>{stopId, slowId, queuedId}));
+
+  running.store(false, std::memory_order_release);
+  serverThread.join();
+}
@@ -84,6 +84,7 @@ class CommandTestMachine final : public Machine {
       : Machine(clock) {}
 
   int reconnectCalls{0};
+  int toolChangerCalls{0};
 
  protected:
   void controlLoopTasks() override {}
@@ -91,7 +92,9 @@ class CommandTestMachine final : public Machine {
   void handleReconnectCommand(const cmd::ReconnectCommand&) override {
     ++reconnectCalls;
   }
-  void handleToolChangerCommand(const cmd::ToolChangerCommand&) override {}
+  void handleToolChangerCommand(const cmd::ToolChangerCommand&) override {
+    ++toolChangerCalls;
+  }
 };
 
 class FlakyCommandTestMachine final : public Machine {
@@ -263,7 +266,7 @@ TEST(MachineCommandTests, CommandsAreProcessedInFifoOrderOnePerCycle) {
   machine.wire();
   Machine::LoopState state{};
 
-  std::vector<std::future<std::string>> futures;
+  std::vector<cmd::ReplyFuture> futures;
   for (const auto component : {utl::ERobotComponent::ControlPanel,
                                utl::ERobotComponent::Contec,
                                utl::ERobotComponent::MotorControl}) {
@@ -329,7 +332,7 @@ TEST(MachineCommandTests, ShutdownFlushesAllQueuedCommandsWithShutdownReply) {
   auto fakeClock = std::make_shared<FakeClock>();
   CommandTestMachine machine(fakeClock);
 
-  std::vector<std::future<std::string>> futures;
+  std::vector<cmd::ReplyFuture> futures;
   for (int i = 0; i < 3; ++i) {
     cmd::Command command;
     command.payload = cmd::ReconnectCommand{utl::ERobotComponent::ControlPanel};
@@ -347,3 +350,173 @@ TEST(MachineCommandTests, ShutdownFlushesAllQueuedCommandsWithShutdownReply) {
 
   std::filesystem::remove(configPath);
 }
+
+TEST(MachineCommandTests, CheapCommandsAreDrainedTogetherExpensiveOnesOnePerCycle) {
+  const auto configPath = writeTempConfig();
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  auto fakeClock = std::make_shared<FakeClock>();
+  CommandTestMachine machine(fakeClock);
+  machine.wire();
+  Machine::LoopState state{};
+
+  std::vector<cmd::ReplyFuture> futures;
+  const auto submit = [&](cmd::Command command) {
+    futures.push_back(command.reply.get_future());
+    ASSERT_TRUE(machine.submitCommand(std::move(command)));
+  };
+  for (int i = 0; i < 8; ++i) {
+    cmd::Command command;
+    if (i == 2 || i == 5) {
+      command.payload =
+          cmd::ReconnectCommand{utl::ERobotComponent::ControlPanel};
+    } else {
+      command.payload = cmd::ToolChangerCommand{
+          utl::EArm::Left, utl::EToolChangerAction::Open};
+    }
+    submit(std::move(command));
+  }
+
+  machine.runOneCycle(state);
+  EXPECT_EQ(machine.toolChangerCalls, 6);
+  EXPECT_EQ(machine.reconnectCalls, 1);
+  EXPECT_EQ(machine.commandQueueStatus().deferred, 1u);
+
+  machine.runOneCycle(state);
+  EXPECT_EQ(machine.reconnectCalls, 2);
+  for (auto& future : futures) {
+    ASSERT_EQ(future.wait_for(50ms), std::future_status::ready);
+  }
+
+  std::filesystem::remove(configPath);
+}
+
+TEST(MachineCommandTests, CommandQueueStatusReportsDepthAndWaitPercentiles) {
+  const auto configPath = writeTempConfig();
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  auto fakeClock = std::make_shared<FakeClock>();
+  CommandTestMachine machine(fakeClock);
+  machine.wire();
+  Machine::LoopState state{};
+
+  for (int i = 0; i < 3; ++i) {
+    cmd::Command command;
+    command.payload =
+        cmd::ToolChangerCommand{utl::EArm::Right, utl::EToolChangerAction::Close};
+    ASSERT_TRUE(machine.submitCommand(std::move(command)));
+  }
+  auto status = machine.commandQueueStatus();
+  EXPECT_EQ(status.depth, 3u);
+  EXPECT_EQ(status.waitP50Ms, 0.0);
+
+  fakeClock->advanceBy(40ms);
+  machine.runOneCycle(state);
+  status = machine.commandQueueStatus();
+  EXPECT_EQ(status.depth, 0u);
+  EXPECT_GE(status.waitP50Ms, 40.0);
+  EXPECT_GE(status.waitP99Ms, status.waitP50Ms);
+
+  std::filesystem::remove(configPath);
+}
+
+TEST(MachineCommandTests, MotorDiagnosticsRunAsJobBesideOtherCommands) {
+  const auto configPath = writeTempConfig();
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  auto fakeClock = std::make_shared<FakeClock>();
+  CommandTestMachine machine(fakeClock);
+  machine.wire();
+  Machine::LoopState state{};
+
+  cmd::Command diagnostics;
+  diagnostics.payload = cmd::MotorDiagnosticsCommand{utl::EMotor::XLeft};
+  auto diagnosticsFuture = diagnostics.reply.get_future();
+  ASSERT_TRUE(machine.submitCommand(std::move(diagnostics)));
+  cmd::Command reconnect;
+  reconnect.payload = cmd::ReconnectCommand{utl::ERobotComponent::ControlPanel};
+  ASSERT_TRUE(machine.submitCommand(std::move(reconnect)));
+
+  machine.runOneCycle(state);
+  // Starting the job does not use up the cycle's one expensive command.
+  EXPECT_EQ(machine.reconnectCalls, 1);
+  // MotorControl is not initialized here, so the first read fails and ends
+  // the job.
+  ASSERT_EQ(diagnosticsFuture.wait_for(50ms), std::future_status::ready);
+  const auto response = nlohmann::json::parse(diagnosticsFuture.get());
+  EXPECT_EQ(response["motor"], "XLeft");
+  EXPECT_TRUE(response.contains("diagnosticsError"));
+  EXPECT_EQ(machine.commandQueueStatus().deferred, 0u);
+
+  std::filesystem::remove(configPath);
+}
+
+TEST(MachineCommandTests, MotorDiagnosticsAreServedFromSnapshotWithAge) {
+  const auto configPath = writeTempConfig();
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  auto fakeClock = std::make_shared<FakeClock>();
+  CommandTestMachine machine(fakeClock);
+  machine.wire();
+  Machine::LoopState state{};
+
+  const auto requestDiagnostics = [&]() {
+    cmd::Command command;
+    command.payload = cmd::MotorDiagnosticsCommand{utl::EMotor::XLeft};
+    auto future = command.reply.get_future();
+    EXPECT_TRUE(machine.submitCommand(std::move(command)));
+    machine.runOneCycle(state);
+    EXPECT_EQ(future.wait_for(50ms), std::future_status::ready);
+    return nlohmann::json::parse(future.get());
+  };
+
+  EXPECT_EQ(requestDiagnostics()["snapshotAgeMs"], 0);
+
+  // Within the refresh interval every viewer gets the same snapshot.
+  fakeClock->advanceBy(200ms);
+  EXPECT_EQ(requestDiagnostics()["snapshotAgeMs"], 200);
+  EXPECT_EQ(requestDiagnostics()["snapshotAgeMs"], 200);
+
+  // A watched motor is re-read once its snapshot is due.
+  fakeClock->advanceBy(1000ms);
+  machine.runOneCycle(state);
+  EXPECT_EQ(requestDiagnostics()["snapshotAgeMs"], 0);
+
+  std::filesystem::remove(configPath);
+}
+
+TEST(MachineCommandTests, MetricsCommandServesLatestSnapshot) {
+  const auto configPath = writeTempConfig();
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  auto fakeClock = std::make_shared<FakeClock>();
+  CommandTestMachine machine(fakeClock);
+  machine.wire();
+  Machine::LoopState state{};
+
+  const auto requestMetrics = [&]() {
+    cmd::Command command;
+    command.payload = cmd::MetricsCommand{};
+    auto future = command.reply.get_future();
+    EXPECT_TRUE(machine.submitCommand(std::move(command)));
+    machine.runOneCycle(state);
+    EXPECT_EQ(future.wait_for(50ms), std::future_status::ready);
+    return future.get();
+  };
+
+  EXPECT_EQ(requestMetrics(), "No metrics gathered yet");
+
+  fakeClock->advanceBy(1000ms);
+  machine.runOneCycle(state);
+  fakeClock->advanceBy(20ms);
+  const auto metrics = nlohmann::json::parse(requestMetrics());
+  EXPECT_EQ(metrics["intervalMs"], 1000);
+  EXPECT_GE(metrics["loop"]["cycles"].get<int>(), 2);
+  EXPECT_EQ(metrics["loop"]["tasks"][0]["name"], "control");
+  EXPECT_EQ(metrics["commandQueue"]["wait"]["count"], 1);
+  ASSERT_TRUE(metrics["modbus"].is_array());
+  EXPECT_EQ(metrics["modbus"][0]["line"], "contec");
+  EXPECT_GT(metrics["snapshotAgeMs"].get<int>(), 0);
+
+  std::filesystem::remove(configPath);
+}
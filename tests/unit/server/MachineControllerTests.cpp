@@ -264,3 +264,47 @@ TEST(MachineControllerTests, AccelerationAndDecelerationIntentsAreApplied) {
   EXPECT_NE(std::find(applied.begin(), applied.end(), "acceleration"), applied.end());
   EXPECT_NE(std::find(applied.begin(), applied.end(), "deceleration"), applied.end());
 }
+
+TEST(MachineControllerTests, MotorIntentsRunInsideDriverInputBatch) {
+  utl::RobotStatus status;
+  auto policy = std::make_unique<FakeControlPolicy>();
+  policy->decisionToReturn.motorIntents.push_back(
+      {.motorId = utl::EMotor::XLeft,
+       .direction = MotorControlDirection::Reverse,
+       .startMovement = true});
+
+  std::vector<std::string> calls;
+  bool inBatch = false;
+  MachineController controller(
+      MachineController::IoOps{
+          .readInputs = []() -> std::optional<signal_map_t> { return signal_map_t{}; },
+          .setOutputs = [](const signal_map_t&) {},
+          .readOutputs = []() -> std::optional<signal_map_t> { return std::nullopt; },
+          .contecState = []() { return MachineComponent::State::Normal; },
+      },
+      MachineController::MotorOps{
+          .setDirection =
+              [&](utl::EMotor, MotorControlDirection) {
+                calls.emplace_back(inBatch ? "direction" : "direction (unbatched)");
+              },
+          .start =
+              [&](utl::EMotor) {
+                calls.emplace_back(inBatch ? "start" : "start (unbatched)");
+              },
+          .isConfigured = [](utl::EMotor) { return true; },
+          .batchInputs =
+              [&](const std::function<void()>& fn) {
+                calls.emplace_back("begin");
+                inBatch = true;
+                fn();
+                inBatch = false;
+                calls.emplace_back("commit");
+              },
+      },
+      status, std::move(policy));
+
+  controller.runControlLoopTasks();
+
+  EXPECT_EQ(calls, (std::vector<std::string>{"begin", "direction", "start",
+                                             "commit"}));
+}
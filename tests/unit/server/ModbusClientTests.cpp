@@ -2,10 +2,86 @@
 
 #include <ModbusClient.hpp>
 
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <thread>
 #include <vector>
 
 #include "server/fakes/FakeModbus.hpp"
 
+namespace {
+// One-shot RTU-over-TCP slave on 127.0.0.1: accepts a single connection,
+// reads one request of `requestSize` bytes and answers with `respond(request)`.
+class LoopbackRtuSlave {
+ public:
+  LoopbackRtuSlave(
+      std::size_t requestSize,
+      std::function<std::vector<std::uint8_t>(const std::vector<std::uint8_t>&)>
+          respond) {
+    _listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    (void)::bind(_listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    (void)::listen(_listenFd, 1);
+    socklen_t len = sizeof(addr);
+    (void)::getsockname(_listenFd, reinterpret_cast<sockaddr*>(&addr), &len);
+    _port = ntohs(addr.sin_port);
+    _thread = std::thread([this, requestSize, respond = std::move(respond)]() {
+      const int fd = ::accept(_listenFd, nullptr, nullptr);
+      if (fd < 0) {
+        return;
+      }
+      std::vector<std::uint8_t> request(requestSize);
+      std::size_t got = 0;
+      while (got < request.size()) {
+        const auto rc = ::recv(fd, request.data() + got, request.size() - got, 0);
+        if (rc <= 0) {
+          break;
+        }
+        got += static_cast<std::size_t>(rc);
+      }
+      _request = request;
+      const auto response = respond(request);
+      (void)::send(fd, response.data(), response.size(), 0);
+      ::close(fd);
+    });
+  }
+
+  ~LoopbackRtuSlave() {
+    if (_thread.joinable()) {
+      _thread.join();
+    }
+    ::close(_listenFd);
+  }
+
+  [[nodiscard]] int port() const { return _port; }
+  [[nodiscard]] const std::vector<std::uint8_t>& request() const {
+    return _request;
+  }
+
+ private:
+  int _listenFd{-1};
+  int _port{0};
+  std::thread _thread;
+  std::vector<std::uint8_t> _request;
+};
+
+std::vector<std::uint8_t> withCrc(std::vector<std::uint8_t> frame) {
+  const auto crc = modbus_rtu::crc16(frame);
+  frame.push_back(static_cast<std::uint8_t>(crc & 0xFFu));
+  frame.push_back(static_cast<std::uint8_t>(crc >> 8u));
+  return frame;
+}
+}  // namespace
+
 TEST(ModbusClientTests, RtuFactoryReturnsErrorWhenBackendCreationFails) {
   fake_modbus::reset();
   fake_modbus::failNext(fake_modbus::FailurePoint::NewRtu, "rtu create failed");
@@ -98,3 +174,125 @@ TEST(ModbusClientTests, WriteBitAndWriteBitsPropagateErrors) {
   EXPECT_EQ(bitsResult.error().message, "write bits failed");
 }
 
+
+TEST(ModbusClientTests, Crc16MatchesReferenceFrame) {
+  // Reference request "read 10 holding registers of slave 1 from 0x0000".
+  const std::array<std::uint8_t, 6> frame{0x01, 0x03, 0x00, 0x00, 0x00, 0x0A};
+  EXPECT_EQ(modbus_rtu::crc16(frame), 0xCDC5u);
+
+  const std::array<std::uint8_t, 8> withValidCrc{0x01, 0x03, 0x00, 0x00,
+                                                 0x00, 0x0A, 0xC5, 0xCD};
+  EXPECT_TRUE(modbus_rtu::has_valid_crc(withValidCrc));
+  auto corrupted = withValidCrc;
+  corrupted[3] ^= 0x01u;
+  EXPECT_FALSE(modbus_rtu::has_valid_crc(corrupted));
+}
+
+TEST(ModbusClientTests, SpanReadFillsCallerBuffer) {
+  fake_modbus::reset();
+  auto result = ModbusClient::rtu("/dev/fake", 115200, 'N', 8, 1, 4);
+  ASSERT_TRUE(result.has_value());
+  auto client = std::move(*result);
+
+  fake_modbus::setHoldingRegister(4, 0x00C6, 0xAAAA);
+  fake_modbus::setHoldingRegister(4, 0x00C7, 0xBBBB);
+  std::array<std::uint16_t, 2> regs{};
+  const auto rc = client.read_holding_registers(0x00C6, regs);
+  ASSERT_TRUE(rc.has_value());
+  EXPECT_EQ(*rc, 2);
+  EXPECT_EQ(regs[0], 0xAAAA);
+  EXPECT_EQ(regs[1], 0xBBBB);
+
+  fake_modbus::failNext(fake_modbus::FailurePoint::ReadRegisters, "read failed");
+  const auto failed = client.read_holding_registers(0x00C6, regs);
+  ASSERT_FALSE(failed.has_value());
+  EXPECT_EQ(failed.error().message, "read failed");
+}
+
+TEST(ModbusClientTests, RtuOverTcpReadsRegistersIntoSpan) {
+  LoopbackRtuSlave slave(8, [](const std::vector<std::uint8_t>& request) {
+    return withCrc({request[0], 0x03, 0x04, 0x12, 0x34, 0xAB, 0xCD});
+  });
+  auto result = ModbusClient::rtu_over_tcp("127.0.0.1", slave.port(), 7);
+  ASSERT_TRUE(result.has_value());
+  auto client = std::move(*result);
+  ASSERT_TRUE(client.connect().has_value());
+
+  std::array<std::uint16_t, 2> regs{};
+  const auto rc = client.read_holding_registers(0x007F, regs);
+  ASSERT_TRUE(rc.has_value()) << rc.error().message;
+  EXPECT_EQ(*rc, 2);
+  EXPECT_EQ(regs[0], 0x1234);
+  EXPECT_EQ(regs[1], 0xABCD);
+  EXPECT_EQ(slave.request(), withCrc({0x07, 0x03, 0x00, 0x7F, 0x00, 0x02}));
+}
+
+TEST(ModbusClientTests, RtuOverTcpRejectsResponseWithBadCrc) {
+  LoopbackRtuSlave slave(8, [](const std::vector<std::uint8_t>& request) {
+    auto response = withCrc({request[0], 0x03, 0x02, 0x00, 0x01});
+    response.back() ^= 0xFFu;
+    return response;
+  });
+  auto result = ModbusClient::rtu_over_tcp("127.0.0.1", slave.port(), 1);
+  ASSERT_TRUE(result.has_value());
+  auto client = std::move(*result);
+  ASSERT_TRUE(client.connect().has_value());
+
+  const auto regs = client.read_holding_registers(0x0080, 1);
+  ASSERT_FALSE(regs.has_value());
+  EXPECT_EQ(regs.error().message, "Invalid CRC in RTU-over-TCP response");
+}
+
+TEST(ModbusClientTests, TrafficStatsCountTransactionsPerSlave) {
+  fake_modbus::reset();
+  ModbusTrafficStats stats;
+  auto result = ModbusClient::tcp("127.0.0.1", 502, 3);
+  ASSERT_TRUE(result.has_value());
+  auto client = std::move(*result);
+  client.set_traffic_stats(&stats);
+
+  std::array<std::uint16_t, 2> regs{};
+  ASSERT_TRUE(client.read_holding_registers(0x00C6, regs).has_value());
+  fake_modbus::failNext(fake_modbus::FailurePoint::ReadRegisters);
+  ASSERT_FALSE(client.read_holding_registers(0x00C6, regs).has_value());
+  ASSERT_TRUE(client.set_slave(5).has_value());
+  ASSERT_TRUE(client.write_single_register(0x007D, 1).has_value());
+
+  const auto reports = stats.collect();
+  ASSERT_EQ(reports.size(), 2u);
+  EXPECT_EQ(reports[0].slave, 3);
+  EXPECT_EQ(reports[0].transactions, 2u);
+  EXPECT_EQ(reports[0].other_errors, 1u);
+  EXPECT_EQ(reports[0].timeouts, 0u);
+  EXPECT_EQ(reports[0].round_trip.count, 2u);
+  EXPECT_EQ(reports[1].slave, 5);
+  EXPECT_EQ(reports[1].transactions, 1u);
+
+  // Counters are totals, round trip times only cover the new interval.
+  const auto again = stats.collect();
+  ASSERT_EQ(again.size(), 2u);
+  EXPECT_EQ(again[0].transactions, 2u);
+  EXPECT_EQ(again[0].round_trip.count, 0u);
+}
+
+TEST(ModbusClientTests, TrafficStatsCountCrcErrors) {
+  LoopbackRtuSlave slave(8, [](const std::vector<std::uint8_t>& request) {
+    auto response = withCrc({request[0], 0x03, 0x02, 0x00, 0x01});
+    response.back() ^= 0xFFu;
+    return response;
+  });
+  ModbusTrafficStats stats;
+  auto result = ModbusClient::rtu_over_tcp("127.0.0.1", slave.port(), 9);
+  ASSERT_TRUE(result.has_value());
+  auto client = std::move(*result);
+  client.set_traffic_stats(&stats);
+  ASSERT_TRUE(client.connect().has_value());
+
+  ASSERT_FALSE(client.read_holding_registers(0x0080, 1).has_value());
+
+  const auto reports = stats.collect();
+  ASSERT_EQ(reports.size(), 1u);
+  EXPECT_EQ(reports[0].slave, 9);
+  EXPECT_EQ(reports[0].transactions, 1u);
+  EXPECT_EQ(reports[0].crc_errors, 1u);
+}
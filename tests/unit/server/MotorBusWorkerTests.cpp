@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include <MotorBusWorker.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+TEST(MotorBusWorkerTests, RunsJobsInSubmissionOrder) {
+  MotorBusWorker worker("test");
+  worker.start();
+
+  std::vector<int> order;
+  std::vector<std::future<void>> pending;
+  for (int i = 0; i < 16; ++i) {
+    pending.push_back(worker.submit([&order, i]() { order.push_back(i); }));
+  }
+  for (auto& future : pending) {
+    future.get();
+  }
+
+  ASSERT_EQ(order.size(), 16u);
+  for (int i = 0; i < 16; ++i) {
+    EXPECT_EQ(order[static_cast<std::size_t>(i)], i);
+  }
+}
+
+TEST(MotorBusWorkerTests, RunReturnsValueAndRethrowsJobException) {
+  MotorBusWorker worker("test");
+  worker.start();
+
+  EXPECT_EQ(worker.run([]() { return 42; }), 42);
+  EXPECT_THROW(worker.run([]() -> int { throw std::runtime_error("bus down"); }),
+               std::runtime_error);
+  // The worker keeps serving jobs after a failed one.
+  EXPECT_EQ(worker.run([]() { return 7; }), 7);
+}
+
+TEST(MotorBusWorkerTests, NestedRunFromWorkerThreadExecutesInline) {
+  MotorBusWorker worker("test");
+  worker.start();
+
+  const auto result = worker.run([&worker]() { return worker.run([]() { return 5; }); });
+  EXPECT_EQ(result, 5);
+}
+
+TEST(MotorBusWorkerTests, SubmitWithoutStartIsRejected) {
+  MotorBusWorker worker("test");
+  EXPECT_THROW((void)worker.submit([]() {}), std::runtime_error);
+}
+
+TEST(MotorBusWorkerTests, SeparateWorkersRunConcurrently) {
+  MotorBusWorker first("first");
+  MotorBusWorker second("second");
+  first.start();
+  second.start();
+
+  // Each job waits for the other one to start; this only completes when the
+  // two workers execute in parallel.
+  std::atomic<bool> firstStarted{false};
+  std::atomic<bool> secondStarted{false};
+  const auto waitFor = [](const std::atomic<bool>& flag) {
+    const auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (!flag.load(std::memory_order_acquire)) {
+      if (std::chrono::steady_clock::now() > deadline) {
+        return false;
+      }
+      std::this_thread::sleep_for(1ms);
+    }
+    return true;
+  };
+
+  auto a = first.submit([&]() {
+    firstStarted.store(true, std::memory_order_release);
+    return waitFor(secondStarted);
+  });
+  auto b = second.submit([&]() {
+    secondStarted.store(true, std::memory_order_release);
+    return waitFor(firstStarted);
+  });
+
+  EXPECT_TRUE(a.get());
+  EXPECT_TRUE(b.get());
+}
+
+TEST(MotorBusWorkerTests, StopDrainsQueuedJobs) {
+  MotorBusWorker worker("test");
+  worker.start();
+
+  std::atomic<int> executed{0};
+  for (int i = 0; i < 8; ++i) {
+    (void)worker.submit([&executed]() {
+      std::this_thread::sleep_for(1ms);
+      executed.fetch_add(1, std::memory_order_relaxed);
+    });
+  }
+  worker.stop();
+
+  EXPECT_EQ(executed.load(std::memory_order_relaxed), 8);
+  EXPECT_FALSE(worker.isRunning());
+}
+
+TEST(MotorBusWorkerTests, QueuedJobsRunByPriorityClass) {
+  MotorBusWorker worker("test");
+  worker.start();
+
+  // Hold the worker so the following jobs all queue up behind this one.
+  std::promise<void> started;
+  std::promise<void> release;
+  auto gate = worker.submit([&started, f = release.get_future()]() {
+    started.set_value();
+    f.wait();
+  });
+  started.get_future().wait();
+
+  std::vector<BusPriority> order;
+  std::vector<std::future<void>> pending;
+  for (const auto priority :
+       {BusPriority::Diagnostics, BusPriority::StatusPoll, BusPriority::Motion,
+        BusPriority::Diagnostics, BusPriority::EmergencyStop}) {
+    pending.push_back(worker.submit(
+        priority, [&order, priority]() { order.push_back(priority); }));
+  }
+  release.set_value();
+  gate.get();
+  for (auto& future : pending) {
+    future.get();
+  }
+
+  EXPECT_EQ(order, (std::vector<BusPriority>{
+                       BusPriority::EmergencyStop, BusPriority::Motion,
+                       BusPriority::StatusPoll, BusPriority::Diagnostics,
+                       BusPriority::Diagnostics}));
+}
+
+TEST(MotorBusWorkerTests, ChargesJobTimeToItsClassUntilNextCycle) {
+  MotorBusWorker worker("test");
+  worker.start();
+
+  worker.run(BusPriority::StatusPoll, []() { std::this_thread::sleep_for(2ms); });
+  worker.run([]() {});
+
+  const auto usage = worker.cycleUsage();
+  EXPECT_GE(usage[BusPriority::StatusPoll], 2ms);
+  EXPECT_EQ(usage[BusPriority::Diagnostics].count(), 0);
+  EXPECT_GE(usage.total(), usage[BusPriority::StatusPoll]);
+
+  const auto closed = worker.beginCycle();
+  EXPECT_EQ(closed[BusPriority::StatusPoll], usage[BusPriority::StatusPoll]);
+  EXPECT_EQ(worker.cycleUsage().total().count(), 0);
+}
+
+TEST(MotorBusWorkerTests, ThreadStartHookRunsOnTheWorkerBeforeJobs) {
+  MotorBusWorker worker("test");
+  std::thread::id hookThread;
+  worker.start([&hookThread]() { hookThread = std::this_thread::get_id(); });
+
+  const auto jobThread = worker.run([]() { return std::this_thread::get_id(); });
+  EXPECT_EQ(hookThread, jobThread);
+  EXPECT_NE(hookThread, std::this_thread::get_id());
+}
@@ -6,9 +6,13 @@
 
 #include <chrono>
 #include <filesystem>
+#include <memory>
 #include <fstream>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include "server/fakes/FakeClock.hpp"
 #include "server/fakes/FakeModbus.hpp"
 
 namespace {
@@ -41,6 +45,33 @@ std::filesystem::path writeMotorControlConfig(const std::string& motorAddressVal
   return path;
 }
 
+std::filesystem::path writeBudgetedMotorControlConfig(const double budgetMS) {
+  const auto stamp =
+      std::chrono::high_resolution_clock::now().time_since_epoch().count();
+  const auto path =
+      std::filesystem::temp_directory_path() /
+      ("rimokun_motor_control_budget_test_" + std::to_string(stamp) + ".yaml");
+
+  std::ofstream out(path);
+  out << "classes:\n";
+  out << "  MotorControl:\n";
+  out << "    model: \"AR-KD2\"\n";
+  out << "    transport:\n";
+  out << "      type: \"serialRtu\"\n";
+  out << "      serial:\n";
+  out << "        device: \"/dev/fake\"\n";
+  out << "        baud: 115200\n";
+  // Every request waits out the gap, so each transaction takes >= 1 ms.
+  out << "    interRequestDelayMS: 1\n";
+  out << "    busCycleBudgetMS: " << budgetMS << "\n";
+  out << "    motors:\n";
+  out << "      XLeft:\n";
+  out << "        address: 5\n";
+  out.close();
+
+  return path;
+}
+
 std::filesystem::path writeMotorControlConfigWithCurrents(
     const std::string& motorAddressValue, const int runCurrent,
     const int stopCurrent) {
@@ -236,11 +267,62 @@ std::filesystem::path writeMotorControlConfigWithCommandAddressAndWriteMode(
   return path;
 }
 
+std::filesystem::path writeMultiBusMotorControlConfig(
+    const bool assignZLeftBus, const std::string& zLeftBusName = "gantry") {
+  const auto stamp =
+      std::chrono::high_resolution_clock::now().time_since_epoch().count();
+  const auto path =
+      std::filesystem::temp_directory_path() /
+      ("rimokun_motor_control_multi_bus_test_" + std::to_string(stamp) + ".yaml");
+
+  std::ofstream out(path);
+  out << "classes:\n";
+  out << "  MotorControl:\n";
+  out << "    model: \"AR-KD2\"\n";
+  out << "    transport:\n";
+  out << "      - name: \"arms\"\n";
+  out << "        type: \"serialRtu\"\n";
+  out << "        serial:\n";
+  out << "          device: \"/dev/fakeA\"\n";
+  out << "          baud: 115200\n";
+  out << "      - name: \"gantry\"\n";
+  out << "        type: \"serialRtu\"\n";
+  out << "        responseTimeoutMS: 250\n";
+  out << "        serial:\n";
+  out << "          device: \"/dev/fakeB\"\n";
+  out << "          baud: 115200\n";
+  out << "    responseTimeoutMS: 1000\n";
+  out << "    motors:\n";
+  out << "      XLeft:\n";
+  out << "        address: 1\n";
+  out << "        bus: \"arms\"\n";
+  out << "      ZLeft:\n";
+  out << "        address: 2\n";
+  if (assignZLeftBus) {
+    out << "        bus: \"" << zLeftBusName << "\"\n";
+  }
+  out.close();
+
+  return path;
+}
+
 std::uint8_t readSelectedOperationIdForMotor(const int slave) {
   return Motor::decodeOperationIdFromInputRaw(
       fake_modbus::getHoldingRegister(slave, makeArKd2RegisterMap().driverInputCommandLower));
 }
 
+std::vector<std::uint16_t> driverInputWritesSince(const std::size_t first) {
+  const auto map = makeArKd2RegisterMap();
+  const auto writes = fake_modbus::writes();
+  std::vector<std::uint16_t> values;
+  for (auto i = first; i < writes.size(); ++i) {
+    if (writes[i].addr == map.driverInputCommandLower) {
+      values.push_back(writes[i].values.front());
+    }
+  }
+  return values;
+}
+
 }  // namespace
 
 TEST(MotorControlTests, InitializeSetsNormalStateAndResetReturnsToError) {
@@ -295,7 +377,8 @@ TEST(MotorControlTests, PositionModeStartMovementSelectsOp2AndPulsesStart) {
   const auto configPath = writeMotorControlConfig("5");
   utl::Config::instance().setConfigPath(configPath.string());
 
-  MotorControl control;
+  auto clock = std::make_shared<FakeClock>();
+  MotorControl control(clock);
   control.initialize();
   control.setMode(utl::EMotor::XLeft, MotorControlMode::Position);
   control.setPosition(utl::EMotor::XLeft, 777);
@@ -308,9 +391,54 @@ TEST(MotorControlTests, PositionModeStartMovementSelectsOp2AndPulsesStart) {
   EXPECT_EQ(lower, static_cast<std::uint16_t>(777u & 0xFFFFu));
   EXPECT_EQ(readSelectedOperationIdForMotor(5), 2);
 
-  const auto inputRaw = fake_modbus::getHoldingRegister(5, map.driverInputCommandLower);
   const auto startBit = static_cast<std::uint16_t>(MotorInputFlag::Start);
-  EXPECT_EQ(inputRaw & startBit, 0u);
+  EXPECT_NE(fake_modbus::getHoldingRegister(5, map.driverInputCommandLower) & startBit,
+            0u);
+  clock->advanceBy(control.pulseHold());
+  control.servicePulses();
+  EXPECT_EQ(fake_modbus::getHoldingRegister(5, map.driverInputCommandLower) & startBit,
+            0u);
+
+  std::filesystem::remove(configPath);
+}
+
+TEST(MotorControlTests, PulseReturnsWithBitHeldUntilHoldTimeElapses) {
+  fake_modbus::reset();
+  const auto configPath = writeMotorControlConfig("5");
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  auto clock = std::make_shared<FakeClock>();
+  MotorControl control(clock);
+  control.initialize();
+  ASSERT_EQ(control.pulseHold(), std::chrono::milliseconds{30});
+
+  const auto map = makeArKd2RegisterMap();
+  const auto homeBit = static_cast<std::uint16_t>(MotorInputFlag::Home);
+  const auto homeAsserted = [&]() {
+    return (fake_modbus::getHoldingRegister(5, map.driverInputCommandLower) &
+            homeBit) != 0u;
+  };
+
+  control.pulseHome(utl::EMotor::XLeft);
+  EXPECT_TRUE(homeAsserted());
+
+  // Other traffic on the bus proceeds while the pulse is held.
+  const auto polls = control.pollStatus({utl::EMotor::XLeft});
+  EXPECT_TRUE(polls.at(utl::EMotor::XLeft).error.empty());
+  clock->advanceBy(std::chrono::milliseconds{29});
+  control.servicePulses();
+  EXPECT_TRUE(homeAsserted());
+
+  // Re-pulsing restarts the hold time.
+  control.pulseHome(utl::EMotor::XLeft);
+  clock->advanceBy(std::chrono::milliseconds{2});
+  control.servicePulses();
+  EXPECT_TRUE(homeAsserted());
+
+  // The next transaction on the bus deasserts a due pulse before it runs.
+  clock->advanceBy(std::chrono::milliseconds{28});
+  control.setSpeed(utl::EMotor::XLeft, 100);
+  EXPECT_FALSE(homeAsserted());
 
   std::filesystem::remove(configPath);
 }
@@ -343,6 +471,97 @@ TEST(MotorControlTests, SpeedModeStartMovementUsesDirectionBitsWithoutStartPulse
   std::filesystem::remove(configPath);
 }
 
+TEST(MotorControlTests, BatchedCycleWritesDriverInputOncePerMotor) {
+  fake_modbus::reset();
+  const auto configPath = writeMotorControlConfig("5");
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  MotorControl control;
+  control.initialize();
+  control.setMode(utl::EMotor::XLeft, MotorControlMode::Speed);
+  control.setSpeed(utl::EMotor::XLeft, 1200);
+  control.setDirection(utl::EMotor::XLeft, MotorControlDirection::Forward);
+  control.startMovement(utl::EMotor::XLeft);
+
+  const auto fwdBit = static_cast<std::uint16_t>(MotorInputFlag::Fwd);
+  const auto revBit = static_cast<std::uint16_t>(MotorInputFlag::Rvs);
+  auto writesBefore = fake_modbus::writes().size();
+  control.batchDriverInputs([&]() {
+    control.setDirection(utl::EMotor::XLeft, MotorControlDirection::Reverse);
+    control.startMovement(utl::EMotor::XLeft);
+  });
+  auto inputWrites = driverInputWritesSince(writesBefore);
+  ASSERT_EQ(inputWrites.size(), 1u);
+  EXPECT_EQ(inputWrites[0] & fwdBit, 0u);
+  EXPECT_NE(inputWrites[0] & revBit, 0u);
+
+  // A new speed selects the other operation; the driver must see it before
+  // the direction input rises.
+  writesBefore = fake_modbus::writes().size();
+  control.batchDriverInputs([&]() {
+    control.setDirection(utl::EMotor::XLeft, MotorControlDirection::Forward);
+    control.setSpeed(utl::EMotor::XLeft, 1500);
+    control.startMovement(utl::EMotor::XLeft);
+  });
+  inputWrites = driverInputWritesSince(writesBefore);
+  ASSERT_EQ(inputWrites.size(), 2u);
+  EXPECT_EQ(Motor::decodeOperationIdFromInputRaw(inputWrites[0]), 0);
+  EXPECT_EQ(inputWrites[0] & (fwdBit | revBit), 0u);
+  EXPECT_EQ(inputWrites[1], inputWrites[0] | fwdBit);
+
+  // Nothing changed, nothing written.
+  writesBefore = fake_modbus::writes().size();
+  control.batchDriverInputs([&]() {
+    control.setDirection(utl::EMotor::XLeft, MotorControlDirection::Forward);
+    control.startMovement(utl::EMotor::XLeft);
+  });
+  EXPECT_TRUE(driverInputWritesSince(writesBefore).empty());
+
+  std::filesystem::remove(configPath);
+}
+
+TEST(MotorControlTests, BatchedPositionStartSelectsOperationBeforeStartEdge) {
+  fake_modbus::reset();
+  const auto configPath = writeMotorControlConfig("5");
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  auto clock = std::make_shared<FakeClock>();
+  MotorControl control(clock);
+  control.initialize();
+  control.setMode(utl::EMotor::XLeft, MotorControlMode::Position);
+
+  const auto startBit = static_cast<std::uint16_t>(MotorInputFlag::Start);
+  auto writesBefore = fake_modbus::writes().size();
+  control.batchDriverInputs([&]() {
+    control.setPosition(utl::EMotor::XLeft, 777);
+    control.startMovement(utl::EMotor::XLeft);
+  });
+  auto inputWrites = driverInputWritesSince(writesBefore);
+  ASSERT_EQ(inputWrites.size(), 2u);
+  EXPECT_EQ(Motor::decodeOperationIdFromInputRaw(inputWrites[0]), 2);
+  EXPECT_EQ(inputWrites[0] & startBit, 0u);
+  EXPECT_EQ(inputWrites[1], inputWrites[0] | startBit);
+
+  // START is still held from the previous cycle: the driver gets the low
+  // level before the new edge.
+  writesBefore = fake_modbus::writes().size();
+  control.batchDriverInputs(
+      [&]() { control.startMovement(utl::EMotor::XLeft); });
+  inputWrites = driverInputWritesSince(writesBefore);
+  ASSERT_EQ(inputWrites.size(), 2u);
+  EXPECT_EQ(inputWrites[0] & startBit, 0u);
+  EXPECT_NE(inputWrites[1] & startBit, 0u);
+
+  clock->advanceBy(control.pulseHold());
+  control.servicePulses();
+  EXPECT_EQ(fake_modbus::getHoldingRegister(
+                5, makeArKd2RegisterMap().driverInputCommandLower) &
+                startBit,
+            0u);
+
+  std::filesystem::remove(configPath);
+}
+
 TEST(MotorControlTests, SpeedModeStopMovementClearsDirectionBits) {
   fake_modbus::reset();
   const auto configPath = writeMotorControlConfig("5");
@@ -686,6 +905,41 @@ TEST(MotorControlTests, SetAccelerationWritesBothSpeedOperationsAndCachesValue)
   std::filesystem::remove(configPath);
 }
 
+TEST(MotorControlTests, SpeedModeSetupWritesOneFc16PerOperationField) {
+  fake_modbus::reset();
+  const auto configPath = writeMotorControlConfig("5");
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  MotorControl control;
+  control.initialize();
+  const auto writesBefore = fake_modbus::writes().size();
+  control.setMode(utl::EMotor::XLeft, MotorControlMode::Speed);
+  const auto writes = fake_modbus::writes();
+
+  const auto map = makeArKd2RegisterMap();
+  std::vector<int> operationWrites;
+  for (auto i = writesBefore; i < writes.size(); ++i) {
+    if (writes[i].addr != map.driverInputCommandLower) {
+      EXPECT_EQ(writes[i].values.size(), 4u);
+      operationWrites.push_back(writes[i].addr);
+    }
+  }
+  EXPECT_EQ(operationWrites,
+            (std::vector<int>{map.speedNo0, map.operationModeNo0,
+                              map.operationModeNo0 + 0x80, map.accelerationNo0,
+                              map.decelerationNo0}));
+
+  // Values the driver already holds are not written again.
+  const auto writesAfterSetup = fake_modbus::writes().size();
+  control.setOperationSpeed(utl::EMotor::XLeft, 0, 1000);
+  control.setOperationMode(utl::EMotor::XLeft, 1, MotorOperationMode::Incremental);
+  EXPECT_EQ(fake_modbus::writes().size(), writesAfterSetup);
+  control.setOperationSpeed(utl::EMotor::XLeft, 1, 1200);
+  EXPECT_EQ(fake_modbus::writes().size(), writesAfterSetup + 1);
+
+  std::filesystem::remove(configPath);
+}
+
 TEST(MotorControlTests, SetDecelerationWritesBothSpeedOperationsAndCachesValue) {
   fake_modbus::reset();
   const auto configPath = writeMotorControlConfig("5");
@@ -716,3 +970,305 @@ TEST(MotorControlTests, SetDecelerationWritesBothSpeedOperationsAndCachesValue)
 
   std::filesystem::remove(configPath);
 }
+
+TEST(MotorControlTests, MultiBusTransportAssignsMotorsToTheirBuses) {
+  fake_modbus::reset();
+  const auto configPath = writeMultiBusMotorControlConfig(true);
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  MotorControl control;
+  EXPECT_EQ(control.busNames(), (std::vector<std::string>{"arms", "gantry"}));
+  EXPECT_EQ(control.busNameFor(utl::EMotor::XLeft), "arms");
+  EXPECT_EQ(control.busNameFor(utl::EMotor::ZLeft), "gantry");
+
+  control.initialize();
+  EXPECT_EQ(control.state(), MachineComponent::State::Normal);
+  EXPECT_EQ(control.motors().size(), 2u);
+
+  control.setDirection(utl::EMotor::XLeft, MotorControlDirection::Forward);
+  control.setDirection(utl::EMotor::ZLeft, MotorControlDirection::Reverse);
+  const auto map = makeArKd2RegisterMap();
+  EXPECT_NE(fake_modbus::getHoldingRegister(1, map.driverInputCommandLower), 0u);
+  EXPECT_NE(fake_modbus::getHoldingRegister(2, map.driverInputCommandLower), 0u);
+
+  control.reset();
+  EXPECT_EQ(control.state(), MachineComponent::State::Error);
+  EXPECT_TRUE(control.motors().empty());
+
+  std::filesystem::remove(configPath);
+}
+
+TEST(MotorControlTests, PollStatusReadsMotorsOnAllBuses) {
+  fake_modbus::reset();
+  const auto configPath = writeMultiBusMotorControlConfig(true);
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  MotorControl control;
+  control.initialize();
+
+  const auto map = makeArKd2RegisterMap();
+  fake_modbus::setHoldingRegister(1, map.actualPosition + 1, 111);
+  fake_modbus::setHoldingRegister(2, map.actualPosition + 1, 222);
+
+  const auto polls =
+      control.pollStatus({utl::EMotor::XLeft, utl::EMotor::ZLeft});
+  ASSERT_EQ(polls.size(), 2u);
+  const auto& xLeft = polls.at(utl::EMotor::XLeft);
+  const auto& zLeft = polls.at(utl::EMotor::ZLeft);
+  EXPECT_TRUE(xLeft.error.empty());
+  EXPECT_TRUE(zLeft.error.empty());
+  ASSERT_TRUE(xLeft.monitor.has_value());
+  ASSERT_TRUE(zLeft.monitor.has_value());
+  EXPECT_EQ(xLeft.monitor->actualPosition, 111);
+  EXPECT_EQ(zLeft.monitor->actualPosition, 222);
+
+  std::filesystem::remove(configPath);
+}
+
+TEST(MotorControlTests, PollStatusReadsDiagnosticsThroughPlannedRanges) {
+  fake_modbus::reset();
+  const auto configPath = writeMultiBusMotorControlConfig(true);
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  MotorControl control;
+  control.initialize();
+
+  const auto map = makeArKd2RegisterMap();
+  const auto& plans = control.statusReadPlans(utl::EMotor::XLeft);
+  ASSERT_EQ(plans.status.ranges().size(), 2u);
+  EXPECT_EQ(plans.status.ranges()[0].start, map.driverOutputCommandLower);
+  EXPECT_EQ(plans.status.ranges()[1].start, map.commandPosition);
+  // At 115200 baud the 20-word gap is cheaper than a second transaction.
+  ASSERT_EQ(plans.warningAndAlarm.ranges().size(), 1u);
+  EXPECT_EQ(plans.warningAndAlarm.ranges()[0].start, map.presentAlarm);
+  EXPECT_EQ(plans.warningAndAlarm.ranges()[0].end(), map.presentWarning + 2);
+
+  fake_modbus::setHoldingRegister(
+      1, map.driverOutputCommandLower,
+      static_cast<std::uint16_t>(MotorOutputFlag::Warning) |
+          static_cast<std::uint16_t>(MotorOutputFlag::Alarm));
+  fake_modbus::setHoldingRegister(1, map.presentAlarm + 1, 0x30);
+  fake_modbus::setHoldingRegister(1, map.presentWarning + 1, 0x21);
+
+  const auto polls = control.pollStatus({utl::EMotor::XLeft});
+  const auto& xLeft = polls.at(utl::EMotor::XLeft);
+  EXPECT_TRUE(xLeft.error.empty());
+  ASSERT_TRUE(xLeft.alarm.has_value());
+  ASSERT_TRUE(xLeft.warning.has_value());
+  EXPECT_EQ(xLeft.alarm->code, 0x30);
+  EXPECT_EQ(xLeft.warning->code, 0x21);
+
+  std::filesystem::remove(configPath);
+}
+
+TEST(MotorControlTests, DiagnosticsAreDeferredOnceBusBudgetIsSpent) {
+  fake_modbus::reset();
+  const auto configPath = writeBudgetedMotorControlConfig(0.001);
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  MotorControl control;
+  control.initialize();
+  control.beginBusCycle();
+  EXPECT_TRUE(control.admitDiagnostics(utl::EMotor::XLeft));
+
+  (void)control.readInputStatus(utl::EMotor::XLeft);
+  EXPECT_FALSE(control.admitDiagnostics(utl::EMotor::XLeft));
+
+  control.beginBusCycle();
+  const auto reports = control.busCycleReports();
+  ASSERT_EQ(reports.size(), 1u);
+  EXPECT_EQ(reports[0].bus, "default");
+  EXPECT_EQ(reports[0].budget, std::chrono::microseconds{1});
+  EXPECT_GT(reports[0].lastCycle[BusPriority::Diagnostics].count(), 0);
+  EXPECT_EQ(reports[0].lastCycle[BusPriority::StatusPoll].count(), 0);
+  EXPECT_EQ(reports[0].deferredDiagnostics, 1u);
+  // A fresh cycle has budget again.
+  EXPECT_TRUE(control.admitDiagnostics(utl::EMotor::XLeft));
+
+  // The status poll of the previous cycle stays reserved in the next one.
+  (void)control.pollStatus({utl::EMotor::XLeft});
+  control.beginBusCycle();
+  EXPECT_GT(control.busCycleReports()[0].lastCycle[BusPriority::StatusPoll].count(),
+            0);
+  EXPECT_FALSE(control.admitDiagnostics(utl::EMotor::XLeft));
+
+  std::filesystem::remove(configPath);
+}
+
+TEST(MotorControlTests, DiagnosticsAreAlwaysAdmittedWithoutBudget) {
+  fake_modbus::reset();
+  const auto configPath = writeMotorControlConfig("5");
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  MotorControl control;
+  control.initialize();
+  control.beginBusCycle();
+  (void)control.readInputStatus(utl::EMotor::XLeft);
+  (void)control.pollStatus({utl::EMotor::XLeft});
+  EXPECT_TRUE(control.admitDiagnostics(utl::EMotor::XLeft));
+  EXPECT_EQ(control.busCycleReports()[0].budget.count(), 0);
+
+  std::filesystem::remove(configPath);
+}
+
+TEST(MotorControlTests, RepeatedTimeoutsOpenBreakerUntilProbeSucceeds) {
+  fake_modbus::reset();
+  const auto configPath = writeMotorControlConfig("5");
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  auto clock = std::make_shared<FakeClock>();
+  MotorControl control(clock);
+  control.initialize();
+  const auto motor = utl::EMotor::XLeft;
+  const auto waitForLinkState = [&](const utl::EMotorLinkState expected) {
+    for (int i = 0; i < 1000 && control.linkState(motor) != expected; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    return control.linkState(motor);
+  };
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(control.linkState(motor), utl::EMotorLinkState::Online);
+    fake_modbus::failNext(fake_modbus::FailurePoint::ReadRegisters,
+                          "Connection timed out");
+    const auto poll = control.pollStatus({motor}).at(motor);
+    EXPECT_FALSE(poll.skipped);
+    EXPECT_FALSE(poll.error.empty());
+  }
+  ASSERT_EQ(control.linkState(motor), utl::EMotorLinkState::Skipped);
+  EXPECT_EQ(control.state(), MachineComponent::State::Normal);
+
+  // Skipped without bus traffic: a queued failure is still pending after it.
+  fake_modbus::failNext(fake_modbus::FailurePoint::ReadRegisters,
+                        "Connection timed out");
+  auto poll = control.pollStatus({motor}).at(motor);
+  EXPECT_TRUE(poll.skipped);
+  EXPECT_FALSE(poll.error.empty());
+  EXPECT_THROW((void)control.readOutputStatus(motor), std::runtime_error);
+
+  // The first probe consumes the failure and doubles the backoff.
+  clock->advanceBy(std::chrono::milliseconds{500});
+  EXPECT_TRUE(control.pollStatus({motor}).at(motor).skipped);
+  ASSERT_EQ(waitForLinkState(utl::EMotorLinkState::Skipped),
+            utl::EMotorLinkState::Skipped);
+  EXPECT_EQ(control.linkHealth().at(motor).backoff,
+            std::chrono::milliseconds{1000});
+
+  clock->advanceBy(std::chrono::milliseconds{999});
+  EXPECT_TRUE(control.pollStatus({motor}).at(motor).skipped);
+  EXPECT_EQ(control.linkState(motor), utl::EMotorLinkState::Skipped);
+
+  clock->advanceBy(std::chrono::milliseconds{1});
+  EXPECT_TRUE(control.pollStatus({motor}).at(motor).skipped);
+  ASSERT_EQ(waitForLinkState(utl::EMotorLinkState::Online),
+            utl::EMotorLinkState::Online);
+  poll = control.pollStatus({motor}).at(motor);
+  EXPECT_FALSE(poll.skipped);
+  EXPECT_TRUE(poll.error.empty());
+
+  std::filesystem::remove(configPath);
+}
+
+TEST(MotorControlTests, PollStatusReportsErrorForUninitializedControl) {
+  fake_modbus::reset();
+  const auto configPath = writeMultiBusMotorControlConfig(true);
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  MotorControl control;
+  const auto polls = control.pollStatus({utl::EMotor::XLeft});
+  ASSERT_EQ(polls.size(), 1u);
+  EXPECT_FALSE(polls.at(utl::EMotor::XLeft).error.empty());
+
+  std::filesystem::remove(configPath);
+}
+
+TEST(MotorControlTests, MultiBusTransportRequiresBusAssignmentPerMotor) {
+  fake_modbus::reset();
+  const auto configPath = writeMultiBusMotorControlConfig(false);
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  EXPECT_THROW((void)MotorControl(), std::runtime_error);
+
+  std::filesystem::remove(configPath);
+}
+
+TEST(MotorControlTests, MultiBusTransportRejectsUnknownBusName) {
+  fake_modbus::reset();
+  const auto configPath = writeMultiBusMotorControlConfig(true, "nonexistent");
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  EXPECT_THROW((void)MotorControl(), std::runtime_error);
+
+  std::filesystem::remove(configPath);
+}
+
+TEST(MotorControlTests, EmergencyStopBroadcastsThenConfirmsEachDrive) {
+  fake_modbus::reset();
+  const auto configPath = writeMultiBusMotorControlConfig(true, "arms");
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  MotorControl control;
+  control.initialize();
+  control.setDirection(utl::EMotor::XLeft, MotorControlDirection::Forward);
+  const auto map = makeArKd2RegisterMap();
+  const auto running =
+      fake_modbus::getHoldingRegister(1, map.driverInputCommandLower);
+  const auto first = fake_modbus::writes().size();
+
+  const auto report = control.emergencyStop();
+
+  EXPECT_TRUE(control.emergencyStopActive());
+  EXPECT_EQ(report.broadcastBuses, 1u);
+  EXPECT_TRUE(report.unconfirmed.empty());
+  EXPECT_LE(report.toFirstFrame, report.toAllConfirmed);
+  const auto writes = fake_modbus::writes();
+  ASSERT_EQ(writes.size(), first + 3);
+  EXPECT_EQ(writes[first].slave, 0);
+  EXPECT_EQ(writes[first].addr, map.driverInputCommandLower);
+  const auto stopWord = writes[first].values.front();
+  EXPECT_NE(stopWord, 0u);
+  for (const auto slave : {1, 2}) {
+    const auto raw =
+        fake_modbus::getHoldingRegister(slave, map.driverInputCommandLower);
+    EXPECT_EQ(raw & stopWord, stopWord) << "slave " << slave;
+  }
+  // FWD dropped, STOP raised.
+  EXPECT_NE(fake_modbus::getHoldingRegister(1, map.driverInputCommandLower),
+            running);
+  ASSERT_TRUE(control.lastEmergencyStop().has_value());
+
+  std::filesystem::remove(configPath);
+}
+
+TEST(MotorControlTests, EmergencyStopRefusesMotionUntilReinitialized) {
+  fake_modbus::reset();
+  const auto configPath = writeMotorControlConfig("5");
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  MotorControl control;
+  control.initialize();
+  const auto report = control.emergencyStop();
+  const auto stopWord = fake_modbus::writes()[fake_modbus::writes().size() - 2]
+                            .values.front();
+  ASSERT_TRUE(report.unconfirmed.empty());
+
+  const auto before = fake_modbus::writes().size();
+  EXPECT_THROW(
+      control.setDirection(utl::EMotor::XLeft, MotorControlDirection::Forward),
+      std::runtime_error);
+  EXPECT_EQ(fake_modbus::writes().size(), before);
+  // Status polls still run.
+  const auto polls = control.pollStatus({utl::EMotor::XLeft});
+  EXPECT_TRUE(polls.at(utl::EMotor::XLeft).error.empty());
+
+  control.initialize();
+  EXPECT_FALSE(control.emergencyStopActive());
+  const auto map = makeArKd2RegisterMap();
+  EXPECT_EQ(fake_modbus::getHoldingRegister(5, map.driverInputCommandLower) &
+                stopWord,
+            0u);
+  EXPECT_NO_THROW(
+      control.setDirection(utl::EMotor::XLeft, MotorControlDirection::Forward));
+
+  std::filesystem::remove(configPath);
+}
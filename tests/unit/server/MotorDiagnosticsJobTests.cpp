@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <ArKd2RegisterMap.hpp>
+#include <Config.hpp>
+#include <MotorControl.hpp>
+#include <MotorDiagnosticsJob.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "server/fakes/FakeModbus.hpp"
+
+namespace {
+
+std::filesystem::path writeDiagnosticsConfig() {
+  const auto stamp =
+      std::chrono::high_resolution_clock::now().time_since_epoch().count();
+  const auto path =
+      std::filesystem::temp_directory_path() /
+      ("rimokun_diagnostics_job_test_" + std::to_string(stamp) + ".yaml");
+
+  std::ofstream out(path);
+  out << "classes:\n";
+  out << "  MotorControl:\n";
+  out << "    model: \"AR-KD2\"\n";
+  out << "    transport:\n";
+  out << "      type: \"serialRtu\"\n";
+  out << "      serial:\n";
+  out << "        device: \"/dev/fake\"\n";
+  out << "        baud: 115200\n";
+  out << "    motors:\n";
+  out << "      XLeft:\n";
+  out << "        address: 1\n";
+  out.close();
+
+  return path;
+}
+
+}  // namespace
+
+TEST(MotorDiagnosticsJobTests, OneReadPerStepUntilResponseIsComplete) {
+  fake_modbus::reset();
+  const auto configPath = writeDiagnosticsConfig();
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  MotorControl control;
+  control.initialize();
+  const auto map = makeArKd2RegisterMap();
+  fake_modbus::setHoldingRegister(1, map.presentAlarm + 1, 0x30);
+
+  MotorDiagnosticsJob job(utl::EMotor::XLeft);
+  for (std::size_t i = 1; i < MotorDiagnosticsJob::kStepCount; ++i) {
+    EXPECT_FALSE(job.step(control));
+    EXPECT_EQ(job.stepsTaken(), i);
+  }
+  EXPECT_EQ(job.response()["alarm"]["code"], 0x30);
+  EXPECT_TRUE(job.response()["warning"].empty());
+
+  EXPECT_TRUE(job.step(control));
+  EXPECT_TRUE(job.done());
+  EXPECT_FALSE(job.response().contains("diagnosticsError"));
+  EXPECT_EQ(job.response()["motor"], "XLeft");
+  EXPECT_TRUE(job.response()["warning"].contains("code"));
+
+  std::filesystem::remove(configPath);
+}
+
+TEST(MotorDiagnosticsJobTests, FailedReadEndsJobWithError) {
+  fake_modbus::reset();
+  const auto configPath = writeDiagnosticsConfig();
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  MotorControl control;
+  control.initialize();
+
+  MotorDiagnosticsJob job(utl::EMotor::XLeft);
+  EXPECT_FALSE(job.step(control));
+  fake_modbus::failNext(fake_modbus::FailurePoint::ReadRegisters);
+  EXPECT_TRUE(job.step(control));
+
+  EXPECT_EQ(job.stepsTaken(), 1u);
+  EXPECT_TRUE(job.response().contains("diagnosticsError"));
+  EXPECT_EQ(job.response()["driverOutputRaw"], 0u);
+
+  std::filesystem::remove(configPath);
+}
+
+TEST(MotorDiagnosticsJobTests, UnknownMotorFailsOnFirstStep) {
+  fake_modbus::reset();
+  const auto configPath = writeDiagnosticsConfig();
+  utl::Config::instance().setConfigPath(configPath.string());
+
+  MotorControl control;
+  control.initialize();
+
+  MotorDiagnosticsJob job(utl::EMotor::YRight);
+  EXPECT_TRUE(job.step(control));
+  EXPECT_TRUE(job.response().contains("diagnosticsError"));
+
+  std::filesystem::remove(configPath);
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <RealTimeMode.hpp>
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+TEST(RealTimeModeTests, MissingNodeLeavesRealTimeModeOff) {
+  const auto settings = realtime::parseSettings(YAML::Node{});
+  EXPECT_FALSE(settings.enabled);
+  EXPECT_EQ(settings.processThread.priority, 80);
+  EXPECT_EQ(settings.busWorkers.priority, 70);
+  EXPECT_TRUE(settings.lockMemory);
+  EXPECT_EQ(settings.spinTail, 0us);
+}
+
+TEST(RealTimeModeTests, ParsesProcessThreadAndBusWorkerSettings) {
+  const auto node = YAML::Load(R"(
+enabled: true
+priority: 90
+cpus: [2, 3]
+prefaultStackKB: 64
+busWorkerPriority: 0
+busWorkerCpus: [1]
+lockMemory: false
+spinTailUS: 200
+)");
+  const auto settings = realtime::parseSettings(node);
+  EXPECT_TRUE(settings.enabled);
+  EXPECT_EQ(settings.processThread.priority, 90);
+  EXPECT_EQ(settings.processThread.cpus, (std::vector<int>{2, 3}));
+  EXPECT_EQ(settings.processThread.prefaultStackBytes, 64u * 1024u);
+  EXPECT_EQ(settings.busWorkers.priority, 0);
+  EXPECT_EQ(settings.busWorkers.cpus, (std::vector<int>{1}));
+  EXPECT_EQ(settings.busWorkers.prefaultStackBytes, 256u * 1024u);
+  EXPECT_FALSE(settings.lockMemory);
+  EXPECT_EQ(settings.spinTail, 200us);
+}
+
+TEST(RealTimeModeTests, RejectsInvalidPriorityAndCpu) {
+  EXPECT_THROW((void)realtime::parseSettings(YAML::Load("priority: 120")),
+               std::runtime_error);
+  EXPECT_THROW(
+      (void)realtime::parseSettings(YAML::Load("busWorkerCpus: [-1]")),
+      std::runtime_error);
+}
+
+TEST(RealTimeModeTests, ReportsWhatTheThreadActuallyGot) {
+  realtime::ThreadReport report;
+  std::thread thread([&report]() {
+    report = realtime::applyToCurrentThread(
+        {.priority = 1, .cpus = {0}, .prefaultStackBytes = 64 * 1024});
+  });
+  thread.join();
+
+  // Without the privileges the thread keeps the normal scheduler and says so.
+  if (report.failures.empty()) {
+    EXPECT_EQ(report.policy, "SCHED_FIFO");
+    EXPECT_EQ(report.priority, 1);
+  } else {
+    EXPECT_FALSE(realtime::describe(report).empty());
+  }
+  EXPECT_EQ(report.stackPrefaultedBytes, 64u * 1024u);
+  const auto json = realtime::toJson(report);
+  EXPECT_EQ(json["stackPrefaultedKB"], 64);
+  EXPECT_EQ(json["failures"].size(), report.failures.size());
+}
+
+TEST(RealTimeModeTests, ClockWakesNoEarlierThanTheTarget) {
+  const realtime::RealTimeClock clock(500us);
+  for (const auto delay : {0ms, 1ms, 3ms}) {
+    const auto target = clock.now() + delay;
+    clock.sleepUntil(target);
+    EXPECT_GE(clock.now(), target);
+  }
+  EXPECT_NE(std::dynamic_pointer_cast<realtime::RealTimeClock>(
+                realtime::makeClock({.enabled = true})),
+            nullptr);
+  EXPECT_EQ(std::dynamic_pointer_cast<realtime::RealTimeClock>(
+                realtime::makeClock({})),
+            nullptr);
+}
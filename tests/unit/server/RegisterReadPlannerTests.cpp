@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <ArKd2RegisterMap.hpp>
+#include <RegisterReadPlanner.hpp>
+
+#include <array>
+#include <stdexcept>
+
+namespace {
+RegisterReadCostModel fixedModel(const double perTransactionUs,
+                                 const double perWordUs) {
+  return {.perTransactionUs = perTransactionUs, .perWordUs = perWordUs};
+}
+}  // namespace
+
+TEST(RegisterReadPlannerTests, CostModelFollowsLineSettings) {
+  MotorRtuConfig rtu;
+  rtu.baud = 9600;
+  rtu.parity = 'E';
+  rtu.dataBits = 8;
+  rtu.stopBits = 1;
+  const auto slow = RegisterReadCostModel::fromRtu(rtu);
+  // 11 bits per character at 9600 baud.
+  EXPECT_NEAR(slow.perWordUs, 2.0 * 11.0 * 1e6 / 9600.0, 1e-6);
+
+  rtu.baud = 115200;
+  const auto fast = RegisterReadCostModel::fromRtu(rtu);
+  EXPECT_LT(fast.perWordUs, slow.perWordUs);
+  EXPECT_LT(fast.perTransactionUs, slow.perTransactionUs);
+
+  rtu.interRequestDelayMS = 5;
+  const auto delayed = RegisterReadCostModel::fromRtu(rtu);
+  EXPECT_NEAR(delayed.perTransactionUs - fast.perTransactionUs, 5000.0, 1e-6);
+
+  rtu.baud = 0;
+  EXPECT_THROW((void)RegisterReadCostModel::fromRtu(rtu), std::runtime_error);
+}
+
+TEST(RegisterReadPlannerTests, MergesOverlappingAndAdjacentRequirements) {
+  const auto plan = RegisterReadPlanner(fixedModel(1000.0, 1000.0))
+                        .require(0x0010, 2)
+                        .require(0x0011, 3)
+                        .require(0x0014, 1)
+                        .plan();
+  ASSERT_EQ(plan.ranges().size(), 1u);
+  EXPECT_EQ(plan.ranges()[0], (RegisterRange{.start = 0x0010, .count = 5}));
+  EXPECT_EQ(plan.wordCount(), 5);
+  EXPECT_DOUBLE_EQ(plan.estimatedCostUs(), 6000.0);
+}
+
+TEST(RegisterReadPlannerTests, BridgesGapOnlyWhenCheaperThanExtraTransaction) {
+  // Gap of 10 words between the two requirements.
+  const auto build = [](const RegisterReadCostModel& model) {
+    return RegisterReadPlanner(model).require(0x0100, 2).require(0x010C, 2).plan();
+  };
+
+  const auto bridged = build(fixedModel(20.0, 1.0));
+  ASSERT_EQ(bridged.ranges().size(), 1u);
+  EXPECT_EQ(bridged.ranges()[0], (RegisterRange{.start = 0x0100, .count = 14}));
+
+  const auto split = build(fixedModel(5.0, 1.0));
+  ASSERT_EQ(split.ranges().size(), 2u);
+  EXPECT_EQ(split.ranges()[0], (RegisterRange{.start = 0x0100, .count = 2}));
+  EXPECT_EQ(split.ranges()[1], (RegisterRange{.start = 0x010C, .count = 2}));
+  EXPECT_DOUBLE_EQ(split.estimatedCostUs(), 2 * (5.0 + 2.0));
+}
+
+TEST(RegisterReadPlannerTests, RespectsWordLimitPerRead) {
+  const auto plan = RegisterReadPlanner(fixedModel(1e6, 0.0), 8)
+                        .require(0x0000, 4)
+                        .require(0x0006, 2)
+                        .require(0x0020, 20)
+                        .plan();
+  for (const auto& range : plan.ranges()) {
+    EXPECT_LE(range.count, 8);
+  }
+  ASSERT_EQ(plan.ranges().size(), 4u);
+  EXPECT_EQ(plan.ranges()[0], (RegisterRange{.start = 0x0000, .count = 8}));
+  EXPECT_EQ(plan.ranges()[1], (RegisterRange{.start = 0x0020, .count = 8}));
+  EXPECT_EQ(plan.ranges()[3], (RegisterRange{.start = 0x0030, .count = 4}));
+
+  EXPECT_THROW((void)RegisterReadPlanner(fixedModel(1.0, 1.0), 126),
+               std::runtime_error);
+}
+
+TEST(RegisterReadPlannerTests, StatusPlanUsesRegisterMapAddresses) {
+  const auto map = makeArKd2RegisterMap();
+  MotorRtuConfig rtu;
+  rtu.baud = 9600;
+  const auto plan =
+      RegisterReadPlanner(RegisterReadCostModel::fromRtu(rtu))
+          .require(map.driverOutputCommandLower)
+          .require(map.commandPosition,
+                   map.directIoAndBrakeStatus + 2 - map.commandPosition)
+          .plan();
+
+  // Bridging 0x0080..0x00C5 costs far more than a second round trip at 9600.
+  ASSERT_EQ(plan.ranges().size(), 2u);
+  EXPECT_EQ(plan.ranges()[0].start, map.driverOutputCommandLower);
+  EXPECT_EQ(plan.ranges()[1].start, map.commandPosition);
+  EXPECT_EQ(plan.ranges()[1].end(), map.directIoAndBrakeStatus + 2);
+  EXPECT_NE(plan.describe().find("2 x FC03: 0x007F+1, 0x00C6+16"),
+            std::string::npos);
+}
+
+TEST(RegisterReadPlannerTests, BlockDecodesWordsByAddress) {
+  RegisterBlock block;
+  const std::array<std::uint16_t, 4> words{0x1234, 0xFFFF, 0xFFFE, 0x0042};
+  block.store(0x00C6, words);
+
+  EXPECT_TRUE(block.contains(0x00C6, 4));
+  EXPECT_FALSE(block.contains(0x00C8, 3));
+  EXPECT_EQ(block.u16(0x00C9), 0x0042);
+  EXPECT_EQ(block.u32(0x00C6), 0x1234FFFFu);
+  EXPECT_EQ(block.i32(0x00C7), -2);
+  EXPECT_THROW((void)block.u16(0x00CA), std::runtime_error);
+  EXPECT_THROW((void)block.u32(0x00C9), std::runtime_error);
+}
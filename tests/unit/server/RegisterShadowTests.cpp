@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <RegisterShadow.hpp>
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+struct RecordedWrite {
+  int start{0};
+  std::vector<std::uint16_t> words;
+};
+
+RegisterShadow::WriteFn recordInto(std::vector<RecordedWrite>& writes) {
+  return [&writes](const int start, std::span<const std::uint16_t> words) {
+    writes.push_back({start, {words.begin(), words.end()}});
+  };
+}
+}  // namespace
+
+TEST(RegisterShadowTests, CoalescesAdjacentStagedWritesIntoOneRange) {
+  RegisterShadow shadow;
+  shadow.stageU32(0x0602, 7);
+  shadow.stageU32(0x0600, 5);
+  shadow.stageU32(0x0680, 9);
+
+  std::vector<RecordedWrite> writes;
+  shadow.flush(recordInto(writes));
+
+  ASSERT_EQ(writes.size(), 2u);
+  EXPECT_EQ(writes[0].start, 0x0600);
+  EXPECT_EQ(writes[0].words, (std::vector<std::uint16_t>{0, 5, 0, 7}));
+  EXPECT_EQ(writes[1].start, 0x0680);
+  EXPECT_EQ(writes[1].words, (std::vector<std::uint16_t>{0, 9}));
+  EXPECT_FALSE(shadow.hasPendingWrites());
+  EXPECT_EQ(shadow.known(0x0603), 7u);
+}
+
+TEST(RegisterShadowTests, SkipsValuesTheDeviceAlreadyHolds) {
+  RegisterShadow shadow;
+  std::vector<RecordedWrite> writes;
+  shadow.stageU32(0x0240, 1000);
+  shadow.flush(recordInto(writes));
+  ASSERT_EQ(writes.size(), 1u);
+
+  shadow.stageU32(0x0240, 1000);
+  EXPECT_FALSE(shadow.hasPendingWrites());
+
+  // Only the low word differs, but the 32-bit value is written as a whole.
+  shadow.stageU32(0x0240, 1001);
+  shadow.flush(recordInto(writes));
+  ASSERT_EQ(writes.size(), 2u);
+  EXPECT_EQ(writes[1].words, (std::vector<std::uint16_t>{0, 1001}));
+}
+
+TEST(RegisterShadowTests, SplitsRangesAtFc16Limit) {
+  RegisterShadow shadow;
+  std::vector<std::uint16_t> words(130, 1);
+  shadow.stage(0x1000, words);
+
+  const auto ranges = shadow.pendingRanges();
+  ASSERT_EQ(ranges.size(), 2u);
+  EXPECT_EQ(ranges[0], (RegisterRange{.start = 0x1000, .count = 123}));
+  EXPECT_EQ(ranges[1], (RegisterRange{.start = 0x1000 + 123, .count = 7}));
+}
+
+TEST(RegisterShadowTests, FailedFlushForgetsStagedRegisters) {
+  RegisterShadow shadow;
+  std::vector<RecordedWrite> writes;
+  shadow.stageU32(0x0480, 10);
+  shadow.flush(recordInto(writes));
+
+  shadow.stageU32(0x0480, 20);
+  EXPECT_THROW(shadow.flush([](int, std::span<const std::uint16_t>) {
+    throw std::runtime_error("bus down");
+  }),
+               std::runtime_error);
+  EXPECT_FALSE(shadow.hasPendingWrites());
+  EXPECT_FALSE(shadow.known(0x0480).has_value());
+
+  // With the value unknown, even the old value is written again.
+  shadow.stageU32(0x0480, 10);
+  EXPECT_TRUE(shadow.hasPendingWrites());
+}
+
+TEST(RegisterShadowTests, ReadBackReplacesAssumedValues) {
+  RegisterShadow shadow;
+  std::vector<RecordedWrite> writes;
+  shadow.stageU32(0x0242, 500);
+  shadow.flush(recordInto(writes));
+
+  const std::array<std::uint16_t, 2> readBack{0, 0};
+  shadow.observe(0x0242, readBack);
+  shadow.stageU32(0x0242, 0);
+  EXPECT_FALSE(shadow.hasPendingWrites());
+  shadow.stageU32(0x0242, 500);
+  EXPECT_TRUE(shadow.hasPendingWrites());
+  shadow.flush(recordInto(writes));
+
+  shadow.invalidateAll();
+  shadow.stageU32(0x0242, 500);
+  EXPECT_TRUE(shadow.hasPendingWrites());
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <RuntimeMetrics.hpp>
+
+#include <chrono>
+
+#include "server/fakes/FakeClock.hpp"
+
+using namespace std::chrono_literals;
+
+TEST(RuntimeMetricsTests, LatencySummaryReportsMicroseconds) {
+  utl::LatencySnapshot snapshot;
+  snapshot.record(1'000);
+  snapshot.record(3'000);
+
+  const auto summary = metrics::latencySummary(snapshot);
+  EXPECT_EQ(summary["count"], 2);
+  EXPECT_DOUBLE_EQ(summary["meanUs"].get<double>(), 2.0);
+  EXPECT_DOUBLE_EQ(summary["maxUs"].get<double>(), 3.0);
+  EXPECT_LE(summary["p50Us"].get<double>(), 1.125);
+
+  const auto empty = metrics::latencySummary({});
+  EXPECT_EQ(empty["count"], 0);
+  EXPECT_DOUBLE_EQ(empty["meanUs"].get<double>(), 0.0);
+}
+
+TEST(RuntimeMetricsTests, ControlLoopReportsDutyCycleOfTheInterval) {
+  FakeClock clock;
+  ControlLoopRunner runner(clock, 10ms);
+  ControlLoopMetrics loop;
+  loop.cycles = 2;
+  loop.overruns = 1;
+  loop.work.record(2'000'000);
+  loop.work.record(6'000'000);
+
+  const auto json = metrics::controlLoop(runner, loop);
+  EXPECT_EQ(json["intervalMs"], 10);
+  EXPECT_EQ(json["cycles"], 2);
+  EXPECT_EQ(json["overruns"], 1);
+  EXPECT_DOUBLE_EQ(json["dutyCycle"]["mean"].get<double>(), 0.4);
+  EXPECT_DOUBLE_EQ(json["dutyCycle"]["max"].get<double>(), 0.6);
+  EXPECT_EQ(json["wakeLatency"]["count"], 0);
+  EXPECT_TRUE(json["tasks"].empty());
+}
+
+TEST(RuntimeMetricsTests, ControlLoopListsTasksWithTheirSchedule) {
+  FakeClock clock;
+  ControlLoopRunner runner(clock, 10ms);
+  runner.addTask({.name = "control", .period = 10ms, .priority = 1}, []() {});
+  runner.addTask({.name = "status",
+                  .period = 50ms,
+                  .overrun = LoopTaskOverrun::Restart},
+                 []() {});
+  ControlLoopMetrics loop;
+  loop.tasks.resize(2);
+  loop.tasks[1].runs = 3;
+  loop.tasks[1].skippedReleases = 1;
+  loop.tasks[1].time.record(4'000'000);
+
+  const auto json = metrics::controlLoop(runner, loop);
+  ASSERT_EQ(json["tasks"].size(), 2u);
+  EXPECT_EQ(json["tasks"][0]["name"], "control");
+  EXPECT_EQ(json["tasks"][0]["priority"], 1);
+  EXPECT_EQ(json["tasks"][0]["runs"], 0);
+  const auto& status = json["tasks"][1];
+  EXPECT_DOUBLE_EQ(status["periodMs"].get<double>(), 50.0);
+  EXPECT_EQ(status["overrun"], "Restart");
+  EXPECT_EQ(status["runs"], 3);
+  EXPECT_EQ(status["skippedReleases"], 1);
+  EXPECT_DOUBLE_EQ(status["time"]["maxUs"].get<double>(), 4'000.0);
+}
+
+TEST(RuntimeMetricsTests, ModbusLineListsSlaves) {
+  ModbusTrafficStats::SlaveReport slave;
+  slave.slave = 4;
+  slave.transactions = 10;
+  slave.timeouts = 2;
+  slave.crc_errors = 1;
+  slave.round_trip.record(5'000);
+
+  const auto json = metrics::modbusLine("bus0", {slave});
+  EXPECT_EQ(json["line"], "bus0");
+  ASSERT_EQ(json["slaves"].size(), 1u);
+  EXPECT_EQ(json["slaves"][0]["slave"], 4);
+  EXPECT_EQ(json["slaves"][0]["timeouts"], 2);
+  EXPECT_EQ(json["slaves"][0]["crcErrors"], 1);
+  EXPECT_EQ(json["slaves"][0]["otherErrors"], 0);
+  EXPECT_EQ(json["slaves"][0]["roundTrip"]["count"], 1);
+}
+
+TEST(RuntimeMetricsTests, OverrunLogListsTasksOldestFirst) {
+  FakeClock clock;
+  ControlLoopRunner runner(clock, 10ms);
+  runner.addTask({.name = "control", .period = 10ms}, []() {});
+  runner.addTask({.name = "status", .period = 50ms}, []() {});
+  ControlLoopOverrunLog log;
+  log.push({.startedAt = IClock::time_point{10ms},
+            .late = 2ms,
+            .tasks = {3ms, 9ms},
+            .culprit = 1});
+  log.push({.startedAt = IClock::time_point{40ms},
+            .late = 1ms,
+            .wake = 12ms,
+            .culprit = std::nullopt});
+
+  const auto json =
+      metrics::overrunLog(runner, log, IClock::time_point{100ms});
+  EXPECT_EQ(json["total"], 2);
+  ASSERT_EQ(json["recent"].size(), 2u);
+  EXPECT_DOUBLE_EQ(json["recent"][0]["agoMs"].get<double>(), 90.0);
+  EXPECT_EQ(json["recent"][0]["culprit"], "status");
+  EXPECT_DOUBLE_EQ(json["recent"][0]["tasksMs"]["status"].get<double>(), 9.0);
+  EXPECT_DOUBLE_EQ(json["recent"][0]["tasksMs"]["control"].get<double>(),
+                   3.0);
+  EXPECT_EQ(json["recent"][1]["culprit"], "wake");
+  EXPECT_DOUBLE_EQ(json["recent"][1]["wakeMs"].get<double>(), 12.0);
+  EXPECT_DOUBLE_EQ(json["recent"][1]["lateMs"].get<double>(), 1.0);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <StatusPublisher.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+utl::RobotStatus statusWithPosition(const double position) {
+  utl::RobotStatus status;
+  status.motors[utl::EMotor::XLeft].currentPosition = position;
+  return status;
+}
+}  // namespace
+
+TEST(StatusPublisherTests, SendsSubmittedStatusFromPublisherThread) {
+  std::mutex mutex;
+  std::condition_variable sent;
+  std::vector<double> positions;
+  std::thread::id sendThread;
+
+  StatusPublisher publisher([&](const utl::RobotStatus& status) {
+    std::lock_guard lock(mutex);
+    sendThread = std::this_thread::get_id();
+    positions.push_back(status.motors.at(utl::EMotor::XLeft).currentPosition);
+    sent.notify_all();
+  });
+  publisher.start();
+  publisher.submit(statusWithPosition(1.5));
+
+  std::unique_lock lock(mutex);
+  ASSERT_TRUE(sent.wait_for(lock, std::chrono::seconds(5),
+                            [&]() { return !positions.empty(); }));
+  EXPECT_EQ(positions.front(), 1.5);
+  EXPECT_NE(sendThread, std::this_thread::get_id());
+}
+
+TEST(StatusPublisherTests, SlowSendSkipsToNewestSnapshot) {
+  std::mutex mutex;
+  std::condition_variable released;
+  bool release = false;
+  std::atomic<bool> firstSendStarted{false};
+  std::vector<double> positions;
+
+  StatusPublisher publisher([&](const utl::RobotStatus& status) {
+    firstSendStarted = true;
+    std::unique_lock lock(mutex);
+    released.wait(lock, [&]() { return release; });
+    positions.push_back(status.motors.at(utl::EMotor::XLeft).currentPosition);
+  });
+  publisher.start();
+  publisher.submit(statusWithPosition(1.0));
+  while (!firstSendStarted) {
+    std::this_thread::yield();
+  }
+  // The first send is stuck; the control side keeps submitting regardless.
+  for (int i = 2; i <= 5; ++i) {
+    publisher.submit(statusWithPosition(static_cast<double>(i)));
+  }
+  {
+    std::lock_guard lock(mutex);
+    release = true;
+  }
+  released.notify_all();
+  publisher.stop();
+
+  EXPECT_EQ(positions, (std::vector<double>{1.0, 5.0}));
+  EXPECT_EQ(publisher.submittedCount(), 5u);
+  EXPECT_EQ(publisher.skippedCount(), 3u);
+}
+
+TEST(StatusPublisherTests, SendFailureDoesNotStopPublisher) {
+  std::atomic<int> attempts{0};
+  StatusPublisher publisher([&](const utl::RobotStatus&) {
+    if (attempts.fetch_add(1) == 0) {
+      throw std::runtime_error("socket gone");
+    }
+  });
+  publisher.start();
+  publisher.submit(statusWithPosition(1.0));
+  while (attempts.load() == 0) {
+    std::this_thread::yield();
+  }
+  publisher.submit(statusWithPosition(2.0));
+  publisher.stop();
+
+  EXPECT_EQ(attempts.load(), 2);
+}
+
+TEST(StatusPublisherTests, MetricsFollowTheNextStatusAndSendTimesAreRecorded) {
+  std::vector<std::string> sent;
+  StatusPublisher publisher(
+      [&](const utl::RobotStatus&) { sent.emplace_back("status"); },
+      [&](const nlohmann::json& metrics) {
+        sent.push_back(metrics.at("name").get<std::string>());
+      });
+  publisher.submitMetrics({{"name", "metrics"}});
+  publisher.submit(statusWithPosition(1.0));
+  publisher.start();
+  publisher.stop();
+
+  EXPECT_EQ(sent, (std::vector<std::string>{"status", "metrics"}));
+  utl::LatencySnapshot sendTimes;
+  publisher.collectSendTimes(sendTimes);
+  EXPECT_EQ(sendTimes.count, 1u);
+}
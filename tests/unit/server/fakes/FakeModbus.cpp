@@ -223,6 +223,30 @@ int modbus_write_registers(modbus_t* ctx, const int addr, const int nb,
   return nb;
 }
 
+// Only FC06 is understood; a slave 0 request is recorded as slave 0.
+int modbus_send_raw_request(modbus_t*, const uint8_t* raw_req,
+                            const int raw_req_length) {
+  if (consumeFailure(fake_modbus::FailurePoint::SendRawRequest)) {
+    return -1;
+  }
+  if (raw_req_length != 6 || raw_req[1] != 0x06) {
+    errno = EINVAL;
+    return -1;
+  }
+  const int slave = raw_req[0];
+  const int addr = (raw_req[2] << 8) | raw_req[3];
+  const auto value = static_cast<std::uint16_t>((raw_req[4] << 8) | raw_req[5]);
+  auto& st = state();
+  std::lock_guard<std::mutex> lock(st.mutex);
+  st.holdingBySlave[slave][addr] = value;
+  st.writeHistory.push_back(fake_modbus::WriteRecord{
+      .slave = slave,
+      .addr = addr,
+      .kind = fake_modbus::WriteKind::SingleRegister,
+      .values = {value}});
+  return raw_req_length + 2;
+}
+
 int modbus_read_bits(modbus_t*, int, int nb, uint8_t* dest) {
   if (consumeFailure(fake_modbus::FailurePoint::ReadBits)) {
     return -1;
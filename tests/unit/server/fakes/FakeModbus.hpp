@@ -25,6 +25,7 @@ enum class FailurePoint {
   ReadInputBits,
   WriteBit,
   WriteBits,
+  SendRawRequest,
 };
 
 struct WriteRecord {
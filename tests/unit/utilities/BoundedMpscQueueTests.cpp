@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <BoundedMpscQueue.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(BoundedMpscQueueTests, PopsInPushOrderAcrossWrapAround) {
+  utl::BoundedMpscQueue<int> queue(3);
+  int next = 0;
+  for (int round = 0; round < 5; ++round) {
+    ASSERT_TRUE(queue.push(int{next}));
+    ASSERT_TRUE(queue.push(int{next + 1}));
+    EXPECT_EQ(queue.try_pop(), next);
+    EXPECT_EQ(queue.try_pop(), next + 1);
+    next += 2;
+  }
+  EXPECT_FALSE(queue.try_pop().has_value());
+}
+
+TEST(BoundedMpscQueueTests, FullQueueLeavesValueWithCaller) {
+  utl::BoundedMpscQueue<std::string> queue(2);
+  ASSERT_TRUE(queue.push(std::string{"first"}));
+  ASSERT_TRUE(queue.push(std::string{"second"}));
+
+  std::string third{"third"};
+  EXPECT_FALSE(queue.push(std::move(third)));
+  EXPECT_EQ(third, "third");
+  EXPECT_EQ(queue.size(), 2u);
+}
+
+TEST(BoundedMpscQueueTests, CloseRejectsPushesButKeepsQueuedValues) {
+  utl::BoundedMpscQueue<int> queue(4);
+  ASSERT_TRUE(queue.push(1));
+  queue.close();
+
+  EXPECT_TRUE(queue.closed());
+  EXPECT_FALSE(queue.push(2));
+  EXPECT_EQ(queue.try_pop(), 1);
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(queue.size(), 0u);
+}
+
+TEST(BoundedMpscQueueTests, EachProducersValuesArriveInOrder) {
+  constexpr int kProducers = 4;
+  constexpr int kPerProducer = 20000;
+  utl::BoundedMpscQueue<int> queue(64);
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&queue, p] {
+      for (int i = 0; i < kPerProducer; ++i) {
+        while (!queue.push(p * kPerProducer + i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::vector<int> lastSeen(kProducers, -1);
+  bool ordered = true;
+  for (int received = 0; received < kProducers * kPerProducer;) {
+    const auto value = queue.try_pop();
+    if (!value) {
+      std::this_thread::yield();
+      continue;
+    }
+    const auto producer = *value / kPerProducer;
+    ordered = ordered && *value % kPerProducer > lastSeen[producer];
+    lastSeen[producer] = *value % kPerProducer;
+    ++received;
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  EXPECT_TRUE(ordered);
+  EXPECT_TRUE(queue.empty());
+}
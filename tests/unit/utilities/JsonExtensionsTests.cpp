@@ -15,3 +15,17 @@ TEST(JsonExtensionsTests, RobotStatusRoundTripPreservesSafetyOn) {
   ASSERT_TRUE(roundTrip.safetyOn.has_value());
   EXPECT_TRUE(*roundTrip.safetyOn);
 }
+
+TEST(JsonExtensionsTests, MotorLinkStateRoundTripsAndDefaultsToOnline) {
+  utl::RobotStatus status;
+  status.motors[utl::EMotor::YLeft].linkState = utl::EMotorLinkState::Skipped;
+
+  auto json = nlohmann::json(status);
+  EXPECT_EQ(json.get<utl::RobotStatus>().motors.at(utl::EMotor::YLeft).linkState,
+            utl::EMotorLinkState::Skipped);
+
+  // Status from an older server carries no link state.
+  json["motors"]["YLeft"].erase("linkState");
+  EXPECT_EQ(json.get<utl::RobotStatus>().motors.at(utl::EMotor::YLeft).linkState,
+            utl::EMotorLinkState::Online);
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <LatestValueSlot.hpp>
+
+#include <string>
+#include <thread>
+
+TEST(LatestValueSlotTests, TakeReturnsNothingUntilSomethingIsPublished) {
+  utl::LatestValueSlot<int> slot;
+  EXPECT_EQ(slot.take(), nullptr);
+
+  slot.writeBuffer() = 7;
+  slot.publish();
+  const auto* value = slot.take();
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(*value, 7);
+  EXPECT_EQ(slot.take(), nullptr);
+}
+
+TEST(LatestValueSlotTests, NewerValueReplacesOneNotYetTaken) {
+  utl::LatestValueSlot<std::string> slot;
+  for (const auto* text : {"first", "second", "third"}) {
+    slot.writeBuffer() = text;
+    slot.publish();
+  }
+
+  const auto* value = slot.take();
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(*value, "third");
+  EXPECT_EQ(slot.publishedCount(), 3u);
+  EXPECT_EQ(slot.overwrittenCount(), 2u);
+}
+
+TEST(LatestValueSlotTests, CloseHandsOutPendingValueThenWakesConsumer) {
+  utl::LatestValueSlot<int> slot;
+  slot.writeBuffer() = 1;
+  slot.publish();
+  slot.close();
+
+  const auto* value = slot.waitAndTake();
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(*value, 1);
+  EXPECT_EQ(slot.waitAndTake(), nullptr);
+}
+
+TEST(LatestValueSlotTests, ConsumerOnlyEverSeesIncreasingValues) {
+  utl::LatestValueSlot<int> slot;
+  constexpr int kLast = 100000;
+  int lastSeen = 0;
+  bool ordered = true;
+
+  std::thread consumer([&]() {
+    while (const auto* value = slot.waitAndTake()) {
+      ordered = ordered && *value > lastSeen;
+      lastSeen = *value;
+    }
+  });
+  for (int i = 1; i <= kLast; ++i) {
+    slot.writeBuffer() = i;
+    slot.publish();
+  }
+  slot.close();
+  consumer.join();
+
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(lastSeen, kLast);
+}
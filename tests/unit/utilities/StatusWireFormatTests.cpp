@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+
+#include <JsonExtensions.hpp>
+#include <StatusWireFormat.hpp>
+
+#include <stdexcept>
+
+namespace {
+utl::RobotStatus makeStatus() {
+  using namespace utl;
+  RobotStatus status;
+  for (const auto motor : {EMotor::XLeft, EMotor::YRight, EMotor::ZLeft}) {
+    status.motors[motor] = {
+        .currentPosition = 12.5,
+        .targetPosition = -3.25,
+        .speed = 4.0,
+        .speedRpm = 120.0,
+        .torque = -17,
+        .state = ELEDState::Warning,
+        .warningDescription = "Overload warning",
+        .alarmDescription = motor == EMotor::ZLeft ? "Overcurrent" : "",
+        .flags = {{EMotorStatusFlags::BrakeApplied, ELEDState::On},
+                  {EMotorStatusFlags::Alarm, ELEDState::ErrorBlinking}},
+        .speedCommandPercent = -42.5,
+        .modeMaxLinearSpeedMmPerSec = 250.0,
+        .linkState = EMotorLinkState::Probing};
+  }
+  status.toolChangers[EArm::Left].flags = {
+      {EToolChangerStatusFlags::ProxSen, ELEDState::On},
+      {EToolChangerStatusFlags::ClosedValve, ELEDState::Off}};
+  status.robotComponents[ERobotComponent::MotorControl] = ELEDState::Error;
+  status.joystics[EArm::Gantry] = {.x = 0.5, .y = -1.0, .btn = true};
+  status.safetyOn = false;
+  status.armStates[EArm::Right] = EAxisState::Fast;
+  status.commandQueue = {.depth = 3,
+                         .deferred = 1,
+                         .waitP50Ms = 12.5,
+                         .waitP95Ms = 48.0,
+                         .waitP99Ms = 61.25};
+  return status;
+}
+}  // namespace
+
+TEST(StatusWireFormatTests, BinaryRoundTripMatchesJsonRoundTrip) {
+  const auto status = makeStatus();
+  std::vector<std::uint8_t> frame;
+  utl::encodeBinaryStatus(status, frame);
+
+  ASSERT_TRUE(utl::isBinaryStatus(frame));
+  const auto decoded = utl::decodeBinaryStatus(frame);
+  EXPECT_EQ(nlohmann::json(decoded), nlohmann::json(status));
+  ASSERT_TRUE(decoded.safetyOn.has_value());
+  EXPECT_FALSE(*decoded.safetyOn);
+}
+
+TEST(StatusWireFormatTests, BinaryFrameIsSmallerThanMsgpackAndDistinguishable) {
+  const auto status = makeStatus();
+  std::vector<std::uint8_t> frame;
+  utl::encodeBinaryStatus(status, frame);
+  const auto msgpack = nlohmann::json::to_msgpack(nlohmann::json(status));
+
+  EXPECT_LT(frame.size() * 2, msgpack.size());
+  EXPECT_FALSE(utl::isBinaryStatus(msgpack));
+}
+
+TEST(StatusWireFormatTests, RepeatedAlarmTextIsStoredOnce) {
+  auto status = makeStatus();
+  std::vector<std::uint8_t> once;
+  utl::encodeBinaryStatus(status, once);
+
+  status.motors[utl::EMotor::XRight] = status.motors.at(utl::EMotor::XLeft);
+  std::vector<std::uint8_t> twice;
+  utl::encodeBinaryStatus(status, twice);
+
+  const auto text = std::string_view("Overload warning");
+  const auto occurrences = [&](const std::vector<std::uint8_t>& frame) {
+    const std::string_view bytes(reinterpret_cast<const char*>(frame.data()),
+                                 frame.size());
+    int count = 0;
+    for (auto pos = bytes.find(text); pos != std::string_view::npos;
+         pos = bytes.find(text, pos + 1)) {
+      ++count;
+    }
+    return count;
+  };
+  EXPECT_EQ(occurrences(once), 1);
+  EXPECT_EQ(occurrences(twice), 1);
+}
+
+TEST(StatusWireFormatTests, RejectsTruncatedNewerAndCorruptFrames) {
+  std::vector<std::uint8_t> frame;
+  utl::encodeBinaryStatus(makeStatus(), frame);
+
+  auto truncated = frame;
+  truncated.pop_back();
+  EXPECT_THROW(utl::decodeBinaryStatus(truncated), std::runtime_error);
+
+  auto newer = frame;
+  newer[2] = utl::kStatusWireVersion + 1;
+  EXPECT_THROW(utl::decodeBinaryStatus(newer), std::runtime_error);
+
+  // First motor id sits right after the 8-byte header and the string table.
+  auto badEnum = frame;
+  std::size_t offset = 8;
+  const auto strings = badEnum[offset] | (badEnum[offset + 1] << 8);
+  offset += 2;
+  for (int i = 0; i < strings; ++i) {
+    offset += 2 + (badEnum[offset] | (badEnum[offset + 1] << 8));
+  }
+  badEnum[offset + 1] = 200;
+  EXPECT_THROW(utl::decodeBinaryStatus(badEnum), std::runtime_error);
+}
+
+TEST(StatusWireFormatTests, ParsesConfiguredEncodingNames) {
+  EXPECT_EQ(utl::parseStatusEncoding("json"), utl::EStatusEncoding::Json);
+  EXPECT_EQ(utl::parseStatusEncoding("binary"), utl::EStatusEncoding::Binary);
+  EXPECT_THROW(utl::parseStatusEncoding("protobuf"), std::runtime_error);
+}
+
+TEST(StatusWireFormatTests, DeltaStreamRebuildsEveryStatus) {
+  utl::StatusDeltaEncoder encoder(4);
+  utl::StatusDeltaDecoder decoder;
+  auto status = makeStatus();
+  std::vector<std::uint8_t> frame;
+
+  std::vector<utl::EStatusFrameKind> kinds;
+  for (int i = 0; i < 6; ++i) {
+    status.motors[utl::EMotor::XLeft].currentPosition += 1.0;
+    if (i == 2) {
+      status.motors[utl::EMotor::ZLeft].alarmDescription = "";
+      status.safetyOn = std::nullopt;
+      status.commandQueue.depth = 0;
+      status.toolChangers[utl::EArm::Left]
+          .flags[utl::EToolChangerStatusFlags::ProxSen] = utl::ELEDState::Off;
+    }
+    kinds.push_back(encoder.encode(status, frame));
+    ASSERT_TRUE(decoder.apply(frame));
+    EXPECT_EQ(nlohmann::json(decoder.state()), nlohmann::json(status));
+  }
+
+  using K = utl::EStatusFrameKind;
+  EXPECT_EQ(kinds, (std::vector{K::Keyframe, K::Delta, K::Delta, K::Delta,
+                                K::Keyframe, K::Delta}));
+  // Only one position changed in the last frame.
+  EXPECT_LT(frame.size(), 32u);
+}
+
+TEST(StatusWireFormatTests, GapWaitsForRequestedKeyframe) {
+  utl::StatusDeltaEncoder encoder(100);
+  utl::StatusDeltaDecoder decoder;
+  auto status = makeStatus();
+  std::vector<std::uint8_t> frame;
+
+  encoder.encode(status, frame);
+  ASSERT_TRUE(decoder.apply(frame));
+  status.motors[utl::EMotor::XLeft].speed = 9.0;
+  encoder.encode(status, frame);  // lost on the way
+  status.motors[utl::EMotor::YRight].torque = 3;
+  encoder.encode(status, frame);
+
+  EXPECT_FALSE(decoder.apply(frame));
+  EXPECT_EQ(decoder.gapCount(), 1u);
+  EXPECT_FALSE(decoder.hasState());
+
+  encoder.requestKeyframe();
+  EXPECT_EQ(encoder.encode(status, frame), utl::EStatusFrameKind::Keyframe);
+  ASSERT_TRUE(decoder.apply(frame));
+  EXPECT_EQ(decoder.state().motors.at(utl::EMotor::XLeft).speed, 9.0);
+  EXPECT_EQ(decoder.lastSequence(), 3u);
+}
+
+TEST(StatusWireFormatTests, DeltaBeforeKeyframeAndShapeChangesAreHandled) {
+  utl::StatusDeltaEncoder encoder(100);
+  auto status = makeStatus();
+  std::vector<std::uint8_t> frame;
+  encoder.encode(status, frame);
+  encoder.encode(status, frame);
+
+  // A subscriber joining mid-stream cannot use a delta.
+  utl::StatusDeltaDecoder lateJoiner;
+  EXPECT_FALSE(lateJoiner.apply(frame));
+  EXPECT_THROW(utl::decodeBinaryStatus(frame), std::runtime_error);
+
+  status.motors[utl::EMotor::XRight] = {};
+  EXPECT_EQ(encoder.encode(status, frame), utl::EStatusFrameKind::Keyframe);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <LatencyHistogram.hpp>
+#include <TimingMetrics.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+const utl::TimingSummary* findSummary(
+    const std::vector<utl::TimingSummary>& summaries, const char* name) {
+  const auto it = std::ranges::find(summaries, std::string_view{name},
+                                    &utl::TimingSummary::name);
+  return it == summaries.end() ? nullptr : &*it;
+}
+}  // namespace
+
+TEST(LatencyHistogramTests, BucketsCoverValuesWithinAnEighth) {
+  for (const std::uint64_t value :
+       {0ull, 1ull, 7ull, 8ull, 9ull, 100ull, 1'000ull, 123'456ull,
+        987'654'321ull, 60'000'000'000ull}) {
+    const auto index = utl::LatencyBuckets::indexFor(value);
+    EXPECT_LE(utl::LatencyBuckets::lowerBound(index), value);
+    EXPECT_GE(utl::LatencyBuckets::upperBound(index), value);
+    EXPECT_LE(utl::LatencyBuckets::upperBound(index) -
+                  utl::LatencyBuckets::lowerBound(index),
+              value / 8);
+  }
+  EXPECT_EQ(utl::LatencyBuckets::indexFor(~std::uint64_t{0}),
+            utl::LatencyBuckets::kCount - 1);
+}
+
+TEST(LatencyHistogramTests, PercentilesOfUniformSamples) {
+  utl::LatencyHistogram histogram;
+  for (std::uint64_t us = 1; us <= 1000; ++us) {
+    histogram.record(us * 1000);
+  }
+  utl::LatencySnapshot snapshot;
+  histogram.collectInto(snapshot);
+
+  EXPECT_EQ(snapshot.count, 1000u);
+  EXPECT_EQ(snapshot.maxNs, 1'000'000u);
+  EXPECT_NEAR(static_cast<double>(snapshot.percentileNs(0.50)), 500'000.0,
+              500'000.0 / 8);
+  EXPECT_NEAR(static_cast<double>(snapshot.percentileNs(0.99)), 990'000.0,
+              990'000.0 / 8);
+  EXPECT_EQ(snapshot.percentileNs(0.999), 1'000'000u);
+}
+
+TEST(LatencyHistogramTests, CollectReportsOnlyNewSamples) {
+  utl::LatencyHistogram histogram;
+  histogram.record(5'000);
+  utl::LatencySnapshot first;
+  histogram.collectInto(first);
+  EXPECT_EQ(first.count, 1u);
+
+  histogram.record(40);
+  histogram.record(60);
+  utl::LatencySnapshot second;
+  histogram.collectInto(second);
+  EXPECT_EQ(second.count, 2u);
+  EXPECT_EQ(second.totalNs, 100u);
+  EXPECT_EQ(second.maxNs, 60u);
+}
+
+TEST(TimingMetricsTests, CollectMergesThreadsPerSite) {
+  auto& registry = utl::TimingMetricsRegistry::instance();
+  const auto site = registry.registerSite("TimingMetricsTests::merge");
+  (void)registry.collect();
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 3; ++t) {
+    threads.emplace_back([&registry, site, t] {
+      for (int i = 0; i < 100; ++i) {
+        registry.record(site, static_cast<std::uint64_t>(1000 * (t + 1)));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto summaries = registry.collect();
+  const auto* summary = findSummary(summaries, "TimingMetricsTests::merge");
+  ASSERT_NE(summary, nullptr);
+  EXPECT_EQ(summary->count, 300u);
+  EXPECT_EQ(summary->totalNs, 600'000u);
+  EXPECT_EQ(summary->maxNs, 3000u);
+  EXPECT_EQ(utl::LatencyBuckets::indexFor(summary->p50Ns),
+            utl::LatencyBuckets::indexFor(2000));
+
+  EXPECT_EQ(findSummary(registry.collect(), "TimingMetricsTests::merge"),
+            nullptr);
+}
+
+TEST(TimingMetricsTests, FinishedThreadsHandTheirSlotOn) {
+  auto& registry = utl::TimingMetricsRegistry::instance();
+  const auto site = registry.registerSite("TimingMetricsTests::reuse");
+  for (int i = 0; i < 5; ++i) {
+    std::thread([&registry, site] { registry.record(site, 10); }).join();
+  }
+
+  const auto summaries = registry.collect();
+  const auto* summary = findSummary(summaries, "TimingMetricsTests::reuse");
+  ASSERT_NE(summary, nullptr);
+  EXPECT_EQ(summary->count, 5u);
+}